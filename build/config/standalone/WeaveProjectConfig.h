@@ -33,6 +33,12 @@
 
 #define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 1
 
+// Let event fetches seek close to the requested event ID.
+#define WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE 32
+
+// Build the event staging front-end; TestEventLoggingStaging enables it
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS 16
+
 #define WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE 300
 
 // Uncomment this for a large Tunnel MTU.
@@ -49,6 +55,22 @@
 // properly when WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG is enabled.
 #define WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED 1
 
+// Enable the memory-mapped BDX file source.
+#define WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT 1
+
+// Let BDX servers grow their transfer pool and share out their sends fairly.
+#define WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL 1
+#define WEAVE_CONFIG_BDX_BLOCK_SCHEDULER 1
+
+// Allow applications to coalesce messages sent over TCP connections.
+#define WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING 1
+
+// Index the schema tree of traits that supply storage for it.
+#define TDM_SCHEMA_PROPERTY_INDEX_SUPPORT 1
+
+// Index the paths in TraitPathStores by trait instance.
+#define TDM_PATH_STORE_INDEX_SUPPORT 1
+
 #define WEAVE_CONFIG_SECURITY_TEST_MODE 1
 
 #define WDM_ENFORCE_EXPIRY_TIME 1
@@ -29,6 +29,7 @@
 #undef WEAVE_CONFIG_USE_MICRO_ECC
 #undef WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL
 #undef WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT
+#undef WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
 #undef WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL
 #undef WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
 #undef WEAVE_CONFIG_AES_IMPLEMENTATION_OPENSSL
@@ -45,6 +46,7 @@
 #define WEAVE_CONFIG_USE_MICRO_ECC 1
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL 0
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT 1
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI 0
 #define WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL 0
 #define WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG 1
 #define WEAVE_CONFIG_AES_IMPLEMENTATION_OPENSSL 0
@@ -53,6 +53,14 @@ uint8_t IsNullableHandleBitfield[] = {
         0x8a, 0x0
 };
 
+//
+// Property Index
+//
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
 //
 // Schema
 //
@@ -76,6 +84,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndex,
 #endif
     }
 };
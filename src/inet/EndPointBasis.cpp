@@ -27,6 +27,8 @@
 
 #include <InetLayer/InetLayer.h>
 
+#include <SystemLayer/SystemLayer.h>
+
 namespace nl {
 namespace Inet {
 
@@ -42,7 +44,99 @@ void EndPointBasis::InitEndPointBasis(InetLayer& aInetLayer, void* aAppState)
     mSocket = INET_INVALID_SOCKET_FD;
     mPendingIO.Clear();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_Unknown;
+    mOnReadyList = false;
+    mReadyIO.Clear();
+    mReadyNext = NULL;
+    mReadyPrev = NULL;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+}
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Register the endpoint's newly created socket with the System Layer's
+ *  epoll instance. Any readiness the socket already has is reported by
+ *  the kernel as an initial edge.
+ *
+ *  @retval INET_NO_ERROR   On success.
+ *  @retval other           The error returned by Weave::System::Layer::WatchSocket.
+ */
+INET_ERROR EndPointBasis::WatchSocket(void)
+{
+    mReadyIO.Clear();
+
+    return SystemLayer().WatchSocket(mSocket, this);
+}
+
+/**
+ *  Deregister the endpoint's socket from the System Layer's epoll
+ *  instance and discard any latched readiness. This must be called
+ *  before the socket is closed.
+ */
+void EndPointBasis::UnwatchSocket(void)
+{
+    if (mSocket != INET_INVALID_SOCKET_FD)
+        SystemLayer().UnwatchSocket(mSocket);
+
+    UnlinkReadyIO();
+    mReadyIO.Clear();
+    mPendingIO.Clear();
+}
+
+/**
+ *  Merge newly reported readiness into the latched state and, if any
+ *  readiness is latched, ensure the endpoint is on the ready list,
+ *  appending it to the tail if it was not already present.
+ *
+ *  @param[in]  aEvents     The events reported by epoll.
+ */
+void EndPointBasis::LatchReadyIO(SocketEvents aEvents)
+{
+    mReadyIO.Value |= aEvents.Value;
+
+    if (mOnReadyList || !mReadyIO.IsSet())
+        return;
+
+    InetLayer& lInetLayer = Layer();
+
+    mReadyNext = NULL;
+    mReadyPrev = lInetLayer.mReadyEndPointsTail;
+    if (mReadyPrev != NULL)
+        mReadyPrev->mReadyNext = this;
+    else
+        lInetLayer.mReadyEndPoints = this;
+    lInetLayer.mReadyEndPointsTail = this;
+    mOnReadyList = true;
+}
+
+/**
+ *  Remove the endpoint from the ready list, retaining any latched
+ *  readiness so that it may be requeued by RequeueReadyIO().
+ */
+void EndPointBasis::UnlinkReadyIO(void)
+{
+    if (!mOnReadyList)
+        return;
+
+    InetLayer& lInetLayer = Layer();
+
+    if (mReadyPrev != NULL)
+        mReadyPrev->mReadyNext = mReadyNext;
+    else
+        lInetLayer.mReadyEndPoints = mReadyNext;
+
+    if (mReadyNext != NULL)
+        mReadyNext->mReadyPrev = mReadyPrev;
+    else
+        lInetLayer.mReadyEndPointsTail = mReadyPrev;
+
+    mReadyNext = NULL;
+    mReadyPrev = NULL;
+    mOnReadyList = false;
 }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
 } // namespace Inet
 } // namespace nl
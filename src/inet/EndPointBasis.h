@@ -86,6 +86,31 @@ protected:
     SocketEvents mPendingIO;        /**< Socket event masks */
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    enum
+    {
+        kSocketEndPointType_Unknown = 0,
+
+        kSocketEndPointType_Raw     = 1,
+        kSocketEndPointType_UDP     = 2,
+        kSocketEndPointType_TCP     = 3,
+        kSocketEndPointType_Tun     = 4
+    };
+
+    uint8_t mSocketEndPointType;    /**< Concrete endpoint class, used to dispatch epoll readiness. */
+    bool mOnReadyList;              /**< Whether the endpoint is linked into the InetLayer ready list. */
+    SocketEvents mReadyIO;          /**< Edge-triggered readiness latched from epoll and not yet consumed. */
+    EndPointBasis* mReadyNext;      /**< Next endpoint in the InetLayer ready list. */
+    EndPointBasis* mReadyPrev;      /**< Previous endpoint in the InetLayer ready list. */
+
+    INET_ERROR WatchSocket(void);
+    void UnwatchSocket(void);
+    void LatchReadyIO(SocketEvents aEvents);
+    void ConsumeReadyIO(int aEvents);
+    void RequeueReadyIO(void);
+    void UnlinkReadyIO(void);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     /** Encapsulated LwIP protocol control block */
     union
@@ -121,6 +146,10 @@ protected:
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     void InitEndPointBasis(InetLayer& aInetLayer, void* aAppState = NULL);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    friend class InetLayer;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 };
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -152,6 +181,30 @@ inline bool EndPointBasis::IsOpenEndPoint(void) const
     return lResult;
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Record that the socket would block for the given events, so that
+ *  they are no longer considered ready until epoll reports a new edge.
+ *
+ *  @param[in]  aEvents     A mask of SocketEvents flags.
+ */
+inline void EndPointBasis::ConsumeReadyIO(int aEvents)
+{
+    mReadyIO.Value &= ~aEvents;
+}
+
+/**
+ *  Place the endpoint back on the ready list if it has latched,
+ *  unconsumed readiness. This must be called whenever the set of
+ *  events the endpoint is interested in grows, since edge-triggered
+ *  notification will not report readiness that was already latched.
+ */
+inline void EndPointBasis::RequeueReadyIO(void)
+{
+    LatchReadyIO(SocketEvents());
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 inline void EndPointBasis::DeferredFree(Weave::System::Object::ReleaseDeferralErrorTactic aTactic)
 {
@@ -93,6 +93,88 @@ union PeerSockAddr
     sockaddr_in  in;
     sockaddr_in6 in6;
 };
+
+static socklen_t ToPeerSockAddr(IPAddressType aAddressType, const IPAddress &aAddress, uint16_t aPort, InterfaceId aInterfaceId,
+        PeerSockAddr &aPeerSockAddr)
+{
+    socklen_t lLength = 0;
+
+    memset(&aPeerSockAddr, 0, sizeof (aPeerSockAddr));
+
+    if (aAddressType == kIPAddressType_IPv6)
+    {
+        aPeerSockAddr.in6.sin6_family   = AF_INET6;
+        aPeerSockAddr.in6.sin6_port     = htons(aPort);
+        aPeerSockAddr.in6.sin6_flowinfo = 0;
+        aPeerSockAddr.in6.sin6_addr     = aAddress.ToIPv6();
+        aPeerSockAddr.in6.sin6_scope_id = aInterfaceId;
+        lLength                         = sizeof (sockaddr_in6);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        aPeerSockAddr.in.sin_family     = AF_INET;
+        aPeerSockAddr.in.sin_port       = htons(aPort);
+        aPeerSockAddr.in.sin_addr       = aAddress.ToIPv4();
+        lLength                         = sizeof (sockaddr_in);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    return lLength;
+}
+
+// Fill in the source address and port, and the destination address and interface, of a datagram received by recvmsg() or
+// recvmmsg(), from its PeerSockAddr and the IP_PKTINFO / IPV6_PKTINFO control data requested by GetSocket().
+static INET_ERROR GetReceivedPacketInfo(struct msghdr &aMsgHeader, IPPacketInfo &aPacketInfo)
+{
+    const PeerSockAddr &lPeerSockAddr = *static_cast<const PeerSockAddr *>(aMsgHeader.msg_name);
+
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return INET_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&aMsgHeader);
+         controlHdr != NULL;
+         controlHdr = CMSG_NXTHDR(&aMsgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
+            aPacketInfo.Interface = inPktInfo->ipi_ifindex;
+            aPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
+            aPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
+            aPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return INET_NO_ERROR;
+}
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -657,28 +739,8 @@ INET_ERROR IPEndPointBasis::SendTo(const IPAddress &aAddress, uint16_t aPort, In
     msgHeader.msg_iov    = &msgIOV;
     msgHeader.msg_iovlen = 1;
 
-    memset(&lPeerSockAddr, 0, sizeof (lPeerSockAddr));
-
-    msgHeader.msg_name = &lPeerSockAddr;
-
-    if (mAddrType == kIPAddressType_IPv6)
-    {
-        lPeerSockAddr.in6.sin6_family   = AF_INET6;
-        lPeerSockAddr.in6.sin6_port     = htons(aPort);
-        lPeerSockAddr.in6.sin6_flowinfo = 0;
-        lPeerSockAddr.in6.sin6_addr     = aAddress.ToIPv6();
-        lPeerSockAddr.in6.sin6_scope_id = aInterfaceId;
-        msgHeader.msg_namelen           = sizeof (sockaddr_in6);
-    }
-#if INET_CONFIG_ENABLE_IPV4
-    else
-    {
-        lPeerSockAddr.in.sin_family     = AF_INET;
-        lPeerSockAddr.in.sin_port       = htons(aPort);
-        lPeerSockAddr.in.sin_addr       = aAddress.ToIPv4();
-        msgHeader.msg_namelen           = sizeof (sockaddr_in);
-    }
-#endif // INET_CONFIG_ENABLE_IPV4
+    msgHeader.msg_name    = &lPeerSockAddr;
+    msgHeader.msg_namelen = ToPeerSockAddr(mAddrType, aAddress, aPort, aInterfaceId, lPeerSockAddr);
 
     // If the endpoint has been bound to a particular interface,
     // and the caller didn't supply a specific interface to send
@@ -849,6 +911,16 @@ INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int
         }
 #endif // defined(SO_NOSIGPIPE)
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // Register the socket for edge-triggered readiness notification.
+        res = WatchSocket();
+        if (res != INET_NO_ERROR)
+        {
+            close(mSocket);
+            mSocket = INET_INVALID_SOCKET_FD;
+            return res;
+        }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
     else if (mAddrType != aAddressType)
     {
@@ -904,6 +976,11 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
         if (rcvLen < 0)
         {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            // The socket has been drained; it is not readable again until epoll reports a new edge.
+            if (errno == EAGAIN)
+                ConsumeReadyIO(SocketEvents::kRead);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
             lStatus = Weave::System::MapErrorPOSIX(errno);
         }
         else if (rcvLen > lBuffer->AvailableDataLength())
@@ -914,52 +991,7 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         {
             lBuffer->SetDataLength((uint16_t) rcvLen);
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
-                 controlHdr != NULL;
-                 controlHdr = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = inPktInfo->ipi_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetReceivedPacketInfo(msgHeader, lPacketInfo);
         }
     }
     else
@@ -980,6 +1012,234 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     return;
 }
+
+/**
+ *  Read up to INET_CONFIG_UDP_RECV_BATCH_SIZE datagrams from the socket with a single recvmmsg() call and deliver them, in order
+ *  of arrival, to \c OnMessagesReceived or else one at a time to \c OnMessageReceived.
+ *
+ *  Where recvmmsg() is unavailable, this reads a single datagram, as HandlePendingIO() does.
+ */
+void IPEndPointBasis::HandlePendingIOBatch(uint16_t aPort)
+{
+#if HAVE_RECVMMSG
+    enum
+    {
+        kMaxMessages = INET_CONFIG_UDP_RECV_BATCH_SIZE,
+        kControlDataSize = 64
+    };
+
+    INET_ERROR      lStatus = INET_NO_ERROR;
+    PacketBuffer *  lBuffers[kMaxMessages];
+    IPPacketInfo    lPacketInfos[kMaxMessages];
+    struct mmsghdr  lMsgHeaders[kMaxMessages];
+    struct iovec    lMsgIOVs[kMaxMessages];
+    PeerSockAddr    lPeerSockAddrs[kMaxMessages];
+    uint8_t         lControlData[kMaxMessages][kControlDataSize];
+    size_t          lCount;
+    size_t          lDelivered;
+    int             lReceived;
+
+    memset(lMsgHeaders, 0, sizeof (lMsgHeaders));
+
+    // Allocate as many buffers as are available, up to the batch size.
+    for (lCount = 0; lCount < kMaxMessages; lCount++)
+    {
+        lBuffers[lCount] = PacketBuffer::New(0);
+        if (lBuffers[lCount] == NULL)
+            break;
+
+        lMsgIOVs[lCount].iov_base = lBuffers[lCount]->Start();
+        lMsgIOVs[lCount].iov_len = lBuffers[lCount]->AvailableDataLength();
+
+        memset(&lPeerSockAddrs[lCount], 0, sizeof (lPeerSockAddrs[lCount]));
+
+        lMsgHeaders[lCount].msg_hdr.msg_name = &lPeerSockAddrs[lCount];
+        lMsgHeaders[lCount].msg_hdr.msg_namelen = sizeof (lPeerSockAddrs[lCount]);
+        lMsgHeaders[lCount].msg_hdr.msg_iov = &lMsgIOVs[lCount];
+        lMsgHeaders[lCount].msg_hdr.msg_iovlen = 1;
+        lMsgHeaders[lCount].msg_hdr.msg_control = lControlData[lCount];
+        lMsgHeaders[lCount].msg_hdr.msg_controllen = kControlDataSize;
+    }
+
+    if (lCount == 0)
+    {
+        if (OnReceiveError != NULL)
+            OnReceiveError(this, INET_ERROR_NO_MEMORY, NULL);
+        return;
+    }
+
+    lReceived = recvmmsg(mSocket, lMsgHeaders, lCount, MSG_DONTWAIT, NULL);
+
+    if (lReceived < 0)
+    {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // The socket has been drained; it is not readable again until epoll reports a new edge.
+        if (errno == EAGAIN)
+            ConsumeReadyIO(SocketEvents::kRead);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        lStatus = Weave::System::MapErrorPOSIX(errno);
+        lReceived = 0;
+    }
+
+    for (size_t i = static_cast<size_t>(lReceived); i < lCount; i++)
+        PacketBuffer::Free(lBuffers[i]);
+
+    if (lStatus != INET_NO_ERROR)
+    {
+        if (OnReceiveError != NULL && lStatus != Weave::System::MapErrorPOSIX(EAGAIN))
+            OnReceiveError(this, lStatus, NULL);
+        return;
+    }
+
+    // The handlers may close the endpoint; keep it alive until the whole batch has been disposed of.
+    Retain();
+
+    // Report the datagrams that could not be received whole, and gather the others at the front of the batch.
+    lDelivered = 0;
+    for (size_t i = 0; i < static_cast<size_t>(lReceived); i++)
+    {
+        struct msghdr &lMsgHeader = lMsgHeaders[i].msg_hdr;
+        IPPacketInfo &lPacketInfo = lPacketInfos[lDelivered];
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        if ((lMsgHeader.msg_flags & MSG_TRUNC) != 0)
+            lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        else
+            lStatus = GetReceivedPacketInfo(lMsgHeader, lPacketInfo);
+
+        if (lStatus == INET_NO_ERROR)
+        {
+            lBuffers[i]->SetDataLength(static_cast<uint16_t>(lMsgHeaders[i].msg_len));
+            lBuffers[lDelivered++] = lBuffers[i];
+        }
+        else
+        {
+            PacketBuffer::Free(lBuffers[i]);
+            if (OnReceiveError != NULL)
+                OnReceiveError(this, lStatus, NULL);
+        }
+    }
+
+    if (lDelivered > 0 && mState == kState_Listening && OnMessageReceived != NULL && OnMessagesReceived != NULL)
+    {
+        OnMessagesReceived(this, lBuffers, lPacketInfos, lDelivered);
+    }
+    else
+    {
+        for (size_t i = 0; i < lDelivered; i++)
+        {
+            if (mState == kState_Listening && OnMessageReceived != NULL)
+                OnMessageReceived(this, lBuffers[i], &lPacketInfos[i]);
+            else
+                PacketBuffer::Free(lBuffers[i]);
+        }
+    }
+
+    Release();
+#else // !HAVE_RECVMMSG
+    HandlePendingIO(aPort);
+#endif // !HAVE_RECVMMSG
+}
+
+/**
+ *  Send several datagrams, each to the destination address, port and interface given by its packet information, using as few
+ *  sendmmsg() calls as INET_CONFIG_UDP_SEND_BATCH_SIZE allows.
+ *
+ *  The buffers are not freed.  Every datagram is attempted, even after one fails to send.  Returns the error for the first
+ *  datagram that could not be sent, if any.
+ *
+ *  Where sendmmsg() is unavailable, each datagram is sent by SendTo().
+ */
+INET_ERROR IPEndPointBasis::SendMessages(const IPPacketInfo *aPacketInfos, PacketBuffer **aBuffers, size_t aCount)
+{
+    INET_ERROR lRetval = INET_NO_ERROR;
+
+#if HAVE_SENDMMSG
+    enum
+    {
+        kMaxMessages = INET_CONFIG_UDP_SEND_BATCH_SIZE
+    };
+
+    struct mmsghdr  lMsgHeaders[kMaxMessages];
+    struct iovec    lMsgIOVs[kMaxMessages];
+    PeerSockAddr    lPeerSockAddrs[kMaxMessages];
+    size_t          lNext = 0;
+
+    while (lNext < aCount)
+    {
+        size_t lCount = 0;
+        size_t lSent = 0;
+
+        memset(lMsgHeaders, 0, sizeof (lMsgHeaders));
+
+        for (; lNext < aCount && lCount < kMaxMessages; lNext++)
+        {
+            const IPPacketInfo &lPacketInfo = aPacketInfos[lNext];
+            PacketBuffer *lBuffer = aBuffers[lNext];
+            INET_ERROR lStatus = INET_NO_ERROR;
+
+            // For now the entire message must fit within a single buffer, and be addressed to the socket's address family.
+            if (lBuffer->Next() != NULL)
+                lStatus = INET_ERROR_MESSAGE_TOO_LONG;
+            else if (lPacketInfo.DestAddress.Type() != mAddrType)
+                lStatus = INET_ERROR_WRONG_ADDRESS_TYPE;
+
+            if (lStatus != INET_NO_ERROR)
+            {
+                if (lRetval == INET_NO_ERROR)
+                    lRetval = lStatus;
+                continue;
+            }
+
+            lMsgIOVs[lCount].iov_base = lBuffer->Start();
+            lMsgIOVs[lCount].iov_len = lBuffer->DataLength();
+
+            lMsgHeaders[lCount].msg_hdr.msg_name = &lPeerSockAddrs[lCount];
+            lMsgHeaders[lCount].msg_hdr.msg_namelen = ToPeerSockAddr(mAddrType, lPacketInfo.DestAddress, lPacketInfo.DestPort,
+                lPacketInfo.Interface, lPeerSockAddrs[lCount]);
+            lMsgHeaders[lCount].msg_hdr.msg_iov = &lMsgIOVs[lCount];
+            lMsgHeaders[lCount].msg_hdr.msg_iovlen = 1;
+
+            lCount++;
+        }
+
+        // sendmmsg() stops at the first datagram that fails; note its error, skip it and carry on with the rest.
+        while (lSent < lCount)
+        {
+            const int lResult = sendmmsg(mSocket, &lMsgHeaders[lSent], lCount - lSent, 0);
+
+            if (lResult < 0)
+            {
+                if (lRetval == INET_NO_ERROR)
+                    lRetval = Weave::System::MapErrorPOSIX(errno);
+                lSent++;
+                continue;
+            }
+
+            for (size_t i = lSent; i < lSent + static_cast<size_t>(lResult); i++)
+            {
+                if (lMsgHeaders[i].msg_len != lMsgIOVs[i].iov_len && lRetval == INET_NO_ERROR)
+                    lRetval = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
+            }
+
+            lSent += static_cast<size_t>(lResult);
+        }
+    }
+#else // !HAVE_SENDMMSG
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const INET_ERROR lStatus = SendTo(aPacketInfos[i].DestAddress, aPacketInfos[i].DestPort, aPacketInfos[i].Interface,
+            aBuffers[i], 0);
+
+        if (lStatus != INET_NO_ERROR && lRetval == INET_NO_ERROR)
+            lRetval = lStatus;
+    }
+#endif // !HAVE_SENDMMSG
+
+    return (lRetval);
+}
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
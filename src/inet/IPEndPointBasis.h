@@ -103,6 +103,30 @@ public:
     /** The endpoint's message reception event handling function delegate. */
     OnMessageReceivedFunct OnMessageReceived;
 
+    /**
+     * @brief   Type of batched message text reception event handling function.
+     *
+     * @param[in]   endPoint    The endpoint associated with the event.
+     * @param[in]   msgs        The messages received, in order of arrival.
+     * @param[in]   pktInfos    The packet information for each message.
+     * @param[in]   count       The number of messages received.
+     *
+     * @details
+     *  Provide a function of this type to the \c OnMessagesReceived delegate
+     *  member to process, in one call, all of the messages read from \c
+     *  endPoint by a single system call.  The function takes ownership of
+     *  each buffer in \c msgs, as \c OnMessageReceived does.
+     */
+    typedef void (*OnMessagesReceivedFunct)(IPEndPointBasis *endPoint, Weave::System::PacketBuffer **msgs, const IPPacketInfo *pktInfos, size_t count);
+
+    /**
+     *  The endpoint's batched message reception event handling function
+     *  delegate.  Optional; when it is \c NULL, messages read together are
+     *  passed one at a time to \c OnMessageReceived, which must be set
+     *  either way for the endpoint to receive.
+     */
+    OnMessagesReceivedFunct OnMessagesReceived;
+
     /**
      * @brief   Type of reception error event handling function.
      *
@@ -234,6 +258,8 @@ protected:
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(uint16_t aPort);
+    void HandlePendingIOBatch(uint16_t aPort);
+    INET_ERROR SendMessages(const IPPacketInfo *aPacketInfos, Weave::System::PacketBuffer **aBuffers, size_t aCount);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 private:
@@ -265,6 +265,110 @@
 #define INET_CONFIG_NUM_TUN_ENDPOINTS                       64
 #endif // INET_CONFIG_NUM_TUN_ENDPOINTS
 
+/**
+ *  @def INET_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *    When the epoll event loop backend is in use, this is the maximum
+ *    number of readiness notifications harvested from the kernel, and
+ *    the maximum number of ready endpoints serviced, in a single call
+ *    to InetLayer::HandleSelectResult.
+ *
+ *    Endpoints beyond this limit remain on the ready list and are
+ *    serviced on the next iteration of the event loop.
+ *
+ */
+#ifndef INET_CONFIG_EPOLL_MAX_EVENTS
+#define INET_CONFIG_EPOLL_MAX_EVENTS                        64
+#endif // INET_CONFIG_EPOLL_MAX_EVENTS
+
+/**
+ *  @def INET_CONFIG_UDP_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    When using BSD sockets, this is the maximum number of datagrams
+ *    read from a UDP endpoint's socket by a single recvmmsg(2) call
+ *    each time the endpoint is serviced.
+ *
+ *    A packet buffer is allocated for each datagram before the call,
+ *    and those left unused are freed after it, so with a fixed packet
+ *    buffer pool this should be well below the pool size.  The default,
+ *    1, reads one datagram per recvmsg(2) call.  Values greater than 1
+ *    take effect only where recvmmsg(2) is available.
+ *
+ */
+#ifndef INET_CONFIG_UDP_RECV_BATCH_SIZE
+#define INET_CONFIG_UDP_RECV_BATCH_SIZE                     1
+#endif // INET_CONFIG_UDP_RECV_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SEND_BATCH_SIZE
+ *
+ *  @brief
+ *    When using BSD sockets, this is the maximum number of datagrams
+ *    passed to a single sendmmsg(2) call by UDPEndPoint::SendMessages.
+ *
+ *    Larger batches are sent in several calls.  Where sendmmsg(2) is
+ *    unavailable, the datagrams are sent one at a time.
+ *
+ */
+#ifndef INET_CONFIG_UDP_SEND_BATCH_SIZE
+#define INET_CONFIG_UDP_SEND_BATCH_SIZE                     16
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_TUN_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    When using BSD sockets, this is the maximum number of packets
+ *    read from a tunnel endpoint's device each time the endpoint is
+ *    serviced.
+ *
+ *    The tun device returns one packet per read(2), so a batch is a
+ *    run of reads that stops early once the device has been drained.
+ *    Values greater than 1 put the device in non-blocking mode.  The
+ *    default, 1, reads one packet per pass of the event loop.
+ *
+ */
+#ifndef INET_CONFIG_TUN_RECV_BATCH_SIZE
+#define INET_CONFIG_TUN_RECV_BATCH_SIZE                     1
+#endif // INET_CONFIG_TUN_RECV_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_TCP_SEND_MAX_IOVECS
+ *
+ *  @brief
+ *    When using BSD sockets, this is the maximum number of buffers
+ *    from a TCP endpoint's send queue that are gathered into a single
+ *    sendmsg(2) call.
+ *
+ *    The I/O vector is allocated on the stack of the sending thread.
+ *    The value is capped at the platform's IOV_MAX.
+ *
+ */
+#ifndef INET_CONFIG_TCP_SEND_MAX_IOVECS
+#define INET_CONFIG_TCP_SEND_MAX_IOVECS                     64
+#endif // INET_CONFIG_TCP_SEND_MAX_IOVECS
+
+/**
+ *  @def INET_CONFIG_TCP_RECV_MAX_BUFFERS
+ *
+ *  @brief
+ *    When using BSD sockets, this is the maximum number of packet
+ *    buffers filled by a single readv(2) call each time a TCP
+ *    endpoint is serviced.
+ *
+ *    The free space at the end of the receive queue is always used
+ *    first.  The remaining buffers are allocated before the call and
+ *    those left unused are freed after it, so with a fixed packet
+ *    buffer pool this should be well below the pool size.  The
+ *    default, 1, reads into a single buffer per call.
+ *
+ */
+#ifndef INET_CONFIG_TCP_RECV_MAX_BUFFERS
+#define INET_CONFIG_TCP_RECV_MAX_BUFFERS                    1
+#endif // INET_CONFIG_TCP_RECV_MAX_BUFFERS
+
 /**
  *  @def INET_CONFIG_NUM_DNS_RESOLVERS
  *
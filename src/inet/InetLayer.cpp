@@ -72,6 +72,10 @@
 #endif // __ANDROID__
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && !INET_CONFIG_WILL_OVERRIDE_PLATFORM_EVENT_FUNCS
 
@@ -129,6 +133,11 @@ InetLayer::InetLayer(void)
 {
     State = kState_NotInitialized;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mReadyEndPoints = NULL;
+    mReadyEndPointsTail = NULL;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     if (!sInetEventHandlerDelegate.IsInitialized())
         sInetEventHandlerDelegate.Init(HandleInetLayerEvent);
@@ -294,6 +303,11 @@ INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext)
     mSystemLayer = &aSystemLayer;
     mContext = aContext;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mReadyEndPoints = NULL;
+    mReadyEndPointsTail = NULL;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     err = InitQueueLimiter();
     SuccessOrExit(err);
@@ -1427,6 +1441,28 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     if (State != kState_Initialized)
         return;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Endpoint sockets are registered with the System Layer's epoll instance, whose descriptor the System Layer places in the
+    // read set, so nothing is added here. Instead, drop endpoints whose latched readiness is of no current interest from the
+    // ready list and, if any endpoint remains ready, arrange for select() not to sleep.
+    for (EndPointBasis* lEndPoint = mReadyEndPoints; lEndPoint != NULL; )
+    {
+        EndPointBasis* lNext = lEndPoint->mReadyNext;
+
+        if ((PrepareEndPointIO(*lEndPoint).Value & lEndPoint->mReadyIO.Value) == 0)
+        {
+            lEndPoint->UnlinkReadyIO();
+        }
+        else
+        {
+            sleepTimeTV.tv_sec = 0;
+            sleepTimeTV.tv_usec = 0;
+        }
+
+        lEndPoint = lNext;
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
     for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
     {
@@ -1463,6 +1499,8 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
 
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
     if (mSystemLayer == &mImplicitSystemLayer)
     {
@@ -1506,6 +1544,61 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
     if (selectRes < 0)
         return;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Latch the edges reported by epoll into their endpoints, placing each on the ready list. Latched readiness persists until
+    // the endpoint's I/O would block, so the ready list is serviced even when select() itself reported nothing.
+    {
+        struct epoll_event lEvents[INET_CONFIG_EPOLL_MAX_EVENTS];
+        const int lCount = mSystemLayer->GetSocketEvents(lEvents, INET_CONFIG_EPOLL_MAX_EVENTS);
+
+        for (int i = 0; i < lCount; i++)
+        {
+            EndPointBasis* lEndPoint = static_cast<EndPointBasis*>(lEvents[i].data.ptr);
+
+            lEndPoint->LatchReadyIO(SocketEvents::FromEPollEvents(lEvents[i].events));
+        }
+    }
+
+    // As with select(), set the pending I/O field for every endpoint to be serviced *before* making any callbacks, retaining
+    // each so that it cannot be freed and reused while the batch is in progress.
+    {
+        EndPointBasis* lBatch[INET_CONFIG_EPOLL_MAX_EVENTS];
+        size_t lBatchCount = 0;
+
+        for (EndPointBasis* lEndPoint = mReadyEndPoints; lEndPoint != NULL && lBatchCount < INET_CONFIG_EPOLL_MAX_EVENTS; )
+        {
+            EndPointBasis* lNext = lEndPoint->mReadyNext;
+
+            lEndPoint->mPendingIO.Value = PrepareEndPointIO(*lEndPoint).Value & lEndPoint->mReadyIO.Value;
+
+            if (lEndPoint->mPendingIO.IsSet())
+            {
+                lEndPoint->Retain();
+                lBatch[lBatchCount++] = lEndPoint;
+            }
+            else if (!lEndPoint->mReadyIO.IsSet())
+            {
+                lEndPoint->UnlinkReadyIO();
+            }
+
+            lEndPoint = lNext;
+        }
+
+        // Rotate serviced endpoints to the tail of the ready list so that a busy endpoint cannot starve the others when the
+        // batch limit is reached.
+        for (size_t i = 0; i < lBatchCount; i++)
+        {
+            lBatch[i]->UnlinkReadyIO();
+        }
+
+        for (size_t i = 0; i < lBatchCount; i++)
+        {
+            HandleEndPointIO(*lBatch[i]);
+            lBatch[i]->RequeueReadyIO();
+            lBatch[i]->Release();
+        }
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     if (selectRes > 0)
     {
         // Set the pending I/O field for each active endpoint based on the value returned by select.
@@ -1598,6 +1691,7 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
         }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
     if (mSystemLayer == &mImplicitSystemLayer)
@@ -1607,6 +1701,86 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
 #endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Return the I/O events in which the specified endpoint is currently
+ *  interested, dispatching to the PrepareIO method of its concrete class.
+ *
+ *  @param[in]    aEndPoint    The endpoint to query.
+ *
+ */
+SocketEvents InetLayer::PrepareEndPointIO(EndPointBasis& aEndPoint)
+{
+    switch (aEndPoint.mSocketEndPointType)
+    {
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_Raw:
+        return static_cast<RawEndPoint&>(aEndPoint).PrepareIO();
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_TCP:
+        return static_cast<TCPEndPoint&>(aEndPoint).PrepareIO();
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_UDP:
+        return static_cast<UDPEndPoint&>(aEndPoint).PrepareIO();
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_Tun:
+        return static_cast<TunEndPoint&>(aEndPoint).PrepareIO();
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+    default:
+        return SocketEvents();
+    }
+}
+
+/**
+ *  Handle the pending I/O previously recorded for the specified
+ *  endpoint, dispatching to the HandlePendingIO method of its concrete
+ *  class.
+ *
+ *  @param[in]    aEndPoint    The endpoint to service.
+ *
+ */
+void InetLayer::HandleEndPointIO(EndPointBasis& aEndPoint)
+{
+    switch (aEndPoint.mSocketEndPointType)
+    {
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_Raw:
+        static_cast<RawEndPoint&>(aEndPoint).HandlePendingIO();
+        break;
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_TCP:
+        static_cast<TCPEndPoint&>(aEndPoint).HandlePendingIO();
+        break;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_UDP:
+        static_cast<UDPEndPoint&>(aEndPoint).HandlePendingIO();
+        break;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    case EndPointBasis::kSocketEndPointType_Tun:
+        static_cast<TunEndPoint&>(aEndPoint).HandlePendingIO();
+        break;
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+    default:
+        aEndPoint.mPendingIO.Clear();
+        break;
+    }
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 /**
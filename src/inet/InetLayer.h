@@ -186,6 +186,10 @@ class NL_DLL_EXPORT InetLayer
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    friend class EndPointBasis;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
   public:
     /**
      *  The current state of the InetLayer object.
@@ -372,6 +376,14 @@ private:
     AsyncDNSResolverSockets mAsyncDNSResolver;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    EndPointBasis*          mReadyEndPoints;        /**< Endpoints with latched, unconsumed epoll readiness. */
+    EndPointBasis*          mReadyEndPointsTail;    /**< Last endpoint in the ready list. */
+
+    static SocketEvents PrepareEndPointIO(EndPointBasis& aEndPoint);
+    static void HandleEndPointIO(EndPointBasis& aEndPoint);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -25,6 +25,10 @@
 
 #include <InetLayer/InetLayerBasis.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 namespace nl {
 namespace Inet {
 
@@ -87,6 +91,31 @@ SocketEvents SocketEvents::FromFDs(int socket, fd_set *readfds, fd_set *writefds
 
     return res;
 }
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Set the read, write or exception bit flags based on an event mask reported by @p epoll_wait().
+ *
+ *  Hang-up and error conditions are reported as both readable and writable, matching the way @p select() reports them, so
+ *  that the subsequent I/O operation surfaces the error. Urgent data is reported as an exception.
+ *
+ *  @param[in]    events    The @p events member of a <tt>struct epoll_event</tt>.
+ *
+ */
+SocketEvents SocketEvents::FromEPollEvents(uint32_t events)
+{
+    SocketEvents res;
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+        res.SetRead();
+    if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+        res.SetWrite();
+    if (events & EPOLLPRI)
+        res.SetError();
+
+    return res;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
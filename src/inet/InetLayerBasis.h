@@ -206,6 +206,10 @@ public:
 
     void SetFDs(int socket, int& nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
     static SocketEvents FromFDs(int socket, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    static SocketEvents FromEPollEvents(uint32_t events);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 };
 
 /**
@@ -261,6 +261,9 @@ INET_ERROR RawEndPoint::BindIPv6LinkLocal(InterfaceId intf, IPAddress addr)
 
 optfail:
     res = Weave::System::MapErrorPOSIX(errno);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    UnwatchSocket();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     ::close(mSocket);
     mSocket = INET_INVALID_SOCKET_FD;
     mAddrType = kIPAddressType_Unknown;
@@ -286,6 +289,10 @@ INET_ERROR RawEndPoint::Listen(void)
 
     if (mState == kState_Listening)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // The receive handler may have been replaced since the endpoint started listening; service anything latched meanwhile.
+        RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
         res = INET_NO_ERROR;
         goto exit;
     }
@@ -317,6 +324,11 @@ INET_ERROR RawEndPoint::Listen(void)
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Readiness may have been latched before the endpoint was listening; make sure it is serviced.
+    RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     // Wake the thread calling select so that it starts selecting on the new socket.
     lSystemLayer.WakeSelect();
 
@@ -363,6 +375,9 @@ void RawEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchSocket();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -626,6 +641,9 @@ exit:
 void RawEndPoint::Init(InetLayer *inetLayer, IPVersion ipVer, IPProtocol ipProto)
 {
     IPEndPointBasis::Init(inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_Raw;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
     IPVer = ipVer;
     IPProto = ipProto;
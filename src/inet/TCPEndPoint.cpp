@@ -58,17 +58,31 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <netinet/tcp.h>
+#include <sys/uio.h>
+#include <limits.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #include "arpa-inet-compatibility.h"
 
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/MacOS:
-#ifdef SOCK_CLOEXEC
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+// Edge-triggered notification requires that every socket, including listening ones, report EAGAIN rather than block.
+#define SOCK_FLAGS (SOCK_CLOEXEC | SOCK_NONBLOCK)
+#elif defined(SOCK_CLOEXEC)
 #define SOCK_FLAGS SOCK_CLOEXEC
 #else
 #define SOCK_FLAGS 0
 #endif
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+// Number of send queue buffers gathered into one sendmsg() call.
+#if defined(IOV_MAX) && (IOV_MAX < INET_CONFIG_TCP_SEND_MAX_IOVECS)
+#define TCP_SEND_MAX_IOVECS IOV_MAX
+#else
+#define TCP_SEND_MAX_IOVECS INET_CONFIG_TCP_SEND_MAX_IOVECS
+#endif
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
 #if defined(SOL_TCP)
 // socket option level for Linux and BSD systems.
 #define TCP_SOCKOPT_LEVEL SOL_TCP
@@ -277,6 +291,11 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Discard the hang-up reported for the unconnected socket when it was registered; incoming connections generate new edges.
+    ConsumeReadyIO(SocketEvents::kRead | SocketEvents::kWrite | SocketEvents::kError);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     if (listen(mSocket, backlog) != 0)
         res = Weave::System::MapErrorPOSIX(errno);
 
@@ -479,6 +498,12 @@ INET_ERROR TCPEndPoint::Connect(IPAddress addr, uint16_t port, InterfaceId intf)
     else
         return INET_ERROR_WRONG_ADDRESS_TYPE;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Discard the writability reported for the unconnected socket when it was registered, lest it be mistaken for completion
+    // of the connection; completion generates a new edge.
+    ConsumeReadyIO(SocketEvents::kRead | SocketEvents::kWrite | SocketEvents::kError);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     int conRes = connect(mSocket, sockaddrptr, sockaddrsize);
 
     if (conRes == -1 && errno != EINPROGRESS)
@@ -726,6 +751,11 @@ INET_ERROR TCPEndPoint::Send(PacketBuffer *data, bool push)
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // The endpoint now wants writability, which may already have been latched.
+    RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     if (push)
         res = DriveSending();
 
@@ -747,6 +777,11 @@ void TCPEndPoint::EnableReceive()
 
     DriveReceiving();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Data that arrived while receiving was disabled will not generate a new edge.
+    RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     // Wake the thread calling select so that it can include the socket
@@ -1171,6 +1206,9 @@ bool TCPEndPoint::IsConnected(int state)
 void TCPEndPoint::Init(InetLayer *inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_TCP;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     ReceiveEnabled = true;
 
     // Initialize to zero for using system defaults.
@@ -1309,27 +1347,70 @@ INET_ERROR TCPEndPoint::DriveSending()
 
     while (mSendQueue != NULL)
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        struct iovec sendIOV[TCP_SEND_MAX_IOVECS];
+        struct msghdr msgHeader;
+        size_t numIOV = 0;
+        size_t queuedLen = 0;
 
-        ssize_t lenSent = send(mSocket, mSendQueue->Start(), (size_t) bufLen, sendFlags);
+        // Gather as much of the send queue as fits the I/O vector into a single call.
+        for (PacketBuffer *buf = mSendQueue; buf != NULL && numIOV < TCP_SEND_MAX_IOVECS; buf = buf->Next())
+        {
+            sendIOV[numIOV].iov_base = buf->Start();
+            sendIOV[numIOV].iov_len = buf->DataLength();
+            queuedLen += buf->DataLength();
+            numIOV++;
+        }
+
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov = sendIOV;
+        msgHeader.msg_iovlen = numIOV;
+
+        ssize_t lenSent = sendmsg(mSocket, &msgHeader, sendFlags);
 
         if (lenSent == -1)
         {
             if (errno != EAGAIN && errno != EWOULDBLOCK)
                 err = (errno == EPIPE) ? INET_ERROR_PEER_DISCONNECTED : Weave::System::MapErrorPOSIX(errno);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            else
+                ConsumeReadyIO(SocketEvents::kWrite);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
             break;
         }
 
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
-            mSendQueue->ConsumeHead(lenSent);
-        else
+        // Free the buffers that were sent in full, and consume what was sent of the one that was not.
+        for (size_t lenLeft = (size_t) lenSent; mSendQueue != NULL && lenLeft > 0; )
+        {
+            uint16_t bufLen = mSendQueue->DataLength();
+
+            if (lenLeft < bufLen)
+            {
+                mSendQueue->ConsumeHead((uint16_t) lenLeft);
+                break;
+            }
+
+            lenLeft -= bufLen;
+            mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+        }
+
+        // Empty buffers at the head of the queue were sent too.
+        while (mSendQueue != NULL && mSendQueue->DataLength() == 0 && (size_t) lenSent == queuedLen)
             mSendQueue = PacketBuffer::FreeHead(mSendQueue);
 
         if (OnDataSent != NULL)
-            OnDataSent(this, (uint16_t) lenSent);
+        {
+            // OnDataSent reports at most 64K at a time.
+            for (size_t lenLeft = (size_t) lenSent; lenLeft > 0; )
+            {
+                uint16_t lenReported = (lenLeft > UINT16_MAX) ? UINT16_MAX : (uint16_t) lenLeft;
+
+                OnDataSent(this, lenReported);
+                lenLeft -= lenReported;
+            }
+        }
 
 #if INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
         // TCP Send is not Idle; Set state and notify if needed
@@ -1364,8 +1445,14 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        if ((size_t) lenSent < queuedLen)
+        {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            // A short write means the send buffer is full; freed space generates a new edge.
+            ConsumeReadyIO(SocketEvents::kWrite);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
             break;
+        }
     }
 
     if (err == INET_NO_ERROR)
@@ -1544,6 +1631,10 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     WeaveLogError(Inet, "SO_LINGER: %d", errno);
             }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchSocket();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
             if (close(mSocket) != 0 && err == INET_NO_ERROR)
                 err = Weave::System::MapErrorPOSIX(errno);
             mSocket = INET_INVALID_SOCKET_FD;
@@ -2257,6 +2348,17 @@ INET_ERROR TCPEndPoint::GetSocket(IPAddressType addrType)
             }
         }
 #endif // defined(SO_NOSIGPIPE)
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // Register the socket for edge-triggered readiness notification.
+        INET_ERROR err = WatchSocket();
+        if (err != INET_NO_ERROR)
+        {
+            close(mSocket);
+            mSocket = INET_INVALID_SOCKET_FD;
+            return err;
+        }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
     else if (mAddrType != addrType)
         return INET_ERROR_INCORRECT_STATE;
@@ -2333,36 +2435,59 @@ void TCPEndPoint::HandlePendingIO()
     Release();
 }
 
+// Free the receive buffers from aFirstUnused on, which received no data.
+static void FreeReceiveBuffers(PacketBuffer *aBufs[], size_t aNumBufs, size_t aFirstUnused)
+{
+    for (size_t i = aFirstUnused; i < aNumBufs; i++)
+        PacketBuffer::Free(aBufs[i]);
+}
+
 void TCPEndPoint::ReceiveData()
 {
-    PacketBuffer *rcvBuf;
+    PacketBuffer *rcvBufs[INET_CONFIG_TCP_RECV_MAX_BUFFERS];
+    struct iovec rcvIOV[INET_CONFIG_TCP_RECV_MAX_BUFFERS];
+    size_t numBufs = 0;
     bool isNewBuf = true;
 
-    if (mRcvQueue == NULL)
-        rcvBuf = PacketBuffer::New(0);
-    else
+    // Read into the free space at the end of the receive queue, if there is any, and then into new buffers.
+    if (mRcvQueue != NULL)
     {
-        rcvBuf = mRcvQueue;
-        for (PacketBuffer *nextBuf = rcvBuf->Next(); nextBuf != NULL; rcvBuf = nextBuf, nextBuf = nextBuf->Next())
+        PacketBuffer *tailBuf = mRcvQueue;
+        for (PacketBuffer *nextBuf = tailBuf->Next(); nextBuf != NULL; tailBuf = nextBuf, nextBuf = nextBuf->Next())
             ;
 
-        if (rcvBuf->AvailableDataLength() == 0)
-            rcvBuf = PacketBuffer::New(0);
-        else
+        if (tailBuf->AvailableDataLength() != 0)
         {
             isNewBuf = false;
-            rcvBuf->CompactHead();
+            tailBuf->CompactHead();
+            rcvBufs[numBufs++] = tailBuf;
         }
     }
 
-    if (rcvBuf == NULL)
+    while (numBufs < INET_CONFIG_TCP_RECV_MAX_BUFFERS)
+    {
+        PacketBuffer *newBuf = PacketBuffer::New(0);
+
+        if (newBuf == NULL)
+            break;
+
+        rcvBufs[numBufs++] = newBuf;
+    }
+
+    if (numBufs == 0)
     {
         DoClose(INET_ERROR_NO_MEMORY, false);
         return;
     }
 
+    for (size_t i = 0; i < numBufs; i++)
+    {
+        rcvIOV[i].iov_base = rcvBufs[i]->Start() + rcvBufs[i]->DataLength();
+        rcvIOV[i].iov_len = rcvBufs[i]->AvailableDataLength();
+    }
+
     // Attempt to receive data from the socket.
-    ssize_t rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+    ssize_t rcvLen = readv(mSocket, rcvIOV, (int) numBufs);
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     INET_ERROR err;
@@ -2403,18 +2528,20 @@ void TCPEndPoint::ReceiveData()
     {
         int systemErrno = errno;
 
-        if (isNewBuf)
-        {
-            PacketBuffer::Free(rcvBuf);
-        }
+        FreeReceiveBuffers(rcvBufs, numBufs, isNewBuf ? 0 : 1);
 
         if (systemErrno == EAGAIN)
         {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            // The socket has been drained; it is not readable again until epoll reports a new edge.
+            ConsumeReadyIO(SocketEvents::kRead);
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
             // Note: in this case, we opt to not retry the recv call,
             // and instead we expect that the read flags will get
             // reset correctly upon a subsequent return from the
             // select call.
             WeaveLogError(Inet, "recv: EAGAIN, will retry");
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
             return;
         }
@@ -2430,8 +2557,7 @@ void TCPEndPoint::ReceiveData()
         // If the peer closed their end of the connection...
         if (rcvLen == 0)
         {
-            if (isNewBuf)
-                PacketBuffer::Free(rcvBuf);
+            FreeReceiveBuffers(rcvBufs, numBufs, isNewBuf ? 0 : 1);
 
             // If in the Connected state and the app has provided an OnPeerClose callback,
             // enter the ReceiveShutdown state.  Providing an OnPeerClose callback allows
@@ -2449,17 +2575,31 @@ void TCPEndPoint::ReceiveData()
         }
 
         // Otherwise, add the new data onto the receive queue.
-        else if (isNewBuf)
+        else
         {
-            rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen);
-            if (mRcvQueue == NULL)
-                mRcvQueue = rcvBuf;
-            else
-                mRcvQueue->AddToEnd(rcvBuf);
-        }
+            size_t lenLeft = (size_t) rcvLen;
+            size_t i = 0;
 
-        else
-            rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen, mRcvQueue);
+            for (; i < numBufs && lenLeft > 0; i++)
+            {
+                uint16_t bufLen = (lenLeft < rcvIOV[i].iov_len) ? (uint16_t) lenLeft : (uint16_t) rcvIOV[i].iov_len;
+
+                lenLeft -= bufLen;
+
+                if (i == 0 && !isNewBuf)
+                    rcvBufs[i]->SetDataLength(rcvBufs[i]->DataLength() + bufLen, mRcvQueue);
+                else
+                {
+                    rcvBufs[i]->SetDataLength(bufLen);
+                    if (mRcvQueue == NULL)
+                        mRcvQueue = rcvBufs[i];
+                    else
+                        mRcvQueue->AddToEnd(rcvBufs[i]);
+                }
+            }
+
+            FreeReceiveBuffers(rcvBufs, numBufs, i);
+        }
     }
 
     // Drive any received data into the app.
@@ -2485,7 +2625,17 @@ void TCPEndPoint::HandleIncomingConnection()
     // Accept the new connection.
     int conSocket = accept(mSocket, &sa.any, &saLen);
     if (conSocket == -1)
+    {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // The accept queue has been drained; this is not an error, and the next connection generates a new edge.
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            ConsumeReadyIO(SocketEvents::kRead);
+            return;
+        }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
         err = Weave::System::MapErrorPOSIX(errno);
+    }
 
     // If there's no callback available, fail with an error.
     if (err == INET_NO_ERROR && OnConnectionReceived == NULL)
@@ -2518,6 +2668,23 @@ void TCPEndPoint::HandleIncomingConnection()
         err = lInetLayer.NewTCPEndPoint(&conEP);
     }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Register the accepted socket for readiness notification before handing the new end point to the app.
+    if (err == INET_NO_ERROR)
+    {
+        if (fcntl(conSocket, F_SETFL, fcntl(conSocket, F_GETFL, 0) | O_NONBLOCK) != 0)
+            err = Weave::System::MapErrorPOSIX(errno);
+    }
+
+    if (err == INET_NO_ERROR)
+    {
+        conEP->mSocket = conSocket;
+        err = conEP->WatchSocket();
+        if (err != INET_NO_ERROR)
+            conEP->mSocket = INET_INVALID_SOCKET_FD;
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     // If all went well...
     if (err == INET_NO_ERROR)
     {
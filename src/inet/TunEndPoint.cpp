@@ -62,8 +62,25 @@ using namespace nl::Weave::Encoding;
 void TunEndPoint::Init(InetLayer *inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_Tun;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+/**
+ * Open a tunnel pseudo interface and create a handle to it.
+ *
+ * @param[in] intfName      The name of the tunnel interface.
+ *
+ * @return INET_NO_ERROR on success, else a corresponding INET mapped OS error.
+ */
+INET_ERROR TunEndPoint::Open (const char *intfName)
+{
+    return Open(intfName, false);
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
 /**
  * Open a tunnel pseudo interface and create a handle to it.
  *
@@ -73,14 +90,22 @@ void TunEndPoint::Init(InetLayer *inetLayer)
  *  of the tunnel interface.  On POSIX, the method has no arguments and the
  *  name of the tunnel device is implied.
  *
+ *  On POSIX, \c multiQueue opens one queue of a Linux multi-queue tunnel
+ *  interface.  Every endpoint opened this way with the same interface name
+ *  attaches a further queue, with its own device handle, to that interface;
+ *  the kernel spreads outbound flows across the queues.  All of the queues
+ *  of an interface must be opened this way.
+ *
  * @return INET_NO_ERROR on success, else a corresponding INET mapped OS error.
+ * @retval INET_ERROR_NOT_IMPLEMENTED   \c multiQueue was requested but the
+ *                                      platform does not support it.
  */
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 INET_ERROR TunEndPoint::Open (void)
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
-INET_ERROR TunEndPoint::Open (const char *intfName)
+INET_ERROR TunEndPoint::Open (const char *intfName, bool multiQueue)
 #endif //WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 {
     INET_ERROR err = INET_NO_ERROR;
@@ -102,7 +127,7 @@ INET_ERROR TunEndPoint::Open (const char *intfName)
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     //Create the tunnel device
-    err = TunDevOpen(intfName);
+    err = TunDevOpen(intfName, multiQueue);
     SuccessOrExit(err);
 
     printf("Opened tunnel device: %s\n", intfName);
@@ -656,7 +681,7 @@ err_t TunEndPoint::TunInterfaceNetifInit (struct netif *netif)
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 /* Open a tun device in linux */
-INET_ERROR TunEndPoint::TunDevOpen (const char *intfName)
+INET_ERROR TunEndPoint::TunDevOpen (const char *intfName, bool multiQueue)
 {
     struct ::ifreq ifr;
     int fd = INET_INVALID_SOCKET_FD;
@@ -670,10 +695,27 @@ INET_ERROR TunEndPoint::TunDevOpen (const char *intfName)
     //Keep copy of open device fd
     mSocket = fd;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL || INET_CONFIG_TUN_RECV_BATCH_SIZE > 1
+    // Edge-triggered notification, and reading in batches, require that a drained device report EAGAIN rather than block.
+    if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) < 0)
+    {
+        ExitNow(ret = Weave::System::MapErrorPOSIX(errno));
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL || INET_CONFIG_TUN_RECV_BATCH_SIZE > 1
+
     memset(&ifr, 0, sizeof(ifr));
 
     ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
 
+    if (multiQueue)
+    {
+#ifdef IFF_MULTI_QUEUE
+        ifr.ifr_flags |= IFF_MULTI_QUEUE;
+#else // !defined(IFF_MULTI_QUEUE)
+        ExitNow(ret = INET_ERROR_NOT_IMPLEMENTED);
+#endif // !defined(IFF_MULTI_QUEUE)
+    }
+
     if (*intfName)
     {
         strncpy(ifr.ifr_name, intfName, sizeof(ifr.ifr_name) - 1);
@@ -701,6 +743,11 @@ INET_ERROR TunEndPoint::TunDevOpen (const char *intfName)
         ExitNow(ret = Weave::System::MapErrorPOSIX(errno));
     }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    ret = WatchSocket();
+    SuccessOrExit(ret);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 exit:
 
     if (ret != INET_NO_ERROR)
@@ -716,6 +763,9 @@ void TunEndPoint::TunDevClose (void)
 {
     if (mSocket >= 0)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UnwatchSocket();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
         close(mSocket);
     }
     mSocket = INET_INVALID_SOCKET_FD;
@@ -739,6 +789,11 @@ INET_ERROR TunEndPoint::TunDevRead (PacketBuffer *msg)
     rcvLen = read(mSocket, p, msg->AvailableDataLength());
     if (rcvLen < 0)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // The device has been drained; it is not readable again until epoll reports a new edge.
+        if (errno == EAGAIN)
+            ConsumeReadyIO(SocketEvents::kRead);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
         err = Weave::System::MapErrorPOSIX(errno);
     }
     else if (rcvLen > msg->AvailableDataLength())
@@ -773,35 +828,51 @@ void TunEndPoint::HandlePendingIO ()
 
     if (mState == kState_Open && OnPacketReceived != NULL && mPendingIO.IsReadable())
     {
+        // The handler may close the endpoint; keep it alive until the batch is finished.
+        Retain();
 
-        PacketBuffer *buf = PacketBuffer::New(0);
-
-        if (buf != NULL)
+        for (size_t i = 0; i < INET_CONFIG_TUN_RECV_BATCH_SIZE; i++)
         {
-            //Read data from Tun Device
-            err = TunDevRead(buf);
-            if (err == INET_NO_ERROR)
+            PacketBuffer *buf = PacketBuffer::New(0);
+
+            if (buf != NULL)
             {
-                err = CheckV6Sanity(buf);
+                //Read data from Tun Device
+                err = TunDevRead(buf);
+                if (err == INET_NO_ERROR)
+                {
+                    err = CheckV6Sanity(buf);
+                }
+            }
+            else
+            {
+                err = INET_ERROR_NO_MEMORY;
             }
-        }
-        else
-        {
-            err = INET_ERROR_NO_MEMORY;
-        }
 
-        if (err == INET_NO_ERROR)
-        {
-            OnPacketReceived(this, buf);
-        }
-        else
-        {
-            PacketBuffer::Free(buf);
-            if (OnReceiveError != NULL)
+            if (err == INET_NO_ERROR)
             {
-                OnReceiveError(this, err);
+                OnPacketReceived(this, buf);
+            }
+            else
+            {
+                PacketBuffer::Free(buf);
+                if (OnReceiveError != NULL
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL || INET_CONFIG_TUN_RECV_BATCH_SIZE > 1
+                    // Only a non-blocking device reports EAGAIN, once it has been drained; that is not an error.
+                    && err != Weave::System::MapErrorPOSIX(EAGAIN)
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL || INET_CONFIG_TUN_RECV_BATCH_SIZE > 1
+                   )
+                {
+                    OnReceiveError(this, err);
+                }
+                break;
             }
+
+            if (mState != kState_Open || OnPacketReceived == NULL)
+                break;
         }
+
+        Release();
     }
 
     mPendingIO.Clear();
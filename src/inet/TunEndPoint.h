@@ -138,6 +138,7 @@ public:
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     INET_ERROR Open(const char *intfName);
+    INET_ERROR Open(const char *intfName, bool multiQueue);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     /** Close the tunnel and release handle on the object. */
@@ -225,7 +226,7 @@ private:
     //Tunnel interface name
     char tunIntfName[IFNAMSIZ];
 
-    INET_ERROR TunDevOpen(const char *interfaceName);
+    INET_ERROR TunDevOpen(const char *interfaceName, bool multiQueue);
     void TunDevClose(void);
     INET_ERROR TunDevRead(Weave::System::PacketBuffer *msg);
     static int TunGetInterface(int fd, struct ::ifreq *ifr);
@@ -175,6 +175,10 @@ INET_ERROR UDPEndPoint::Listen(void)
 
     if (mState == kState_Listening)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // The receive handler may have been replaced since the endpoint started listening; service anything latched meanwhile.
+        RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
         res = INET_NO_ERROR;
         goto exit;
     }
@@ -206,6 +210,11 @@ INET_ERROR UDPEndPoint::Listen(void)
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Readiness may have been latched before the endpoint was listening; make sure it is serviced.
+    RequeueReadyIO();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     // Wake the thread calling select so that it starts selecting on the new socket.
     lSystemLayer.WakeSelect();
 
@@ -252,6 +261,9 @@ void UDPEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchSocket();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -400,6 +412,40 @@ exit:
     return res;
 }
 
+INET_ERROR UDPEndPoint::SendMessages(const IPPacketInfo *pktInfos, Weave::System::PacketBuffer **msgs, size_t count, uint16_t sendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    for (size_t i = 0; i < count; i++)
+    {
+        const INET_ERROR msgRes = SendTo(pktInfos[i].DestAddress, pktInfos[i].DestPort, pktInfos[i].Interface, msgs[i], sendFlags);
+
+        if (msgRes != INET_NO_ERROR && res == INET_NO_ERROR)
+            res = msgRes;
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    // Make sure we have the appropriate type of socket based on the
+    // destination address of the first message.
+
+    if (count > 0)
+        res = GetSocket(pktInfos[0].DestAddress.Type());
+
+    if (res == INET_NO_ERROR)
+        res = IPEndPointBasis::SendMessages(pktInfos, msgs, count);
+
+    if ((sendFlags & kSendFlag_RetainBuffer) == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+            PacketBuffer::Free(msgs[i]);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+    return res;
+}
+
 //A lock is required because the LwIP thread may be referring to intf_filter,
 //while this code running in the Inet application is potentially modifying it.
 //NOTE: this only supports LwIP interfaces whose number is no bigger than 9.
@@ -456,6 +502,9 @@ exit:
 void UDPEndPoint::Init(InetLayer *inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_UDP;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 }
 
 InterfaceId UDPEndPoint::GetBoundInterface (void)
@@ -648,7 +697,11 @@ void UDPEndPoint::HandlePendingIO(void)
     {
         const uint16_t lPort = mBoundPort;
 
+#if INET_CONFIG_UDP_RECV_BATCH_SIZE > 1
+        IPEndPointBasis::HandlePendingIOBatch(lPort);
+#else // INET_CONFIG_UDP_RECV_BATCH_SIZE <= 1
         IPEndPointBasis::HandlePendingIO(lPort);
+#endif // INET_CONFIG_UDP_RECV_BATCH_SIZE <= 1
     }
 
     mPendingIO.Clear();
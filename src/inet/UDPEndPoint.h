@@ -147,6 +147,34 @@ public:
      */
     INET_ERROR SendTo(IPAddress addr, uint16_t port, InterfaceId intfId, Weave::System::PacketBuffer *msg, uint16_t sendFlags = 0);
 
+    /**
+     * @brief   Send several UDP messages, each to its own destination.
+     *
+     * @param[in]   pktInfos    the destination address, port and optional
+     *                          network interface of each message
+     * @param[in]   msgs        the packet buffers containing the UDP messages
+     * @param[in]   count       the number of messages
+     * @param[in]   sendFlags   optional transmit option flags
+     *
+     * @retval  INET_NO_ERROR       success: every message is queued for
+     *                              transmit.
+     *
+     * @retval  other               the error for the first message that
+     *                              could not be sent, as for \c SendTo.
+     *
+     * @details
+     *      Equivalent to calling \c SendTo for each message in turn, but on
+     *      BSD sockets where sendmmsg(2) is available the messages are
+     *      passed to the kernel up to INET_CONFIG_UDP_SEND_BATCH_SIZE at a
+     *      time.  A message that cannot be sent does not prevent the others
+     *      from being sent.  All of the destinations must be of the same
+     *      address type.
+     *
+     *      The buffers are freed as by \c SendTo, unless
+     *      <tt>(sendFlags & kSendFlag_RetainBuffer) != 0</tt>.
+     */
+    INET_ERROR SendMessages(const IPPacketInfo *pktInfos, Weave::System::PacketBuffer **msgs, size_t count, uint16_t sendFlags = 0);
+
     /**
      * Get the bound interface on this endpoint.
      *
@@ -664,6 +664,39 @@ exit:
     return err;
 }
 
+/**
+ *  Wait for a response on the exchange to messages already sent, as if the
+ *  last of them had been sent with kSendFlag_ExpectResponse.
+ *
+ *  This arms the response timer, if a timeout has been specified, for a
+ *  protocol that sends several messages before the peer responds to any of
+ *  them, and only knows which one was the last once it has been sent.
+ *
+ *  @retval  #WEAVE_ERROR_INCORRECT_STATE  If a response is already expected.
+ *  @retval  #WEAVE_NO_ERROR               On success.
+ *  @retval  other                         The error arming the response timer.
+ *
+ */
+WEAVE_ERROR ExchangeContext::ExpectResponse(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    // Only one 'response expected' message can be outstanding at a time.
+    VerifyOrExit(!IsResponseExpected(), err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Arm the response timer if a timeout has been specified.
+    if (ResponseTimeout > 0)
+    {
+        err = StartResponseTimer();
+        SuccessOrExit(err);
+    }
+
+    SetResponseExpected(true);
+
+exit:
+    return err;
+}
+
 /**
  *  Encode the exchange header into a message buffer.
  *
@@ -867,6 +900,9 @@ void ExchangeContext::Release(void)
         }
 
         DoClose(false);
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        em->UnindexContext(this);
+#endif
         mRefCount = 0;
         ExchangeMgr = NULL;
 
@@ -146,6 +146,114 @@
 #endif // WEAVE_CONFIG_BDX_SEND_INIT_MAX_METADATA_BYTES
 
 
+/**
+ *  @def WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+ *
+ *  @brief
+ *      Compile support for windowed (pipelined) sender-drive transfers.
+ *
+ *  Compile support for windowed transfers, in which the sender keeps
+ *      several blocks in flight and the receiver acknowledges them
+ *      cumulatively.  Windowing is only used when both ends advertise
+ *      it and the application sets a window size above 1 on the
+ *      transfer.  Enabled by default.  Set to 0 to save code space.
+ */
+#ifndef WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+#define WEAVE_CONFIG_BDX_WINDOWED_SUPPORT 1
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+ *
+ *  @brief
+ *      Largest number of blocks a windowed transfer may have in flight.
+ *
+ *  Each transfer reserves this many block slots.  A windowed sender
+ *      holds a copy of every unacknowledged block, and a windowed
+ *      receiver holds blocks that arrive ahead of a missing one, so a
+ *      transfer may pin up to this many PacketBuffers.
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+#define WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE 8
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT && ((WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 2) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 255))
+#error "WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE must be between 2 and 255 when WEAVE_CONFIG_BDX_WINDOWED_SUPPORT is enabled"
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT && ((WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 2) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 255))
+
+/**
+ *  @def WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+ *
+ *  @brief
+ *      Compile support for BdxFileSource, a read-only file image
+ *      that many outgoing transfers can send from at once.
+ *
+ *  The image is memory-mapped once and blocks are handed to the
+ *      protocol straight from the mapping, so serving a file needs no
+ *      per-transfer file handle or read buffer.  Requires POSIX
+ *      mmap().  Disabled by default.
+ */
+#ifndef WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+#define WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT 0
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+ *
+ *  @brief
+ *      Let a BdxNode allocate more transfers from the heap once its
+ *      WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS built-in transfers are in use.
+ *
+ *  Extra transfers are allocated WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE
+ *      at a time with malloc(), are kept for reuse once released, and
+ *      are only freed when the node is shut down.  Disabled by default.
+ */
+#ifndef WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+#define WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL 0
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+/**
+ *  @def WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE
+ *
+ *  @brief
+ *      Number of transfers a BdxNode allocates at a time when its
+ *      transfer pool grows.
+ */
+#ifndef WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE
+#define WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE 16
+#endif // WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS
+ *
+ *  @brief
+ *      Largest number of transfers a BdxNode may have at once, counting
+ *      its built-in ones, when WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL is
+ *      enabled.
+ *
+ *  Every transfer also needs an ExchangeContext, so
+ *      WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS must be raised to match.
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS
+#define WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS 1024
+#endif // WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS
+
+/**
+ *  @def WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+ *
+ *  @brief
+ *      Compile support for scheduling the blocks a BdxNode sends.
+ *
+ *  Instead of sending the next block as soon as the peer asks for it,
+ *      a transfer joins a queue that the node serves round-robin, one
+ *      block per transfer per pass, so that many transfers share the
+ *      node fairly.  A transfer's mMaxBytesPerSec, if set, caps the rate
+ *      at which it is served.  Disabled by default.
+ */
+#ifndef WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+#define WEAVE_CONFIG_BDX_BLOCK_SCHEDULER 0
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
 #if (WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT == 0) && (WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT == 0)
 #error "At least one of WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT or WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT must be enabled"
 #endif //(WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT == 0) && (WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT == 0)
@@ -560,6 +560,35 @@
 #error "Please assert exactly one of WEAVE_CONFIG_SECURITY_MGR_TIME_ALERTS_DUMMY or WEAVE_CONFIG_SECURITY_MGR_TIME_ALERTS_PLATFORM."
 #endif // ((WEAVE_CONFIG_SECURITY_MGR_TIME_ALERTS_DUMMY + WEAVE_CONFIG_SECURITY_MGR_TIME_ALERTS_PLATFORM) != 1)
 
+/**
+ *  @def WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+ *
+ *  @brief
+ *    Maximum number of CASE, PASE, TAKE and key export interactions
+ *    that the Weave Security Manager will run at the same time.
+ *
+ *    Each in-progress interaction holds its own protocol engine,
+ *    exchange context and session timer.  Requests beyond this limit,
+ *    whether started locally or by a peer, are rejected with
+ *    #WEAVE_ERROR_SECURITY_MANAGER_BUSY.
+ *
+ *  @note Values greater than one require a memory manager that can
+ *        hold the state of several engines at once and are therefore
+ *        not supported with #WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE.
+ *
+ */
+#ifndef WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+#define WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS   1
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS < 1
+#error "WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS must be at least 1."
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS < 1
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS > 1 && WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE
+#error "WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS > 1 is not supported with WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE."
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS > 1 && WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE
+
 /**
  *  @name Weave Random Number Generator (RNG) Implementation Configuration
  *
@@ -635,6 +664,55 @@
 #error "Please assert exactly one of WEAVE_CONFIG_RNG_IMPLEMENTATION_PLATFORM, WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG, or WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL."
 #endif // ((WEAVE_CONFIG_RNG_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG + WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL) != 1)
 
+/**
+ *  @def WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+ *
+ *  @brief
+ *    Enable (1) or disable (0) running the big-number cryptography
+ *    of CASE session establishment (ECDH key generation and key
+ *    agreement, ECDSA signing and certificate validation) on a pool
+ *    of worker threads.
+ *
+ *    When enabled, the Weave Security Manager hands each such step to
+ *    a worker thread and resumes the handshake on the Weave thread,
+ *    via System::Layer::ScheduleWork(), once the step is done.  The
+ *    event loop meanwhile remains free to serve other traffic.
+ *
+ *  @note The CASE authentication delegate is then called on a worker
+ *        thread, as are the time-consuming crypto alerts.  The random
+ *        number generator must be safe to call from several threads,
+ *        which rules out #WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG.
+ *        Requires POSIX threads.
+ *
+ */
+#ifndef WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+#define WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD            0
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
+/**
+ *  @def WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS
+ *
+ *  @brief
+ *    Number of worker threads that run offloaded session
+ *    establishment cryptography.
+ *
+ *  @note Only meaningful when #WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+ *        is enabled.  There is little to gain from more threads than
+ *        #WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS.
+ *
+ */
+#ifndef WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS
+#define WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS     2
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD && WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS < 1
+#error "WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS must be at least 1 when WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD is enabled."
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD && WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS < 1
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD && WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
+#error "WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD is not supported with WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG."
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD && WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
+
 
 /**
  *  @def WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED
@@ -765,6 +843,7 @@
  *      * #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
  *      * #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT
  *      * #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL
+ *      * #WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
  *
  *    Note that these options are mutually exclusive and only one of
  *    these options should be set.
@@ -780,8 +859,9 @@
  *    implementation of the Weave SHA1 and SHA256 hashes.
  *
  *  @note This configuration is mutual exclusive with
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT and
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL.
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT,
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL and
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI.
  *
  */
 #ifndef WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
@@ -798,8 +878,9 @@
  *    mincrypt library of Android core.
  *
  *  @note This configuration is mutual exclusive with
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM and
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL.
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM,
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL and
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI.
  *
  */
 #ifndef WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT
@@ -814,21 +895,41 @@
  *    implementation of the Weave SHA1 and SHA256 hash functions.
  *
  *  @note This configuration is mutual exclusive with
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM and
- *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT.
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM,
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT and
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI.
  *
  */
 #ifndef WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL            1
 #endif // WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL
 
+/**
+ *  @def WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for a Weave-provided
+ *    implementation of the Weave SHA1 and SHA256 hash functions
+ *    that uses the Intel SHA extensions on CPUs that support them,
+ *    as detected at run time, and portable C code on other CPUs.
+ *
+ *  @note This configuration is mutual exclusive with
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM,
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT and
+ *        #WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL.
+ *
+ */
+#ifndef WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI              0
+#endif // WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+
 /**
  *  @}
  */
 
-#if ((WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT + WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL) != 1)
-#error "Please assert exactly one of WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM, WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT, or WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL."
-#endif // ((WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT + WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL) != 1)
+#if ((WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT + WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL + WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI) != 1)
+#error "Please assert exactly one of WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM, WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT, WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL, or WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI."
+#endif // ((WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT + WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL + WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI) != 1)
 
 
 /**
@@ -930,6 +1031,24 @@
 #define WEAVE_CONFIG_MAX_CONNECTIONS                        INET_CONFIG_NUM_TCP_ENDPOINTS
 #endif // WEAVE_CONFIG_MAX_CONNECTIONS
 
+/**
+ *  @def WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+ *
+ *  @brief
+ *    Maximum number of incoming connections that may be waiting to be
+ *    accepted on each of the message layer's listening TCP endpoints.
+ *
+ *    Connection attempts beyond this are left for the peer to retry.
+ *    Nodes that expect many peers to connect at once, and that allow
+ *    more than one concurrent session establishment (see
+ *    #WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS), should raise
+ *    this accordingly.
+ *
+ */
+#ifndef WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+#define WEAVE_CONFIG_TCP_LISTEN_BACKLOG                     1
+#endif // WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+
 /**
  *  @def WEAVE_CONFIG_MAX_TUNNELS
  *
@@ -1021,6 +1140,26 @@
 #error "Please set WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS to a value greater than zero and smaller than 256."
 #endif // !(WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS > 0 && WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS < 256)
 
+/**
+ *  @def WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+ *
+ *  @brief
+ *    Enable (1) or disable (0) caching of the expanded AES-128 round
+ *    keys and of the HMAC-SHA-1 inner and outer hash states alongside
+ *    each Weave message encryption key.
+ *
+ *    When enabled, the key schedules are computed once, when a session
+ *    key is set or an application key is derived into the key cache,
+ *    so that encrypting and authenticating each message only does the
+ *    data-dependent work. This costs the size of an AES-128 block
+ *    cipher and of two SHA-1 contexts for each session key and for
+ *    each cached application key.
+ *
+ */
+#ifndef WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+#define WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES            0
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  *  @name Weave Encrypted Passcode Configuration
  *
@@ -1142,6 +1281,27 @@
 #define WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS                  16
 #endif // WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+ *
+ *  @brief
+ *    Enable (1) or disable (0) hash indexes over the exchange context
+ *    and unsolicited message handler pools of the exchange manager.
+ *
+ *    When enabled, an inbound message is matched to its exchange context
+ *    and, failing that, to its unsolicited message handler through
+ *    open-addressing tables keyed on the exchange identifier and on the
+ *    (profile, message type, connection) tuple, respectively, rather
+ *    than by scanning both pools. The tables cost two bytes per entry,
+ *    sized at twice #WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS and
+ *    #WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS, and pay off on
+ *    nodes configured with large pools.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+#define WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX                  0
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
 /**
  *  @def WEAVE_CONFIG_MAX_BINDINGS
  *
@@ -1192,6 +1352,23 @@
 #define WEAVE_CONFIG_CONNECT_IP_ADDRS                       4
 #endif // WEAVE_CONFIG_CONNECT_IP_ADDRS
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for coalescing messages sent
+ *    over a TCP WeaveConnection.
+ *
+ *    When an application enables coalescing on a connection with
+ *    WeaveConnection::EnableCoalescing(), messages sent within the
+ *    configured flush delay are packed into a single packet buffer
+ *    and written to the TCP endpoint together.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+#define WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING           0
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
 /**
  *  @def WEAVE_CONFIG_DEFAULT_UDP_MTU_SIZE
  *
@@ -1352,6 +1529,29 @@
 #define WEAVE_CONFIG_DEBUG_CERT_VALIDATION                  1
 #endif // WEAVE_CONFIG_DEBUG_CERT_VALIDATION
 
+/**
+ *  @def WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of verified certificate signatures remembered by a
+ *    certificate validation cache
+ *    (nl::Weave::Profiles::Security::CertValidationCache).
+ *
+ *    Each entry records that a certificate's signature was verified
+ *    against the public key of its issuing CA certificate, allowing
+ *    later validations of the same certificate chain to skip the
+ *    ECDSA verification.  When full, the least recently used entry
+ *    is replaced.
+ *
+ */
+#ifndef WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+#define WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE             8
+#endif // WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE < 1
+#error "WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE must be at least 1."
+#endif // WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE < 1
+
 /**
  *  @def WEAVE_CONFIG_ENABLE_PASE_INITIATOR
  *
@@ -1444,6 +1644,60 @@
 #endif
 #endif // WEAVE_CONFIG_DEFAULT_CASE_ALLOWED_CURVES
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+ *
+ *  @brief
+ *    Enable (1) or disable (0) CASE session resumption.
+ *
+ *    When enabled, both parties to a CASE session retain a resumption secret once the
+ *    session is established.  A later session with the same peer is then established
+ *    using keys derived from the secret and fresh random values, without repeating the
+ *    ECDH exchange or certificate validation.  The responder only establishes the session
+ *    once the initiator has confirmed the keys, so that a replayed request is of no use.
+ *    Should the peer no longer hold the secret, the initiator falls back to a full CASE
+ *    exchange.
+ *
+ *    Both peers must be built with this option for resumption to take place.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+#define WEAVE_CONFIG_ENABLE_CASE_RESUMPTION                 0
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ *  @def WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+ *
+ *  @brief
+ *    The maximum number of CASE resumption secrets retained by the security manager.
+ *
+ *    When the cache is full, the entry closest to expiry is replaced.
+ *
+ */
+#ifndef WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+#define WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE             8
+#endif // WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION && !WEAVE_CONFIG_ENABLE_CASE_INITIATOR && !WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+#error "WEAVE_CONFIG_ENABLE_CASE_RESUMPTION requires WEAVE_CONFIG_ENABLE_CASE_INITIATOR or WEAVE_CONFIG_ENABLE_CASE_RESPONDER."
+#endif
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION && WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE < 1
+#error "WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE must be at least 1 when CASE resumption is enabled."
+#endif
+
+/**
+ *  @def WEAVE_CONFIG_CASE_RESUMPTION_LIFETIME
+ *
+ *  @brief
+ *    The time, in seconds, for which a CASE resumption secret may be used after the
+ *    full CASE exchange that produced it.
+ *
+ */
+#ifndef WEAVE_CONFIG_CASE_RESUMPTION_LIFETIME
+#define WEAVE_CONFIG_CASE_RESUMPTION_LIFETIME               3600
+#endif // WEAVE_CONFIG_CASE_RESUMPTION_LIFETIME
+
 /**
  * @def WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE
  *
@@ -665,6 +665,16 @@ WEAVE_ERROR WeaveConnection::SendMessage (WeaveMessageInfo *msgInfo, PacketBuffe
         ExitNow(res = (res == WEAVE_ERROR_MESSAGE_TOO_LONG) ? WEAVE_ERROR_SENDING_BLOCKED : res);
     }
 
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    // Leave the message to be written out together with the ones sent after it.
+    if (mCoalescingEnabled)
+    {
+        res = CoalesceMessage(msgBuf);
+        msgBuf = NULL;
+        ExitNow();
+    }
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
     // Copy msg to a right-sized buffer if applicable
     msgBuf = PacketBuffer::RightSize(msgBuf);
 
@@ -727,6 +737,9 @@ WEAVE_ERROR WeaveConnection::Shutdown()
 
     if (State == kState_Connected)
     {
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+        Flush();
+#endif
         State = kState_SendShutdown;
         mTcpEndPoint->Shutdown();
     }
@@ -1060,6 +1073,176 @@ WEAVE_ERROR WeaveConnection::SetIdleTimeout(uint32_t timeoutMS)
     return WEAVE_NO_ERROR;
 }
 
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+/**
+ *  WeaveConnection::EnableCoalescing
+ *
+ *  @brief
+ *    Coalesce the messages sent over the underlying TCP connection.
+ *
+ *  @param[in]  flushDelayMS
+ *    The longest time (in milliseconds) that a message is held back waiting for others to be
+ *    written out with it.  A delay of 0 writes out the messages sent during one pass of the
+ *    event loop together.
+ *
+ *  @details
+ *    While coalescing is enabled, each encoded message is copied into the free space of a
+ *    pending packet buffer instead of being written to the TCP endpoint by itself.  The pending
+ *    buffer is written out when the next message does not fit in it, when flushDelayMS has
+ *    elapsed since the first message was put in it, when Flush() or DisableCoalescing() is
+ *    called, and before the connection is shut down or gracefully closed.  This reduces the
+ *    number of system calls and TCP segments used to send many small messages, at the cost of
+ *    up to flushDelayMS of extra latency.
+ *
+ *  @note
+ *     -This method can only be called on a Weave connection backed by a TCP connection.
+ *
+ *     -This method can only be called when the connection is in a state that allows sending.
+ *
+ *     -This method can be called multiple times to adjust the flush delay.  The new delay
+ *      applies from the next message put in an empty pending buffer.
+ *
+ *  @retval  #WEAVE_NO_ERROR                     on successful enabling of coalescing.
+ *  @retval  #WEAVE_ERROR_NOT_IMPLEMENTED        if this function is invoked for an incompatible
+ *                                               endpoint (e.g., BLE) in the network layer.
+ *  @retval  #WEAVE_ERROR_INCORRECT_STATE        if the WeaveConnection object is not
+ *                                               in the correct state for sending messages.
+ *
+ */
+WEAVE_ERROR WeaveConnection::EnableCoalescing(uint32_t flushDelayMS)
+{
+#if CONFIG_NETWORK_LAYER_BLE
+    if (mBleEndPoint != NULL)
+        return WEAVE_ERROR_NOT_IMPLEMENTED;
+#endif
+
+    if (!StateAllowsSend())
+        return WEAVE_ERROR_INCORRECT_STATE;
+
+    mCoalesceDelayMS = flushDelayMS;
+    mCoalescingEnabled = true;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ *  WeaveConnection::DisableCoalescing
+ *
+ *  @brief
+ *    Stop coalescing the messages sent over the underlying TCP connection, writing out any
+ *    messages that are pending.
+ *
+ *  @retval  #WEAVE_NO_ERROR                     on successful disabling of coalescing.
+ *  @retval  other Inet layer errors related to the TCP endpoint send operation.
+ *
+ */
+WEAVE_ERROR WeaveConnection::DisableCoalescing(void)
+{
+    mCoalescingEnabled = false;
+
+    return Flush();
+}
+
+/**
+ *  WeaveConnection::Flush
+ *
+ *  @brief
+ *    Write out any coalesced messages to the underlying TCP connection now.
+ *
+ *  @details
+ *    This does nothing if coalescing is not enabled or no messages are pending.
+ *
+ *  @retval  #WEAVE_NO_ERROR                     on successfully handing the pending messages to the
+ *                                               TCP endpoint, or if none were pending.
+ *  @retval  #WEAVE_ERROR_INCORRECT_STATE        if the connection no longer allows sending; the
+ *                                               pending messages are dropped.
+ *  @retval  other Inet layer errors related to the TCP endpoint send operation.
+ *
+ */
+WEAVE_ERROR WeaveConnection::Flush(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *buf = mCoalesceBuf;
+
+    VerifyOrExit(buf != NULL, /* nothing pending */);
+
+    mCoalesceBuf = NULL;
+    MessageLayer->SystemLayer->CancelTimer(HandleCoalesceTimeout, this);
+
+    if (mTcpEndPoint == NULL || !StateAllowsSend())
+    {
+        PacketBuffer::Free(buf);
+        ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
+    }
+
+    err = mTcpEndPoint->Send(buf, true);
+
+exit:
+    return err;
+}
+
+// Take ownership of an encoded, length-prefixed message and add it to the pending buffer, starting
+// a new one if it does not fit.
+WEAVE_ERROR WeaveConnection::CoalesceMessage(PacketBuffer *msgBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint16_t msgLen = msgBuf->DataLength();
+
+    if (mCoalesceBuf != NULL && msgBuf->Next() == NULL && mCoalesceBuf->AvailableDataLength() >= msgLen)
+    {
+        memcpy(mCoalesceBuf->Start() + mCoalesceBuf->DataLength(), msgBuf->Start(), msgLen);
+        mCoalesceBuf->SetDataLength(mCoalesceBuf->DataLength() + msgLen);
+        PacketBuffer::Free(msgBuf);
+
+        // Nothing more will fit, so there is no reason to wait.
+        if (mCoalesceBuf->AvailableDataLength() == 0)
+            err = Flush();
+
+        ExitNow();
+    }
+
+    err = Flush();
+    if (err != WEAVE_NO_ERROR)
+    {
+        PacketBuffer::Free(msgBuf);
+        ExitNow();
+    }
+
+    // The message's own buffer becomes the pending buffer, unless there is no room left in it.
+    if (msgBuf->Next() != NULL || msgBuf->AvailableDataLength() == 0)
+    {
+        ExitNow(err = mTcpEndPoint->Send(msgBuf, true));
+    }
+
+    mCoalesceBuf = msgBuf;
+
+    // If the flush timer can't be started, don't hold the message back.
+    if (MessageLayer->SystemLayer->StartTimer(mCoalesceDelayMS, HandleCoalesceTimeout, this) != WEAVE_SYSTEM_NO_ERROR)
+        err = Flush();
+
+exit:
+    return err;
+}
+
+void WeaveConnection::DiscardCoalescedMessages(void)
+{
+    if (mCoalesceBuf != NULL)
+    {
+        MessageLayer->SystemLayer->CancelTimer(HandleCoalesceTimeout, this);
+        PacketBuffer::Free(mCoalesceBuf);
+        mCoalesceBuf = NULL;
+    }
+}
+
+void WeaveConnection::HandleCoalesceTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    WeaveConnection *con = static_cast<WeaveConnection *>(aAppState);
+
+    // A failed send closes the TCP endpoint, which closes the connection.
+    con->Flush();
+}
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
 void WeaveConnection::DoClose(WEAVE_ERROR err, uint8_t flags)
 {
     if (State != kState_Closed)
@@ -1084,6 +1267,13 @@ void WeaveConnection::DoClose(WEAVE_ERROR err, uint8_t flags)
         else
 #endif
         {
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+            // A graceful close delivers any coalesced messages; otherwise they are dropped.
+            if (err == WEAVE_NO_ERROR)
+                Flush();
+            DiscardCoalescedMessages();
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
             if (mTcpEndPoint != NULL)
             {
                 if (err == WEAVE_NO_ERROR)
@@ -1635,6 +1825,11 @@ void WeaveConnection::Init(WeaveMessageLayer *msgLayer)
 #if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
     mDNSOptions = 0;
 #endif
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    mCoalesceBuf = NULL;
+    mCoalesceDelayMS = 0;
+    mCoalescingEnabled = false;
+#endif
 }
 
 // Default OnConnectionClosed handler.
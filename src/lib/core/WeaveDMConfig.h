@@ -466,6 +466,48 @@
 #define TDM_VERSIONING_SUPPORT 1
 #endif
 
+/**
+ * @def TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) support for an index of the schema
+ *   tree, built on first use into storage a trait's schema table may
+ *   supply, that replaces the linear scans of the handle table made
+ *   to find the children of a property.  Without it, serializing or
+ *   deserializing a whole trait takes time quadratic in the number of
+ *   its properties.  The index also numbers the tree in pre-order, so
+ *   that IsParent() and GetDepth() answer in constant time rather than
+ *   by walking up to the root.
+ */
+#ifndef TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+#define TDM_SCHEMA_PROPERTY_INDEX_SUPPORT 0
+#endif
+
+/**
+ * @def TDM_PATH_STORE_INDEX_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) an index of the paths in a
+ *   TraitPathStore by TraitDataHandle.  Each record is chained, in
+ *   store order, into one of TDM_PATH_STORE_NUM_BUCKETS buckets picked
+ *   by its TraitDataHandle, so that iterating over the paths of one
+ *   trait instance, and the AddItemDedup(), Includes() and
+ *   Intersects() calls built on it, visit only that bucket instead of
+ *   every slot of the store.  Costs two bytes per record and two per
+ *   bucket.
+ */
+#ifndef TDM_PATH_STORE_INDEX_SUPPORT
+#define TDM_PATH_STORE_INDEX_SUPPORT 0
+#endif
+
+/**
+ * @def TDM_PATH_STORE_NUM_BUCKETS
+ *
+ * @brief The number of buckets in the index of each TraitPathStore,
+ *   when TDM_PATH_STORE_INDEX_SUPPORT is enabled.
+ */
+#ifndef TDM_PATH_STORE_NUM_BUCKETS
+#define TDM_PATH_STORE_NUM_BUCKETS 16
+#endif
+
 /**
  *  @def WDM_PUBLISHER_ENABLE_CUSTOM_COMMANDS
  *
@@ -176,4 +176,46 @@
 #define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 0
 #endif
 
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+ *
+ * @brief
+ *   The number of entries in the sparse event ID index kept for each
+ *   event buffer.  The index lets FetchEventsSince() begin reading
+ *   close to the requested event rather than at the start of the
+ *   log.  Each entry costs a few bytes per importance level; 0
+ *   disables the index.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+ *
+ * @brief
+ *   The number of events each event ID space can stage between
+ *   LogEvent() and the event buffers.  With staging, LogEvent()
+ *   reserves an event ID and copies the event into a slot without
+ *   taking the logging critical section; the Weave thread writes the
+ *   staged events to the event buffers in batches.  Events that do
+ *   not fit a slot, or that are logged while the slots are full, are
+ *   written directly.  Staging is used once the application calls
+ *   LoggingManagement::EnableStaging().  0 disables staging.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE
+ *
+ * @brief
+ *   The size, in bytes, of the serialized event data a staging slot
+ *   holds.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE WEAVE_CONFIG_EVENT_SIZE_RESERVE
+#endif
+
 #endif /* WEAVEEVENTLOGGINGCONFIG_H */
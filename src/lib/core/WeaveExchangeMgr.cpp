@@ -94,6 +94,11 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
     memset(UMHandlerPool, 0, sizeof(UMHandlerPool));
     OnExchangeContextChanged = NULL;
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    memset(mContextIndex, 0, sizeof(mContextIndex));
+    memset(mUMHIndex, 0, sizeof(mUMHIndex));
+#endif
+
     msgLayer->ExchangeMgr = this;
     msgLayer->OnMessageReceived = HandleMessageReceived;
     msgLayer->OnAcceptError = HandleAcceptError;
@@ -220,6 +225,9 @@ ExchangeContext *WeaveExchangeManager::NewContext(const uint64_t &peerNodeId, co
         ec->PeerIntf = sendIntfId;
         ec->AppState = appState;
         ec->SetInitiator(true);
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        IndexContext(ec);
+#endif
         //Initialize WRMP variables
         ec->mMsgProtocolVersion = 0;
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -509,6 +517,9 @@ void WeaveExchangeManager::HandleConnectionClosed(WeaveConnection *con, WEAVE_ER
     for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
         if (umh->Handler != NULL && umh->Con == con)
         {
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+            UnindexUMH(umh);
+#endif
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
             umh->Handler = NULL;
         }
@@ -619,10 +630,103 @@ static void DefaultOnMessageReceived(ExchangeContext *ec, const IPPacketInfo *pk
     PacketBuffer::Free(payload);
 }
 
+/**
+ *  Find the exchange context to which an inbound message applies.
+ *
+ *  When more than one context matches, the one earliest in the context pool is returned.
+ *
+ *  @return   A pointer to the matching ExchangeContext object, or NULL if the message does not
+ *            belong to any existing exchange.
+ *
+ */
+ExchangeContext *WeaveExchangeManager::FindContextForMessage(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+        const WeaveExchangeHeader *exchangeHeader)
+{
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    ExchangeContext *matchingEC = NULL;
+
+    // Visit every context indexed under the message's exchange id; the probe sequence ends at the
+    // first empty slot.
+    for (size_t slot = exchangeHeader->ExchangeId % kContextIndexSize; mContextIndex[slot] != 0;
+         slot = (slot + 1) % kContextIndexSize)
+    {
+        ExchangeContext *ec = &ContextPool[mContextIndex[slot] - 1];
+
+        if (ec->ExchangeMgr != NULL && (matchingEC == NULL || ec < matchingEC) &&
+            ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
+            matchingEC = ec;
+    }
+
+    return matchingEC;
+#else // !WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    ExchangeContext *ec = (ExchangeContext *) ContextPool;
+    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
+            return ec;
+    return NULL;
+#endif // !WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+}
+
+/**
+ *  Find the unsolicited message handler for an inbound message that does not belong to an existing exchange.
+ *
+ *  Handlers that explicitly handle the message type are preferred, the earliest in the handler pool first,
+ *  over handlers that handle all messages for a profile, the latest in the handler pool first.
+ *
+ *  @return   A pointer to the matching handler, or NULL if no handler accepts the message.
+ *
+ */
+WeaveExchangeManager::UnsolicitedMessageHandler *WeaveExchangeManager::FindUMHForMessage(WeaveConnection *msgCon,
+        const WeaveMessageInfo *msgInfo, const WeaveExchangeHeader *exchangeHeader)
+{
+    const bool isDupMsg = (msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) != 0;
+    UnsolicitedMessageHandler *matchingUMH = NULL;
+
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    UnsolicitedMessageHandler *umh;
+    UnsolicitedMessageHandler *anyConUMH;
+
+    // Handlers registered for the connection and for any connection share a key only when the message arrived over UDP.
+    umh = FindIndexedUMH(exchangeHeader->ProfileId, exchangeHeader->MessageType, msgCon);
+    anyConUMH = (msgCon != NULL) ? FindIndexedUMH(exchangeHeader->ProfileId, exchangeHeader->MessageType, NULL) : NULL;
+    if (umh != NULL && (!isDupMsg || umh->AllowDuplicateMsgs))
+        matchingUMH = umh;
+    if (anyConUMH != NULL && (!isDupMsg || anyConUMH->AllowDuplicateMsgs) && (matchingUMH == NULL || anyConUMH < matchingUMH))
+        matchingUMH = anyConUMH;
+
+    if (matchingUMH == NULL)
+    {
+        umh = FindIndexedUMH(exchangeHeader->ProfileId, -1, msgCon);
+        anyConUMH = (msgCon != NULL) ? FindIndexedUMH(exchangeHeader->ProfileId, -1, NULL) : NULL;
+        if (umh != NULL && (!isDupMsg || umh->AllowDuplicateMsgs))
+            matchingUMH = umh;
+        if (anyConUMH != NULL && (!isDupMsg || anyConUMH->AllowDuplicateMsgs) && (matchingUMH == NULL || anyConUMH > matchingUMH))
+            matchingUMH = anyConUMH;
+    }
+#else // !WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    UnsolicitedMessageHandler *umh = (UnsolicitedMessageHandler *) UMHandlerPool;
+
+    for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
+        if (umh->Handler != NULL && umh->ProfileId == exchangeHeader->ProfileId && (umh->Con == NULL || umh->Con == msgCon)
+            && (!isDupMsg || umh->AllowDuplicateMsgs))
+        {
+            if (umh->MessageType == exchangeHeader->MessageType)
+            {
+                matchingUMH = umh;
+                break;
+            }
+
+            if (umh->MessageType == -1)
+                matchingUMH = umh;
+        }
+#endif // !WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
+    return matchingUMH;
+}
+
 void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
 {
     WeaveExchangeHeader exchangeHeader;
-    UnsolicitedMessageHandler *umh         = NULL;
     UnsolicitedMessageHandler *matchingUMH = NULL;
     ExchangeContext *ec                    = NULL;
     WeaveConnection *msgCon                = NULL;
@@ -721,27 +825,24 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 #endif
 
     // Search for an existing exchange that the message applies to. If a match is found...
-    ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    ec = FindContextForMessage(msgCon, msgInfo, &exchangeHeader);
+    if (ec != NULL)
     {
-        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, &exchangeHeader))
-        {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            // Found a matching exchange. Set flag for correct subsequent WRM
-            // retransmission timeout selection.
-            if (!ec->HasRcvdMsgFromPeer())
-            {
-                ec->SetMsgRcvdFromPeer(true);
-            }
+        // Found a matching exchange. Set flag for correct subsequent WRM
+        // retransmission timeout selection.
+        if (!ec->HasRcvdMsgFromPeer())
+        {
+            ec->SetMsgRcvdFromPeer(true);
+        }
 #endif
 
-            //Matched ExchangeContext; send to message handler.
-            ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
+        //Matched ExchangeContext; send to message handler.
+        ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
 
-            msgBuf = NULL;
+        msgBuf = NULL;
 
-            ExitNow(err = WEAVE_NO_ERROR);
-        }
+        ExitNow(err = WEAVE_NO_ERROR);
     }
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -755,25 +856,8 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
     // unsolicited messages must be marked as being from an initiator.
     if (exchangeHeader.Flags & kWeaveExchangeFlag_Initiator)
     {
-        // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
-        // handle the message type over handlers that handle all messages for a profile.
-        umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-
-        matchingUMH = NULL;
-
-        for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
-            if (umh->Handler != NULL && umh->ProfileId == exchangeHeader.ProfileId && (umh->Con == NULL || umh->Con == msgCon)
-                && (!(msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) || umh->AllowDuplicateMsgs))
-            {
-                if (umh->MessageType == exchangeHeader.MessageType)
-                {
-                    matchingUMH = umh;
-                    break;
-                }
-
-                if (umh->MessageType == -1)
-                    matchingUMH = umh;
-            }
+        // Search for an unsolicited message handler that can handle the message.
+        matchingUMH = FindUMHForMessage(msgCon, msgInfo, &exchangeHeader);
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message is not a duplicate
     // that needs to send ack to the peer.
@@ -822,6 +906,9 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 
         ec->Con = msgCon;
         ec->ExchangeId = exchangeHeader.ExchangeId;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        IndexContext(ec);
+#endif
         ec->PeerNodeId = msgInfo->SourceNodeId;
         if (msgInfo->InPacketInfo != NULL)
         {
@@ -928,6 +1015,9 @@ WEAVE_ERROR WeaveExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgTyp
     selected->Con = con;
     selected->MessageType = msgType;
     selected->AllowDuplicateMsgs = allowDups;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    IndexUMH(selected);
+#endif
 
     SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -941,6 +1031,9 @@ WEAVE_ERROR WeaveExchangeManager::UnregisterUMH(uint32_t profileId, int16_t msgT
     {
         if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
         {
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+            UnindexUMH(umh);
+#endif
             umh->Handler = NULL;
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
             return WEAVE_NO_ERROR;
@@ -949,6 +1042,119 @@ WEAVE_ERROR WeaveExchangeManager::UnregisterUMH(uint32_t profileId, int16_t msgT
     return WEAVE_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
 }
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
+static inline size_t HashUMHKey(uint32_t profileId, int16_t msgType, const WeaveConnection *con)
+{
+    uint32_t hash = profileId * 2654435761U;
+
+    hash ^= static_cast<uint16_t>(msgType) * 40503U;
+    hash ^= static_cast<uint32_t>(reinterpret_cast<uintptr_t>(con) >> 3) * 2246822519U;
+
+    return hash ^ (hash >> 16);
+}
+
+size_t WeaveExchangeManager::ContextIndexHome(uint16_t entry) const
+{
+    return ContextPool[entry - 1].ExchangeId % kContextIndexSize;
+}
+
+size_t WeaveExchangeManager::UMHIndexHome(uint16_t entry) const
+{
+    const UnsolicitedMessageHandler &umh = UMHandlerPool[entry - 1];
+
+    return HashUMHKey(umh.ProfileId, umh.MessageType, umh.Con) % kUMHIndexSize;
+}
+
+/**
+ *  Empty a slot of a linear probing index, shifting back any later entries of the same probe sequence
+ *  that would otherwise no longer be reachable from their home slot.
+ */
+void WeaveExchangeManager::RemoveIndexEntry(uint16_t *index, size_t indexSize, size_t slot,
+        size_t (WeaveExchangeManager::*homeFunct)(uint16_t entry) const)
+{
+    size_t next = slot;
+
+    while (true)
+    {
+        next = (next + 1) % indexSize;
+        if (index[next] == 0)
+            break;
+
+        const size_t home = (this->*homeFunct)(index[next]);
+
+        // Leave the entry in place if its home lies cyclically within (slot, next].
+        if ((slot < next) ? (slot < home && home <= next) : (slot < home || home <= next))
+            continue;
+
+        index[slot] = index[next];
+        slot = next;
+    }
+
+    index[slot] = 0;
+}
+
+void WeaveExchangeManager::IndexContext(ExchangeContext *ec)
+{
+    size_t slot = ec->ExchangeId % kContextIndexSize;
+
+    while (mContextIndex[slot] != 0)
+        slot = (slot + 1) % kContextIndexSize;
+
+    mContextIndex[slot] = static_cast<uint16_t>(ec - ContextPool + 1);
+}
+
+void WeaveExchangeManager::UnindexContext(ExchangeContext *ec)
+{
+    const uint16_t entry = static_cast<uint16_t>(ec - ContextPool + 1);
+
+    for (size_t slot = ec->ExchangeId % kContextIndexSize; mContextIndex[slot] != 0; slot = (slot + 1) % kContextIndexSize)
+        if (mContextIndex[slot] == entry)
+        {
+            RemoveIndexEntry(mContextIndex, kContextIndexSize, slot, &WeaveExchangeManager::ContextIndexHome);
+            break;
+        }
+}
+
+void WeaveExchangeManager::IndexUMH(UnsolicitedMessageHandler *umh)
+{
+    size_t slot = HashUMHKey(umh->ProfileId, umh->MessageType, umh->Con) % kUMHIndexSize;
+
+    while (mUMHIndex[slot] != 0)
+        slot = (slot + 1) % kUMHIndexSize;
+
+    mUMHIndex[slot] = static_cast<uint16_t>(umh - UMHandlerPool + 1);
+}
+
+void WeaveExchangeManager::UnindexUMH(UnsolicitedMessageHandler *umh)
+{
+    const uint16_t entry = static_cast<uint16_t>(umh - UMHandlerPool + 1);
+
+    for (size_t slot = HashUMHKey(umh->ProfileId, umh->MessageType, umh->Con) % kUMHIndexSize; mUMHIndex[slot] != 0;
+         slot = (slot + 1) % kUMHIndexSize)
+        if (mUMHIndex[slot] == entry)
+        {
+            RemoveIndexEntry(mUMHIndex, kUMHIndexSize, slot, &WeaveExchangeManager::UMHIndexHome);
+            break;
+        }
+}
+
+WeaveExchangeManager::UnsolicitedMessageHandler *WeaveExchangeManager::FindIndexedUMH(uint32_t profileId, int16_t msgType,
+        WeaveConnection *con) const
+{
+    for (size_t slot = HashUMHKey(profileId, msgType, con) % kUMHIndexSize; mUMHIndex[slot] != 0; slot = (slot + 1) % kUMHIndexSize)
+    {
+        const UnsolicitedMessageHandler *umh = &UMHandlerPool[mUMHIndex[slot] - 1];
+
+        if (umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
+            return const_cast<UnsolicitedMessageHandler *>(umh);
+    }
+
+    return NULL;
+}
+
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
 void WeaveExchangeManager::HandleMessageReceived(WeaveMessageLayer *msgLayer, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
 {
     msgLayer->ExchangeMgr->DispatchMessage(msgInfo, msgBuf);
@@ -186,6 +186,7 @@ public:
     WEAVE_ERROR SendMessage(uint32_t profileId, uint8_t msgType, PacketBuffer *msgPayload, uint16_t sendFlags = 0, void *msgCtxt = 0);
     WEAVE_ERROR SendMessage(uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf, uint16_t sendFlags, WeaveMessageInfo * msgInfo, void *msgCtxt = 0);
     WEAVE_ERROR SendCommonNullMessage(void);
+    WEAVE_ERROR ExpectResponse(void);
     WEAVE_ERROR EncodeExchHeader(WeaveExchangeHeader *exchangeHeader, uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf, uint16_t sendFlags);
     void TeardownTrickleRetransmit(void);
     WEAVE_ERROR SetupTrickleRetransmit(uint32_t retransInterval=WEAVE_TRICKLE_DEFAULT_PERIOD, uint8_t threshold=WEAVE_TRICKLE_DEFAULT_THRESHOLD, uint32_t timeout=0);
@@ -514,7 +515,33 @@ private:
     UnsolicitedMessageHandler UMHandlerPool[WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
     void (*OnExchangeContextChanged)(size_t numContextsInUse);
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    enum
+    {
+        kContextIndexSize   = 2 * WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS,
+        kUMHIndexSize       = 2 * WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
+    };
+
+    // Open-addressing (linear probing) tables holding one plus the pool index of each entry, zero when empty.
+    uint16_t mContextIndex[kContextIndexSize];  // keyed on ExchangeId
+    uint16_t mUMHIndex[kUMHIndexSize];          // keyed on (ProfileId, MessageType, Con)
+
+    void IndexContext(ExchangeContext *ec);
+    void UnindexContext(ExchangeContext *ec);
+    void IndexUMH(UnsolicitedMessageHandler *umh);
+    void UnindexUMH(UnsolicitedMessageHandler *umh);
+    UnsolicitedMessageHandler *FindIndexedUMH(uint32_t profileId, int16_t msgType, WeaveConnection *con) const;
+    size_t ContextIndexHome(uint16_t entry) const;
+    size_t UMHIndexHome(uint16_t entry) const;
+    void RemoveIndexEntry(uint16_t *index, size_t indexSize, size_t slot,
+            size_t (WeaveExchangeManager::*homeFunct)(uint16_t entry) const);
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
     ExchangeContext *AllocContext(void);
+    ExchangeContext *FindContextForMessage(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+            const WeaveExchangeHeader *exchangeHeader);
+    UnsolicitedMessageHandler *FindUMHForMessage(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+            const WeaveExchangeHeader *exchangeHeader);
 
     void HandleConnectionReceived(WeaveConnection *con);
     void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
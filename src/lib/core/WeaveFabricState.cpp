@@ -104,6 +104,29 @@ enum
 // Key diversifier used for Weave message encryption key derivation.
 const uint8_t kWeaveMsgEncAppKeyDiversifier[] = { 0xB1, 0x1D, 0xAE, 0x5B };
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+/**
+ * Recompute the key schedules of a WeaveMsgEncryptionKey object from its secret key material.
+ *
+ * This must be called whenever the encryption type or the secret key material of the key changes.
+ */
+void WeaveMsgEncryptionKey::UpdateKeySchedule(void)
+{
+    if (EncType == kWeaveEncryptionType_AES128CTRSHA1)
+    {
+        KeySchedule.DataKey.SetKey(EncKey.AES128CTRSHA1.DataKey);
+        KeySchedule.IntegrityKey.Init(EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+    }
+    else
+    {
+        KeySchedule.DataKey.Reset();
+        KeySchedule.IntegrityKey.Reset();
+    }
+}
+
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  * Initialize a WeaveSessionKey object.
  */
@@ -127,6 +150,9 @@ void WeaveSessionKey::Clear(void)
 {
     Init();
     ClearSecretData((uint8_t *)&MsgEncKey.EncKey, sizeof(MsgEncKey.EncKey));
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    ClearSecretData((uint8_t *)&MsgEncKey.KeySchedule, sizeof(MsgEncKey.KeySchedule));
+#endif
 }
 
 /**
@@ -342,6 +368,9 @@ void WeaveFabricState::SetSessionKey(WeaveSessionKey *sessionKey, uint8_t encTyp
 {
     sessionKey->MsgEncKey.EncType = encType;
     sessionKey->MsgEncKey.EncKey = *encKey;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.UpdateKeySchedule();
+#endif
     sessionKey->NextMsgId.Init(0);
     sessionKey->MaxRcvdMsgId = 0;
     sessionKey->RcvFlags = 0;
@@ -1574,6 +1603,9 @@ WEAVE_ERROR WeaveFabricState::DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType
     // Set key parameters.
     appKey.KeyId = keyId;
     appKey.EncType = encType;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    appKey.UpdateKeySchedule();
+#endif
 
 exit:
     ClearSecretData(keyData, sizeof(keyData));
@@ -48,6 +48,8 @@
 #include <Weave/Core/WeaveKeyIds.h>
 #include <Weave/Profiles/security/WeaveSecurity.h>
 #include <Weave/Profiles/security/WeaveApplicationKeys.h>
+#include <Weave/Support/crypto/AESBlockCipher.h>
+#include <Weave/Support/crypto/HMAC.h>
 
 namespace nl {
 namespace Weave {
@@ -287,6 +289,14 @@ typedef union WeaveEncryptionKey
     WeaveEncryptionKey_AES128CTRSHA1 AES128CTRSHA1;
 } WeaveEncryptionKey;
 
+// Key schedules precomputed from an AES-128-CTR-SHA-1 message encryption key
+class WeaveEncryptionKeySchedule_AES128CTRSHA1
+{
+public:
+    Platform::Security::AES128BlockCipherEnc DataKey;  /**< The AES-128 cipher keyed with the data key. */
+    Crypto::HMACSHA1::KeySchedule IntegrityKey;         /**< The HMAC-SHA-1 key schedule of the integrity key. */
+};
+
 // AES128CTRSHA1 encryption and integrity test keys, which should only be used for testing purposes.
 enum
 {
@@ -307,6 +317,11 @@ public:
     uint16_t KeyId;                                     /**< The key ID. */
     uint8_t EncType;                                    /**< The encryption type supported by the key. */
     WeaveEncryptionKey EncKey;                          /**< The secret key material. */
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    WeaveEncryptionKeySchedule_AES128CTRSHA1 KeySchedule; /**< The key schedules computed from the secret key material. */
+
+    void UpdateKeySchedule(void);
+#endif
 };
 
 /**
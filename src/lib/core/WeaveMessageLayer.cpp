@@ -1096,10 +1096,7 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
             // TODO: re-validate MIC to ensure that no part of the message has been altered since the time it was received.
 
             // Re-encrypt the payload.
-            AES128CTRMode aes128CTR;
-            aes128CTR.SetKey(sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey);
-            aes128CTR.SetWeaveMessageCounter(msgInfo.SourceNodeId, msgInfo.MessageId);
-            aes128CTR.EncryptData(p, encryptionLen, p);
+            Encrypt_AES128CTRSHA1(&msgInfo, sessionState.MsgEncKey, p, encryptionLen, p);
         }
         break;
     default:
@@ -1111,6 +1108,113 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
     return WEAVE_NO_ERROR;
 }
 
+/**
+ *  @class WeaveMessageLayer::BatchContext
+ *
+ *  @brief
+ *    State shared by the messages of a batch passed to EncodeMessages() or DecodeMessages().
+ *
+ *    Consecutive messages exchanged with the same node under the same key reuse the session
+ *    state looked up for the first of them, and the AES and HMAC key schedules expanded from
+ *    its key.  Only the most recent lookup is kept, so that a lookup that may reuse a fabric
+ *    state entry (for example, an application key derived into the key cache) can never leave
+ *    stale state behind.
+ */
+class WeaveMessageLayer::BatchContext
+{
+public:
+    BatchContext(WeaveFabricState *fabricState);
+    ~BatchContext(void);
+
+    WEAVE_ERROR GetSessionState(uint64_t remoteNodeId, uint16_t keyId, uint8_t encType, WeaveSessionState &outSessionState);
+    const WeaveEncryptionKeySchedule_AES128CTRSHA1 &GetKeySchedule(const WeaveMsgEncryptionKey *msgEncKey);
+
+private:
+    WeaveFabricState *mFabricState;
+    WeaveSessionState mSessionState;
+    uint64_t mRemoteNodeId;
+    uint16_t mKeyId;
+    uint8_t mEncType;
+    bool mHaveSessionState;
+#if !WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    bool mHaveKeySchedule;
+    WeaveEncryptionKeySchedule_AES128CTRSHA1 mKeySchedule;
+#endif
+};
+
+WeaveMessageLayer::BatchContext::BatchContext(WeaveFabricState *fabricState) :
+    mFabricState(fabricState),
+    mRemoteNodeId(kNodeIdNotSpecified),
+    mKeyId(WeaveKeyId::kNone),
+    mEncType(kWeaveEncryptionType_None),
+    mHaveSessionState(false)
+#if !WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    , mHaveKeySchedule(false)
+#endif
+{
+}
+
+WeaveMessageLayer::BatchContext::~BatchContext(void)
+{
+#if !WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    mKeySchedule.DataKey.Reset();
+    mKeySchedule.IntegrityKey.Reset();
+#endif
+}
+
+/**
+ *  Get the session state for a message of the batch, as by WeaveFabricState::GetSessionState()
+ *  without a connection, reusing that of the previous message if it has the same peer and key.
+ *
+ *  A failed lookup is not cached.
+ */
+WEAVE_ERROR WeaveMessageLayer::BatchContext::GetSessionState(uint64_t remoteNodeId, uint16_t keyId, uint8_t encType,
+        WeaveSessionState &outSessionState)
+{
+    WEAVE_ERROR err;
+
+    if (!mHaveSessionState || remoteNodeId != mRemoteNodeId || keyId != mKeyId || encType != mEncType)
+    {
+        mHaveSessionState = false;
+#if !WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+        mHaveKeySchedule = false;
+#endif
+
+        err = mFabricState->GetSessionState(remoteNodeId, keyId, encType, NULL, mSessionState);
+        if (err != WEAVE_NO_ERROR)
+            return err;
+
+        mRemoteNodeId = remoteNodeId;
+        mKeyId = keyId;
+        mEncType = encType;
+        mHaveSessionState = true;
+    }
+
+    outSessionState = mSessionState;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ *  Get the key schedules of the message encryption key returned by the last call to GetSessionState(),
+ *  expanding them on first use if they are not cached with the key itself.
+ */
+const WeaveEncryptionKeySchedule_AES128CTRSHA1 &WeaveMessageLayer::BatchContext::GetKeySchedule(const WeaveMsgEncryptionKey *msgEncKey)
+{
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    return msgEncKey->KeySchedule;
+#else
+    if (!mHaveKeySchedule)
+    {
+        mKeySchedule.DataKey.SetKey(msgEncKey->EncKey.AES128CTRSHA1.DataKey);
+        mKeySchedule.IntegrityKey.Init(msgEncKey->EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+        mHaveKeySchedule = true;
+    }
+
+    return mKeySchedule;
+#endif
+}
+
 /**
  *  Encode a WeaveMessageLayer header into an PacketBuffer.
  *
@@ -1140,6 +1244,12 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
  */
 WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con,
         uint16_t maxLen, uint16_t reserve)
+{
+    return EncodeMessage(msgInfo, msgBuf, con, maxLen, reserve, NULL);
+}
+
+WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con,
+        uint16_t maxLen, uint16_t reserve, BatchContext *batch)
 {
     WEAVE_ERROR err;
     uint8_t *p1;
@@ -1203,15 +1313,12 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
 
     // Get the session state for the given destination node and encryption key.
     WeaveSessionState sessionState;
+    uint64_t remoteNodeId = (msgInfo->DestNodeId == kAnyNodeId) ? msgInfo->SourceNodeId : msgInfo->DestNodeId;
 
-    if (msgInfo->DestNodeId == kAnyNodeId)
-    {
-        err = FabricState->GetSessionState(msgInfo->SourceNodeId, msgInfo->KeyId, msgInfo->EncryptionType, con, sessionState);
-    }
+    if (batch != NULL)
+        err = batch->GetSessionState(remoteNodeId, msgInfo->KeyId, msgInfo->EncryptionType, sessionState);
     else
-    {
-        err = FabricState->GetSessionState(msgInfo->DestNodeId, msgInfo->KeyId, msgInfo->EncryptionType, con, sessionState);
-    }
+        err = FabricState->GetSessionState(remoteNodeId, msgInfo->KeyId, msgInfo->EncryptionType, con, sessionState);
     if (err != WEAVE_NO_ERROR)
         return err;
 
@@ -1279,14 +1386,22 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         // so skip over the payload data.
         p += payloadLen;
 
-        // Compute the integrity check value and store it immediately after the payload data.
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
-                                            payloadStart, payloadLen, p);
-        p += HMACSHA1::kDigestLength;
+        // Compute the integrity check value and store it immediately after the payload data, then encrypt the
+        // message payload and the integrity check value that follows it, in place, in the message buffer.
+        if (batch != NULL)
+        {
+            const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule = batch->GetKeySchedule(sessionState.MsgEncKey);
 
-        // Encrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
-                              payloadStart, payloadLen + HMACSHA1::kDigestLength, payloadStart);
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, keySchedule, payloadStart, payloadLen, p);
+            Encrypt_AES128CTRSHA1(msgInfo, keySchedule, payloadStart, payloadLen + HMACSHA1::kDigestLength, payloadStart);
+        }
+        else
+        {
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey, payloadStart, payloadLen, p);
+            Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
+                                  payloadStart, payloadLen + HMACSHA1::kDigestLength, payloadStart);
+        }
+        p += HMACSHA1::kDigestLength;
 
         break;
     }
@@ -1303,8 +1418,55 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
     return WEAVE_NO_ERROR;
 }
 
+static WEAVE_ERROR FirstBatchError(const WeaveMessageBatchEntry *batch, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        if (batch[i].Status != WEAVE_NO_ERROR)
+            return batch[i].Status;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ *  Encode a batch of Weave messages, as if by calling EncodeMessage() on each, without a
+ *  connection, in turn.
+ *
+ *  Consecutive messages to the same node under the same key share one session state lookup
+ *  and one expansion of the AES and HMAC key schedules, so a batch costs less than encoding
+ *  its messages one at a time.  A message that cannot be encoded does not stop the rest of
+ *  the batch from being encoded.
+ *
+ *  @param[in,out] batch        An array of messages to encode.  The status of each message is
+ *                              returned in its Status member.
+ *
+ *  @param[in]    count         The number of messages in the batch.
+ *
+ *  @param[in]    maxLen        The maximum length of each encoded Weave message.
+ *
+ *  @param[in]    reserve       The reserved space before each payload to hold the Weave message header.
+ *
+ *  @retval  #WEAVE_NO_ERROR    if all the messages were encoded.
+ *  @retval  other              the status of the first message that could not be encoded.
+ *
+ */
+WEAVE_ERROR WeaveMessageLayer::EncodeMessages(WeaveMessageBatchEntry *batch, size_t count, uint16_t maxLen, uint16_t reserve)
+{
+    BatchContext batchContext(FabricState);
+
+    for (size_t i = 0; i < count; i++)
+        batch[i].Status = EncodeMessage(batch[i].MsgInfo, batch[i].MsgBuf, NULL, maxLen, reserve, &batchContext);
+
+    return FirstBatchError(batch, count);
+}
+
 WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
         WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen) // TODO: use references
+{
+    return DecodeMessage(msgBuf, sourceNodeId, con, msgInfo, rPayload, rPayloadLen, NULL);
+}
+
+WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+        WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen, BatchContext *batch)
 {
     WEAVE_ERROR err;
     uint8_t *msgStart = msgBuf->Start();
@@ -1321,7 +1483,10 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
     // Get the session state for the given source node and encryption key.
     WeaveSessionState sessionState;
 
-    err = FabricState->GetSessionState(sourceNodeId, msgInfo->KeyId, msgInfo->EncryptionType, con, sessionState);
+    if (batch != NULL)
+        err = batch->GetSessionState(sourceNodeId, msgInfo->KeyId, msgInfo->EncryptionType, sessionState);
+    else
+        err = FabricState->GetSessionState(sourceNodeId, msgInfo->KeyId, msgInfo->EncryptionType, con, sessionState);
     if (err != WEAVE_NO_ERROR)
         return err;
 
@@ -1347,14 +1512,23 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
         *rPayloadLen = payloadLen;
         *rPayload = p;
 
-        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
-                              p, payloadLen + HMACSHA1::kDigestLength, p);
-
-        // Compute the expected integrity check value from the decrypted payload.
+        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer,
+        // then compute the expected integrity check value from the decrypted payload.
         uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
-                                            p, payloadLen, expectedIntegrityCheck);
+        if (batch != NULL)
+        {
+            const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule = batch->GetKeySchedule(sessionState.MsgEncKey);
+
+            Encrypt_AES128CTRSHA1(msgInfo, keySchedule, p, payloadLen + HMACSHA1::kDigestLength, p);
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, keySchedule, p, payloadLen, expectedIntegrityCheck);
+        }
+        else
+        {
+            Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
+                                  p, payloadLen + HMACSHA1::kDigestLength, p);
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
+                                                p, payloadLen, expectedIntegrityCheck);
+        }
         // Error if the expected integrity check doesn't match the integrity check in the message.
         if (!ConstantTimeCompare(p + payloadLen, expectedIntegrityCheck, HMACSHA1::kDigestLength))
             return WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
@@ -1386,6 +1560,41 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
     return err;
 }
 
+/**
+ *  Decode a batch of Weave messages, as if by calling DecodeMessage() on each, without a
+ *  connection, in turn.
+ *
+ *  Consecutive messages from the same node under the same key share one session state lookup
+ *  and one expansion of the AES and HMAC key schedules.  A message that cannot be decoded does
+ *  not stop the rest of the batch from being decoded.
+ *
+ *  @param[in,out] batch        An array of messages to decode.  The status of each message is
+ *                              returned in its Status member, and the location of its payload
+ *                              in its Payload and PayloadLen members.
+ *
+ *  @param[in]    count         The number of messages in the batch.
+ *
+ *  @retval  #WEAVE_NO_ERROR    if all the messages were decoded.
+ *  @retval  other              the status of the first message that could not be decoded.
+ *
+ */
+WEAVE_ERROR WeaveMessageLayer::DecodeMessages(WeaveMessageBatchEntry *batch, size_t count)
+{
+    BatchContext batchContext(FabricState);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        WeaveMessageBatchEntry &entry = batch[i];
+
+        entry.Payload = NULL;
+        entry.PayloadLen = 0;
+        entry.Status = DecodeMessage(entry.MsgBuf, entry.MsgInfo->SourceNodeId, NULL, entry.MsgInfo, &entry.Payload, &entry.PayloadLen,
+                                     &batchContext);
+    }
+
+    return FirstBatchError(batch, count);
+}
+
 WEAVE_ERROR WeaveMessageLayer::EncodeMessageWithLength(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf,
         WeaveConnection *con, uint16_t maxLen)
 {
@@ -1457,6 +1666,25 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessageWithLength(PacketBuffer *msgBuf, uin
     return err;
 }
 
+/**
+ *  Handle the messages read together from a UDP endpoint, when batched reception is configured
+ *  (see #INET_CONFIG_UDP_RECV_BATCH_SIZE).
+ *
+ *  Each message is decoded and dispatched in order of arrival, as by HandleUDPMessage(), so that
+ *  duplicate detection and exchange state see the same sequence as with unbatched reception.
+ */
+void WeaveMessageLayer::HandleUDPMessages(UDPEndPoint *endPoint, PacketBuffer **msgs, const IPPacketInfo *pktInfos, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        // Drop the rest of the batch if handling an earlier message closed the endpoint.
+        if (endPoint->mState == UDPEndPoint::kState_Listening)
+            HandleUDPMessage(endPoint, msgs[i], &pktInfos[i]);
+        else
+            PacketBuffer::Free(msgs[i]);
+    }
+}
+
 void WeaveMessageLayer::HandleUDPMessage(UDPEndPoint *endPoint, PacketBuffer *msg, const IPPacketInfo *pktInfo)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -1821,7 +2049,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
             mIPv4TCPListen->AppState = this;
             mIPv4TCPListen->OnConnectionReceived = HandleIncomingTcpConnection;
             mIPv4TCPListen->OnAcceptError = HandleAcceptError;
-            res = mIPv4TCPListen->Listen(1);
+            res = mIPv4TCPListen->Listen(WEAVE_CONFIG_TCP_LISTEN_BACKLOG);
             if (res != WEAVE_NO_ERROR)
                 goto exit;
         }
@@ -1855,7 +2083,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
             mIPv6TCPListen->AppState = this;
             mIPv6TCPListen->OnConnectionReceived = HandleIncomingTcpConnection;
             mIPv6TCPListen->OnAcceptError = HandleAcceptError;
-            res = mIPv6TCPListen->Listen(1);
+            res = mIPv6TCPListen->Listen(WEAVE_CONFIG_TCP_LISTEN_BACKLOG);
             if (res != WEAVE_NO_ERROR)
                 goto exit;
         }
@@ -1889,7 +2117,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
             mUnsecuredIPv6TCPListen->AppState = this;
             mUnsecuredIPv6TCPListen->OnConnectionReceived = HandleIncomingTcpConnection;
             mUnsecuredIPv6TCPListen->OnAcceptError = HandleAcceptError;
-            res = mUnsecuredIPv6TCPListen->Listen(1);
+            res = mUnsecuredIPv6TCPListen->Listen(WEAVE_CONFIG_TCP_LISTEN_BACKLOG);
             if (res != WEAVE_NO_ERROR)
                 goto exit;
         }
@@ -1928,6 +2156,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
 
             mIPv4UDP->AppState = this;
             mIPv4UDP->OnMessageReceived = reinterpret_cast<IPEndPointBasis::OnMessageReceivedFunct>(HandleUDPMessage);
+            mIPv4UDP->OnMessagesReceived = reinterpret_cast<IPEndPointBasis::OnMessagesReceivedFunct>(HandleUDPMessages);
             mIPv4UDP->OnReceiveError = reinterpret_cast<IPEndPointBasis::OnReceiveErrorFunct>(HandleUDPReceiveError);
             res = mIPv4UDP->Listen();
             if (res != WEAVE_NO_ERROR)
@@ -1962,6 +2191,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
 
             mIPv6UDP->AppState = this;
             mIPv6UDP->OnMessageReceived = reinterpret_cast<IPEndPointBasis::OnMessageReceivedFunct>(HandleUDPMessage);
+            mIPv6UDP->OnMessagesReceived = reinterpret_cast<IPEndPointBasis::OnMessagesReceivedFunct>(HandleUDPMessages);
             mIPv6UDP->OnReceiveError = reinterpret_cast<IPEndPointBasis::OnReceiveErrorFunct>(HandleUDPReceiveError);
             res = mIPv6UDP->Listen();
             if (res != WEAVE_NO_ERROR)
@@ -2001,6 +2231,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
             // Enable reception of incoming messages.
             mIPv6UDPMulticastRcv->AppState = this;
             mIPv6UDPMulticastRcv->OnMessageReceived = reinterpret_cast<IPEndPointBasis::OnMessageReceivedFunct>(HandleUDPMessage);
+            mIPv6UDPMulticastRcv->OnMessagesReceived = reinterpret_cast<IPEndPointBasis::OnMessagesReceivedFunct>(HandleUDPMessages);
             mIPv6UDPMulticastRcv->OnReceiveError = reinterpret_cast<IPEndPointBasis::OnReceiveErrorFunct>(HandleUDPReceiveError);
             res = mIPv6UDPMulticastRcv->Listen();
             if (res != WEAVE_NO_ERROR)
@@ -2082,6 +2313,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoints()
                 {
                     ep->AppState = this;
                     ep->OnMessageReceived = reinterpret_cast<IPEndPointBasis::OnMessageReceivedFunct>(HandleUDPMessage);
+                    ep->OnMessagesReceived = reinterpret_cast<IPEndPointBasis::OnMessagesReceivedFunct>(HandleUDPMessages);
                     ep->OnReceiveError = reinterpret_cast<IPEndPointBasis::OnReceiveErrorFunct>(HandleUDPReceiveError);
                     epErr = ep->Listen();
                 }
@@ -2118,25 +2350,35 @@ exit:
     return res;
 }
 
-void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveMsgEncryptionKey *msgEncKey,
                                               const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
 {
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    Encrypt_AES128CTRSHA1(msgInfo, msgEncKey->KeySchedule, inData, inLen, outBuf);
+#else
     AES128CTRMode aes128CTR;
-    aes128CTR.SetKey(key);
+    aes128CTR.SetKey(msgEncKey->EncKey.AES128CTRSHA1.DataKey);
     aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
     aes128CTR.EncryptData(inData, inLen, outBuf);
+#endif
 }
 
-void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule,
+                                              const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+{
+    AES128CTRMode aes128CTR;
+    aes128CTR.SetKey(keySchedule.DataKey);
+    aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
+    aes128CTR.EncryptData(inData, inLen, outBuf);
+}
+
+// Hash the message header fields covered by the integrity check, then the payload, and generate the MAC.
+static void FinishIntegrityCheck_AES128CTRSHA1(HMACSHA1 &hmacSHA1, const WeaveMessageInfo *msgInfo,
+                                               const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
 {
-    HMACSHA1 hmacSHA1;
     uint8_t encodedBuf[2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)];
     uint8_t *p = encodedBuf;
 
-    // Initialize HMAC Key.
-    hmacSHA1.Begin(key, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
-
     // Encode the source and destination node identifiers in a little-endian format.
     Encoding::LittleEndian::Write64(p, msgInfo->SourceNodeId);
     Encoding::LittleEndian::Write64(p, msgInfo->DestNodeId);
@@ -2165,6 +2407,33 @@ void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageIn
     hmacSHA1.Finish(outBuf);
 }
 
+void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveMsgEncryptionKey *msgEncKey,
+                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+{
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, msgEncKey->KeySchedule, inData, inLen, outBuf);
+#else
+    HMACSHA1 hmacSHA1;
+
+    // Initialize HMAC Key.
+    hmacSHA1.Begin(msgEncKey->EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+
+    FinishIntegrityCheck_AES128CTRSHA1(hmacSHA1, msgInfo, inData, inLen, outBuf);
+#endif
+}
+
+void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo,
+                                                            const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule,
+                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+{
+    HMACSHA1 hmacSHA1;
+
+    // Initialize HMAC from the expanded key.
+    hmacSHA1.Begin(keySchedule.IntegrityKey);
+
+    FinishIntegrityCheck_AES128CTRSHA1(hmacSHA1, msgInfo, inData, inLen, outBuf);
+}
+
 /**
  *  Close all open TCP and UDP endpoints. Then abort any
  *  open WeaveConnections and shutdown any open
@@ -117,6 +117,24 @@ struct WeaveMessageInfo
 // DEPRECATED alias for WeaveMessageInfo
 typedef struct WeaveMessageInfo WeaveMessageHeader;
 
+/**
+ *  @struct WeaveMessageBatchEntry
+ *
+ *  @brief
+ *    A message in a batch encoded by WeaveMessageLayer::EncodeMessages() or decoded by
+ *    WeaveMessageLayer::DecodeMessages().
+ *
+ */
+struct WeaveMessageBatchEntry
+{
+    WeaveMessageInfo *MsgInfo;         /**< The message information, as for EncodeMessage() or DecodeMessage(). When decoding, SourceNodeId
+                                            must be set to the source node id to use if the message header does not carry one. */
+    PacketBuffer *MsgBuf;              /**< The message, which is encoded or decoded in place. */
+    uint8_t *Payload;                  /**< [OUT] When decoding, the start of the decrypted payload within MsgBuf. */
+    uint16_t PayloadLen;               /**< [OUT] When decoding, the length of the decrypted payload. */
+    WEAVE_ERROR Status;                /**< [OUT] The result of encoding or decoding the message. */
+};
+
 
 /**
  *  @brief
@@ -296,6 +314,13 @@ public:
 
     WEAVE_ERROR SetUserTimeout(uint32_t userTimeoutMillis);
     WEAVE_ERROR ResetUserTimeout(void);
+
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    WEAVE_ERROR EnableCoalescing(uint32_t flushDelayMS);
+    WEAVE_ERROR DisableCoalescing(void);
+    WEAVE_ERROR Flush(void);
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
     uint16_t LogId(void) const { return static_cast<uint16_t>(reinterpret_cast<intptr_t>(this)); }
 
     TCPEndPoint * GetTCPEndPoint(void) const { return mTcpEndPoint; }
@@ -380,6 +405,11 @@ private:
 #if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
     uint8_t mDNSOptions;
 #endif
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    PacketBuffer *mCoalesceBuf;                         // Encoded messages waiting to be written to the TCP endpoint
+    uint32_t mCoalesceDelayMS;
+    bool mCoalescingEnabled;
+#endif
 
     void Init(WeaveMessageLayer *msgLayer);
     void MakeConnectedTcp(TCPEndPoint *endPoint, const IPAddress &localAddr, const IPAddress &peerAddr);
@@ -401,6 +431,12 @@ private:
                                          Profiles::StatusReporting::StatusReport *statusReport);
     static void DefaultConnectionClosedHandler(WeaveConnection *con, WEAVE_ERROR conErr);
 
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    WEAVE_ERROR CoalesceMessage(PacketBuffer *msgBuf);
+    void DiscardCoalescedMessages(void);
+    static void HandleCoalesceTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+#endif
+
 #if CONFIG_NETWORK_LAYER_BLE
 public:
     WEAVE_ERROR ConnectBle(BLE_CONNECTION_OBJECT connObj, WeaveAuthMode authMode, bool autoClose = true);
@@ -654,6 +690,8 @@ public:
     WEAVE_ERROR EncodeMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con, uint16_t maxLen,
             uint16_t reserve = 0);
     WEAVE_ERROR EncodeMessage(const IPAddress &destAddr, uint16_t destPort, InterfaceId sendIntId, WeaveMessageInfo *msgInfo, PacketBuffer *payload);
+    WEAVE_ERROR EncodeMessages(WeaveMessageBatchEntry *batch, size_t count, uint16_t maxLen = UINT16_MAX, uint16_t reserve = 0);
+    WEAVE_ERROR DecodeMessages(WeaveMessageBatchEntry *batch, size_t count);
 
     WEAVE_ERROR RefreshEndpoints(void);
     WEAVE_ERROR CloseEndpoints(void);
@@ -727,19 +765,31 @@ private:
     WEAVE_ERROR SelectDestNodeIdAndAddress(uint64_t& destNodeId, IPAddress& destAddr);
     WEAVE_ERROR DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
             WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen);
+
+    class BatchContext;
+    WEAVE_ERROR EncodeMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con, uint16_t maxLen,
+            uint16_t reserve, BatchContext *batch);
+    WEAVE_ERROR DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen, BatchContext *batch);
+
     WEAVE_ERROR EncodeMessageWithLength(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con,
             uint16_t maxLen);
     WEAVE_ERROR DecodeMessageWithLength(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
             WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen, uint16_t *rFrameLen);
 
     static void HandleUDPMessage(UDPEndPoint *endPoint, PacketBuffer *msg, const IPPacketInfo *pktInfo);
+    static void HandleUDPMessages(UDPEndPoint *endPoint, PacketBuffer **msgs, const IPPacketInfo *pktInfos, size_t count);
     static void HandleUDPReceiveError(UDPEndPoint *endPoint, INET_ERROR err, const IPPacketInfo *pktInfo);
     static void HandleIncomingTcpConnection(TCPEndPoint *listeningEndPoint, TCPEndPoint *conEndPoint, const IPAddress &peerAddr,
             uint16_t peerPort);
     static void HandleAcceptError(TCPEndPoint *endPoint, INET_ERROR err);
-    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveMsgEncryptionKey *msgEncKey,
+                                      const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
+    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveMsgEncryptionKey *msgEncKey,
+                                                    const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
+    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule,
                                       const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
-    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const WeaveEncryptionKeySchedule_AES128CTRSHA1 &keySchedule,
                                                     const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
     static bool IsIgnoredMulticastSendError(WEAVE_ERROR err);
 
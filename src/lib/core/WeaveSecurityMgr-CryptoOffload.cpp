@@ -0,0 +1,341 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the pool of worker threads on which the Weave Security
+ *      Manager runs session establishment cryptography.  This implementation is used
+ *      when #WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD is enabled (1).
+ *
+ *      The pool is shared by all security manager instances in the process.  It is
+ *      started by the first call to Init() and stopped by the matching last call to
+ *      Shutdown().  Completed jobs are handed back to the thread of the System Layer
+ *      they were posted to via System::Layer::ScheduleWork(), which may be called
+ *      from any thread.
+ *
+ */
+
+#include "WeaveConfig.h"
+#include "WeaveSecurityMgr.h"
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#if !WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#error "WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD requires WEAVE_SYSTEM_CONFIG_POSIX_LOCKING."
+#endif // !WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
+namespace nl {
+namespace Weave {
+namespace CryptoOffload {
+
+enum
+{
+    kJobState_Idle = 0,
+    kJobState_Queued,
+    kJobState_Running,
+    kJobState_Done
+};
+
+// Delay before retrying to schedule the delivery of a completed job, should the System Layer be out of timers.
+static const useconds_t kScheduleRetryDelayUS = 1000;
+
+// Number of retries after which a completed job is left on the done queue, to be delivered along with the next job
+// completed for the same System Layer, or withdrawn by Cancel().
+static const unsigned int kScheduleMaxRetries = 100;
+
+static pthread_mutex_t sLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sWorkAvailable = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t sJobDone = PTHREAD_COND_INITIALIZER;
+static pthread_t sWorkers[WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS];
+static size_t sNumWorkers;
+static size_t sRefCount;
+static bool sShuttingDown;
+
+// Jobs waiting for a worker, oldest first.
+static Job *sPendingHead;
+static Job *sPendingTail;
+
+// Jobs whose work is done but whose completion has not yet been delivered, oldest first.
+static Job *sDoneHead;
+static Job *sDoneTail;
+
+static void Enqueue(Job *&head, Job *&tail, Job *job)
+{
+    job->mNext = NULL;
+
+    if (tail != NULL)
+        tail->mNext = job;
+    else
+        head = job;
+
+    tail = job;
+}
+
+static bool Unlink(Job *&head, Job *&tail, Job *job)
+{
+    Job *prev = NULL;
+
+    for (Job *cur = head; cur != NULL; prev = cur, cur = cur->mNext)
+    {
+        if (cur == job)
+        {
+            if (prev != NULL)
+                prev->mNext = cur->mNext;
+            else
+                head = cur->mNext;
+
+            if (tail == cur)
+                tail = prev;
+
+            cur->mNext = NULL;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void DeliverCompletedJobs(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    pthread_mutex_lock(&sLock);
+
+    while (true)
+    {
+        Job *job;
+
+        for (job = sDoneHead; job != NULL; job = job->mNext)
+        {
+            if (job->mSystemLayer == aSystemLayer)
+                break;
+        }
+
+        if (job == NULL)
+            break;
+
+        Unlink(sDoneHead, sDoneTail, job);
+        job->mState = kJobState_Idle;
+
+        // The completion function may post or cancel jobs, so call it without holding the lock.
+        pthread_mutex_unlock(&sLock);
+        job->OnComplete(job->AppState, job->mResult);
+        pthread_mutex_lock(&sLock);
+    }
+
+    pthread_mutex_unlock(&sLock);
+}
+
+static void *WorkerMain(void *arg)
+{
+    pthread_mutex_lock(&sLock);
+
+    while (true)
+    {
+        Job *job;
+        System::Layer *systemLayer;
+        System::Error schedErr;
+        WEAVE_ERROR err;
+
+        while (sPendingHead == NULL && !sShuttingDown)
+            pthread_cond_wait(&sWorkAvailable, &sLock);
+
+        // Exit once shutting down and no work is left.
+        if (sPendingHead == NULL)
+            break;
+
+        job = sPendingHead;
+        Unlink(sPendingHead, sPendingTail, job);
+        job->mState = kJobState_Running;
+
+        pthread_mutex_unlock(&sLock);
+        err = job->Work(job->AppState);
+        pthread_mutex_lock(&sLock);
+
+        job->mResult = err;
+        job->mState = kJobState_Done;
+        Enqueue(sDoneHead, sDoneTail, job);
+        pthread_cond_broadcast(&sJobDone);
+
+        // Once the lock is released the job may be cancelled and reused, so only its System Layer is kept.
+        systemLayer = job->mSystemLayer;
+
+        pthread_mutex_unlock(&sLock);
+        schedErr = systemLayer->ScheduleWork(DeliverCompletedJobs, NULL);
+        pthread_mutex_lock(&sLock);
+
+        // Stop retrying when shutting down, so that the pool can be stopped.
+        for (unsigned int retries = 0; schedErr != WEAVE_SYSTEM_NO_ERROR && !sShuttingDown && retries < kScheduleMaxRetries;
+             retries++)
+        {
+            pthread_mutex_unlock(&sLock);
+            usleep(kScheduleRetryDelayUS);
+            schedErr = systemLayer->ScheduleWork(DeliverCompletedJobs, NULL);
+            pthread_mutex_lock(&sLock);
+        }
+
+        if (schedErr != WEAVE_SYSTEM_NO_ERROR)
+            WeaveLogError(SecurityManager, "Crypto offload: failed to schedule job completion: %d", schedErr);
+    }
+
+    pthread_mutex_unlock(&sLock);
+
+    return NULL;
+}
+
+static void StopWorkers(void)
+{
+    size_t numWorkers;
+
+    pthread_mutex_lock(&sLock);
+    sShuttingDown = true;
+    numWorkers = sNumWorkers;
+    sNumWorkers = 0;
+    pthread_cond_broadcast(&sWorkAvailable);
+    pthread_mutex_unlock(&sLock);
+
+    for (size_t i = 0; i < numWorkers; i++)
+        pthread_join(sWorkers[i], NULL);
+}
+
+/**
+ * Start the crypto worker threads, unless they are already running.
+ *
+ * Each successful call must be matched by a call to Shutdown().
+ *
+ * @retval #WEAVE_NO_ERROR  On success.
+ * @retval other            The error returned by pthread_create().
+ */
+WEAVE_ERROR Init(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    pthread_mutex_lock(&sLock);
+
+    if (sRefCount == 0)
+    {
+        sShuttingDown = false;
+
+        while (sNumWorkers < WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS)
+        {
+            int res = pthread_create(&sWorkers[sNumWorkers], NULL, WorkerMain, NULL);
+            VerifyOrExit(res == 0, err = System::MapErrorPOSIX(res));
+            sNumWorkers++;
+        }
+    }
+
+    sRefCount++;
+
+exit:
+    pthread_mutex_unlock(&sLock);
+
+    // Stop any workers started before the failure.
+    if (err != WEAVE_NO_ERROR)
+        StopWorkers();
+
+    return err;
+}
+
+/**
+ * Release a reference to the crypto worker threads, stopping them when it is the last.
+ *
+ * All jobs must have completed or been cancelled beforehand.
+ */
+void Shutdown(void)
+{
+    bool stop;
+
+    pthread_mutex_lock(&sLock);
+    stop = (sRefCount > 0 && --sRefCount == 0);
+    pthread_mutex_unlock(&sLock);
+
+    if (stop)
+        StopWorkers();
+}
+
+/**
+ * Queue a job to be run on a crypto worker thread.
+ *
+ * On success, the job's OnComplete function will be called on the thread of the given
+ * System Layer once the job's Work function has run, unless the job is cancelled first.
+ * The job must not be posted again until then.  Should the System Layer persistently fail to
+ * schedule the completion, it is delivered along with that of the next job completed for the
+ * same System Layer.
+ *
+ * @param[in]  systemLayer  The System Layer on whose thread the job completes.
+ * @param[in]  job          The job to run.
+ *
+ * @retval #WEAVE_NO_ERROR               On success.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE  If the worker threads are not running, or the job
+ *                                       is already queued.
+ */
+WEAVE_ERROR Post(System::Layer &systemLayer, Job &job)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    pthread_mutex_lock(&sLock);
+
+    VerifyOrExit(sNumWorkers > 0 && !sShuttingDown, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(job.mState == kJobState_Idle, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    job.mSystemLayer = &systemLayer;
+    job.mState = kJobState_Queued;
+    Enqueue(sPendingHead, sPendingTail, &job);
+
+    pthread_cond_signal(&sWorkAvailable);
+
+exit:
+    pthread_mutex_unlock(&sLock);
+
+    return err;
+}
+
+/**
+ * Withdraw a posted job, such that its OnComplete function is not called.
+ *
+ * If a worker thread is running the job, this waits for the job's Work function to return.
+ * Cancelling a job that is not posted has no effect.
+ *
+ * @param[in]  job          The job to cancel.
+ */
+void Cancel(Job &job)
+{
+    pthread_mutex_lock(&sLock);
+
+    while (job.mState == kJobState_Running)
+        pthread_cond_wait(&sJobDone, &sLock);
+
+    if (job.mState == kJobState_Queued)
+        Unlink(sPendingHead, sPendingTail, &job);
+    else if (job.mState == kJobState_Done)
+        Unlink(sDoneHead, sDoneTail, &job);
+
+    job.mState = kJobState_Idle;
+
+    pthread_mutex_unlock(&sLock);
+}
+
+} // namespace CryptoOffload
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
@@ -93,13 +93,7 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     OnSessionEstablished = NULL;
     OnSessionError = NULL;
     OnKeyErrorMsgRcvd = NULL;
-    mEC = NULL;
-    mCon = NULL;
-#if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
-    mPASEEngine = NULL;
-#endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-    mCASEEngine = NULL;
     mDefaultAuthDelegate = NULL;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
@@ -107,14 +101,17 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     InitiatorCASECurveId = WEAVE_CONFIG_DEFAULT_CASE_CURVE_ID;
     InitiatorAllowedCASEConfigs = CASE::kCASEAllowedConfig_Config2|CASE::kCASEAllowedConfig_Config1;
     InitiatorAllowedCASECurves = WEAVE_CONFIG_DEFAULT_CASE_ALLOWED_CURVES;
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    InitiatorResumeCASESessions = true;
+#endif
+#endif
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    mResumptionCache.Init();
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     ResponderAllowedCASEConfigs = CASE::kCASEAllowedConfig_Config2|CASE::kCASEAllowedConfig_Config1;
     ResponderAllowedCASECurves = WEAVE_CONFIG_DEFAULT_CASE_ALLOWED_CURVES;
 #endif
-#if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
-    mTAKEEngine = NULL;
-#endif
 #if WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
     mDefaultTAKETokenAuthDelegate = NULL;
 #endif
@@ -122,7 +119,6 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     mDefaultTAKEChallengerAuthDelegate = NULL;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    mKeyExport = NULL;
     InitiatorKeyExportConfig = KeyExport::kKeyExportConfig_Config1;
     InitiatorAllowedKeyExportConfigs = KeyExport::kKeyExportSupportedConfig_All;
 #endif
@@ -135,16 +131,55 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR || WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     mDefaultKeyExportDelegate = NULL;
 #endif
-    mStartSecureSession_OnComplete = NULL;
-    mStartSecureSession_OnError = NULL;
-    mStartSecureSession_ReqState = NULL;
-    mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
-    mSessionKeyId = WeaveKeyId::kNone;
-    mEncType = kWeaveEncryptionType_None;
+
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        SessionContext *session = &mSessionContexts[i];
+
+        session->mSecMgr = this;
+        session->mState = kState_Idle;
+        session->mEC = NULL;
+        session->mCon = NULL;
+#if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
+        session->mPASEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+        session->mCASEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
+        session->mTAKEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
+        session->mKeyExport = NULL;
+#endif
+        session->mStartSecureSession_OnComplete = NULL;
+        session->mStartSecureSession_OnError = NULL;
+        session->mStartSecureSession_ReqState = NULL;
+        session->mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
+        session->mSessionKeyId = WeaveKeyId::kNone;
+        session->mEncType = kWeaveEncryptionType_None;
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+        session->mCryptoPending = false;
+        session->mCryptoJob.Work = DoCASEStep;
+        session->mCryptoJob.OnComplete = HandleCASEStepComplete;
+        session->mCryptoJob.AppState = session;
+        session->mCASEStep.MsgBuf = NULL;
+        session->mCASEStep.RespMsgBuf = NULL;
+#endif
+    }
 
     mFlags = 0;
 
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    err = CryptoOffload::Init();
+    SuccessOrExit(err);
+#endif
+
     err = ExchangeManager->RegisterUnsolicitedMessageHandler(kWeaveProfile_Security, HandleUnsolicitedMessage, this);
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    if (err != WEAVE_NO_ERROR)
+        CryptoOffload::Shutdown();
+#endif
     SuccessOrExit(err);
 
     aExchangeMgr.MessageLayer->SecurityMgr = this;
@@ -174,7 +209,16 @@ WEAVE_ERROR WeaveSecurityManager::Shutdown(void)
 
         // TODO: clean-up in-progress session establishment
 
-        Reset();
+        for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+            Reset(&mSessionContexts[i]);
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        mResumptionCache.Clear();
+#endif
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+        CryptoOffload::Shutdown();
+#endif
 
         State = kState_NotInitialized;
     }
@@ -182,11 +226,30 @@ WEAVE_ERROR WeaveSecurityManager::Shutdown(void)
     return WEAVE_NO_ERROR;
 }
 
+/**
+ * Set State from the states of the session contexts: idle when none
+ * is in progress, else the state of the first that is.
+ */
+void WeaveSecurityManager::UpdateState(void)
+{
+    State = kState_Idle;
+
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessionContexts[i].mState != kState_Idle)
+        {
+            State = mSessionContexts[i].mState;
+            break;
+        }
+    }
+}
+
 void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session;
 
     // Handle Key Error Messages.
     if (profileId == kWeaveProfile_Security && msgType == kMsgType_KeyError)
@@ -198,8 +261,9 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
         ExitNow();
     }
 
-    // Verify that we don't already have a session establishment in progress.
-    VerifyOrExit(secMgr->State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify that we have room for another session establishment.
+    session = secMgr->GetIdleSessionContext();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -223,7 +287,7 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
         // PASE is not supported over WRMP.
         VerifyOrExit(ec->Con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-        secMgr->HandlePASESessionStart(ec, pktInfo, msgInfo, msgBuf);
+        secMgr->HandlePASESessionStart(session, ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
         ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
@@ -234,7 +298,18 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
     else if (profileId == kWeaveProfile_Security && msgType == kMsgType_CASEBeginSessionRequest)
     {
 #if WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-        secMgr->HandleCASESessionStart(ec, pktInfo, msgInfo, msgBuf);
+        secMgr->HandleCASESessionStart(session, ec, pktInfo, msgInfo, msgBuf);
+        msgBuf = NULL;
+#else
+        ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
+#endif
+    }
+
+    // Handle messages that resume an earlier CASE session...
+    else if (profileId == kWeaveProfile_Security && msgType == kMsgType_CASEResumeSessionRequest)
+    {
+#if WEAVE_CONFIG_ENABLE_CASE_RESPONDER && WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        secMgr->HandleCASEResumeSessionStart(session, ec, msgBuf);
         msgBuf = NULL;
 #else
         ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
@@ -249,7 +324,7 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
         // TAKE is not supported over WRMP.
         VerifyOrExit(ec->Con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-        secMgr->HandleTAKESessionStart(ec, pktInfo, msgInfo, msgBuf);
+        secMgr->HandleTAKESessionStart(session, ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
         ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
@@ -260,7 +335,7 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
     else if (profileId == kWeaveProfile_Security && msgType == kMsgType_KeyExportRequest)
     {
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
-        secMgr->HandleKeyExportRequest(ec, pktInfo, msgInfo, msgBuf);
+        secMgr->HandleKeyExportRequest(session, ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
         ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
@@ -307,13 +382,15 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey *sessionKey;
+    SessionContext *session;
     bool clearStateOnError = false;
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify there is room for another session establishment.
+    session = GetIdleSessionContext();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -328,14 +405,15 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     // PASE is not yet supported over WRMP.
     VerifyOrExit(con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    State = kState_PASEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = kWeaveEncryptionType_AES128CTRSHA1;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    session->mState = kState_PASEInProgress;
+    UpdateState();
+    session->mRequestedAuthMode = requestedAuthMode;
+    session->mEncType = kWeaveEncryptionType_AES128CTRSHA1;
+    session->mCon = con;
+    session->mStartSecureSession_OnComplete = onComplete;
+    session->mStartSecureSession_OnError = onError;
+    session->mStartSecureSession_ReqState = reqState;
+    session->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -345,10 +423,10 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     err = FabricState->AllocSessionKey(con->PeerNodeId, WeaveKeyId::kNone, con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    session->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(session, session->mCon->PeerNodeId, session->mCon->PeerAddr, session->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize Weave platform memory.
@@ -356,57 +434,58 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     SuccessOrExit(err);
 
     // Allocate and initialize PASE engine object.
-    mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    session->mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
+    VerifyOrExit(session->mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mPASEEngine->Init();
 
     // Initialize PASE password if provided.
     if (pw != NULL)
     {
-        mPASEEngine->Pw = pw;
-        mPASEEngine->PwLen = pwLen;
+        session->mPASEEngine->Pw = pw;
+        session->mPASEEngine->PwLen = pwLen;
     }
 
     // Start PASE session.
-    StartPASESession();
+    StartPASESession(session);
 
 exit:
     if (err != WEAVE_NO_ERROR && clearStateOnError)
     {
-        if (mSessionKeyId != WeaveKeyId::kNone)
-            FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        if (session->mSessionKeyId != WeaveKeyId::kNone)
+            FabricState->RemoveSessionKey(session->mSessionKeyId, con->PeerNodeId);
 
-        Reset();
+        Reset(session);
     }
 
     return err;
 }
 
-void WeaveSecurityManager::StartPASESession(void)
+void WeaveSecurityManager::StartPASESession(SessionContext *session)
 {
     WEAVE_ERROR err;
 
-    err = SendPASEInitiatorStep1(kPASEConfig_ConfigDefault);
+    err = SendPASEInitiatorStep1(session, kPASEConfig_ConfigDefault);
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived = HandlePASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    session->mEC->OnMessageReceived = HandlePASEMessageInitiator;
+    session->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall PASE duration.
-    StartSessionTimer();
+    StartSessionTimer(session);
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
+        HandleSessionError(session, err, NULL);
 }
 
 void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the PASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -423,7 +502,7 @@ void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const
             PacketBuffer::Free(msgBuf);
             msgBuf = NULL;
 
-            err = secMgr->SendPASEInitiatorStep1(kPASEConfig_Config1);
+            err = secMgr->SendPASEInitiatorStep1(session, kPASEConfig_Config1);
             ExitNow();
         }
         else
@@ -442,56 +521,56 @@ void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const
     case kMsgType_PASEResponderReconfigure:
         uint32_t newConfig;
 
-        err = secMgr->ProcessPASEResponderReconfigure(msgBuf, newConfig);
+        err = secMgr->ProcessPASEResponderReconfigure(session, msgBuf, newConfig);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendPASEInitiatorStep1(newConfig);
+        err = secMgr->SendPASEInitiatorStep1(session, newConfig);
         SuccessOrExit(err);
 
         break;
 
     case kMsgType_PASEResponderStep1:
 
-        err = secMgr->ProcessPASEResponderStep1(msgBuf);
+        err = secMgr->ProcessPASEResponderStep1(session, msgBuf);
         SuccessOrExit(err);
 
         break;
 
     case kMsgType_PASEResponderStep2:
 
-        err = secMgr->ProcessPASEResponderStep2(msgBuf);
+        err = secMgr->ProcessPASEResponderStep2(session, msgBuf);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendPASEInitiatorStep2();
+        err = secMgr->SendPASEInitiatorStep2(session);
         SuccessOrExit(err);
 
-        if (secMgr->mPASEEngine->State == WeavePASEEngine::kState_InitiatorDone)
+        if (session->mPASEEngine->State == WeavePASEEngine::kState_InitiatorDone)
         {
-            err = secMgr->HandleSessionEstablished();
+            err = secMgr->HandleSessionEstablished(session);
             SuccessOrExit(err);
 
-            secMgr->HandleSessionComplete();
+            secMgr->HandleSessionComplete(session);
         }
 
         break;
 
     case kMsgType_PASEResponderKeyConfirm:
 
-        err = secMgr->ProcessPASEResponderKeyConfirm(msgBuf);
+        err = secMgr->ProcessPASEResponderKeyConfirm(session, msgBuf);
         SuccessOrExit(err);
 
-        err = secMgr->HandleSessionEstablished();
+        err = secMgr->HandleSessionEstablished(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
 
         break;
 
@@ -503,13 +582,13 @@ void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep1(uint32_t paseConfig)
+WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep1(SessionContext *session, uint32_t paseConfig)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -520,16 +599,16 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep1(uint32_t paseConfig)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Extract the password source from the requested auth mode.
-    pwSource = PasswordSourceFromAuthMode(mRequestedAuthMode);
+    pwSource = PasswordSourceFromAuthMode(session->mRequestedAuthMode);
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, mEC->PeerNodeId, mSessionKeyId, kWeaveEncryptionType_AES128CTRSHA1, pwSource, FabricState, true);
+    err = session->mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, session->mEC->PeerNodeId, session->mSessionKeyId, kWeaveEncryptionType_AES128CTRSHA1, pwSource, FabricState, true);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -540,12 +619,12 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderReconfigure(PacketBuffer* msgBuf, uint32_t &newConfig)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderReconfigure(SessionContext *session, PacketBuffer* msgBuf, uint32_t &newConfig)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's reconfigure message.
-    err = mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
+    err = session->mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
     SuccessOrExit(err);
 
 exit:
@@ -553,13 +632,13 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep1(PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep1(SessionContext *session, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep1(msgBuf);
+    err = session->mPASEEngine->ProcessResponderStep1(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -568,13 +647,13 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep2(PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep2(SessionContext *session, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep2(msgBuf);
+    err = session->mPASEEngine->ProcessResponderStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -583,7 +662,7 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep2(void)
+WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep2(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -594,12 +673,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep2(void)
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep2(msgBuf);
+    err = session->mPASEEngine->GenerateInitiatorStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -610,12 +689,12 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderKeyConfirm(PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderKeyConfirm(SessionContext *session, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's key confirmation message.
-    err = mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
+    err = session->mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -635,14 +714,16 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
 
 #if WEAVE_CONFIG_ENABLE_PASE_RESPONDER
 
-void WeaveSecurityManager::HandlePASESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
+void WeaveSecurityManager::HandlePASESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Setup state for the new PASE exchange.
-    State = kState_PASEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    session->mState = kState_PASEInProgress;
+    UpdateState();
+    session->mEC = ec;
+    session->mCon = ec->Con;
+    ec->AppState = session;
     ec->OnMessageReceived = HandlePASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -652,18 +733,18 @@ void WeaveSecurityManager::HandlePASESessionStart(ExchangeContext *ec, const IPP
     // TODO: rate limit unsuccessful PASE exchanges (WEAVE_ERROR_SECURITY_RATE_LIMIT_EXCEEDED)
 
     // Time limit overall PASE duration.
-    StartSessionTimer();
+    StartSessionTimer(session);
 
     // Initialize Weave Platform Memory.
     err = Platform::Security::MemoryInit();
     SuccessOrExit(err);
 
     // Prepare PASE engine and start session
-    mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    session->mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
+    VerifyOrExit(session->mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mPASEEngine->Init();
 
-    err = ProcessPASEInitiatorStep1(ec, msgBuf);
+    err = ProcessPASEInitiatorStep1(session, ec, msgBuf);
 
     // Free the received message buffer so that it can be reused to send the outgoing messages.
     PacketBuffer::Free(msgBuf);
@@ -672,20 +753,20 @@ void WeaveSecurityManager::HandlePASESessionStart(ExchangeContext *ec, const IPP
     // Check if ProcessPASEInitiatorStep1 generated Reconfiguration Request
     if (err == WEAVE_ERROR_PASE_RECONFIGURE_REQUIRED)
     {
-        err = SendPASEResponderReconfigure();
+        err = SendPASEResponderReconfigure(session);
         SuccessOrExit(err);
 
         // Reset state.
-        Reset();
+        Reset(session);
     }
     else
     {
         SuccessOrExit(err);
 
-        err = SendPASEResponderStep1();
+        err = SendPASEResponderStep1(session);
         SuccessOrExit(err);
 
-        err = SendPASEResponderStep2();
+        err = SendPASEResponderStep2(session);
         SuccessOrExit(err);
     }
 
@@ -693,16 +774,17 @@ exit:
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
+        HandleSessionError(session, err, NULL);
 }
 
 void WeaveSecurityManager::HandlePASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the PASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -713,7 +795,7 @@ void WeaveSecurityManager::HandlePASEMessageResponder(ExchangeContext *ec, const
     VerifyOrExit(profileId == kWeaveProfile_Security && msgType == kMsgType_PASEInitiatorStep2,
                  err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
 
-    err = secMgr->ProcessPASEInitiatorStep2(msgBuf);
+    err = secMgr->ProcessPASEInitiatorStep2(session, msgBuf);
     SuccessOrExit(err);
 
     // Free the received message buffer so that it can be reused to send the outgoing messages.
@@ -721,37 +803,37 @@ void WeaveSecurityManager::HandlePASEMessageResponder(ExchangeContext *ec, const
     msgBuf = NULL;
 
     // If performing key confirmation send a responder key confirmation message.
-    if (secMgr->mPASEEngine->PerformKeyConfirmation)
+    if (session->mPASEEngine->PerformKeyConfirmation)
     {
-        err = secMgr->SendPASEResponderKeyConfirm();
+        err = secMgr->SendPASEResponderKeyConfirm(session);
         SuccessOrExit(err);
     }
 
     // If we've successfully establish a session, go perform the appropriate actions.
-    if (secMgr->mPASEEngine->State == WeavePASEEngine::kState_ResponderDone)
+    if (session->mPASEEngine->State == WeavePASEEngine::kState_ResponderDone)
     {
-        err = secMgr->HandleSessionEstablished();
+        err = secMgr->HandleSessionEstablished(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
     }
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep1(ExchangeContext *ec, PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep1(SessionContext *session, ExchangeContext *ec, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey *sessionKey;
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
+    err = session->mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -761,21 +843,21 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep1(ExchangeContext *ec,
     //
     // If the initiator has proposed a key id that already exists, make sure we don't remove the
     // existing key during the error clean-up process.
-    err = FabricState->AllocSessionKey(ec->PeerNodeId, mPASEEngine->SessionKeyId, ec->Con, sessionKey);
+    err = FabricState->AllocSessionKey(ec->PeerNodeId, session->mPASEEngine->SessionKeyId, ec->Con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(false);
     sessionKey->SetRemoveOnIdle(false); // TODO FUTURE: Set this to true when support for PASE over WRM is implemented.
 
     // Save the proposed session key id and encryption type.
-    mSessionKeyId = mPASEEngine->SessionKeyId;
-    mEncType = mPASEEngine->EncryptionType;
+    session->mSessionKeyId = session->mPASEEngine->SessionKeyId;
+    session->mEncType = session->mPASEEngine->EncryptionType;
 
 exit:
     return err;
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEResponderReconfigure(void)
+WEAVE_ERROR WeaveSecurityManager::SendPASEResponderReconfigure(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -785,11 +867,11 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderReconfigure(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate PASE reconfigure message.
-    err = mPASEEngine->GenerateResponderReconfigure(msgBuf);
+    err = session->mPASEEngine->GenerateResponderReconfigure(msgBuf);
     SuccessOrExit(err);
 
     // Send PASE reconfigure message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -800,7 +882,7 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep1(void)
+WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep1(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -811,12 +893,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep1(void)
 
     // Generate PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep1(msgBuf);
+    err = session->mPASEEngine->GenerateResponderStep1(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -827,7 +909,7 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep2(void)
+WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep2(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -838,12 +920,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep2(void)
 
     // Generate PASE step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep2(msgBuf);
+    err = session->mPASEEngine->GenerateResponderStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -854,13 +936,13 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep2(PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep2(SessionContext *session, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the initiator's step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep2(msgBuf);
+    err = session->mPASEEngine->ProcessInitiatorStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -869,7 +951,7 @@ exit:
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendPASEResponderKeyConfirm(void)
+WEAVE_ERROR WeaveSecurityManager::SendPASEResponderKeyConfirm(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -879,11 +961,11 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderKeyConfirm(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate and encode a key confirmation message.
-    err = mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
+    err = session->mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // Send a key confirmation message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -895,6 +977,66 @@ exit:
 
 #endif // WEAVE_CONFIG_ENABLE_PASE_RESPONDER
 
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+
+/**
+ * Run a time-consuming CASE engine step, then pass its result to a completion method.
+ *
+ * When #WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD is enabled the step runs on a crypto
+ * worker thread and the completion method is called later, on the Weave thread.
+ * Otherwise both are called before this method returns.
+ *
+ * @param[in] session       The session context whose CASE engine runs the step.
+ * @param[in] step          The step state; this must be the session's own when offloading.
+ * @param[in] stepFunct     The step itself.
+ * @param[in] onComplete    The method that carries on with the handshake.
+ */
+void WeaveSecurityManager::RunCASEStep(SessionContext *session, CASEStepContext &step, CASEStepFunct stepFunct,
+                                       CASEStepCompleteFunct onComplete)
+{
+    WEAVE_ERROR err;
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    VerifyOrDie(&step == &session->mCASEStep);
+
+    session->mCASEStepFunct = stepFunct;
+    session->mCASEStepComplete = onComplete;
+
+    err = CryptoOffload::Post(*mSystemLayer, session->mCryptoJob);
+    if (err == WEAVE_NO_ERROR)
+    {
+        session->mCryptoPending = true;
+        return;
+    }
+#else
+    err = stepFunct(session, step);
+#endif
+
+    (this->*onComplete)(session, step, err);
+}
+
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
+WEAVE_ERROR WeaveSecurityManager::DoCASEStep(void *appState)
+{
+    SessionContext *session = (SessionContext *)appState;
+
+    return session->mCASEStepFunct(session, session->mCASEStep);
+}
+
+void WeaveSecurityManager::HandleCASEStepComplete(void *appState, WEAVE_ERROR err)
+{
+    SessionContext *session = (SessionContext *)appState;
+
+    session->mCryptoPending = false;
+
+    (session->mSecMgr->*session->mCASEStepComplete)(session, session->mCASEStep, err);
+}
+
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
 
 /**
@@ -926,6 +1068,7 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey *sessionKey = NULL;
+    SessionContext *session;
     bool clearStateOnError = false;
     bool isSharedSession = (terminatingNodeId != kNodeIdNotSpecified);
     const uint8_t encType = kWeaveEncryptionType_AES128CTRSHA1; // Only one encryption type supported for now.
@@ -953,7 +1096,7 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
             // the concurrent request to wait until the session is fully established.
             //
             // If the located shared session is NOT in the process of being established...
-            if (State != kState_CASEInProgress || mEC->PeerNodeId != terminatingNodeId || mSessionKeyId != sessionKey->MsgEncKey.KeyId)
+            if (FindCASESessionContext(sessionKey->MsgEncKey.KeyId, terminatingNodeId) == NULL)
             {
                 // Add a new end node to the list of end nodes associated with the session.
                 err = FabricState->AddSharedSessionEndNode(sessionKey, peerNodeId);
@@ -967,11 +1110,15 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
 
                 ExitNow();
             }
+
+            // Otherwise ask the caller to wait for the establishment to complete.
+            ExitNow(err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
         }
     }
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify there is room for another session establishment.
+    session = GetIdleSessionContext();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -979,14 +1126,15 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
             ExitNow(err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
         });
 
-    State = kState_CASEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = encType;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    session->mState = kState_CASEInProgress;
+    UpdateState();
+    session->mRequestedAuthMode = requestedAuthMode;
+    session->mEncType = encType;
+    session->mCon = con;
+    session->mStartSecureSession_OnComplete = onComplete;
+    session->mStartSecureSession_OnError = onError;
+    session->mStartSecureSession_ReqState = reqState;
+    session->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after that would require state clearing in case of error.
     clearStateOnError = true;
@@ -998,7 +1146,7 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
     sessionKey->SetSharedSession(isSharedSession);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    session->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // If requested session is shared.
     if (isSharedSession)
@@ -1009,7 +1157,7 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
     }
 
     // Create a new exchange context.
-    err = NewSessionExchange((isSharedSession ? terminatingNodeId : peerNodeId), peerAddr, peerPort);
+    err = NewSessionExchange(session, (isSharedSession ? terminatingNodeId : peerNodeId), peerAddr, peerPort);
     SuccessOrExit(err);
 
     // Initialize Weave Platform Memory.
@@ -1017,29 +1165,37 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
     SuccessOrExit(err);
 
     // Allocate and Initialize CASE Engine object
-    mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    session->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(session->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mCASEEngine->Init();
 
     // Initialize CASE Authentication Delegate
     if (authDelegate == NULL)
         authDelegate = mDefaultAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = WEAVE_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = authDelegate;
+    session->mCASEEngine->AuthDelegate = authDelegate;
 
-    // Set the allowed CASE configs and ECDH curves.
-    mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
+    InitCASEInitiatorEngine(session);
 
-    // Set the expected peer certificate type based on the requested authentication mode.
-    mCASEEngine->SetCertType(CertTypeFromAuthMode(requestedAuthMode));
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // If a resumption secret is held for the peer, and the peer authenticated with a certificate of
+    // the requested type, resume the earlier session rather than repeating the full CASE exchange.
+    if (InitiatorResumeCASESessions)
+    {
+        const CASE::SessionResumptionInfo *resumption =
+            mResumptionCache.FindByPeer(session->mEC->PeerNodeId, true, GetCASEResumptionTime());
+        uint8_t requiredCertType = CertTypeFromAuthMode(requestedAuthMode);
 
-#if WEAVE_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+        if (resumption != NULL && (requiredCertType == kCertType_NotSpecified || requiredCertType == resumption->CertType))
+        {
+            StartCASEResumption(session, *resumption);
+            ExitNow();
+        }
+    }
 #endif
 
     // Start CASE Session using specified initiator parameters.
-    StartCASESession(InitiatorCASEConfig, InitiatorCASECurveId);
+    StartCASESession(session, InitiatorCASEConfig, InitiatorCASECurveId);
 
 exit:
     if (err != WEAVE_NO_ERROR && clearStateOnError)
@@ -1047,153 +1203,193 @@ exit:
         if (sessionKey != NULL)
             FabricState->RemoveSessionKey(sessionKey);
 
-        Reset();
+        Reset(session);
     }
 
     return err;
 }
 
-void WeaveSecurityManager::StartCASESession(uint32_t config, uint32_t curveId)
+/**
+ * Set the protocol options of a session's CASE engine for initiating a full CASE exchange.
+ */
+void WeaveSecurityManager::InitCASEInitiatorEngine(SessionContext *session)
 {
-    WEAVE_ERROR err;
-    PacketBuffer * msgBuf = NULL;
-    uint16_t sendFlags = 0;
+    // Set the allowed CASE configs and ECDH curves.
+    session->mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
+    session->mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
+
+    // Set the expected peer certificate type based on the requested authentication mode.
+    session->mCASEEngine->SetCertType(CertTypeFromAuthMode(session->mRequestedAuthMode));
+
+#if WEAVE_CONFIG_SECURITY_TEST_MODE
+    session->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+#endif
+}
+
+void WeaveSecurityManager::StartCASESession(SessionContext *session, uint32_t config, uint32_t curveId)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    CASEStepContext &step = session->mCASEStep;
+#else
+    CASEStepContext step;
+#endif
 
     // Allocate a buffer to hold the Begin Session message.
-    msgBuf = PacketBuffer::New();
-    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    step.MsgBuf = PacketBuffer::New();
+    step.RespMsgBuf = NULL;
+    VerifyOrExit(step.MsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    step.ReqCtx.Reset();
+    step.ReqCtx.SetIsInitiator(true);
+    step.ReqCtx.PeerNodeId = session->mEC->PeerNodeId;
+    step.ReqCtx.ProtocolConfig = config;
+    session->mCASEEngine->SetAlternateConfigs(step.ReqCtx);
+    step.ReqCtx.CurveId = curveId;
+    session->mCASEEngine->SetAlternateCurves(step.ReqCtx);
+    step.ReqCtx.SetPerformKeyConfirm(true);
+    step.ReqCtx.SessionKeyId = session->mSessionKeyId;
+    step.ReqCtx.EncryptionType = session->mEncType;
+
+    // Generate the CASE Begin Session message, then send it.
+    RunCASEStep(session, step, GenerateCASEBeginSessionRequest, &WeaveSecurityManager::SendCASEBeginSessionRequest);
 
-    // Generate the CASE Begin Session message.
-    {
-        CASE::BeginSessionRequestContext reqCtx;
+exit:
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(session, err, NULL);
+}
 
-        reqCtx.Reset();
-        reqCtx.SetIsInitiator(true);
-        reqCtx.PeerNodeId = mEC->PeerNodeId;
-        reqCtx.ProtocolConfig = config;
-        mCASEEngine->SetAlternateConfigs(reqCtx);
-        reqCtx.CurveId = curveId;
-        mCASEEngine->SetAlternateCurves(reqCtx);
-        reqCtx.SetPerformKeyConfirm(true);
-        reqCtx.SessionKeyId = mSessionKeyId;
-        reqCtx.EncryptionType = mEncType;
+WEAVE_ERROR WeaveSecurityManager::GenerateCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step)
+{
+    WEAVE_ERROR err;
 
-        Platform::Security::OnTimeConsumingCryptoStart();
-        err = mCASEEngine->GenerateBeginSessionRequest(reqCtx, msgBuf);
-        Platform::Security::OnTimeConsumingCryptoDone();
-        SuccessOrExit(err);
-    }
+    Platform::Security::OnTimeConsumingCryptoStart();
+    err = session->mCASEEngine->GenerateBeginSessionRequest(step.ReqCtx, step.MsgBuf);
+    Platform::Security::OnTimeConsumingCryptoDone();
+
+    return err;
+}
+
+void WeaveSecurityManager::SendCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err)
+{
+    PacketBuffer * msgBuf = step.MsgBuf;
+    uint16_t sendFlags = 0;
+
+    step.MsgBuf = NULL;
+    SuccessOrExit(err);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (session->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send the message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived = HandleCASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    session->mEC->OnMessageReceived = HandleCASEMessageInitiator;
+    session->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall CASE duration.
-    StartSessionTimer();
+    StartSessionTimer(session);
 
 exit:
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
+        HandleSessionError(session, err, NULL);
 }
 
 void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
-    uint16_t sendFlags = 0;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    CASEStepContext &step = session->mCASEStep;
+#else
+    CASEStepContext step;
+#endif
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the CASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
     if (profileId == kWeaveProfile_Common && msgType == kMsgType_StatusReport)
+    {
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        // If the responder turned down an attempt to resume an earlier session, for any reason other
+        // than being busy, forget the resumption secret and fall back to a full CASE exchange.
+        if (session->mCASEEngine->State == WeaveCASEEngine::kState_ResumeRequestGenerated)
+        {
+            StatusReport statusReport;
+
+            if (StatusReport::parse(msgBuf, statusReport) == WEAVE_NO_ERROR &&
+                !(statusReport.mProfileId == kWeaveProfile_Common && statusReport.mStatusCode == kStatus_Busy))
+            {
+                err = secMgr->FallBackToFullCASE(session, ec);
+                ExitNow();
+            }
+        }
+#endif
+
         ExitNow(err = WEAVE_ERROR_STATUS_REPORT_RECEIVED);
+    }
+
+    // Drop anything else that arrives while the previous message is still being processed.
+    if (IsCryptoStepPending(session))
+        ExitNow();
 
     // All other messages must be part of the Security profile.
     VerifyOrExit(profileId == kWeaveProfile_Security, err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // If the message is a ResumeSessionResponse...
+    if (msgType == kMsgType_CASEResumeSessionResponse)
+    {
+        // Deriving the keys of a resumed session takes no time-consuming crypto, so the response is processed here.
+        err = session->mCASEEngine->ProcessResumeSessionResponse(msgBuf);
+
+        // A responder that does not confirm the keys no longer shares the resumption secret.
+        if (err != WEAVE_NO_ERROR)
+            secMgr->mResumptionCache.Remove(ec->PeerNodeId, true);
+        SuccessOrExit(err);
+
+        // Confirm the keys to the responder, which only establishes the session once it has the confirmation.
+        err = secMgr->FinishCASEInitiator(session);
+        ExitNow();
+    }
+#endif
+
     // If the message is a BeginSessionResponse...
     if (msgType == kMsgType_CASEBeginSessionResponse)
     {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session response.
-        err = secMgr->mEC->WRMPFlushAcks();
+        err = session->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
 #endif
 
-        // Decode and process the BeginSessionResponse.
-        {
-            CASE::BeginSessionResponseContext respCtx;
-
-            respCtx.Reset();
-            respCtx.SetIsInitiator(true);
-            respCtx.PeerNodeId = ec->PeerNodeId;
-            respCtx.MsgInfo = msgInfo;
-
-            Platform::Security::OnTimeConsumingCryptoStart();
-            err = secMgr->mCASEEngine->ProcessBeginSessionResponse(msgBuf, respCtx);
-            Platform::Security::OnTimeConsumingCryptoDone();
-            SuccessOrExit(err);
-        }
-
-        // Release the buffer containing the response.
-        PacketBuffer::Free(msgBuf);
+        // Keep the response, and a copy of its message info, for as long as the step runs.
+        step.MsgBuf = msgBuf;
+        step.RespMsgBuf = NULL;
         msgBuf = NULL;
+        step.MsgInfo = *msgInfo;
+        step.MsgInfo.InPacketInfo = NULL;
 
-        // If performing key confirmation...
-        if (secMgr->mCASEEngine->PerformingKeyConfirm())
-        {
-            // Generate and encode an InitiatorKeyConfirm message.
-            msgBuf = PacketBuffer::New();
-            VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
-            err = secMgr->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
-            SuccessOrExit(err);
-
-#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            if (secMgr->mCon == NULL)
-            {
-                sendFlags = ExchangeContext::kSendFlag_RequestAck;
-            }
-#endif
-
-            // Send the InitiatorKeyConfirm message to the peer.
-            err = secMgr->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
-            msgBuf = NULL;
-            SuccessOrExit(err);
-        }
-
-        // Initialize the newly established security session.
-        err = secMgr->HandleSessionEstablished();
-        SuccessOrExit(err);
+        step.RespCtx.Reset();
+        step.RespCtx.SetIsInitiator(true);
+        step.RespCtx.PeerNodeId = ec->PeerNodeId;
+        step.RespCtx.MsgInfo = &step.MsgInfo;
 
-#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-        // Complete the session when any of these is true:
-        //     - session establishment was done over a Weave connection
-        //     - key confirmation wasn't required
-        // For WRMP when key confirmation is required, the session will be completed
-        // on one of these events:
-        //     - Received Ack from the peer for the last message on this exchange (CASEInitiatorKeyConfirm)
-        //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-        if (secMgr->mCon || !secMgr->mCASEEngine->PerformingKeyConfirm())
-#endif
-        {
-            secMgr->HandleSessionComplete();
-        }
+        // Decode and process the BeginSessionResponse, then confirm the session key.
+        secMgr->RunCASEStep(session, step, ProcessCASEBeginSessionResponse,
+                            &WeaveSecurityManager::HandleCASEBeginSessionResponseProcessed);
     }
 
     // Otherwise, if the message is a Reconfigure...
@@ -1202,7 +1398,7 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         // Process the reconfigure message.  If this proposed alternate configuration is not acceptable,
         // the call will fail with an error.
         CASE::ReconfigureContext reconfCtx;
-        err = secMgr->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
+        err = session->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
         SuccessOrExit(err);
 
         // Release the buffer containing the response.
@@ -1212,11 +1408,11 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         // Create a new exchange context for the new CASE session.  This will result in the old exchange context
         // being closed. (NOTE: We cannot re-use the initial exchange for the new CASE session because the peer
         // believes the exchange ended when the Reconfigure message was sent).
-        err = secMgr->NewSessionExchange(ec->PeerNodeId, ec->PeerAddr, ec->PeerPort);
+        err = secMgr->NewSessionExchange(session, ec->PeerNodeId, ec->PeerAddr, ec->PeerPort);
         SuccessOrExit(err);
 
         // Restart the CASE session using the peer's propose parameters.
-        secMgr->StartCASESession(reconfCtx.ProtocolConfig, reconfCtx.CurveId);
+        secMgr->StartCASESession(session, reconfCtx.ProtocolConfig, reconfCtx.CurveId);
     }
 
     // Fail if the message is unrecognized.
@@ -1225,11 +1421,166 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+}
+
+WEAVE_ERROR WeaveSecurityManager::ProcessCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step)
+{
+    WEAVE_ERROR err;
+
+    Platform::Security::OnTimeConsumingCryptoStart();
+    err = session->mCASEEngine->ProcessBeginSessionResponse(step.MsgBuf, step.RespCtx);
+    Platform::Security::OnTimeConsumingCryptoDone();
+
+    return err;
+}
+
+void WeaveSecurityManager::HandleCASEBeginSessionResponseProcessed(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err)
+{
+    // Release the buffer containing the response.
+    PacketBuffer::Free(step.MsgBuf);
+    step.MsgBuf = NULL;
+    SuccessOrExit(err);
+
+    err = FinishCASEInitiator(session);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(session, err, NULL);
+}
+
+/**
+ * Send the InitiatorKeyConfirm message, if key confirmation is being performed, and establish the
+ * session, once the initiator has processed the responder's session keys.
+ */
+WEAVE_ERROR WeaveSecurityManager::FinishCASEInitiator(SessionContext *session)
+{
+    WEAVE_ERROR err;
+    PacketBuffer * msgBuf = NULL;
+    uint16_t sendFlags = 0;
+
+    // If performing key confirmation...
+    if (session->mCASEEngine->PerformingKeyConfirm())
+    {
+        // Generate and encode an InitiatorKeyConfirm message.
+        msgBuf = PacketBuffer::New();
+        VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        err = session->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
+        SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        if (session->mCon == NULL)
+        {
+            sendFlags = ExchangeContext::kSendFlag_RequestAck;
+        }
+#endif
+
+        // Send the InitiatorKeyConfirm message to the peer.
+        err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
+        msgBuf = NULL;
+        SuccessOrExit(err);
+    }
+
+    // Initialize the newly established security session.
+    err = HandleSessionEstablished(session);
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    // Complete the session when any of these is true:
+    //     - session establishment was done over a Weave connection
+    //     - key confirmation wasn't required
+    // For WRMP when key confirmation is required, the session will be completed
+    // on one of these events:
+    //     - Received Ack from the peer for the last message on this exchange (CASEInitiatorKeyConfirm)
+    //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
+    if (session->mCon || !session->mCASEEngine->PerformingKeyConfirm())
+#endif
+    {
+        HandleSessionComplete(session);
+    }
+
+exit:
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+    return err;
+}
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ * Resume an earlier CASE session with the peer by sending a ResumeSessionRequest.
+ *
+ * @param[in] session       The session context, set up as for a full CASE exchange.
+ * @param[in] resumption    The resumption secret held for the peer.
+ */
+void WeaveSecurityManager::StartCASEResumption(SessionContext *session, const CASE::SessionResumptionInfo &resumption)
+{
+    WEAVE_ERROR err;
+    PacketBuffer *msgBuf;
+    uint16_t sendFlags = 0;
+
+    msgBuf = PacketBuffer::New();
+    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = session->mCASEEngine->GenerateResumeSessionRequest(resumption, session->mSessionKeyId, session->mEncType, msgBuf);
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    if (session->mCon == NULL)
+    {
+        sendFlags = ExchangeContext::kSendFlag_RequestAck;
+    }
+#endif
+
+    // Send the message.
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEResumeSessionRequest, msgBuf, sendFlags);
+    msgBuf = NULL;
+    SuccessOrExit(err);
+
+    session->mEC->OnMessageReceived = HandleCASEMessageInitiator;
+    session->mEC->OnConnectionClosed = HandleConnectionClosed;
+
+    // Time limit overall CASE duration.
+    StartSessionTimer(session);
+
+exit:
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(session, err, NULL);
+}
+
+/**
+ * Abandon an attempt to resume a CASE session which the responder turned down, and start a full
+ * CASE exchange with the same session key id instead.
+ */
+WEAVE_ERROR WeaveSecurityManager::FallBackToFullCASE(SessionContext *session, ExchangeContext *ec)
+{
+    WEAVE_ERROR err;
+
+    WeaveLogProgress(SecurityManager, "CASE resumption declined by peer; falling back to full CASE");
+
+    mResumptionCache.Remove(ec->PeerNodeId, true);
+
+    // The responder considers the exchange over once it has sent a status report, so the full CASE
+    // exchange uses a new one.
+    err = NewSessionExchange(session, ec->PeerNodeId, ec->PeerAddr, ec->PeerPort);
+    SuccessOrExit(err);
+
+    // Return the engine to its initial state, keeping the auth delegate.
+    session->mCASEEngine->Reset();
+    InitCASEInitiatorEngine(session);
+
+    StartCASESession(session, InitiatorCASEConfig, InitiatorCASECurveId);
+
+exit:
+    return err;
 }
 
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 #else // !WEAVE_CONFIG_ENABLE_CASE_INITIATOR
 
 WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_t peerNodeId, const IPAddress &peerAddr,
@@ -1244,18 +1595,20 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
 
 #if WEAVE_CONFIG_ENABLE_CASE_RESPONDER
 
-void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
+void WeaveSecurityManager::HandleCASESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err;
-    WeaveSessionKey * sessionKey;
-    CASE::BeginSessionRequestContext reqCtx;
-    CASE::ReconfigureContext reconfCtx;
-    PacketBuffer * respMsgBuf = NULL;
-    uint16_t sendFlags = 0;
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    CASEStepContext &step = session->mCASEStep;
+#else
+    CASEStepContext step;
+#endif
 
-    State = kState_CASEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    session->mState = kState_CASEInProgress;
+    UpdateState();
+    session->mEC = ec;
+    session->mCon = ec->Con;
+    ec->AppState = session;
     ec->OnMessageReceived = HandleCASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -1263,17 +1616,15 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     ec->AddRef();
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (session->mCon == NULL)
     {
-        mEC->OnAckRcvd = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        session->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        session->mEC->OnSendError = WRMPHandleSendError;
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session request.
-        err = mEC->WRMPFlushAcks();
+        err = session->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
-
-        sendFlags |= ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
@@ -1282,32 +1633,71 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     SuccessOrExit(err);
 
     // Allocate and initialize a CASE engine.
-    mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    session->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(session->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mCASEEngine->Init();
 
     // Since this session is being initiated by a remote node, use the default auth delegate.
     // Reject the request if no auth delegate has been set.
     VerifyOrExit(mDefaultAuthDelegate != NULL, err = WEAVE_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
+    session->mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
 
     // Set the allowed protocol options for a responder.
-    mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
-    mCASEEngine->SetResponderRequiresKeyConfirm(true);
+    session->mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
+    session->mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
+    session->mCASEEngine->SetResponderRequiresKeyConfirm(true);
 
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+    session->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
 #endif
 
-    // Process the BeginSessionRequest
-    reqCtx.Reset();
-    reqCtx.PeerNodeId = ec->PeerNodeId;
-    reqCtx.MsgInfo = msgInfo;
-    reconfCtx.Reset();
+    // Keep the request, and a copy of its message info, until the response has been generated.
+    step.MsgBuf = msgBuf;
+    step.RespMsgBuf = NULL;
+    msgBuf = NULL;
+    step.MsgInfo = *msgInfo;
+    step.MsgInfo.InPacketInfo = NULL;
+
+    step.ReqCtx.Reset();
+    step.ReqCtx.PeerNodeId = ec->PeerNodeId;
+    step.ReqCtx.MsgInfo = &step.MsgInfo;
+    step.ReconfCtx.Reset();
+
+    // Process the BeginSessionRequest, then answer it.
+    RunCASEStep(session, step, ProcessCASEBeginSessionRequest, &WeaveSecurityManager::HandleCASEBeginSessionRequestProcessed);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(session, err, NULL);
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+}
+
+WEAVE_ERROR WeaveSecurityManager::ProcessCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step)
+{
+    WEAVE_ERROR err;
+
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mCASEEngine->ProcessBeginSessionRequest(msgBuf, reqCtx, reconfCtx);
+    err = session->mCASEEngine->ProcessBeginSessionRequest(step.MsgBuf, step.ReqCtx, step.ReconfCtx);
     Platform::Security::OnTimeConsumingCryptoDone();
+
+    return err;
+}
+
+void WeaveSecurityManager::HandleCASEBeginSessionRequestProcessed(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err)
+{
+    ExchangeContext *ec = session->mEC;
+    WeaveSessionKey * sessionKey;
+    PacketBuffer * respMsgBuf = NULL;
+    uint16_t sendFlags = 0;
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    if (session->mCon == NULL)
+    {
+        sendFlags |= ExchangeContext::kSendFlag_RequestAck;
+    }
+#endif
+
     if (err != WEAVE_ERROR_CASE_RECONFIG_REQUIRED)
         SuccessOrExit(err);
 
@@ -1315,13 +1705,13 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     if (err == WEAVE_ERROR_CASE_RECONFIG_REQUIRED)
     {
         // Discard the request buffer.
-        PacketBuffer::Free(msgBuf);
-        msgBuf = NULL;
+        PacketBuffer::Free(step.MsgBuf);
+        step.MsgBuf = NULL;
 
         // Encode a CASE Reconfigure message into a new buffer.
         respMsgBuf = PacketBuffer::New();
         VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
-        err = reconfCtx.Encode(respMsgBuf);
+        err = step.ReconfCtx.Encode(respMsgBuf);
         SuccessOrExit(err);
 
         // Send the Reconfigure message to the peer.
@@ -1330,7 +1720,7 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
         SuccessOrExit(err);
 
         // Reset the security manager.
-        Reset();
+        Reset(session);
     }
 
     // Otherwise the proposed protocol parameters are acceptable, so...
@@ -1341,70 +1731,104 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
         // be bound to the connection, such that when the connection closes, the key is removed.
         // Set the RemoveOnIdle flag so that the session will be automatically removed after a period of
         // inactivity (note that this only applies to sessions that are NOT bound to connections).
-        err = FabricState->AllocSessionKey(ec->PeerNodeId, reqCtx.SessionKeyId, ec->Con, sessionKey);
+        err = FabricState->AllocSessionKey(ec->PeerNodeId, step.ReqCtx.SessionKeyId, ec->Con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(false);
         sessionKey->SetRemoveOnIdle(true);
 
         // Save the proposed session key id and encryption type.
-        mSessionKeyId = reqCtx.SessionKeyId;
-        mEncType = reqCtx.EncryptionType;
+        session->mSessionKeyId = step.ReqCtx.SessionKeyId;
+        session->mEncType = step.ReqCtx.EncryptionType;
 
         // Allocate a buffer to hold the encoded BeginSessionResponse message.
-        respMsgBuf = PacketBuffer::New();
-        VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        step.RespMsgBuf = PacketBuffer::New();
+        VerifyOrExit(step.RespMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        step.RespCtx.Reset();
+        step.RespCtx.PeerNodeId = ec->PeerNodeId;
+        step.RespCtx.MsgInfo = &step.MsgInfo;
+        step.RespCtx.ProtocolConfig = step.ReqCtx.ProtocolConfig;
+        step.RespCtx.CurveId = step.ReqCtx.CurveId;
+        step.RespCtx.SetPerformKeyConfirm(true);
+
+        // Generate the BeginSessionResponse message, then send it.
+        RunCASEStep(session, step, GenerateCASEBeginSessionResponse, &WeaveSecurityManager::SendCASEBeginSessionResponse);
+    }
 
-        // Generate the BeginSessionResponse message.
-        {
-            CASE::BeginSessionResponseContext respCtx;
-
-            respCtx.Reset();
-            respCtx.PeerNodeId = ec->PeerNodeId;
-            respCtx.MsgInfo = msgInfo;
-            respCtx.ProtocolConfig = reqCtx.ProtocolConfig;
-            respCtx.CurveId = reqCtx.CurveId;
-            respCtx.SetPerformKeyConfirm(true);
-
-            Platform::Security::OnTimeConsumingCryptoStart();
-            err = mCASEEngine->GenerateBeginSessionResponse(respCtx, respMsgBuf, reqCtx);
-            Platform::Security::OnTimeConsumingCryptoDone();
-            SuccessOrExit(err);
-        }
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        PacketBuffer::Free(step.MsgBuf);
+        step.MsgBuf = NULL;
+        PacketBuffer::Free(step.RespMsgBuf);
+        step.RespMsgBuf = NULL;
 
-        // Send the BeginSessionResponse message to the peer.
-        err = ec->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionResponse, respMsgBuf, sendFlags);
-        respMsgBuf = NULL;
-        SuccessOrExit(err);
+        HandleSessionError(session, err, NULL);
+    }
+    if (respMsgBuf != NULL)
+        PacketBuffer::Free(respMsgBuf);
+}
 
-        // Start a timer to limit the overall duration of session establishment.
-        StartSessionTimer();
+WEAVE_ERROR WeaveSecurityManager::GenerateCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step)
+{
+    WEAVE_ERROR err;
 
-        // If the CASE interaction is complete...
-        // (NOTE: this will only be true if the initiator didn't request key confirmation).
-        if (mCASEEngine->State == CASE::WeaveCASEEngine::kState_Complete)
-        {
-            // Initialize the new session.
-            err = HandleSessionEstablished();
-            SuccessOrExit(err);
+    Platform::Security::OnTimeConsumingCryptoStart();
+    err = session->mCASEEngine->GenerateBeginSessionResponse(step.RespCtx, step.RespMsgBuf, step.ReqCtx);
+    Platform::Security::OnTimeConsumingCryptoDone();
+
+    return err;
+}
+
+void WeaveSecurityManager::SendCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err)
+{
+    PacketBuffer * respMsgBuf = step.RespMsgBuf;
+    uint16_t sendFlags = 0;
+
+    // The request is no longer needed once the response has been generated.
+    PacketBuffer::Free(step.MsgBuf);
+    step.MsgBuf = NULL;
+    step.RespMsgBuf = NULL;
+    SuccessOrExit(err);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            // 1. Complete the session now if it was established over a connection.
-            // 2. For WRMP the session will be completed on one of these events:
-            //     - Received Ack from the peer for the last message on this exchange (CASEBeginSessionResponse)
-            //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-            if (mCon)
+    if (session->mCon == NULL)
+    {
+        sendFlags |= ExchangeContext::kSendFlag_RequestAck;
+    }
 #endif
-            {
-                HandleSessionComplete();
-            }
+
+    // Send the BeginSessionResponse message to the peer.
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionResponse, respMsgBuf, sendFlags);
+    respMsgBuf = NULL;
+    SuccessOrExit(err);
+
+    // Start a timer to limit the overall duration of session establishment.
+    StartSessionTimer(session);
+
+    // If the CASE interaction is complete...
+    // (NOTE: this will only be true if the initiator didn't request key confirmation).
+    if (session->mCASEEngine->State == CASE::WeaveCASEEngine::kState_Complete)
+    {
+        // Initialize the new session.
+        err = HandleSessionEstablished(session);
+        SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        // 1. Complete the session now if it was established over a connection.
+        // 2. For WRMP the session will be completed on one of these events:
+        //     - Received Ack from the peer for the last message on this exchange (CASEBeginSessionResponse)
+        //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
+        if (session->mCon)
+#endif
+        {
+            HandleSessionComplete(session);
         }
     }
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
-    if (msgBuf != NULL)
-        PacketBuffer::Free(msgBuf);
+        HandleSessionError(session, err, NULL);
     if (respMsgBuf != NULL)
         PacketBuffer::Free(respMsgBuf);
 }
@@ -1413,15 +1837,20 @@ void WeaveSecurityManager::HandleCASEMessageResponder(ExchangeContext *ec, const
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the CASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
     if (profileId == kWeaveProfile_Common && msgType == kMsgType_StatusReport)
         ExitNow(err = WEAVE_ERROR_STATUS_REPORT_RECEIVED);
 
+    // Drop anything else that arrives while the request is still being processed.
+    if (IsCryptoStepPending(session))
+        ExitNow();
+
     // Otherwise, the only other message expected is an InitiatorKeyConfirm.
     VerifyOrExit(profileId == kWeaveProfile_Security && msgType == kMsgType_CASEInitiatorKeyConfirm,
                  err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
@@ -1429,29 +1858,121 @@ void WeaveSecurityManager::HandleCASEMessageResponder(ExchangeContext *ec, const
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs to give sooner notification to the peer that current
     // CASE session establishment can be finalized.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = session->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
     // Process the initiator's key confirm message.
     // NOTE: No need to initialize crypto memory for this call.
-    err = secMgr->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
+    err = session->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // At this point the session is established.
-    err = secMgr->HandleSessionEstablished();
+    err = secMgr->HandleSessionEstablished(session);
     SuccessOrExit(err);
 
     // Complete the session and notify the user.
-    secMgr->HandleSessionComplete();
+    secMgr->HandleSessionComplete(session);
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+void WeaveSecurityManager::HandleCASEResumeSessionStart(SessionContext *session, ExchangeContext *ec, PacketBuffer *msgBuf)
+{
+    WEAVE_ERROR err;
+    const CASE::SessionResumptionInfo *resumption;
+    const uint8_t *resumptionId;
+    WeaveSessionKey *sessionKey;
+    PacketBuffer *respMsgBuf = NULL;
+    uint16_t sendFlags = 0;
+
+    session->mState = kState_CASEInProgress;
+    UpdateState();
+    session->mEC = ec;
+    session->mCon = ec->Con;
+    ec->AppState = session;
+    ec->OnMessageReceived = HandleCASEMessageResponder;
+    ec->OnConnectionClosed = HandleConnectionClosed;
+
+    // Ensure the exchange context stays around until we're done with it.
+    ec->AddRef();
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    if (session->mCon == NULL)
+    {
+        session->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        session->mEC->OnSendError = WRMPHandleSendError;
+        sendFlags = ExchangeContext::kSendFlag_RequestAck;
+    }
+#endif
+
+    // Initialize Weave Platform Memory
+    err = Platform::Security::MemoryInit();
+    SuccessOrExit(err);
+
+    // Allocate and initialize a CASE engine.
+    session->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(session->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mCASEEngine->Init();
+    session->mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
+
+    // Decode the request.
+    err = session->mCASEEngine->ProcessResumeSessionRequest(msgBuf, resumptionId);
+    SuccessOrExit(err);
+
+    PacketBuffer::Free(msgBuf);
+    msgBuf = NULL;
+
+    // Look up the resumption secret named by the initiator, which must have been established with
+    // the same peer.  If it is not found the initiator falls back to a full CASE exchange.
+    resumption = mResumptionCache.FindById(resumptionId, GetCASEResumptionTime());
+    VerifyOrExit(resumption != NULL && resumption->PeerNodeId == ec->PeerNodeId, err = WEAVE_ERROR_KEY_NOT_FOUND);
+
+    // Allocate an entry in the session key table using the key id proposed by the peer, as for a
+    // full CASE exchange.
+    err = FabricState->AllocSessionKey(ec->PeerNodeId, session->mCASEEngine->SessionKeyId, ec->Con, sessionKey);
+    SuccessOrExit(err);
+    sessionKey->SetLocallyInitiated(false);
+    sessionKey->SetRemoveOnIdle(true);
+
+    // Save the proposed session key id and encryption type.
+    session->mSessionKeyId = session->mCASEEngine->SessionKeyId;
+    session->mEncType = session->mCASEEngine->EncryptionType;
+
+    // Verify the initiator holds the resumption secret, derive the session keys and encode the response.
+    respMsgBuf = PacketBuffer::New();
+    VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    err = session->mCASEEngine->GenerateResumeSessionResponse(*resumption, respMsgBuf);
+    SuccessOrExit(err);
+
+    // Send the ResumeSessionResponse message to the peer.
+    err = ec->SendMessage(kWeaveProfile_Security, kMsgType_CASEResumeSessionResponse, respMsgBuf, sendFlags);
+    respMsgBuf = NULL;
+    SuccessOrExit(err);
+
+    // Start a timer to limit the overall duration of session establishment.
+    StartSessionTimer(session);
+
+    // The session is established once the initiator's InitiatorKeyConfirm message arrives, and so proves
+    // that the request is not a replay.  This is handled by HandleCASEMessageResponder().
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(session, err, NULL);
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+    if (respMsgBuf != NULL)
+        PacketBuffer::Free(respMsgBuf);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 #endif // WEAVE_CONFIG_ENABLE_CASE_RESPONDER
 
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR
@@ -1489,13 +2010,15 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     bool useSessionKeyID = encryptAuthPhase || encryptCommPhase;
+    SessionContext *session;
     bool clearStateOnError = false;
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify there is room for another session establishment.
+    session = GetIdleSessionContext();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -1509,14 +2032,15 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
     // Reject the request if no connection has been specified.
     VerifyOrExit(con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    State = kState_TAKEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = kWeaveEncryptionType_AES128CTRSHA1;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    session->mState = kState_TAKEInProgress;
+    UpdateState();
+    session->mRequestedAuthMode = requestedAuthMode;
+    session->mEncType = kWeaveEncryptionType_AES128CTRSHA1;
+    session->mCon = con;
+    session->mStartSecureSession_OnComplete = onComplete;
+    session->mStartSecureSession_OnError = onError;
+    session->mStartSecureSession_ReqState = reqState;
+    session->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -1529,11 +2053,11 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
         err = FabricState->AllocSessionKey(con->PeerNodeId, WeaveKeyId::kNone, con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(true);
-        mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+        session->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
     }
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(session, session->mCon->PeerNodeId, session->mCon->PeerAddr, session->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize Weave platform memory.
@@ -1541,49 +2065,49 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
     SuccessOrExit(err);
 
     // Allocate and initialize TAKE engine object.
-    mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    session->mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
+    VerifyOrExit(session->mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mTAKEEngine->Init();
 
     if (authDelegate == NULL)
         authDelegate = mDefaultTAKEChallengerAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = WEAVE_ERROR_NO_TAKE_AUTH_DELEGATE);
-    mTAKEEngine->ChallengerAuthDelegate = authDelegate;
+    session->mTAKEEngine->ChallengerAuthDelegate = authDelegate;
 
     // Start TAKE session.
-    StartTAKESession(encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
+    StartTAKESession(session, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
 
 exit:
     if (err != WEAVE_NO_ERROR && clearStateOnError)
     {
-        FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        FabricState->RemoveSessionKey(session->mSessionKeyId, con->PeerNodeId);
 
-        Reset();
+        Reset(session);
     }
 
     return err;
 }
 
-void WeaveSecurityManager::StartTAKESession(bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId)
+void WeaveSecurityManager::StartTAKESession(SessionContext *session, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId)
 {
     WEAVE_ERROR err;
 
-    err = SendTAKEIdentifyToken(TAKE::kTAKEConfig_Config1, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
+    err = SendTAKEIdentifyToken(session, TAKE::kTAKEConfig_Config1, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
     SuccessOrExit(err);
 
-    mEncType = mTAKEEngine->GetEncryptionType();
+    session->mEncType = session->mTAKEEngine->GetEncryptionType();
 
-    mEC->OnMessageReceived = HandleTAKEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    session->mEC->OnMessageReceived = HandleTAKEMessageInitiator;
+    session->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Using a smaller timeout may help prevent Relay Attack.
     // TODO: consider reducing the timeout, and using different values of timeout
     // for first and subsequent authentication.
-    StartSessionTimer();
+    StartSessionTimer(session);
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
+        HandleSessionError(session, err, NULL);
 }
 
 
@@ -1591,9 +2115,10 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -1610,15 +2135,15 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
     {
     case kMsgType_TAKEIdentifyTokenResponse:
     {
-        err = secMgr->ProcessTAKEIdentifyTokenResponse(msgBuf);
+        err = secMgr->ProcessTAKEIdentifyTokenResponse(session, msgBuf);
         bool doReauth = err == WEAVE_ERROR_TAKE_REAUTH_POSSIBLE;
 
         if (!doReauth)
             SuccessOrExit(err);
 
-        if (secMgr->mTAKEEngine->IsEncryptAuthPhase())
+        if (session->mTAKEEngine->IsEncryptAuthPhase())
         {
-            err = secMgr->CreateTAKESecureSession();
+            err = secMgr->CreateTAKESecureSession(session);
             SuccessOrExit(err);
         }
 
@@ -1628,11 +2153,11 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
 
         if (doReauth)
         {
-            err = secMgr->SendTAKEReAuthenticateToken();
+            err = secMgr->SendTAKEReAuthenticateToken(session);
         }
         else
         {
-            err = secMgr->SendTAKEAuthenticateToken();
+            err = secMgr->SendTAKEAuthenticateToken(session);
         }
         SuccessOrExit(err);
         break;
@@ -1640,44 +2165,44 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
     case kMsgType_TAKETokenReconfigure:
         uint8_t newConfig;
 
-        err = secMgr->ProcessTAKETokenReconfigure(newConfig, msgBuf);
+        err = secMgr->ProcessTAKETokenReconfigure(session, newConfig, msgBuf);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendTAKEIdentifyToken(newConfig, secMgr->mTAKEEngine->IsEncryptAuthPhase(),
-                secMgr->mTAKEEngine->IsEncryptCommPhase(), secMgr->mTAKEEngine->IsTimeLimitedIK(), secMgr->mTAKEEngine->HasSentChallengerId());
+        err = secMgr->SendTAKEIdentifyToken(session, newConfig, session->mTAKEEngine->IsEncryptAuthPhase(),
+                session->mTAKEEngine->IsEncryptCommPhase(), session->mTAKEEngine->IsTimeLimitedIK(), session->mTAKEEngine->HasSentChallengerId());
         SuccessOrExit(err);
         break;
 
     case kMsgType_TAKEAuthenticateTokenResponse:
-        err = secMgr->ProcessTAKEAuthenticateTokenResponse(msgBuf);
+        err = secMgr->ProcessTAKEAuthenticateTokenResponse(session, msgBuf);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->FinishTAKESetUp();
+        err = secMgr->FinishTAKESetUp(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
         break;
 
     case kMsgType_TAKEReAuthenticateTokenResponse:
-        err = secMgr->ProcessTAKEReAuthenticateTokenResponse(msgBuf);
+        err = secMgr->ProcessTAKEReAuthenticateTokenResponse(session, msgBuf);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->FinishTAKESetUp();
+        err = secMgr->FinishTAKESetUp(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
         break;
 
     default:
@@ -1687,12 +2212,12 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKEIdentifyToken(uint8_t takeConfig, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId)
+WEAVE_ERROR WeaveSecurityManager::SendTAKEIdentifyToken(SessionContext *session, uint8_t takeConfig, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId)
 {
     WEAVE_ERROR     err;
     PacketBuffer*   msgBuf = NULL;
@@ -1701,11 +2226,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEIdentifyToken(uint8_t takeConfig, bool
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenMessage(mSessionKeyId, takeConfig, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId, kWeaveEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId, msgBuf);
+    err = session->mTAKEEngine->GenerateIdentifyTokenMessage(session->mSessionKeyId, takeConfig, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId, kWeaveEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId, msgBuf);
     SuccessOrExit(err);
 
     // Send the message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1716,29 +2241,29 @@ exit:
 }
 
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKEIdentifyTokenResponse(const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKEIdentifyTokenResponse(SessionContext *session, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
+    err = session->mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKETokenReconfigure(uint8_t& config, const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKETokenReconfigure(SessionContext *session, uint8_t& config, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
+    err = session->mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateToken(void)
+WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateToken(SessionContext *session)
 {
     WEAVE_ERROR     err = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf = NULL;
@@ -1747,11 +2272,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateToken(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
+    err = session->mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1759,12 +2284,12 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateTokenResponse(const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateTokenResponse(SessionContext *session, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
+    err = session->mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -1772,7 +2297,7 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateToken(void)
+WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateToken(SessionContext *session)
 {
     WEAVE_ERROR     err = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf = NULL;
@@ -1780,10 +2305,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateToken(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
+    err = session->mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1791,11 +2316,11 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateTokenResponse(const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateTokenResponse(SessionContext *session, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
+    err = session->mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1817,7 +2342,7 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
 
 #if WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
 
-void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
+void WeaveSecurityManager::HandleTAKESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR     err = WEAVE_NO_ERROR;
     PacketBuffer*   respMsgBuf = NULL;
@@ -1825,9 +2350,11 @@ void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPP
     VerifyOrExit(mDefaultTAKETokenAuthDelegate != NULL, err = WEAVE_ERROR_NO_TAKE_AUTH_DELEGATE);
 
     // Setup state for the new TAKE exchange.
-    State = kState_TAKEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    session->mState = kState_TAKEInProgress;
+    UpdateState();
+    session->mEC = ec;
+    session->mCon = ec->Con;
+    ec->AppState = session;
 
     ec->OnMessageReceived = HandleTAKEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
@@ -1835,60 +2362,60 @@ void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPP
     // Ensure the exchange context stays around until we're done with it.
     ec->AddRef();
 
-    StartSessionTimer();
+    StartSessionTimer(session);
 
     // Initialize Weave Platform Memory
     err = Platform::Security::MemoryInit();
     SuccessOrExit(err);
 
     // Prepare TAKE engine and start session
-    mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    session->mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
+    VerifyOrExit(session->mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mTAKEEngine->Init();
 
-    mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
+    session->mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
 
-    err = mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
+    err = session->mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
     PacketBuffer::Free(msgBuf);
     msgBuf = NULL;
 
     if (err == WEAVE_ERROR_TAKE_RECONFIGURE_REQUIRED)
     {
-        err = SendTAKETokenReconfigure();
+        err = SendTAKETokenReconfigure(session);
         SuccessOrExit(err);
 
         // Reset state.
-        Reset();
+        Reset(session);
 
         ExitNow();
     }
 
     SuccessOrExit(err);
 
-    if (mTAKEEngine->UseSessionKey())
+    if (session->mTAKEEngine->UseSessionKey())
     {
         WeaveSessionKey *sessionKey;
-        err = FabricState->AllocSessionKey(ec->PeerNodeId, mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
+        err = FabricState->AllocSessionKey(ec->PeerNodeId, session->mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(false);
         sessionKey->SetRemoveOnIdle(true);
-        mSessionKeyId = mTAKEEngine->SessionKeyId;
-        mEncType = mTAKEEngine->GetEncryptionType();
+        session->mSessionKeyId = session->mTAKEEngine->SessionKeyId;
+        session->mEncType = session->mTAKEEngine->GetEncryptionType();
     }
 
     respMsgBuf = PacketBuffer::New();
     VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
+    err = session->mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
     SuccessOrExit(err);
 
     err = ec->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyTokenResponse, respMsgBuf);
     respMsgBuf = NULL;
     SuccessOrExit(err);
 
-    if (mTAKEEngine->IsEncryptAuthPhase())
+    if (session->mTAKEEngine->IsEncryptAuthPhase())
     {
-        err = CreateTAKESecureSession();
+        err = CreateTAKESecureSession(session);
         SuccessOrExit(err);
     }
 
@@ -1898,16 +2425,17 @@ exit:
     if (respMsgBuf != NULL)
         PacketBuffer::Free(respMsgBuf);
     if (err != WEAVE_NO_ERROR)
-        HandleSessionError(err, NULL);
+        HandleSessionError(session, err, NULL);
 }
 
 void WeaveSecurityManager::HandleTAKEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -1920,36 +2448,36 @@ void WeaveSecurityManager::HandleTAKEMessageResponder(ExchangeContext *ec, const
     switch (msgType)
     {
     case kMsgType_TAKEAuthenticateToken:
-        err = secMgr->ProcessTAKEAuthenticateToken(msgBuf);
+        err = secMgr->ProcessTAKEAuthenticateToken(session, msgBuf);
         SuccessOrExit(err);
 
-        err = secMgr->SendTAKEAuthenticateTokenResponse();
+        err = secMgr->SendTAKEAuthenticateTokenResponse(session);
         SuccessOrExit(err);
 
         // freeing the buffer after the generation of the next message in order to not copy the gx array
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->FinishTAKESetUp();
+        err = secMgr->FinishTAKESetUp(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
         break;
 
     case kMsgType_TAKEReAuthenticateToken:
-        err = secMgr->ProcessTAKEReAuthenticateToken(msgBuf);
+        err = secMgr->ProcessTAKEReAuthenticateToken(session, msgBuf);
         SuccessOrExit(err);
 
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendTAKEReAuthenticateTokenResponse();
+        err = secMgr->SendTAKEReAuthenticateTokenResponse(session);
         SuccessOrExit(err);
 
-        err = secMgr->FinishTAKESetUp();
+        err = secMgr->FinishTAKESetUp(session);
         SuccessOrExit(err);
 
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
         break;
 
     default:
@@ -1963,17 +2491,17 @@ void WeaveSecurityManager::HandleTAKEMessageResponder(ExchangeContext *ec, const
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleSessionError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleSessionError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateToken(const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateToken(SessionContext *session, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
+    err = session->mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -1981,7 +2509,7 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKETokenReconfigure(void)
+WEAVE_ERROR WeaveSecurityManager::SendTAKETokenReconfigure(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -1990,10 +2518,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKETokenReconfigure(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
+    err = session->mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2003,7 +2531,7 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateTokenResponse(void)
+WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateTokenResponse(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -2012,11 +2540,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateTokenResponse(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
+    err = session->mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2026,11 +2554,11 @@ exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateToken(const PacketBuffer* msgBuf)
+WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateToken(SessionContext *session, const PacketBuffer* msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
+    err = session->mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -2038,7 +2566,7 @@ exit:
 }
 
 
-WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateTokenResponse(void)
+WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateTokenResponse(SessionContext *session)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   msgBuf  = NULL;
@@ -2046,10 +2574,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateTokenResponse(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
+    err = session->mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2063,44 +2591,44 @@ exit:
 
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
 
-WEAVE_ERROR WeaveSecurityManager::CreateTAKESecureSession(void)
+WEAVE_ERROR WeaveSecurityManager::CreateTAKESecureSession(SessionContext *session)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = HandleSessionEstablished();
+    err = HandleSessionEstablished(session);
     SuccessOrExit(err);
 
-    mEC->KeyId = mSessionKeyId;
-    mEC->EncryptionType = mEncType;
+    session->mEC->KeyId = session->mSessionKeyId;
+    session->mEC->EncryptionType = session->mEncType;
 
     // Add a reservation for the new session key and configure the ExchangeContext to automatically release
     // the key when the context is freed.  This will ensure the key is not removed until rest of the TAKE
     // exchange completes.
-    ReserveKey(mEC->PeerNodeId, mEC->KeyId);
-    mEC->SetAutoReleaseKey(true);
+    ReserveKey(session->mEC->PeerNodeId, session->mEC->KeyId);
+    session->mEC->SetAutoReleaseKey(true);
 
 exit:
     return err;
 }
 
-WEAVE_ERROR WeaveSecurityManager::FinishTAKESetUp(void)
+WEAVE_ERROR WeaveSecurityManager::FinishTAKESetUp(SessionContext *session)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mTAKEEngine->IsEncryptCommPhase())
+    if (session->mTAKEEngine->IsEncryptCommPhase())
     {
-        err = HandleSessionEstablished();
+        err = HandleSessionEstablished(session);
         SuccessOrExit(err);
     }
     else
     {
-        if (mTAKEEngine->IsEncryptAuthPhase())
+        if (session->mTAKEEngine->IsEncryptAuthPhase())
         {
-            err = FabricState->RemoveSessionKey(mSessionKeyId, mEC->PeerNodeId);
+            err = FabricState->RemoveSessionKey(session->mSessionKeyId, session->mEC->PeerNodeId);
             SuccessOrExit(err);
         }
-        mEncType = kWeaveEncryptionType_None;
-        mSessionKeyId = WeaveKeyId::kNone;
+        session->mEncType = kWeaveEncryptionType_None;
+        session->mSessionKeyId = WeaveKeyId::kNone;
     }
 
 exit:
@@ -2116,19 +2644,22 @@ WEAVE_ERROR WeaveSecurityManager::StartKeyExport(WeaveConnection *con, uint64_t
         KeyExportCompleteFunct onComplete, KeyExportErrorFunct onError, WeaveKeyExportDelegate *keyExportDelegate)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+    SessionContext *session;
 
-    // Verify we've been initialized and that we don't already have a session in process.
+    // Verify we've been initialized and that there is room for another session establishment.
     if (State == kState_NotInitialized)
         return WEAVE_ERROR_INCORRECT_STATE;
-    if (State != kState_Idle)
+    session = GetIdleSessionContext();
+    if (session == NULL)
         return WEAVE_ERROR_SECURITY_MANAGER_BUSY;
 
-    State = kState_KeyExportInProgress;
+    session->mState = kState_KeyExportInProgress;
+    UpdateState();
 
-    mCon = con;
+    session->mCon = con;
 
     // Create a new exchange context.
-    err = NewSessionExchange(peerNodeId, peerAddr, peerPort);
+    err = NewSessionExchange(session, peerNodeId, peerAddr, peerPort);
     SuccessOrExit(err);
 
     // Initialize key export delegate.
@@ -2140,30 +2671,30 @@ WEAVE_ERROR WeaveSecurityManager::StartKeyExport(WeaveConnection *con, uint64_t
     SuccessOrExit(err);
 
     // Allocate and initialize KeyExport object.
-    mKeyExport = (WeaveKeyExport *)Platform::Security::MemoryAlloc(sizeof(WeaveKeyExport), true);
-    VerifyOrExit(mKeyExport != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mKeyExport->Init(keyExportDelegate);
+    session->mKeyExport = (WeaveKeyExport *)Platform::Security::MemoryAlloc(sizeof(WeaveKeyExport), true);
+    VerifyOrExit(session->mKeyExport != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    session->mKeyExport->Init(keyExportDelegate);
 
     // Set the allowed key export protocol configurations.
-    mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
+    session->mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
 
     // Send key export request message.
-    err = SendKeyExportRequest(InitiatorKeyExportConfig, keyId, signMessage);
+    err = SendKeyExportRequest(session, InitiatorKeyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
-    mStartKeyExport_OnComplete = onComplete;
-    mStartKeyExport_OnError = onError;
-    mStartKeyExport_ReqState = reqState;
+    session->mStartKeyExport_OnComplete = onComplete;
+    session->mStartKeyExport_OnError = onError;
+    session->mStartKeyExport_ReqState = reqState;
 
-    mEC->OnMessageReceived = HandleKeyExportMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    session->mEC->OnMessageReceived = HandleKeyExportMessageInitiator;
+    session->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall Key Export duration.
-    StartSessionTimer();
+    StartSessionTimer(session);
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        HandleKeyExportError(err, NULL);
+        HandleKeyExportError(session, err, NULL);
 
     return err;
 }
@@ -2172,9 +2703,10 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
         uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(ec == session->mEC);
 
     // Abort the key export interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -2189,7 +2721,7 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs before we begin the long crypto operation,
     // to prevent the peer from re-transmitting message.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = session->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
@@ -2199,14 +2731,14 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
     case kMsgType_KeyExportReconfigure:
         uint8_t newConfig;
 
-        err = secMgr->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
+        err = session->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendKeyExportRequest(newConfig, secMgr->mKeyExport->KeyId(), secMgr->mKeyExport->SignMessages());
+        err = secMgr->SendKeyExportRequest(session, newConfig, session->mKeyExport->KeyId(), session->mKeyExport->SignMessages());
         SuccessOrExit(err);
 
         break;
@@ -2216,18 +2748,18 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
         uint16_t exportedKeyLen;
         uint8_t exportedKey[kWeaveFabricSecretSize];
 
-        err = secMgr->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo,
+        err = session->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo,
                                                            exportedKey, sizeof(exportedKey), exportedKeyLen, exportedKeyId);
         SuccessOrExit(err);
 
         // Call the user's completion function.
-        if (secMgr->mStartKeyExport_OnComplete != NULL)
+        if (session->mStartKeyExport_OnComplete != NULL)
         {
-            secMgr->mStartKeyExport_OnComplete(secMgr, secMgr->mCon, secMgr->mStartKeyExport_ReqState, exportedKeyId, exportedKey, exportedKeyLen);
+            session->mStartKeyExport_OnComplete(secMgr, session->mCon, session->mStartKeyExport_ReqState, exportedKeyId, exportedKey, exportedKeyLen);
         }
 
         // Reset state.
-        secMgr->Reset();
+        secMgr->Reset(session);
 
         break;
 
@@ -2239,13 +2771,13 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
 
 exit:
     if (err != WEAVE_NO_ERROR)
-        secMgr->HandleKeyExportError(err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
+        secMgr->HandleKeyExportError(session, err, (err == WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? msgBuf : NULL);
 
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
 }
 
-void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf)
+void WeaveSecurityManager::HandleKeyExportError(SessionContext *session, WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf)
 {
     // If session establishment in progress...
     //
@@ -2256,11 +2788,11 @@ void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *s
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (session->mState != kState_Idle)
     {
-        WeaveConnection *con = mCon;
-        KeyExportErrorFunct userOnError = mStartKeyExport_OnError;
-        void *reqState = mStartKeyExport_ReqState;
+        WeaveConnection *con = session->mCon;
+        KeyExportErrorFunct userOnError = session->mStartKeyExport_OnError;
+        void *reqState = session->mStartKeyExport_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport *statusReportPtr = NULL;
 
@@ -2276,7 +2808,7 @@ void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *s
         }
 
         // Reset state.
-        Reset();
+        Reset(session);
 
         // Call the user's error handler.
         if (userOnError != NULL)
@@ -2285,7 +2817,7 @@ void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *s
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendKeyExportRequest(uint8_t keyExportConfig, uint32_t keyId, bool signMessage)
+WEAVE_ERROR WeaveSecurityManager::SendKeyExportRequest(SessionContext *session, uint8_t keyExportConfig, uint32_t keyId, bool signMessage)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
@@ -2297,21 +2829,21 @@ WEAVE_ERROR WeaveSecurityManager::SendKeyExportRequest(uint8_t keyExportConfig,
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate key export request.
-    err = mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen, keyExportConfig, keyId, signMessage);
+    err = session->mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen, keyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
     // Set message length.
     msgBuf->SetDataLength(dataLen);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (session->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export request message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2326,29 +2858,31 @@ exit:
 
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
 
-void WeaveSecurityManager::HandleKeyExportRequest(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
+void WeaveSecurityManager::HandleKeyExportRequest(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
 {
     WEAVE_ERROR err;
     WeaveKeyExport keyExport;
 
-    State = kState_KeyExportInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    session->mState = kState_KeyExportInProgress;
+    UpdateState();
+    session->mEC = ec;
+    session->mCon = ec->Con;
+    ec->AppState = session;
 
     // Ensure the exchange context stays around until we're done with it.
     ec->AddRef();
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (session->mCon == NULL)
     {
         // Do nothing on the Ack received from the requestor.
-        // mEC->OnAckRcvd is not initialized.
+        // session->mEC->OnAckRcvd is not initialized.
         // Do nothing on the message send error.
-        // mEC->OnSendError is not initialized.
+        // session->mEC->OnSendError is not initialized.
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Key Export request.
-        err = mEC->WRMPFlushAcks();
+        err = session->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
     }
 #endif
@@ -2373,11 +2907,11 @@ void WeaveSecurityManager::HandleKeyExportRequest(ExchangeContext *ec, const IPP
     // Check if reconfiguration was requested.
     if (err == WEAVE_ERROR_KEY_EXPORT_RECONFIGURE_REQUIRED)
     {
-        err = SendKeyExportResponse(keyExport, kMsgType_KeyExportReconfigure, msgInfo);
+        err = SendKeyExportResponse(session, keyExport, kMsgType_KeyExportReconfigure, msgInfo);
     }
     else if (err == WEAVE_NO_ERROR)
     {
-        err = SendKeyExportResponse(keyExport, kMsgType_KeyExportResponse, msgInfo);
+        err = SendKeyExportResponse(session, keyExport, kMsgType_KeyExportResponse, msgInfo);
     }
     SuccessOrExit(err);
 
@@ -2393,11 +2927,11 @@ exit:
     keyExport.Shutdown();
 
     // Reset state.
-    Reset();
+    Reset(session);
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo)
+WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(SessionContext *session, WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
@@ -2421,14 +2955,14 @@ WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(WeaveKeyExport& keyExpor
     msgBuf->SetDataLength(dataLen);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (session->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export response message.
-    err = mEC->SendMessage(kWeaveProfile_Security, msgType, msgBuf, sendFlags);
+    err = session->mEC->SendMessage(kWeaveProfile_Security, msgType, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2666,32 +3200,32 @@ exit:
     return;
 }
 
-WEAVE_ERROR WeaveSecurityManager::NewSessionExchange(uint64_t peerNodeId, IPAddress peerAddr, uint16_t peerPort)
+WEAVE_ERROR WeaveSecurityManager::NewSessionExchange(SessionContext *session, uint64_t peerNodeId, IPAddress peerAddr, uint16_t peerPort)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mEC != NULL)
+    if (session->mEC != NULL)
     {
-        mEC->Close();
-        mEC = NULL;
+        session->mEC->Close();
+        session->mEC = NULL;
     }
 
     // Create a new exchange context.
-    if (mCon)
+    if (session->mCon)
     {
-        mEC = ExchangeManager->NewContext(mCon, this);
-        VerifyOrExit(mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        session->mEC = ExchangeManager->NewContext(session->mCon, session);
+        VerifyOrExit(session->mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
     }
     else
     {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         VerifyOrExit(peerNodeId != kNodeIdNotSpecified && peerNodeId != kAnyNodeId, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-        mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, this);
-        VerifyOrExit(mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        session->mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, session);
+        VerifyOrExit(session->mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-        mEC->OnAckRcvd = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        session->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        session->mEC->OnSendError = WRMPHandleSendError;
 #else
         // Reject the request if no connection has been specified.
         ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
@@ -2842,22 +3376,22 @@ exit:
 
 #endif // WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
 
-WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
+WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(SessionContext *session)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    uint64_t peerNodeId = mEC->PeerNodeId;
-    uint16_t sessionKeyId = mSessionKeyId;
-    uint8_t encType = mEncType;
+    uint64_t peerNodeId = session->mEC->PeerNodeId;
+    uint16_t sessionKeyId = session->mSessionKeyId;
+    uint8_t encType = session->mEncType;
     const WeaveEncryptionKey *sessionKey;
     WeaveAuthMode authMode;
 
-    switch (State)
+    switch (session->mState)
     {
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
 
         // Get the derived session key.
-        err = mCASEEngine->GetSessionKey(sessionKey);
+        err = session->mCASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the type of certificate that was used by the peer.
@@ -2866,7 +3400,7 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
         // was requested by the application.  For example, if the app requested kWeaveAuthMode_CASE_AnyCert
         // then the final key auth mode will reflect the actual certificate type used by the peer.
         //
-        authMode = CASEAuthMode(mCASEEngine->CertType());
+        authMode = CASEAuthMode(session->mCASEEngine->CertType());
 
         break;
 #endif
@@ -2875,11 +3409,11 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
     case kState_PASEInProgress:
 
         // Get the derived session key.
-        err = mPASEEngine->GetSessionKey(sessionKey);
+        err = session->mPASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the password source.
-        authMode = PASEAuthMode(mPASEEngine->PwSource);
+        authMode = PASEAuthMode(session->mPASEEngine->PwSource);
 
         break;
 #endif
@@ -2888,7 +3422,7 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
     case kState_TAKEInProgress:
 
         // Get the derived session key.
-        err = mTAKEEngine->GetSessionKey(sessionKey);
+        err = session->mTAKEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Currently only one key auth mode is supported for TAKE.
@@ -2905,21 +3439,63 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
     err = FabricState->SetSessionKey(sessionKeyId, peerNodeId, encType, authMode, sessionKey);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Retain the resumption secret of a full CASE exchange, so that the next session with the peer can be resumed.
+    if (session->mState == kState_CASEInProgress && !session->mCASEEngine->IsResumedSession())
+        SaveCASEResumptionSecret(session);
+#endif
+
 exit:
     return err;
 }
 
-void WeaveSecurityManager::HandleSessionComplete(void)
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+void WeaveSecurityManager::SaveCASEResumptionSecret(SessionContext *session)
+{
+    CASE::SessionResumptionInfo resumption;
+
+    if (session->mCASEEngine->GetResumptionInfo(resumption) == WEAVE_NO_ERROR)
+    {
+        resumption.PeerNodeId = session->mEC->PeerNodeId;
+        resumption.ExpiryTime = GetCASEResumptionTime() + WEAVE_CONFIG_CASE_RESUMPTION_LIFETIME;
+        mResumptionCache.Add(resumption);
+        ClearSecretData((uint8_t *)&resumption, sizeof(resumption));
+    }
+}
+
+/**
+ * The time base, in seconds, against which the expiry of CASE resumption secrets is measured.
+ */
+uint32_t WeaveSecurityManager::GetCASEResumptionTime(void)
+{
+    return static_cast<uint32_t>(System::Layer::GetClock_MonotonicMS() / 1000);
+}
+
+/**
+ * Forget all retained CASE resumption secrets.
+ *
+ * Applications should call this when the trust placed in peers' certificates changes, for example
+ * when trust anchors are removed, since resumed sessions are not subject to certificate validation.
+ */
+void WeaveSecurityManager::ClearCASEResumptionSecrets(void)
+{
+    mResumptionCache.Clear();
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+void WeaveSecurityManager::HandleSessionComplete(SessionContext *session)
 {
-    WeaveConnection *con = mCon;
-    uint64_t peerNodeId = mEC->PeerNodeId;
-    uint16_t sessionKeyId = mSessionKeyId;
-    uint8_t encType = mEncType;
-    SessionEstablishedFunct userOnComplete = mStartSecureSession_OnComplete;
-    void *reqState = mStartSecureSession_ReqState;
+    WeaveConnection *con = session->mCon;
+    uint64_t peerNodeId = session->mEC->PeerNodeId;
+    uint16_t sessionKeyId = session->mSessionKeyId;
+    uint8_t encType = session->mEncType;
+    SessionEstablishedFunct userOnComplete = session->mStartSecureSession_OnComplete;
+    void *reqState = session->mStartSecureSession_ReqState;
 
     // Reset state.
-    Reset();
+    Reset(session);
 
     // Call the general session established handler.
     if (OnSessionEstablished != NULL)
@@ -2948,7 +3524,7 @@ void WeaveSecurityManager::HandleSessionComplete(void)
     AsyncNotifySecurityManagerAvailable();
 }
 
-void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* statusReportMsgBuf)
+void WeaveSecurityManager::HandleSessionError(SessionContext *session, WEAVE_ERROR err, PacketBuffer* statusReportMsgBuf)
 {
     // If session establishment in progress...
     //
@@ -2959,13 +3535,13 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (session->mState != kState_Idle)
     {
-        WeaveConnection *con = mCon;
-        uint64_t peerNodeId = mEC->PeerNodeId;
-        uint16_t sessionKeyId = mSessionKeyId;
-        SessionErrorFunct userOnError = mStartSecureSession_OnError;
-        void *reqState = mStartSecureSession_ReqState;
+        WeaveConnection *con = session->mCon;
+        uint64_t peerNodeId = session->mEC->PeerNodeId;
+        uint16_t sessionKeyId = session->mSessionKeyId;
+        SessionErrorFunct userOnError = session->mStartSecureSession_OnError;
+        void *reqState = session->mStartSecureSession_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport *statusReportPtr = NULL;
 
@@ -2982,13 +3558,13 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
 
         // Otherwise, send a status report to the peer with our reason for the failure.
         else
-            SendStatusReport(err, mEC);
+            SendStatusReport(err, session->mEC);
 
         // Remove the session key from the key table.
         FabricState->RemoveSessionKey(sessionKeyId, peerNodeId);
 
         // Reset state.
-        Reset();
+        Reset(session);
 
         // Call the general session error handler.
         if (OnSessionError != NULL)
@@ -3006,18 +3582,19 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
 
 void WeaveSecurityManager::HandleConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr)
 {
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
     if (conErr == WEAVE_NO_ERROR)
         conErr = WEAVE_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY;
 
     // Clean-up the local state and invoke the appropriate callbacks.
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
-        secMgr->HandleKeyExportError(conErr, NULL);
+    if (session->mState == kState_KeyExportInProgress)
+        secMgr->HandleKeyExportError(session, conErr, NULL);
     else
 #endif
-        secMgr->HandleSessionError(conErr, NULL);
+        secMgr->HandleSessionError(session, conErr, NULL);
 }
 
 WEAVE_ERROR WeaveSecurityManager::SendStatusReport(WEAVE_ERROR localErr, ExchangeContext *ec)
@@ -3113,6 +3690,10 @@ WEAVE_ERROR WeaveSecurityManager::SendStatusReport(WEAVE_ERROR localErr, Exchang
         profileId = kWeaveProfile_Security;
         statusCode = kStatusCode_UnsupportedCertificate;
         break;
+    case WEAVE_ERROR_KEY_NOT_FOUND:
+        profileId = kWeaveProfile_Security;
+        statusCode = kStatusCode_KeyNotFound;
+        break;
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     case WEAVE_ERROR_NO_COMMON_KEY_EXPORT_CONFIGURATIONS:
         profileId = kWeaveProfile_Security;
@@ -3140,53 +3721,67 @@ exit:
     return err;
 }
 
-void WeaveSecurityManager::Reset(void)
+void WeaveSecurityManager::Reset(SessionContext *session)
 {
-    if (mEC != NULL)
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    // Withdraw any crypto step still queued, or wait for the one running to stop using the engine.
+    if (session->mCryptoPending)
     {
-        mEC->Abort();
-        mEC = NULL;
+        CryptoOffload::Cancel(session->mCryptoJob);
+        session->mCryptoPending = false;
+
+        PacketBuffer::Free(session->mCASEStep.MsgBuf);
+        session->mCASEStep.MsgBuf = NULL;
+        PacketBuffer::Free(session->mCASEStep.RespMsgBuf);
+        session->mCASEStep.RespMsgBuf = NULL;
     }
+#endif
 
-    switch (State)
+    if (session->mEC != NULL)
+    {
+        session->mEC->Abort();
+        session->mEC = NULL;
+    }
+
+    switch (session->mState)
     {
 #if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
     case kState_PASEInProgress:
-        if (mPASEEngine != NULL)
+        if (session->mPASEEngine != NULL)
         {
-            mPASEEngine->Shutdown();
-            Platform::Security::MemoryFree(mPASEEngine);
-            mPASEEngine = NULL;
+            session->mPASEEngine->Shutdown();
+            Platform::Security::MemoryFree(session->mPASEEngine);
+            session->mPASEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
     case kState_TAKEInProgress:
-        if (mTAKEEngine != NULL)
+        if (session->mTAKEEngine != NULL)
         {
-            mTAKEEngine->Shutdown();
-            Platform::Security::MemoryFree(mTAKEEngine);
-            mTAKEEngine = NULL;
+            session->mTAKEEngine->Shutdown();
+            Platform::Security::MemoryFree(session->mTAKEEngine);
+            session->mTAKEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
-        if (mCASEEngine != NULL)
+        if (session->mCASEEngine != NULL)
         {
-            mCASEEngine->Shutdown();
-            Platform::Security::MemoryFree(mCASEEngine);
-            mCASEEngine = NULL;
+            session->mCASEEngine->Shutdown();
+            Platform::Security::MemoryFree(session->mCASEEngine);
+            session->mCASEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
     case kState_KeyExportInProgress:
-        if (mKeyExport != NULL)
+        if (session->mKeyExport != NULL)
         {
-            mKeyExport->Shutdown();
-            Platform::Security::MemoryFree(mKeyExport);
-            mKeyExport = NULL;
+            session->mKeyExport->Shutdown();
+            Platform::Security::MemoryFree(session->mKeyExport);
+            session->mKeyExport = NULL;
         }
         break;
 #endif
@@ -3194,44 +3789,98 @@ void WeaveSecurityManager::Reset(void)
         break;
     }
 
-    Platform::Security::MemoryShutdown();
+    CancelSessionTimer(session);
+
+    session->mState = kState_Idle;
+    UpdateState();
+    session->mCon = NULL;
+    session->mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
+    session->mSessionKeyId = WeaveKeyId::kNone;
+    session->mEncType = kWeaveEncryptionType_None;
+    session->mStartSecureSession_OnComplete = NULL;
+    session->mStartSecureSession_OnError = NULL;
+    session->mStartSecureSession_ReqState = NULL;
+
+    // Release platform memory once no other session establishment is using it.
+    if (!IsSessionEstablishmentInProgress())
+        Platform::Security::MemoryShutdown();
+}
+
+/**
+ * Find a session context that is free to start a new session establishment.
+ *
+ * @retval  A pointer to an idle session context, or NULL if the maximum number of
+ *          concurrent session establishments are already in progress.
+ */
+WeaveSecurityManager::SessionContext *WeaveSecurityManager::GetIdleSessionContext(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessionContexts[i].mState == kState_Idle)
+            return &mSessionContexts[i];
+    }
+
+    return NULL;
+}
 
-    CancelSessionTimer();
+/**
+ * Find the in-progress CASE session establishment for a given session key.
+ *
+ * @param[in]  sessionKeyId     The id of the session key being established.
+ * @param[in]  peerNodeId       The node id of the peer with which the key is being established.
+ *
+ * @retval  A pointer to the matching session context, or NULL if there is none.
+ */
+WeaveSecurityManager::SessionContext *WeaveSecurityManager::FindCASESessionContext(uint16_t sessionKeyId, uint64_t peerNodeId)
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        SessionContext *session = &mSessionContexts[i];
 
-    State = kState_Idle;
-    mCon = NULL;
-    mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
-    mSessionKeyId = WeaveKeyId::kNone;
-    mEncType = kWeaveEncryptionType_None;
-    mStartSecureSession_OnComplete = NULL;
-    mStartSecureSession_OnError = NULL;
-    mStartSecureSession_ReqState = NULL;
+        if (session->mState == kState_CASEInProgress &&
+            session->mSessionKeyId == sessionKeyId &&
+            session->mEC != NULL && session->mEC->PeerNodeId == peerNodeId)
+            return session;
+    }
+
+    return NULL;
+}
+
+bool WeaveSecurityManager::IsSessionEstablishmentInProgress(void) const
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessionContexts[i].mState != kState_Idle)
+            return true;
+    }
+
+    return false;
 }
 
-void WeaveSecurityManager::StartSessionTimer(void)
+void WeaveSecurityManager::StartSessionTimer(SessionContext *session)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
 
     if (SessionEstablishTimeout != 0)
     {
-        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, this);
+        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, session);
     }
 }
 
-void WeaveSecurityManager::CancelSessionTimer(void)
+void WeaveSecurityManager::CancelSessionTimer(SessionContext *session)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
-    mSystemLayer->CancelTimer(HandleSessionTimeout, this);
+    mSystemLayer->CancelTimer(HandleSessionTimeout, session);
 }
 
 void WeaveSecurityManager::HandleSessionTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
 
-    WeaveSecurityManager* securityMgr = reinterpret_cast<WeaveSecurityManager*>(aAppState);
-    if (securityMgr)
+    SessionContext* session = reinterpret_cast<SessionContext*>(aAppState);
+    if (session)
     {
-        securityMgr->HandleSessionError(WEAVE_ERROR_TIMEOUT, NULL);
+        session->mSecMgr->HandleSessionError(session, WEAVE_ERROR_TIMEOUT, NULL);
     }
 }
 
@@ -3279,13 +3928,13 @@ void WeaveSecurityManager::OnEncryptedMsgRcvd(uint16_t sessionKeyId, uint64_t pe
     // is received before the Ack for the last message on the session establishment exchange.
     // In that case there is no need to wait for the Ack and the session can be completed.
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-    if (State == kState_CASEInProgress &&
-        mCASEEngine->State == WeaveCASEEngine::kState_Complete &&
-        mSessionKeyId == sessionKeyId &&
-        mEC->PeerNodeId == peerNodeId &&
-        mEncType == encType)
+    SessionContext *session = FindCASESessionContext(sessionKeyId, peerNodeId);
+
+    if (session != NULL && !IsCryptoStepPending(session) &&
+        session->mCASEEngine->State == WeaveCASEEngine::kState_Complete &&
+        session->mEncType == encType)
     {
-        HandleSessionComplete();
+        HandleSessionComplete(session);
     }
 #endif
 }
@@ -3295,29 +3944,31 @@ void WeaveSecurityManager::OnEncryptedMsgRcvd(uint16_t sessionKeyId, uint64_t pe
 void WeaveSecurityManager::WRMPHandleAckRcvd(ExchangeContext *ec, void *msgCtxt)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
-    if (secMgr->State == kState_CASEInProgress &&
-        secMgr->mCASEEngine->State == WeaveCASEEngine::kState_Complete)
+    if (session->mState == kState_CASEInProgress && !IsCryptoStepPending(session) &&
+        session->mCASEEngine->State == WeaveCASEEngine::kState_Complete)
     {
-        secMgr->HandleSessionComplete();
+        secMgr->HandleSessionComplete(session);
     }
 }
 
 void WeaveSecurityManager::WRMPHandleSendError(ExchangeContext *ec, WEAVE_ERROR err, void *msgCtxt)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
-    WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session = (SessionContext *)ec->AppState;
+    WeaveSecurityManager *secMgr = session->mSecMgr;
 
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
+    if (session->mState == kState_KeyExportInProgress)
     {
-        secMgr->HandleKeyExportError(err, NULL);
+        secMgr->HandleKeyExportError(session, err, NULL);
     }
     else
 #endif
     {
-        secMgr->HandleSessionError(err, NULL);
+        secMgr->HandleSessionError(session, err, NULL);
     }
 }
 
@@ -3331,7 +3982,7 @@ void WeaveSecurityManager::AsyncNotifySecurityManagerAvailable()
 void WeaveSecurityManager::DoNotifySecurityManagerAvailable(System::Layer *systemLayer, void *appState, System::Error err)
 {
     WeaveSecurityManager *_this = (WeaveSecurityManager *)appState;
-    if (_this->State == kState_Idle)
+    if (_this->GetIdleSessionContext() != NULL)
     {
         _this->ExchangeManager->NotifySecurityManagerAvailable();
     }
@@ -3350,25 +4001,27 @@ void WeaveSecurityManager::DoNotifySecurityManagerAvailable(System::Layer *syste
  */
 WEAVE_ERROR WeaveSecurityManager::CancelSessionEstablishment(void *reqState)
 {
-    // If a session establishment is in progress and the supplied request state matches what was provided
-    // when the session was started...
-    if ((State == kState_CASEInProgress || State == kState_PASEInProgress || State == kState_TAKEInProgress) &&
-        reqState == mStartSecureSession_ReqState)
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
     {
-        // Clear the application's OnError handler to prevent a callback.
-        mStartSecureSession_OnError = NULL;
+        SessionContext *session = &mSessionContexts[i];
 
-        // Fail the session with a canceled error.
-        HandleSessionError(WEAVE_ERROR_TRANSACTION_CANCELED, NULL);
+        // If a session establishment is in progress and the supplied request state matches what was provided
+        // when the session was started...
+        if ((session->mState == kState_CASEInProgress || session->mState == kState_PASEInProgress || session->mState == kState_TAKEInProgress) &&
+            reqState == session->mStartSecureSession_ReqState)
+        {
+            // Clear the application's OnError handler to prevent a callback.
+            session->mStartSecureSession_OnError = NULL;
+
+            // Fail the session with a canceled error.
+            HandleSessionError(session, WEAVE_ERROR_TRANSACTION_CANCELED, NULL);
 
-        return WEAVE_NO_ERROR;
+            return WEAVE_NO_ERROR;
+        }
     }
 
     // Otherwise, tell the caller there was no match.
-    else
-    {
-        return WEAVE_ERROR_INCORRECT_STATE;
-    }
+    return WEAVE_ERROR_INCORRECT_STATE;
 }
 
 /**
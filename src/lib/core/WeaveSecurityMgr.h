@@ -168,6 +168,47 @@ extern void OnTimeConsumingCryptoDone(void);
 } // namespace Platform
 } // namespace Security
 
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
+/**
+ *   @namespace nl::Weave::CryptoOffload
+ *
+ *   @brief
+ *     This namespace includes the pool of worker threads on which the Weave
+ *     Security Manager runs time-consuming session establishment cryptography.
+ *
+ *     A job's Work function is called on a worker thread.  Its OnComplete
+ *     function is then called with the result on the thread of the System
+ *     Layer the job was posted to.
+ */
+namespace CryptoOffload {
+
+struct Job
+{
+    typedef WEAVE_ERROR (*WorkFunct)(void *appState);
+    typedef void (*CompleteFunct)(void *appState, WEAVE_ERROR err);
+
+    WorkFunct Work;                     // Function run on a worker thread.
+    CompleteFunct OnComplete;           // Function called with the result on the Weave thread.
+    void *AppState;                     // Argument passed to both functions.
+
+    System::Layer *mSystemLayer;        // [PRIVATE] Layer on whose thread the job completes.
+    Job *mNext;                         // [PRIVATE] Next job in the pending or done queue.
+    WEAVE_ERROR mResult;                // [PRIVATE] Result of the Work function.
+    uint8_t mState;                     // [PRIVATE] Whether the job is idle, queued, running or done.
+
+    Job(void) : Work(NULL), OnComplete(NULL), AppState(NULL), mSystemLayer(NULL), mNext(NULL), mResult(WEAVE_NO_ERROR), mState(0) { }
+};
+
+extern WEAVE_ERROR Init(void);
+extern void Shutdown(void);
+extern WEAVE_ERROR Post(System::Layer &systemLayer, Job &job);
+extern void Cancel(Job &job);
+
+} // namespace CryptoOffload
+
+#endif // WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+
 
 using nl::Weave::Profiles::StatusReporting::StatusReport;
 using nl::Weave::Profiles::Security::PASE::WeavePASEEngine;
@@ -194,12 +235,17 @@ public:
 
     WeaveFabricState *FabricState;                      // [READ ONLY] Associated Fabric State object.
     WeaveExchangeManager *ExchangeManager;              // [READ ONLY] Associated Exchange Manager object.
-    uint8_t State;                                      // [READ ONLY] State of the Weave Message Layer object
+    uint8_t State;                                      // [READ ONLY] kState_Idle when no session establishment or key
+                                                        // export is in progress, else the state of one that is
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
     uint32_t InitiatorCASEConfig;                       // CASE configuration proposed when initiating a CASE session
     uint32_t InitiatorCASECurveId;                      // ECDH curve proposed when initiating a CASE session
     uint8_t InitiatorAllowedCASEConfigs;                // Set of allowed CASE configurations when initiating a CASE session
     uint8_t InitiatorAllowedCASECurves;                 // Set of allowed ECDH curves when initiating a CASE session
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    bool InitiatorResumeCASESessions;                   // Resume an earlier CASE session with the peer, where possible, when
+                                                        // initiating a CASE session
+#endif
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     uint8_t ResponderAllowedCASEConfigs;                // Set of allowed CASE configurations when responding to CASE session
@@ -357,57 +403,115 @@ public:
     void ReserveKey(uint64_t peerNodeId, uint16_t keyId);
     void ReleaseKey(uint64_t peerNodeId, uint16_t keyId);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Forget all retained CASE resumption secrets, forcing the next session with any peer to use a full CASE exchange.
+    void ClearCASEResumptionSecrets(void);
+#endif
+
 private:
     enum Flags
     {
         kFlag_IdleSessionTimerRunning   = 0x01
     };
 
-    ExchangeContext *mEC;
-    WeaveConnection *mCon;
-    union
+    struct SessionContext;
+
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+    /**
+     * Inputs and outputs of a time-consuming CASE engine step.
+     *
+     * Steps run on a crypto worker thread when #WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+     * is enabled, in which case each session context holds the step state.  Otherwise
+     * the step state lives on the stack of the message handler that runs the step.
+     */
+    struct CASEStepContext
     {
+        PacketBuffer *MsgBuf;                       // Message being processed or generated.
+        PacketBuffer *RespMsgBuf;                   // Response being generated, if any.
+        WeaveMessageInfo MsgInfo;                   // Copy of the received message's info.
+        nl::Weave::Profiles::Security::CASE::BeginSessionRequestContext ReqCtx;
+        nl::Weave::Profiles::Security::CASE::BeginSessionResponseContext RespCtx;
+        nl::Weave::Profiles::Security::CASE::ReconfigureContext ReconfCtx;
+    };
+
+    typedef WEAVE_ERROR (*CASEStepFunct)(SessionContext *session, CASEStepContext &step);
+    typedef void (WeaveSecurityManager::*CASEStepCompleteFunct)(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err);
+#endif
+
+    /**
+     * State for a single in-progress CASE, PASE, TAKE or key export interaction.
+     *
+     * The exchange context and session timer of an interaction carry a pointer to
+     * its SessionContext as their application state.
+     */
+    struct SessionContext
+    {
+        WeaveSecurityManager *mSecMgr;
+        uint8_t mState;
+        ExchangeContext *mEC;
+        WeaveConnection *mCon;
+        union
+        {
 #if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
-        WeavePASEEngine *mPASEEngine;
+            WeavePASEEngine *mPASEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-        WeaveCASEEngine *mCASEEngine;
+            WeaveCASEEngine *mCASEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
-        WeaveTAKEEngine *mTAKEEngine;
+            WeaveTAKEEngine *mTAKEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-        WeaveKeyExport *mKeyExport;
+            WeaveKeyExport *mKeyExport;
+#endif
+        };
+        union
+        {
+            SessionEstablishedFunct mStartSecureSession_OnComplete;
+
+            /**
+             * The key export protocol complete callback function. This function is
+             * called when the secret key export process is complete.
+             */
+            KeyExportCompleteFunct mStartKeyExport_OnComplete;
+        };
+        union
+        {
+            SessionErrorFunct mStartSecureSession_OnError;
+
+            /**
+             * The key export protocol error callback function. This function is
+             * called when an error is encountered during key export process.
+             */
+            KeyExportErrorFunct mStartKeyExport_OnError;
+        };
+        union
+        {
+            void *mStartSecureSession_ReqState;
+            void *mStartKeyExport_ReqState;
+        };
+        uint16_t        mSessionKeyId;
+        WeaveAuthMode   mRequestedAuthMode;
+        uint8_t         mEncType;
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+        bool            mCryptoPending;
+        CryptoOffload::Job mCryptoJob;
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+        CASEStepFunct   mCASEStepFunct;
+        CASEStepCompleteFunct mCASEStepComplete;
+        CASEStepContext mCASEStep;
+#endif
 #endif
     };
-    union
-    {
-        SessionEstablishedFunct mStartSecureSession_OnComplete;
 
-        /**
-         * The key export protocol complete callback function. This function is
-         * called when the secret key export process is complete.
-         */
-        KeyExportCompleteFunct mStartKeyExport_OnComplete;
-    };
-    union
-    {
-        SessionErrorFunct mStartSecureSession_OnError;
+    SessionContext mSessionContexts[WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS];
 
-        /**
-         * The key export protocol error callback function. This function is
-         * called when an error is encountered during key export process.
-         */
-        KeyExportErrorFunct mStartKeyExport_OnError;
-    };
-    union
-    {
-        void *mStartSecureSession_ReqState;
-        void *mStartKeyExport_ReqState;
-    };
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     WeaveCASEAuthDelegate *mDefaultAuthDelegate;
 #endif
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    nl::Weave::Profiles::Security::CASE::SessionResumptionCache mResumptionCache;
+#endif
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR
     WeaveTAKEChallengerAuthDelegate *mDefaultTAKEChallengerAuthDelegate;
 #endif
@@ -418,14 +522,11 @@ private:
     WeaveKeyExportDelegate *mDefaultKeyExportDelegate;
 #endif
 
-    uint16_t        mSessionKeyId;
-    WeaveAuthMode   mRequestedAuthMode;
-    uint8_t         mEncType;
     System::Layer*  mSystemLayer;
     uint8_t         mFlags;
 
-    void StartSessionTimer(void);
-    void CancelSessionTimer(void);
+    void StartSessionTimer(SessionContext *session);
+    void CancelSessionTimer(SessionContext *session);
     static void HandleSessionTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
 
     void StartIdleSessionTimer(void);
@@ -435,81 +536,120 @@ private:
     static void HandleUnsolicitedMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
 
-    void StartPASESession(void);
-    void HandlePASESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
-    WEAVE_ERROR ProcessPASEInitiatorStep1(ExchangeContext *ec, PacketBuffer *msgBuf);
-    WEAVE_ERROR SendPASEResponderReconfigure(void);
-    WEAVE_ERROR SendPASEResponderStep1(void);
-    WEAVE_ERROR SendPASEResponderStep2(void);
-    WEAVE_ERROR SendPASEInitiatorStep1(uint32_t paseConfig);
-    WEAVE_ERROR ProcessPASEResponderReconfigure(PacketBuffer *msgBuf, uint32_t &newConfig);
-    WEAVE_ERROR ProcessPASEResponderStep1(PacketBuffer *msgBuf);
-    WEAVE_ERROR ProcessPASEResponderStep2(PacketBuffer *msgBuf);
-    WEAVE_ERROR SendPASEInitiatorStep2(void);
-    WEAVE_ERROR ProcessPASEInitiatorStep2(PacketBuffer *msgBuf);
-    WEAVE_ERROR SendPASEResponderKeyConfirm(void);
-    WEAVE_ERROR ProcessPASEResponderKeyConfirm(PacketBuffer *msgBuf);
-    WEAVE_ERROR HandlePASESessionEstablished(void);
+    void StartPASESession(SessionContext *session);
+    void HandlePASESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    WEAVE_ERROR ProcessPASEInitiatorStep1(SessionContext *session, ExchangeContext *ec, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendPASEResponderReconfigure(SessionContext *session);
+    WEAVE_ERROR SendPASEResponderStep1(SessionContext *session);
+    WEAVE_ERROR SendPASEResponderStep2(SessionContext *session);
+    WEAVE_ERROR SendPASEInitiatorStep1(SessionContext *session, uint32_t paseConfig);
+    WEAVE_ERROR ProcessPASEResponderReconfigure(SessionContext *session, PacketBuffer *msgBuf, uint32_t &newConfig);
+    WEAVE_ERROR ProcessPASEResponderStep1(SessionContext *session, PacketBuffer *msgBuf);
+    WEAVE_ERROR ProcessPASEResponderStep2(SessionContext *session, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendPASEInitiatorStep2(SessionContext *session);
+    WEAVE_ERROR ProcessPASEInitiatorStep2(SessionContext *session, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendPASEResponderKeyConfirm(SessionContext *session);
+    WEAVE_ERROR ProcessPASEResponderKeyConfirm(SessionContext *session, PacketBuffer *msgBuf);
+    WEAVE_ERROR HandlePASESessionEstablished(SessionContext *session);
     static void HandlePASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     static void HandlePASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     static void HandlePASEConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr);
 
-    void StartCASESession(uint32_t config, uint32_t curveId);
-    void HandleCASESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    void StartCASESession(SessionContext *session, uint32_t config, uint32_t curveId);
+    void HandleCASESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     static void HandleCASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     static void HandleCASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+    static WEAVE_ERROR GenerateCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step);
+    void SendCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err);
+    static WEAVE_ERROR ProcessCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step);
+    void HandleCASEBeginSessionResponseProcessed(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err);
+    WEAVE_ERROR FinishCASEInitiator(SessionContext *session);
+    static WEAVE_ERROR ProcessCASEBeginSessionRequest(SessionContext *session, CASEStepContext &step);
+    void HandleCASEBeginSessionRequestProcessed(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err);
+    static WEAVE_ERROR GenerateCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step);
+    void SendCASEBeginSessionResponse(SessionContext *session, CASEStepContext &step, WEAVE_ERROR err);
+    void RunCASEStep(SessionContext *session, CASEStepContext &step, CASEStepFunct stepFunct, CASEStepCompleteFunct onComplete);
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    static WEAVE_ERROR DoCASEStep(void *appState);
+    static void HandleCASEStepComplete(void *appState, WEAVE_ERROR err);
+#endif
+#endif // WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
+    void InitCASEInitiatorEngine(SessionContext *session);
+#endif
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    void StartCASEResumption(SessionContext *session, const nl::Weave::Profiles::Security::CASE::SessionResumptionInfo &resumption);
+    WEAVE_ERROR FallBackToFullCASE(SessionContext *session, ExchangeContext *ec);
+    void HandleCASEResumeSessionStart(SessionContext *session, ExchangeContext *ec, PacketBuffer *msgBuf);
+    void SaveCASEResumptionSecret(SessionContext *session);
+    static uint32_t GetCASEResumptionTime(void);
+#endif
+
+    static bool IsCryptoStepPending(const SessionContext *session)
+    {
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+        return session->mCryptoPending;
+#else
+        return false;
+#endif
+    }
 
-    void StartTAKESession(bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId);
-    void HandleTAKESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
-    WEAVE_ERROR SendTAKEIdentifyToken(uint8_t takeConfig, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId);
+    void StartTAKESession(SessionContext *session, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId);
+    void HandleTAKESessionStart(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendTAKEIdentifyToken(SessionContext *session, uint8_t takeConfig, bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId);
     static void HandleTAKEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     static void HandleTAKEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
-    WEAVE_ERROR ProcessTAKEIdentifyTokenResponse(const PacketBuffer *msgBuf);
-    WEAVE_ERROR CreateTAKESecureSession(void);
-    WEAVE_ERROR SendTAKEAuthenticateToken(void);
-    WEAVE_ERROR ProcessTAKEAuthenticateToken(const PacketBuffer *msgBuf);
-    WEAVE_ERROR SendTAKEAuthenticateTokenResponse(void);
-    WEAVE_ERROR ProcessTAKEAuthenticateTokenResponse(const PacketBuffer *msgBuf);
-    WEAVE_ERROR SendTAKEReAuthenticateToken(void);
-    WEAVE_ERROR ProcessTAKEReAuthenticateToken(const PacketBuffer *msgBuf);
-    WEAVE_ERROR SendTAKEReAuthenticateTokenResponse(void);
-    WEAVE_ERROR ProcessTAKEReAuthenticateTokenResponse(const PacketBuffer *msgBuf);
-    WEAVE_ERROR SendTAKETokenReconfigure(void);
-    WEAVE_ERROR ProcessTAKETokenReconfigure(uint8_t& config, const PacketBuffer *msgBuf);
-    WEAVE_ERROR FinishTAKESetUp(void);
+    WEAVE_ERROR ProcessTAKEIdentifyTokenResponse(SessionContext *session, const PacketBuffer *msgBuf);
+    WEAVE_ERROR CreateTAKESecureSession(SessionContext *session);
+    WEAVE_ERROR SendTAKEAuthenticateToken(SessionContext *session);
+    WEAVE_ERROR ProcessTAKEAuthenticateToken(SessionContext *session, const PacketBuffer *msgBuf);
+    WEAVE_ERROR SendTAKEAuthenticateTokenResponse(SessionContext *session);
+    WEAVE_ERROR ProcessTAKEAuthenticateTokenResponse(SessionContext *session, const PacketBuffer *msgBuf);
+    WEAVE_ERROR SendTAKEReAuthenticateToken(SessionContext *session);
+    WEAVE_ERROR ProcessTAKEReAuthenticateToken(SessionContext *session, const PacketBuffer *msgBuf);
+    WEAVE_ERROR SendTAKEReAuthenticateTokenResponse(SessionContext *session);
+    WEAVE_ERROR ProcessTAKEReAuthenticateTokenResponse(SessionContext *session, const PacketBuffer *msgBuf);
+    WEAVE_ERROR SendTAKETokenReconfigure(SessionContext *session);
+    WEAVE_ERROR ProcessTAKETokenReconfigure(SessionContext *session, uint8_t& config, const PacketBuffer *msgBuf);
+    WEAVE_ERROR FinishTAKESetUp(SessionContext *session);
 
     void HandleKeyErrorMsg(ExchangeContext *ec, PacketBuffer *msgBuf);
 
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     WEAVE_ERROR NewMsgCounterSyncExchange(const WeaveMessageInfo *rcvdMsgInfo, const IPPacketInfo *rcvdMsgPacketInfo, ExchangeContext *& ec);
 #endif
-    WEAVE_ERROR NewSessionExchange(uint64_t peerNodeId, IPAddress peerAddr, uint16_t peerPort);
-    WEAVE_ERROR HandleSessionEstablished(void);
-    void HandleSessionComplete(void);
-    void HandleSessionError(WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf);
+    WEAVE_ERROR NewSessionExchange(SessionContext *session, uint64_t peerNodeId, IPAddress peerAddr, uint16_t peerPort);
+    WEAVE_ERROR HandleSessionEstablished(SessionContext *session);
+    void HandleSessionComplete(SessionContext *session);
+    void HandleSessionError(SessionContext *session, WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf);
     static void HandleConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr);
 
     static WEAVE_ERROR SendStatusReport(WEAVE_ERROR localError, ExchangeContext *ec);
 
-    void HandleKeyExportRequest(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
-    WEAVE_ERROR SendKeyExportRequest(uint8_t keyExportConfig, uint32_t keyId, bool signMessage);
-    WEAVE_ERROR SendKeyExportResponse(WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo);
+    void HandleKeyExportRequest(SessionContext *session, ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendKeyExportRequest(SessionContext *session, uint8_t keyExportConfig, uint32_t keyId, bool signMessage);
+    WEAVE_ERROR SendKeyExportResponse(SessionContext *session, WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo);
     static void HandleKeyExportMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
                                                 uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
-    void HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf);
+    void HandleKeyExportError(SessionContext *session, WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     static void WRMPHandleAckRcvd(ExchangeContext *ec, void *msgCtxt);
     static void WRMPHandleSendError(ExchangeContext *ec, WEAVE_ERROR err, void *msgCtxt);
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
-    void Reset(void);
+    SessionContext *GetIdleSessionContext(void);
+    SessionContext *FindCASESessionContext(uint16_t sessionKeyId, uint64_t peerNodeId);
+    bool IsSessionEstablishmentInProgress(void) const;
+    void Reset(SessionContext *session);
+    void UpdateState(void);
 
     void AsyncNotifySecurityManagerAvailable();
     static void DoNotifySecurityManagerAvailable(System::Layer *systemLayer, void *appState, System::Error err);
@@ -469,6 +469,33 @@
 #define WEAVE_CONFIG_TUNNEL_INTERFACE_MTU                           (1536)
 #endif // WEAVE_CONFIG_TUNNEL_INTERFACE_MTU
 
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_TUN_QUEUES
+ *
+ *  @brief
+ *    The number of queues the tunnel agent opens on a Linux
+ *    multi-queue tunnel interface.
+ *
+ *    Each queue is a separate TunEndPoint serviced by the event loop,
+ *    so the kernel can spread packets bound for the Service across
+ *    them.  Packets arriving from the Service are written to the queue
+ *    chosen by a hash of their IPv6 flow, which keeps each flow in
+ *    order.  The default, 1, opens a single-queue interface.
+ *
+ *  @note
+ *    Values greater than 1 are only supported on socket platforms.
+ *    Each queue takes one of the INET_CONFIG_NUM_TUN_ENDPOINTS
+ *    endpoints.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_TUN_QUEUES
+#define WEAVE_CONFIG_TUNNEL_TUN_QUEUES                              (1)
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES
+
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1 && WEAVE_SYSTEM_CONFIG_USE_LWIP
+#error "WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1 requires socket support"
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1 && WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 // clang-format on
 
 #endif /* WEAVE_TUNNEL_CONFIG_H_ */
@@ -81,6 +81,18 @@ enum
     kMode_Asynchronous =                    0x40,
 };
 
+/*
+ * windowing is not a transfer mode of its own but a capability flag
+ * carried alongside the mode bits.  in an init message it states that
+ * the initiator can run a windowed sender-drive transfer; in an accept
+ * message it states that the transfer will be windowed and that a
+ * one-byte window size follows the max block size field.
+ */
+enum
+{
+    kMode_Windowed =                        0x80,
+};
+
 /*
  * with respect to range control, there are several options:
  * - definite length, if set then the transfer has definite length
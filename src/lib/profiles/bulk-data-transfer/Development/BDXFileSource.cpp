@@ -0,0 +1,267 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file contains definitions for BdxFileSource, a memory-mapped
+ *      file image shared by outgoing BDX transfers.
+ */
+
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXFileSource.h>
+
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <SystemLayer/SystemError.h>
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
+
+using namespace ::nl::Weave::Logging;
+
+BdxFileSource::BdxFileSource(void)
+{
+    mData           = NULL;
+    mLength         = 0;
+    mNumTransfers   = 0;
+    mIsOpen         = false;
+}
+
+/**
+ * @brief
+ *  Map the given file into memory, read-only.  The file descriptor is closed
+ *  again once the file is mapped.
+ *
+ * @param[in]   aPath       Path of the file to serve
+ *
+ * @retval      #WEAVE_NO_ERROR                 If the file was mapped
+ * @retval      #WEAVE_ERROR_INCORRECT_STATE    If the source is already open
+ * @retval      #WEAVE_ERROR_INVALID_ARGUMENT   If aPath is NULL or not a regular file
+ * @retval      #WEAVE_ERROR_MESSAGE_TOO_LONG   If the file is too large to map
+ * @retval      other                           The POSIX error that prevented opening or mapping the file
+ */
+WEAVE_ERROR BdxFileSource::Open(const char *aPath)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    int fd = -1;
+    struct stat st;
+    void *map;
+
+    VerifyOrExit(!mIsOpen, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aPath != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    fd = open(aPath, O_RDONLY | O_CLOEXEC);
+    VerifyOrExit(fd >= 0, err = System::MapErrorPOSIX(errno));
+
+    VerifyOrExit(fstat(fd, &st) == 0, err = System::MapErrorPOSIX(errno));
+    VerifyOrExit(S_ISREG(st.st_mode), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(static_cast<uint64_t>(st.st_size) <= SIZE_MAX, err = WEAVE_ERROR_MESSAGE_TOO_LONG);
+
+    // An empty file can't be mapped, but it can still be served as a single empty block.
+    if (st.st_size > 0)
+    {
+        map = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        VerifyOrExit(map != MAP_FAILED, err = System::MapErrorPOSIX(errno));
+
+        // Transfers read the image from many offsets at once, so just ask for all of it.
+        posix_madvise(map, static_cast<size_t>(st.st_size), POSIX_MADV_WILLNEED);
+
+        mData = static_cast<uint8_t *>(map);
+    }
+
+    mLength = static_cast<uint64_t>(st.st_size);
+    mIsOpen = true;
+
+    WeaveLogDetail(BDX, "BdxFileSource opened %s, %lu bytes", aPath, static_cast<unsigned long>(mLength));
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Unmap the file.
+ *
+ * @retval      #WEAVE_NO_ERROR                 If the file was unmapped, or the source was not open
+ * @retval      #WEAVE_ERROR_INCORRECT_STATE    If transfers are still attached to the source
+ */
+WEAVE_ERROR BdxFileSource::Close(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mNumTransfers == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    if (mData != NULL)
+    {
+        munmap(mData, static_cast<size_t>(mLength));
+    }
+
+    mData   = NULL;
+    mLength = 0;
+    mIsOpen = false;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Returns whether a file is currently mapped.
+ */
+bool BdxFileSource::IsOpen(void) const
+{
+    return mIsOpen;
+}
+
+/**
+ * @brief
+ *  Returns the length of the mapped file, 0 if none is.
+ */
+uint64_t BdxFileSource::GetLength(void) const
+{
+    return mLength;
+}
+
+/**
+ * @brief
+ *  Returns the number of transfers currently sending from the source.
+ */
+uint32_t BdxFileSource::GetNumTransfers(void) const
+{
+    return mNumTransfers;
+}
+
+/**
+ * @brief
+ *  Have an outgoing transfer send its blocks from the file.
+ *
+ *  The transfer sends aXfer.mLength bytes of the file starting at
+ *  aXfer.mStartOffset.  A length of 0, or one that runs past the end of the
+ *  file, is cut to the rest of the file, so that the accept message advertises
+ *  the length that will actually be sent.  The transfer's GetBlockHandler is
+ *  replaced with GetBlockHandler().
+ *
+ * @param[in]   aXfer       The transfer, which must not have been initiated or accepted yet
+ *
+ * @retval      #WEAVE_NO_ERROR                 If the transfer was attached
+ * @retval      #WEAVE_ERROR_INCORRECT_STATE    If the source is not open, or the transfer already has a source
+ * @retval      #WEAVE_ERROR_INVALID_ARGUMENT   If aXfer.mStartOffset is past the end of the file
+ */
+WEAVE_ERROR BdxFileSource::AttachTransfer(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint64_t remaining;
+
+    VerifyOrExit(mIsOpen, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aXfer.mFileSource == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aXfer.mStartOffset <= mLength, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    remaining = mLength - aXfer.mStartOffset;
+
+    if (aXfer.mLength == 0 || aXfer.mLength > remaining)
+    {
+        aXfer.mLength = remaining;
+    }
+
+    aXfer.mBytesSent = 0;
+    aXfer.mHandlers.mGetBlockHandler = GetBlockHandler;
+    aXfer.mFileSource = this;
+
+    mNumTransfers++;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Stop a transfer from sending from the file.  Called by
+ *  BDXTransfer::Shutdown().
+ *
+ * @param[in]   aXfer       A transfer attached to this source
+ */
+void BdxFileSource::DetachTransfer(BDXTransfer &aXfer)
+{
+    if (aXfer.mFileSource == this)
+    {
+        aXfer.mFileSource = NULL;
+        aXfer.mHandlers.mGetBlockHandler = NULL;
+
+        mNumTransfers--;
+    }
+}
+
+/**
+ * @brief
+ *  GetBlockHandler for transfers attached to a BdxFileSource.  It points
+ *  the protocol at the next block of the transfer's range of the file,
+ *  within the mapping.
+ *
+ * @see GetBlockHandler
+ */
+void BdxFileSource::GetBlockHandler(BDXTransfer *aXfer, uint64_t *aLength, uint8_t **aDataBlock, bool *aLastBlock)
+{
+    BdxFileSource *source = aXfer->mFileSource;
+    uint64_t length = 0;
+
+    if (source != NULL && source->mData != NULL)
+    {
+        // On input, aLength is the space the protocol has for the block.
+        length = aXfer->mLength - aXfer->mBytesSent;
+
+        if (length > *aLength)
+        {
+            length = *aLength;
+        }
+
+        if (length > aXfer->mMaxBlockSize)
+        {
+            length = aXfer->mMaxBlockSize;
+        }
+
+        *aDataBlock = source->mData + aXfer->mStartOffset + aXfer->mBytesSent;
+    }
+
+    aXfer->mBytesSent += length;
+
+    *aLength = length;
+    *aLastBlock = (aXfer->mBytesSent >= aXfer->mLength);
+}
+
+} // namespace BulkDataTransfer
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares BdxFileSource, a memory-mapped file image that
+ *      any number of outgoing BDX transfers can send from at once.
+ *
+ */
+
+#ifndef _WEAVE_BDX_FILE_SOURCE_H
+#define _WEAVE_BDX_FILE_SOURCE_H
+
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXManagedNamespace.hpp>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXTransferState.h>
+
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
+
+/**
+ * A read-only file, e.g. a firmware image, that is memory-mapped once and
+ * shared by every transfer sending it.
+ *
+ * Attach a transfer to the source from a ReceiveInitHandler, or before calling
+ * InitBdxSend(), instead of giving it a GetBlockHandler.  Each transfer keeps
+ * its own position in mStartOffset and mBytesSent, and blocks are handed to the
+ * protocol as pointers into the mapping, so serving the file needs no file
+ * handle or read buffer per transfer, and the only copy made of the file's
+ * contents is the one into the outgoing message.
+ *
+ * The file must not be truncated while it is open, and the source must stay
+ * open until every transfer attached to it has been shut down;
+ * BDXTransfer::Shutdown() detaches a transfer from its source.
+ */
+class NL_DLL_EXPORT BdxFileSource
+{
+public:
+    BdxFileSource(void);
+
+    WEAVE_ERROR Open(const char *aPath);
+
+    WEAVE_ERROR Close(void);
+
+    bool IsOpen(void) const;
+
+    uint64_t GetLength(void) const;
+
+    uint32_t GetNumTransfers(void) const;
+
+    WEAVE_ERROR AttachTransfer(BDXTransfer &aXfer);
+
+    void DetachTransfer(BDXTransfer &aXfer);
+
+    static void GetBlockHandler(BDXTransfer *aXfer, uint64_t *aLength, uint8_t **aDataBlock, bool *aLastBlock);
+
+private:
+    uint8_t *mData;             // Start of the mapping, NULL if the file is empty
+    uint64_t mLength;           // Length of the file
+    uint32_t mNumTransfers;     // Number of transfers attached to the source
+    bool mIsOpen;
+};
+
+} // namespace BulkDataTransfer
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+#endif // _WEAVE_BDX_FILE_SOURCE_H
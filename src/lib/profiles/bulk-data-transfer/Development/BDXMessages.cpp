@@ -50,6 +50,7 @@ SendInit::SendInit()
     , mSenderDriveSupported(true)
     , mReceiverDriveSupported(false)
     , mAsynchronousModeSupported(false)
+    , mWindowedSupported(false)
     , mDefiniteLength(true)
     , mStartOffsetPresent(false)
     , mWideRange(false)
@@ -241,6 +242,7 @@ WEAVE_ERROR SendInit::pack(PacketBuffer *aBuffer)
     if (mSenderDriveSupported) ptcByte |= kMode_SenderDrive;
     if (mReceiverDriveSupported) ptcByte |= kMode_ReceiverDrive;
     if (mAsynchronousModeSupported) ptcByte |= kMode_Asynchronous;
+    if (mWindowedSupported) ptcByte |= kMode_Windowed;
 
     err = i.writeByte(ptcByte);
     SuccessOrExit(err);
@@ -398,6 +400,7 @@ WEAVE_ERROR SendInit::parse(PacketBuffer *aBuffer, SendInit &aRequest)
     aRequest.mSenderDriveSupported = ((ptcByte & kMode_SenderDrive) != 0);
     aRequest.mReceiverDriveSupported = ((ptcByte & kMode_ReceiverDrive) != 0);
     aRequest.mAsynchronousModeSupported = ((ptcByte & kMode_Asynchronous) != 0);
+    aRequest.mWindowedSupported = ((ptcByte & kMode_Windowed) != 0);
 
     // now the range ctl field and do the same
     err = i.readByte(&rangeCtl);
@@ -461,6 +464,7 @@ bool SendInit::operator == (const SendInit &another) const
             mSenderDriveSupported == another.mSenderDriveSupported &&
             mReceiverDriveSupported == another.mReceiverDriveSupported &&
             mAsynchronousModeSupported == another.mAsynchronousModeSupported &&
+            mWindowedSupported == another.mWindowedSupported &&
             mDefiniteLength == another.mDefiniteLength &&
             mStartOffsetPresent == another.mStartOffsetPresent &&
             mAsynchronousModeSupported == another.mAsynchronousModeSupported &&
@@ -479,6 +483,7 @@ SendAccept::SendAccept()
     : mVersion(0)
     , mTransferMode(kMode_SenderDrive)
     , mMaxBlockSize(0)
+    , mWindowSize(1)
 {
 }
 
@@ -531,12 +536,19 @@ WEAVE_ERROR SendAccept::pack(PacketBuffer *aBuffer)
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     i.append();
-    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK));
+    err = i.writeByte(mTransferMode | (mWindowSize > 1 ? kMode_Windowed : 0) | (mVersion & VERSION_MASK));
     SuccessOrExit(err);
 
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    // the window size is only present for windowed transfers
+    if (mWindowSize > 1)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     mMetaData.pack(i);
 
 exit:
@@ -551,8 +563,8 @@ exit:
  */
 uint16_t SendAccept::packedLength()
 {
-    // <transfer mode>+<max block size>+<meta data (optional)>
-    return 1 + 2 + mMetaData.packedLength();
+    // <transfer mode>+<max block size>+<window size (optional)>+<meta data (optional)>
+    return 1 + 2 + (mWindowSize > 1 ? 1 : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -576,11 +588,18 @@ WEAVE_ERROR SendAccept::parse(PacketBuffer *aBuffer, SendAccept &aResponse)
     SuccessOrExit(err);
 
     aResponse.mVersion = tcByte & VERSION_MASK ;
-    aResponse.mTransferMode = tcByte & ~VERSION_MASK;
+    aResponse.mTransferMode = tcByte & ~(VERSION_MASK | kMode_Windowed);
 
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if (tcByte & kMode_Windowed)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+    }
+
     ReferencedTLVData::parse(i, aResponse.mMetaData);
 
 exit:
@@ -600,6 +619,7 @@ bool SendAccept::operator == (const SendAccept &another) const
     return (mVersion == another.mVersion &&
             mTransferMode == another.mTransferMode &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mMetaData == another.mMetaData);
 }
 
@@ -710,7 +730,7 @@ WEAVE_ERROR ReceiveAccept::pack(PacketBuffer *aBuffer)
     uint8_t rangeCtl = 0;
 
     i.append();
-    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK));
+    err = i.writeByte(mTransferMode | (mWindowSize > 1 ? kMode_Windowed : 0) | (mVersion & VERSION_MASK));
     SuccessOrExit(err);
 
     // format and pack the range control field
@@ -723,6 +743,13 @@ WEAVE_ERROR ReceiveAccept::pack(PacketBuffer *aBuffer)
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    // the window size is only present for windowed transfers
+    if (mWindowSize > 1)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     // and the length, if any
     if (mDefiniteLength)
     {
@@ -752,8 +779,8 @@ exit:
  */
 uint16_t ReceiveAccept::packedLength()
 {
-    // <transfer mode>+<range control>+<max block size>+<length (optional)>+<meta data (optional)>
-    return 1 + 1 + 2 + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
+    // <transfer mode>+<range control>+<max block size>+<window size (optional)>+<length (optional)>+<meta data (optional)>
+    return 1 + 1 + 2 + (mWindowSize > 1 ? 1 : 0) + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -779,7 +806,7 @@ WEAVE_ERROR ReceiveAccept::parse(PacketBuffer *aBuffer, ReceiveAccept &aResponse
     SuccessOrExit(err);
 
     aResponse.mVersion = tcByte & VERSION_MASK ;
-    aResponse.mTransferMode = tcByte & ~VERSION_MASK;
+    aResponse.mTransferMode = tcByte & ~(VERSION_MASK | kMode_Windowed);
 
     // unpack the range control byte
     err = i.readByte(&rangeCtl);
@@ -791,6 +818,13 @@ WEAVE_ERROR ReceiveAccept::parse(PacketBuffer *aBuffer, ReceiveAccept &aResponse
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if (tcByte & kMode_Windowed)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+    }
+
     if (aResponse.mDefiniteLength)
     {
         if (aResponse.mWideRange)
@@ -826,6 +860,7 @@ bool ReceiveAccept::operator == (const ReceiveAccept &another) const
             mDefiniteLength == another.mDefiniteLength &&
             mWideRange == another.mWideRange &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mLength == another.mLength &&
             mMetaData == another.mMetaData);
 }
@@ -140,6 +140,7 @@ public:
     bool mSenderDriveSupported;         /**< True if we can support sender drive. */
     bool mReceiverDriveSupported;       /**< True if we can support receiver drive. */
     bool mAsynchronousModeSupported;    /**< True if we can support async mode. */
+    bool mWindowedSupported;            /**< True if we can support windowed sender drive. */
     // Range control options
     bool mDefiniteLength;               /**< True if the length field is present. */
     bool mStartOffsetPresent;           /**< True if the start offset field is present. */
@@ -180,6 +181,7 @@ public:
     uint8_t mVersion;               /**< Version of the BDX protocol we decided on. */
     uint8_t mTransferMode;          /**< Transfer mode that we decided on. */
     uint16_t mMaxBlockSize;         /**< Maximum block size we decided on. */
+    uint8_t mWindowSize;            /**< Blocks the sender may have in flight, 1 if not windowed. */
     ReferencedTLVData mMetaData;    /**< Optional TLV Metadata. */
 };
 
@@ -23,6 +23,14 @@
  *      BdxProtocol class to facilitate transfers.
  */
 
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 #include <Weave/Support/logging/WeaveLogging.h>
@@ -52,6 +60,18 @@ BdxNode::BdxNode(void)
     mInitialized            = false;
     mSendInitHandler        = NULL;
     mReceiveInitHandler     = NULL;
+    mFreeTransfers          = NULL;
+    mNumTransfers           = 0;
+
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+    mTransferChunks         = NULL;
+    mPoolSize               = 0;
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    mSendQueueHead          = NULL;
+    mSendQueueTail          = NULL;
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
 }
 
 /**
@@ -74,13 +94,21 @@ WEAVE_ERROR BdxNode::Init(WeaveExchangeManager *anExchangeMgr)
     VerifyOrExit(anExchangeMgr != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
     mExchangeMgr = anExchangeMgr;
 
-    // Initialize all the BDXTransfers
-    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS; i++)
+    // Initialize all the BDXTransfers and put them on the free list, in order
+    mFreeTransfers = NULL;
+    mNumTransfers = 0;
+
+    for (int i = WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS - 1; i >= 0; i--)
     {
-        // Error if already initialized.
         mTransferPool[i].Reset();
+        mTransferPool[i].mNextTransfer = mFreeTransfers;
+        mFreeTransfers = &mTransferPool[i];
     }
 
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+    mPoolSize = WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS;
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
     mIsBdxTransferAllowed = true;
     mInitialized = true;
 
@@ -106,8 +134,43 @@ WEAVE_ERROR BdxNode::Shutdown(void)
 
     for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS; i++)
     {
-        ShutdownTransfer(&mTransferPool[i]);
+        if (mTransferPool[i].mIsInitiated)
+        {
+            ShutdownTransfer(&mTransferPool[i]);
+        }
+    }
+
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+    while (mTransferChunks != NULL)
+    {
+        TransferChunk *chunk = mTransferChunks;
+
+        for (int i = 0; i < WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE; i++)
+        {
+            if (chunk->mTransfers[i].mIsInitiated)
+            {
+                ShutdownTransfer(&chunk->mTransfers[i]);
+            }
+        }
+
+        mTransferChunks = chunk->mNext;
+
+        chunk->~TransferChunk();
+        free(chunk);
+    }
+
+    mPoolSize = 0;
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+    // Everything left on the free list belonged to the pool just torn down
+    mFreeTransfers = NULL;
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    if (mExchangeMgr != NULL)
+    {
+        mExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleSendPass, this);
     }
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
 
     AllowBdxTransferToRun(false);
 
@@ -157,6 +220,7 @@ exit:
  *
  * @retval      #WEAVE_NO_ERROR                     If we successfully found a new BDXTransfer.
  * @retval      #WEAVE_ERROR_TOO_MANY_CONNECTIONS   If too many transfers are currently active and aXfer is NULL
+ * @retval      #WEAVE_ERROR_NO_MEMORY              If the pool needed to grow but couldn't, and aXfer is NULL
  */
 WEAVE_ERROR BdxNode::AllocTransfer(BDXTransfer * &aXfer)
 {
@@ -164,31 +228,298 @@ WEAVE_ERROR BdxNode::AllocTransfer(BDXTransfer * &aXfer)
 
     WEAVE_FAULT_INJECT(FaultInjection::kFault_BDXAllocTransfer, ExitNow());
 
-    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS; i++)
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+    if (mFreeTransfers == NULL)
+    {
+        err = GrowTransferPool();
+        VerifyOrExit(err == WEAVE_NO_ERROR, aXfer = NULL);
+    }
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+    // All of the transfers are in use
+    VerifyOrExit(mFreeTransfers != NULL, aXfer = NULL; err = WEAVE_ERROR_TOO_MANY_CONNECTIONS);
+
+    aXfer = mFreeTransfers;
+    mFreeTransfers = aXfer->mNextTransfer;
+    mNumTransfers++;
+
+    aXfer->mNextTransfer = NULL;
+    aXfer->mNode = this;
+    aXfer->mIsInitiated = true;
+    err = WEAVE_NO_ERROR;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Return a transfer to the free pool.  Called by BDXTransfer::Shutdown() once
+ *  the transfer has been reset; applications shut transfers down instead.
+ *
+ * @param[in]   aXfer       A transfer allocated from this node
+ */
+void BdxNode::ReleaseTransfer(BDXTransfer &aXfer)
+{
+    aXfer.mNextTransfer = mFreeTransfers;
+    mFreeTransfers = &aXfer;
+    mNumTransfers--;
+}
+
+/**
+ * @brief
+ *  Returns the number of transfers currently allocated from this node.
+ */
+uint32_t BdxNode::GetNumTransfers(void) const
+{
+    return mNumTransfers;
+}
+
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+/**
+ * @brief
+ *  Allocate another WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE transfers, or as
+ *  many as WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS still allows, and put them
+ *  on the free list.
+ *
+ * @retval      #WEAVE_NO_ERROR                     If the pool grew
+ * @retval      #WEAVE_ERROR_TOO_MANY_CONNECTIONS   If the pool is already as large as it may get
+ * @retval      #WEAVE_ERROR_NO_MEMORY              If the transfers couldn't be allocated
+ */
+WEAVE_ERROR BdxNode::GrowTransferPool(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TransferChunk *chunk;
+    uint32_t count = WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE;
+
+    VerifyOrExit(mPoolSize < WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS, err = WEAVE_ERROR_TOO_MANY_CONNECTIONS);
+
+    if (count > WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS - mPoolSize)
     {
-        aXfer = &mTransferPool[i];
-        if (aXfer->mIsInitiated)
+        count = WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS - mPoolSize;
+    }
+
+    chunk = static_cast<TransferChunk *>(malloc(sizeof(TransferChunk)));
+    VerifyOrExit(chunk != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    new (chunk) TransferChunk();
+
+    chunk->mNext = mTransferChunks;
+    mTransferChunks = chunk;
+
+    for (int i = WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE - 1; i >= 0; i--)
+    {
+        // Transfers beyond the limit stay reset and off the free list for good.
+        chunk->mTransfers[i].Reset();
+
+        if (static_cast<uint32_t>(i) < count)
         {
+            chunk->mTransfers[i].mNextTransfer = mFreeTransfers;
+            mFreeTransfers = &chunk->mTransfers[i];
+        }
+    }
+
+    mPoolSize += count;
+
+    WeaveLogDetail(BDX, "Transfer pool grown to %u", static_cast<unsigned int>(mPoolSize));
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+/**
+ * @brief
+ *  Queue a transfer to send, when its turn comes, the block(s) its mNext
+ *  action sends.  BdxProtocol calls this instead of sending straight away
+ *  whenever the peer asks a transfer allocated from this node for more data.
+ *
+ *  The queue is served round-robin, one action per transfer per pass, and a
+ *  transfer with mMaxBytesPerSec set is passed over until it is back under
+ *  its cap.  A transfer that is already queued keeps its place.
+ *
+ * @param[in]   aXfer       A transfer allocated from this node, with mNext set
+ *
+ * @retval      #WEAVE_NO_ERROR     If the transfer was queued
+ * @retval      other               If the send pass could not be scheduled
+ */
+WEAVE_ERROR BdxNode::ScheduleTransfer(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    EnqueueTransfer(aXfer);
+
+    // Run a pass as soon as the node is next idle.
+    err = mExchangeMgr->MessageLayer->SystemLayer->StartTimer(0, HandleSendPass, this);
+    if (err != WEAVE_NO_ERROR)
+    {
+        UnscheduleTransfer(aXfer);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Put a transfer at the back of the send queue, if it isn't queued already.
+ */
+void BdxNode::EnqueueTransfer(BDXTransfer &aXfer)
+{
+    VerifyOrExit(!aXfer.mIsScheduled, );
+
+    aXfer.mNextTransfer = NULL;
+    aXfer.mPrevTransfer = mSendQueueTail;
+
+    if (mSendQueueTail != NULL)
+    {
+        mSendQueueTail->mNextTransfer = &aXfer;
+    }
+    else
+    {
+        mSendQueueHead = &aXfer;
+    }
+
+    mSendQueueTail = &aXfer;
+    aXfer.mIsScheduled = true;
+
+exit:
+    return;
+}
+
+/**
+ * @brief
+ *  Take a transfer out of the send queue, e.g. because it is shutting down.
+ *
+ * @param[in]   aXfer       A transfer allocated from this node
+ */
+void BdxNode::UnscheduleTransfer(BDXTransfer &aXfer)
+{
+    VerifyOrExit(aXfer.mIsScheduled, );
+
+    if (aXfer.mPrevTransfer != NULL)
+    {
+        aXfer.mPrevTransfer->mNextTransfer = aXfer.mNextTransfer;
+    }
+    else
+    {
+        mSendQueueHead = aXfer.mNextTransfer;
+    }
+
+    if (aXfer.mNextTransfer != NULL)
+    {
+        aXfer.mNextTransfer->mPrevTransfer = aXfer.mPrevTransfer;
+    }
+    else
+    {
+        mSendQueueTail = aXfer.mPrevTransfer;
+    }
+
+    aXfer.mNextTransfer = NULL;
+    aXfer.mPrevTransfer = NULL;
+    aXfer.mIsScheduled = false;
+
+exit:
+    return;
+}
+
+/**
+ * @brief
+ *  Serve the send queue once: every transfer queued when the pass starts
+ *  takes its pending action, unless it is over its bandwidth cap, in which
+ *  case it goes to the back of the queue.  Another pass is then scheduled
+ *  for when the next transfer in the queue may send.
+ */
+void BdxNode::HandleSendPass(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    BdxNode *node = static_cast<BdxNode *>(aAppState);
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+    uint64_t nextPassTime = UINT64_MAX;
+    uint32_t numQueued = 0;
+    BDXTransfer *xfer;
+
+    for (xfer = node->mSendQueueHead; xfer != NULL; xfer = xfer->mNextTransfer)
+    {
+        numQueued++;
+    }
+
+    // Transfers queued during the pass, including any sent to the back, wait for the next one.
+    for (; numQueued > 0 && node->mSendQueueHead != NULL; numQueued--)
+    {
+        WEAVE_ERROR err;
+        WEAVE_ERROR (*next)(BDXTransfer &);
+        uint32_t numBlocks = 1;
+        uint32_t firstBlock = 0;
+
+        xfer = node->mSendQueueHead;
+        node->UnscheduleTransfer(*xfer);
+
+        if (xfer->mMaxBytesPerSec != 0 && xfer->mNextSendTimeMS > now)
+        {
+            node->EnqueueTransfer(*xfer);
             continue;
         }
 
-        if (aXfer->mExchangeContext != NULL)
+        next = xfer->mNext;
+        xfer->mNext = NULL;
+
+        if (next == NULL)
         {
-            WeaveLogDetail(BDX, "Error! Xfer is not initiated but has mExchangeContext.");
             continue;
         }
 
-        aXfer->mIsInitiated = true;
-        err = WEAVE_NO_ERROR;
-        ExitNow();
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+        firstBlock = xfer->mNextBlockCounter;
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+        err = next(*xfer);
+        if (err != WEAVE_NO_ERROR)
+        {
+            xfer->DispatchErrorHandler(err);
+            continue;
+        }
+
+        // Charge a capped transfer a full block for each block it just sent; a window may send several.
+        if (xfer->mMaxBytesPerSec != 0)
+        {
+            uint64_t cost;
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+            if (xfer->IsWindowed() && xfer->mNextBlockCounter > firstBlock)
+            {
+                numBlocks = xfer->mNextBlockCounter - firstBlock;
+            }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+            cost = static_cast<uint64_t>(numBlocks) * xfer->mMaxBlockSize;
+
+            if (xfer->mNextSendTimeMS < now)
+            {
+                xfer->mNextSendTimeMS = now;
+            }
+
+            xfer->mNextSendTimeMS += (cost * 1000) / xfer->mMaxBytesPerSec;
+        }
+    }
+
+    for (xfer = node->mSendQueueHead; xfer != NULL; xfer = xfer->mNextTransfer)
+    {
+        uint64_t sendTime = (xfer->mMaxBytesPerSec != 0) ? xfer->mNextSendTimeMS : now;
+
+        if (sendTime < nextPassTime)
+        {
+            nextPassTime = sendTime;
+        }
     }
 
-    // All of the connections are in use
-    aXfer = NULL;
+    if (nextPassTime != UINT64_MAX)
+    {
+        uint32_t delay = (nextPassTime > now) ? static_cast<uint32_t>(nextPassTime - now) : 0;
 
-exit:
-    return err;
+        aSystemLayer->StartTimer(delay, HandleSendPass, node);
+    }
 }
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
 
 /**
  * @brief
@@ -744,6 +1075,11 @@ void BdxNode::HandleReceiveInit(ExchangeContext *anEc, const IPPacketInfo *aPktI
         //TODO: merge this up one line when async supported: && !receiveInit.mAsynchronousModeSupported)
                  err = WEAVE_ERROR_INVALID_TRANSFER_MODE; statusCode = kStatus_ServerBadState);
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    // Window the transfer only if both the initiator and the application asked for it
+    xfer->mWindowSize = BdxProtocol::NegotiateWindowSize(*xfer, receiveInit.mWindowedSupported ? WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE : 1);
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     // TODO: validate max block size?  anything else?
     WeaveLogDetail(BDX, "HandleReceiveInit validated request\n");
 
@@ -883,6 +1219,11 @@ void BdxNode::HandleSendInit(ExchangeContext *anEc, const IPPacketInfo *aPktInfo
         //TODO: merge this up one line when async supported: && !sendInit.mAsynchronousModeSupported)
                  err = WEAVE_ERROR_INVALID_TRANSFER_MODE; statusCode = kStatus_ServerBadState);
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    // Window the transfer only if both the initiator and the application asked for it
+    xfer->mWindowSize = BdxProtocol::NegotiateWindowSize(*xfer, sendInit.mWindowedSupported ? WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE : 1);
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     WeaveLogDetail(BDX, "HandleSendInit validated request\n");
 
     err = SendSendAccept(anEc, xfer);
@@ -1006,6 +1347,10 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendReceiveAccept error calling Init on receiveAccept: %d", err));
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    receiveAccept.mWindowSize = aXfer->mWindowSize;
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
@@ -1029,6 +1374,13 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     if (aXfer->IsDriver())
     {
         WeaveLogDetail(BDX, "ReceiveAccept sent: Am driving so sending first block");
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+        if (aXfer->IsWindowed())
+        {
+            err = BdxProtocol::SendWindowV1(*aXfer);
+        }
+        else
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
         if (aXfer->mVersion == 1)
         {
             err = BdxProtocol::SendNextBlockV1(*aXfer);
@@ -1072,6 +1424,10 @@ WEAVE_ERROR BdxNode::SendSendAccept(ExchangeContext *anEc, BDXTransfer *aXfer)
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendSendAccept error calling Init on sendAccept: %d", err));
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    sendAccept.mWindowSize = aXfer->mWindowSize;
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
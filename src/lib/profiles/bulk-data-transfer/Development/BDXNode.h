@@ -86,6 +86,16 @@ public:
 
     static void ShutdownTransfer(BDXTransfer *aXfer);
 
+    void ReleaseTransfer(BDXTransfer &aXfer);
+
+    uint32_t GetNumTransfers(void) const;
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    WEAVE_ERROR ScheduleTransfer(BDXTransfer &aXfer);
+
+    void UnscheduleTransfer(BDXTransfer &aXfer);
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
     void AllowBdxTransferToRun(bool aEnable);
 
     bool CanBdxTransferRun(void);
@@ -129,6 +139,32 @@ private:
     bool mInitialized;
 
     BDXTransfer mTransferPool[WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS];
+    BDXTransfer *mFreeTransfers;             // Transfers not in use, linked through mNextTransfer
+    uint32_t mNumTransfers;                  // Number of transfers in use
+
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+    /** A block of transfers allocated from the heap when the pool grows. */
+    struct TransferChunk
+    {
+        TransferChunk *mNext;
+        BDXTransfer mTransfers[WEAVE_CONFIG_BDX_TRANSFER_POOL_CHUNK_SIZE];
+    };
+
+    TransferChunk *mTransferChunks;
+    uint32_t mPoolSize;                      // Number of transfers in the pool, built-in and allocated
+
+    WEAVE_ERROR GrowTransferPool(void);
+#endif // WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    // Transfers waiting to send, linked through mNextTransfer and mPrevTransfer and served from the head
+    BDXTransfer *mSendQueueHead;
+    BDXTransfer *mSendQueueTail;
+
+    void EnqueueTransfer(BDXTransfer &aXfer);
+
+    static void HandleSendPass(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
 
     // Application programmer-defined callbacks that take a Send/ReceiveInit message and a BDXTransfer,
     // determining whether they want to accept a transfer or not and setting up
@@ -31,6 +31,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Core/WeaveServerBase.h>
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXProtocol.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXNode.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 
 namespace nl {
@@ -78,6 +79,10 @@ WEAVE_ERROR InitBdxReceive(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    msg.mWindowedSupported = aXfer.IsWindowed();
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -134,6 +139,10 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    msg.mWindowedSupported = aXfer.IsWindowed();
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -190,6 +199,10 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    msg.mWindowedSupported = aXfer.IsWindowed();
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -637,6 +650,435 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+/*
+ * Windowed transfers.
+ *
+ * A windowed transfer is a version 1 sender-drive transfer in which the
+ * sender keeps up to mWindowSize blocks in flight instead of waiting for
+ * each block to be acknowledged.  The sender holds a copy of every block
+ * until it is acknowledged, since the GetBlockHandler cannot be asked for
+ * the same block twice.
+ *
+ * The receiver hands blocks to the application strictly in order.  After
+ * each in-order block it sends a BlockAckV1, which acknowledges that block
+ * and every block before it.  A block that arrives ahead of a missing one
+ * is held if it fits within the receiver's window (and dropped if not),
+ * and the receiver sends a BlockQueryV1 for the missing block, once per
+ * missing block.  The query acknowledges every block before the one it
+ * names, and the sender retransmits just that block.
+ *
+ * Like the stop-and-wait modes, windowed transfers rely on the exchange's
+ * transport (TCP or WRMP) to deliver every message, so there is no
+ * retransmission timer: a block that is lost along with everything sent
+ * after it ends the transfer with a response timeout.
+ */
+
+static inline uint8_t WindowSlot(uint32_t aBlockCounter)
+{
+    return aBlockCounter % WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE;
+}
+
+/**
+ * @brief
+ *  Settles the window size of a transfer from the size offered on this end,
+ *  aXfer.mWindowSize, and the size offered by the counterpart.  Only version 1
+ *  sender-drive transfers are windowed; any other transfer gets a window of
+ *  one block, which is plain stop-and-wait.
+ *
+ * @param[in]   aXfer               The transfer whose mode and version have been decided
+ * @param[in]   aPeerWindowSize     The largest window the counterpart will run with
+ *
+ * @return the number of blocks the sender may keep in flight
+ */
+uint8_t NegotiateWindowSize(BDXTransfer &aXfer, uint8_t aPeerWindowSize)
+{
+    uint8_t windowSize = aXfer.mWindowSize;
+
+    if (windowSize > WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE)
+    {
+        windowSize = WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE;
+    }
+
+    if (aPeerWindowSize < windowSize)
+    {
+        windowSize = aPeerWindowSize;
+    }
+
+    if (windowSize == 0 || aXfer.mTransferMode != kMode_SenderDrive || aXfer.mVersion != 1)
+    {
+        windowSize = 1;
+    }
+
+    return windowSize;
+}
+
+/**
+ * @brief
+ *  Sends a BlockAckV1 or BlockQueryV1 with the given block counter on a windowed transfer.
+ *  Neither expects a response, as the sender drives the transfer.
+ */
+static WEAVE_ERROR SendWindowControlV1(BDXTransfer &aXfer, uint8_t aMsgType, uint32_t aBlockCounter)
+{
+    WEAVE_ERROR     err     = WEAVE_NO_ERROR;
+    PacketBuffer*   buffer  = PacketBuffer::NewWithAvailableSize(BlockQueryV1::kPayloadLen);
+    BlockQueryV1    outMsg;
+
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    SuccessOrExit(err = outMsg.init(aBlockCounter));
+    SuccessOrExit(err = outMsg.pack(buffer));
+
+    err = aXfer.mExchangeContext->SendMessage(kWeaveProfile_BDX, aMsgType, buffer, aXfer.GetDefaultFlags(false));
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Acknowledges every block the receiver of a windowed transfer has handed
+ *  to the application, i.e. every block before aXfer.mBlockCounter.
+ */
+static WEAVE_ERROR SendWindowAckV1(BDXTransfer &aXfer)
+{
+    return SendWindowControlV1(aXfer, kMsgType_BlockAckV1, aXfer.mBlockCounter - 1);
+}
+
+/**
+ * @brief
+ *  Asks the sender of a windowed transfer to retransmit the block the
+ *  receiver is missing, aXfer.mBlockCounter.
+ */
+static WEAVE_ERROR SendWindowQueryV1(BDXTransfer &aXfer)
+{
+    aXfer.mIsBlockQueried = true;
+
+    return SendWindowControlV1(aXfer, kMsgType_BlockQueryV1, aXfer.mBlockCounter);
+}
+
+/**
+ * @brief
+ *  Sends a copy of a block held in the sender's window.  The held block stays
+ *  in the window until it is acknowledged.
+ */
+static WEAVE_ERROR SendWindowBlockV1(BDXTransfer &aXfer, uint32_t aBlockCounter)
+{
+    WEAVE_ERROR     err     = WEAVE_NO_ERROR;
+    PacketBuffer*   block   = aXfer.mWindowBlocks[WindowSlot(aBlockCounter)];
+    PacketBuffer*   buffer  = NULL;
+    uint8_t         msgType;
+
+    VerifyOrExit(block != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    buffer = PacketBuffer::NewWithAvailableSize(block->DataLength());
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memcpy(buffer->Start(), block->Start(), block->DataLength());
+    buffer->SetDataLength(block->DataLength());
+
+    if (aXfer.mIsLastBlockKnown && aBlockCounter == aXfer.mLastBlockCounter)
+    {
+        msgType = kMsgType_BlockEOFV1;
+    }
+    else
+    {
+        msgType = kMsgType_BlockSendV1;
+    }
+
+    // The response timer is armed once the window has been sent; see SendWindowV1
+    err = aXfer.mExchangeContext->SendMessage(kWeaveProfile_BDX, msgType, buffer, aXfer.GetDefaultFlags(false));
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  This function fills the window of a windowed transfer: it gets new blocks
+ *  from the BDXTransfer's GetBlockHandler and sends them until mWindowSize
+ *  blocks are in flight or the last block has been sent.  While any blocks are
+ *  in flight, it then leaves the response timer armed for the receiver's ack.
+ *
+ * @param[in]       aXfer   The windowed BDXTransfer to send blocks for
+ *
+ * @retval          #WEAVE_ERROR_INCORRECT_STATE    If the GetBlockHandler is NULL
+ * @retval          #WEAVE_ERROR_NO_MEMORY          If no available PacketBuffers
+ */
+WEAVE_ERROR SendWindowV1(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR     err     = WEAVE_NO_ERROR;
+    PacketBuffer*   block   = NULL;
+    uint64_t        length;
+    uint8_t*        data;
+    bool            isLast;
+
+    VerifyOrExit(aXfer.mHandlers.mGetBlockHandler != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    while (!aXfer.mIsLastBlockKnown && aXfer.mNextBlockCounter - aXfer.mBlockCounter < aXfer.mWindowSize)
+    {
+        WeaveLogDetail(BDX, "Sending next block # %d\n", aXfer.mNextBlockCounter);
+
+        block = PacketBuffer::NewWithAvailableSize(sizeof(aXfer.mBlockCounter) + aXfer.mMaxBlockSize);
+        VerifyOrExit(block != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        data = block->Start();
+        nl::Weave::Encoding::LittleEndian::Write32(data, aXfer.mNextBlockCounter);
+
+        length = block->AvailableDataLength() - sizeof(aXfer.mBlockCounter);
+
+        if (length > aXfer.mMaxBlockSize)
+        {
+            length = aXfer.mMaxBlockSize;
+        }
+
+        aXfer.DispatchGetBlockHandler(&length, &data, &isLast);
+
+        VerifyOrExit((length + sizeof(aXfer.mBlockCounter)) <= block->AvailableDataLength(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        // if the data pointer has changed, the callee used her own
+        // buffer.  Copy the contents.
+
+        if (data != (block->Start() + sizeof(aXfer.mBlockCounter)))
+        {
+            memcpy(block->Start() + sizeof(aXfer.mBlockCounter), data, length);
+        }
+
+        block->SetDataLength(length + sizeof(aXfer.mBlockCounter));
+
+        aXfer.mWindowBlocks[WindowSlot(aXfer.mNextBlockCounter)] = block;
+        block = NULL;
+
+        if (isLast)
+        {
+            aXfer.mIsLastBlockKnown = true;
+            aXfer.mLastBlockCounter = aXfer.mNextBlockCounter;
+        }
+
+        err = SendWindowBlockV1(aXfer, aXfer.mNextBlockCounter++);
+        SuccessOrExit(err);
+    }
+
+    // Every message from the receiver cancels the response timer, and only one
+    // response can be outstanding on an exchange, so the timer is armed here on
+    // behalf of the whole window, rather than by any one block of it
+    if (!aXfer.mExchangeContext->IsResponseExpected() && aXfer.mBlockCounter != aXfer.mNextBlockCounter)
+    {
+        err = aXfer.mExchangeContext->ExpectResponse();
+        SuccessOrExit(err);
+    }
+
+exit:
+    if (block != NULL)
+    {
+        PacketBuffer::Free(block);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Retransmits the oldest unacknowledged block of a windowed transfer, which
+ *  the receiver has asked for again, then tops the window back up.
+ */
+static WEAVE_ERROR ResendWindowV1(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (aXfer.mBlockCounter != aXfer.mNextBlockCounter)
+    {
+        WeaveLogDetail(BDX, "Resending block # %d\n", aXfer.mBlockCounter);
+
+        err = SendWindowBlockV1(aXfer, aXfer.mBlockCounter);
+        SuccessOrExit(err);
+    }
+
+    err = SendWindowV1(aXfer);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Releases the sender's copies of every block before aBlockCounter, which the
+ *  receiver has acknowledged, and slides the window up to it.
+ */
+static void SlideWindowV1(BDXTransfer &aXfer, uint32_t aBlockCounter)
+{
+    while (aXfer.mBlockCounter != aBlockCounter)
+    {
+        uint8_t slot = WindowSlot(aXfer.mBlockCounter);
+
+        if (aXfer.mWindowBlocks[slot] != NULL)
+        {
+            PacketBuffer::Free(aXfer.mWindowBlocks[slot]);
+            aXfer.mWindowBlocks[slot] = NULL;
+        }
+
+        aXfer.mBlockCounter++;
+    }
+}
+
+/**
+ * @brief
+ *  Handles a BlockAckV1 or BlockQueryV1 received by the sender of a windowed
+ *  transfer.  Either one acknowledges every block before aBlockCounter; a
+ *  query also asks for block aBlockCounter to be sent again.
+ */
+static void HandleWindowAckV1(BDXTransfer &aXfer, uint32_t aBlockCounter, bool aIsQuery)
+{
+    if (aBlockCounter < aXfer.mBlockCounter || aBlockCounter > aXfer.mNextBlockCounter)
+    {
+        WeaveLogDetail(BDX, "Received bad block counter: %d, expected: %d - %d", aBlockCounter, aXfer.mBlockCounter, aXfer.mNextBlockCounter);
+
+        if (aBlockCounter > aXfer.mNextBlockCounter)
+        {
+            // Only send a status report for a block that was never sent, and ignore
+            // acknowledgements that have been overtaken by later ones
+            aXfer.mNext = SendBadBlockCounterStatusReport;
+        }
+    }
+    else
+    {
+        SlideWindowV1(aXfer, aBlockCounter);
+        aXfer.mNext = aIsQuery ? ResendWindowV1 : SendWindowV1;
+    }
+}
+
+/**
+ * @brief
+ *  Hands a block held by the receiver of a windowed transfer to the
+ *  application and releases it.
+ */
+static WEAVE_ERROR DeliverHeldBlockV1(BDXTransfer &aXfer, PacketBuffer *aBlock, bool aIsLast)
+{
+    WEAVE_ERROR err;
+    BlockSendV1 blockSendV1;
+
+    err = BlockSendV1::parse(aBlock, blockSendV1);
+    if (err == WEAVE_NO_ERROR)
+    {
+        aXfer.DispatchPutBlockHandler(blockSendV1.mLength, blockSendV1.mData, aIsLast);
+    }
+
+    PacketBuffer::Free(aBlock);
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Handles a BlockSendV1 or BlockEOFV1 received on a windowed transfer,
+ *  delivering blocks to the application in order and deciding whether to
+ *  acknowledge them or to ask for a missing one.
+ */
+static WEAVE_ERROR HandleWindowBlockV1(BDXTransfer &aXfer, PacketBuffer *aPacketBuffer, bool aIsLast)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BlockSendV1 blockSendV1;
+    uint32_t    rcvdCounter;
+    uint8_t     slot;
+
+    err = BlockSendV1::parse(aPacketBuffer, blockSendV1);
+    VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
+
+    rcvdCounter = blockSendV1.mBlockCounter;
+
+    if (rcvdCounter < aXfer.mBlockCounter)
+    {
+        // Ignore a retransmission of a block that has already been delivered
+        WeaveLogDetail(BDX, "Received bad block counter: %d, expected: %d", rcvdCounter, aXfer.mBlockCounter);
+        ExitNow();
+    }
+
+    if (aIsLast)
+    {
+        aXfer.mIsLastBlockKnown = true;
+        aXfer.mLastBlockCounter = rcvdCounter;
+    }
+
+    if (rcvdCounter >= aXfer.mNextBlockCounter)
+    {
+        aXfer.mNextBlockCounter = rcvdCounter + 1;
+    }
+
+    if (rcvdCounter != aXfer.mBlockCounter)
+    {
+        // Hold on to a block that arrived ahead of a missing one, as long as it fits
+        // this end's window; a block that doesn't is dropped and asked for later.
+        slot = WindowSlot(rcvdCounter);
+
+        if (rcvdCounter - aXfer.mBlockCounter < aXfer.mWindowSize && aXfer.mWindowBlocks[slot] == NULL)
+        {
+            aPacketBuffer->AddRef();
+            aXfer.mWindowBlocks[slot] = aPacketBuffer;
+        }
+
+        if (!aXfer.mIsBlockQueried)
+        {
+            aXfer.mNext = SendWindowQueryV1;
+        }
+
+        ExitNow();
+    }
+
+    aXfer.DispatchPutBlockHandler(blockSendV1.mLength, blockSendV1.mData, aIsLast);
+
+    // Hand over every held block that is now in order
+    while (!(aXfer.mIsLastBlockKnown && aXfer.mBlockCounter == aXfer.mLastBlockCounter))
+    {
+        PacketBuffer *held;
+
+        aXfer.mBlockCounter++;
+        aXfer.mIsBlockQueried = false;
+
+        slot = WindowSlot(aXfer.mBlockCounter);
+        held = aXfer.mWindowBlocks[slot];
+        if (held == NULL)
+        {
+            break;
+        }
+
+        aXfer.mWindowBlocks[slot] = NULL;
+
+        err = DeliverHeldBlockV1(aXfer, held, aXfer.mIsLastBlockKnown && aXfer.mBlockCounter == aXfer.mLastBlockCounter);
+        SuccessOrExit(err);
+    }
+
+    if (aXfer.mIsLastBlockKnown && aXfer.mBlockCounter == aXfer.mLastBlockCounter)
+    {
+        // SendBlockEOFAckV1 acks aXfer.mBlockCounter and completes the transfer
+        aXfer.mNext = SendBlockEOFAckV1;
+    }
+    else if (aXfer.mNextBlockCounter != aXfer.mBlockCounter)
+    {
+        // A later block has been seen, so the next one in order is missing
+        aXfer.mNext = SendWindowQueryV1;
+    }
+    else
+    {
+        aXfer.mNext = SendWindowAckV1;
+    }
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
 /**
  * @brief
  *  The main handler for messages arriving on the BDX exchange.  It essentially
@@ -656,10 +1098,21 @@ void HandleResponse(ExchangeContext *anEc, const IPPacketInfo *aPktInfo, const W
     WEAVE_ERROR err = WEAVE_NO_ERROR;	// we'll use this later
     // extract the BDXTransfer object from the exchange context to access state
     BDXTransfer *xfer = static_cast<BDXTransfer *>(anEc->AppState);
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    WEAVE_ERROR (*scheduledNext)(BDXTransfer &) = NULL;
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
 
     VerifyOrExit(aProfileId == kWeaveProfile_BDX || (aProfileId == kWeaveProfile_Common && aMessageType == Common::kMsgType_StatusReport), err = WEAVE_ERROR_INVALID_PROFILE_ID);
     VerifyOrExit(xfer->mIsInitiated, err = WEAVE_ERROR_INCORRECT_STATE);
 
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    // A send already waiting in the node's queue stands unless this message calls for something else.
+    if (xfer->mIsScheduled)
+    {
+        scheduledNext = xfer->mNext;
+    }
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
     // (Re-)Initialize the next action to take
     xfer->mNext = NULL;
 
@@ -686,6 +1139,19 @@ void HandleResponse(ExchangeContext *anEc, const IPPacketInfo *aPktInfo, const W
     PacketBuffer::Free(aPacketBuffer);
     aPacketBuffer = NULL;
 
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    if (xfer->mNext == NULL && xfer->mIsScheduled)
+    {
+        xfer->mNext = scheduledNext;
+    }
+
+    // Blocks a node sends wait their turn in its send queue, which keeps hold of mNext.
+    if (xfer->mNext && xfer->mAmSender && xfer->mNode != NULL && xfer->mNext != SendBadBlockCounterStatusReport)
+    {
+        err = xfer->mNode->ScheduleTransfer(*xfer);
+    }
+    else
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
     if (xfer->mNext)
     {
         err = xfer->mNext(*xfer);
@@ -923,6 +1389,15 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
 
                     rcvdCounter = ackV1.mBlockCounter;
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    if (aXfer.IsWindowed())
+                    {
+                        // The ack covers every block up to and including rcvdCounter
+                        HandleWindowAckV1(aXfer, rcvdCounter + 1, false);
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
                         // Update the counter and send the next block
@@ -986,6 +1461,19 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
                 {
                     BlockQueryV1 queryV1;
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    if (aXfer.IsWindowed())
+                    {
+                        // The receiver of a windowed transfer is missing this block, and has
+                        // every block before it
+                        err = BlockQueryV1::parse(aPacketBuffer, queryV1);
+                        VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockQueryV1 parse failed."));
+
+                        HandleWindowAckV1(aXfer, queryV1.mBlockCounter, true);
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
                     VerifyOrExit(!aXfer.IsDriver() && !aXfer.IsAsync(), err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
 
                     err = BlockQueryV1::parse(aPacketBuffer, queryV1);
@@ -1046,6 +1534,14 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
 
                     rcvdCounter = EOFAckV1.mBlockCounter;
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    if (aXfer.IsWindowed() && aXfer.mIsLastBlockKnown && rcvdCounter == aXfer.mLastBlockCounter)
+                    {
+                        // Every block before the last one has arrived as well
+                        SlideWindowV1(aXfer, rcvdCounter);
+                    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
                         aXfer.mIsCompletedSuccessfully = true;
@@ -1137,6 +1633,15 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
             case kMsgType_BlockSendV1:
                 {
                     BlockSendV1 blockSendV1;
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    if (aXfer.IsWindowed())
+                    {
+                        err = HandleWindowBlockV1(aXfer, aPacketBuffer, false);
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
                     err = BlockSendV1::parse(aPacketBuffer, blockSendV1);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
 
@@ -1195,6 +1700,15 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
             case kMsgType_BlockEOFV1:
                 {
                     BlockEOFV1 blockEOFV1;
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    if (aXfer.IsWindowed())
+                    {
+                        err = HandleWindowBlockV1(aXfer, aPacketBuffer, true);
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
                     err = BlockEOFV1::parse(aPacketBuffer, blockEOFV1);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockEOFV1 parse failed."));
 
@@ -1306,6 +1820,9 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mMaxBlockSize = inMsg.mMaxBlockSize;
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    aXfer.mWindowSize = NegotiateWindowSize(aXfer, inMsg.mWindowSize);
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
                     err = aXfer.DispatchSendAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchSendAccept failed."));
 
@@ -1322,6 +1839,13 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
 #else
                             aXfer.mNext = aXfer.mVersion == 1 ? SendNextBlockV1 : NULL;
 #endif // WEAVE_CONFIG_BDX_V0_SUPPORT
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                            if (aXfer.IsWindowed())
+                            {
+                                aXfer.mNext = SendWindowV1;
+                            }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
                             break;
 
                         case kMode_ReceiverDrive:
@@ -1381,6 +1905,9 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
                     aXfer.mLength = inMsg.mLength;
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+                    aXfer.mWindowSize = NegotiateWindowSize(aXfer, inMsg.mWindowSize);
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
                     err = aXfer.DispatchReceiveAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchReceiveAccept failed."));
                     xferMode = inMsg.mTransferMode;
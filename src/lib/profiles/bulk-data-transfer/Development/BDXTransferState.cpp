@@ -25,6 +25,8 @@
 #include <Weave/Support/logging/WeaveLogging.h>
 
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXTransferState.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXFileSource.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXNode.h>
 
 namespace nl {
 namespace Weave {
@@ -53,6 +55,32 @@ using namespace nl::Weave::Logging;
  */
 void BDXTransfer::Shutdown(void)
 {
+    BdxNode *node = mIsInitiated ? mNode : NULL;
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    if (mIsScheduled && mNode != NULL)
+    {
+        mNode->UnscheduleTransfer(*this);
+    }
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE; i++)
+    {
+        if (mWindowBlocks[i] != NULL)
+        {
+            PacketBuffer::Free(mWindowBlocks[i]);
+        }
+    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+    if (mFileSource != NULL)
+    {
+        mFileSource->DetachTransfer(*this);
+    }
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
     if (mExchangeContext != NULL)
     {
         if (mIsCompletedSuccessfully)
@@ -66,6 +94,12 @@ void BDXTransfer::Shutdown(void)
     }
 
     Reset();
+
+    // Hand the transfer back to the node it came from.
+    if (node != NULL)
+    {
+        node->ReleaseTransfer(*this);
+    }
 }
 
 /**
@@ -87,6 +121,33 @@ void BDXTransfer::Reset(void)
     mIsCompletedSuccessfully        = false;
     mAmInitiator                    = false;
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    mWindowSize                     = 1;
+    mIsLastBlockKnown               = false;
+    mIsBlockQueried                 = false;
+    mNextBlockCounter               = 0;
+    mLastBlockCounter               = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE; i++)
+    {
+        mWindowBlocks[i]            = NULL;
+    }
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+    mFileSource                     = NULL;
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
+    mNode                           = NULL;
+    mNextTransfer                   = NULL;
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    mPrevTransfer                   = NULL;
+    mIsScheduled                    = false;
+    mMaxBytesPerSec                 = 0;
+    mNextSendTimeMS                 = 0;
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
     mHandlers.mSendAcceptHandler    = NULL;
     mHandlers.mReceiveAcceptHandler = NULL;
     mHandlers.mRejectHandler        = NULL;
@@ -123,6 +184,21 @@ bool BDXTransfer::IsDriver(void)
             (!mAmSender && (mTransferMode & kMode_ReceiverDrive)));
 }
 
+/**
+ * @brief
+ *      Returns true if this transfer keeps more than one block in flight, false otherwise.
+ *
+ * @return true iff the transfer is windowed
+ */
+bool BDXTransfer::IsWindowed(void)
+{
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    return mWindowSize > 1;
+#else
+    return false;
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+}
+
 /**
  * @brief
  *  This function sets the handlers on this BDXTransfer object.  You should always
@@ -40,6 +40,10 @@ namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesigna
 #define DEFAULT_MAX_BLOCK_SIZE 256
 
 struct BDXTransfer; // forward declaration for inclusion in callbacks
+class BdxNode;
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+class BdxFileSource;
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
 
 // typedefs for handler types needed below
 
@@ -290,13 +294,53 @@ struct BDXTransfer
      */
     uint32_t            mBlockCounter;
 
+#if WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+    /** The number of blocks a windowed sender may have in flight, 1 if the
+     * transfer is not windowed.  Set it above 1 before initiating a transfer,
+     * or from the SendInit/ReceiveInit handler when responding, to offer a
+     * windowed sender-drive transfer; once the transfer is accepted it holds
+     * the size both ends settled on.  While a transfer is windowed,
+     * mBlockCounter is the oldest unacknowledged block on the sender and the
+     * next block to hand to the application on the receiver.
+     */
+    uint8_t             mWindowSize;
+    bool                mIsLastBlockKnown; // true once the sender has fetched, or the receiver has seen, the BlockEOF
+    bool                mIsBlockQueried; // receiver: true if mBlockCounter has already been asked for again
+    uint32_t            mNextBlockCounter; // sender: next new block to fetch; receiver: one past the highest block seen
+    uint32_t            mLastBlockCounter; // counter of the BlockEOF, valid when mIsLastBlockKnown is true
+    /** Blocks held by a windowed transfer, indexed by block counter modulo
+     * WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE: the sender's unacknowledged blocks,
+     * or the blocks the receiver got ahead of a missing one.
+     */
+    PacketBuffer *      mWindowBlocks[WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE];
+#endif // WEAVE_CONFIG_BDX_WINDOWED_SUPPORT
+
+#if WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+    BdxFileSource *     mFileSource; // File this transfer is sending from, set by BdxFileSource::AttachTransfer()
+#endif // WEAVE_CONFIG_BDX_FILE_SOURCE_SUPPORT
+
+    BdxNode *           mNode; // Node the transfer was allocated from, NULL if it was set up by hand
+    BDXTransfer *       mNextTransfer; // Next transfer in the node's free list or send queue
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    BDXTransfer *       mPrevTransfer; // Previous transfer in the node's send queue
+    bool                mIsScheduled; // true while the transfer is waiting in the node's send queue
+    /** Cap on the rate at which the node sends this transfer's blocks, in
+     * bytes per second, or 0 for none.  Set it before the transfer starts,
+     * e.g. from the ReceiveInit handler, and keep it well above one block per
+     * WEAVE_CONFIG_BDX_RESPONSE_TIMEOUT_SEC so that the peer doesn't time out.
+     */
+    uint32_t            mMaxBytesPerSec;
+    uint64_t            mNextSendTimeMS; // Time before which a capped transfer may not send again
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
     // application-supplied handlers
     //TODO: make these private when BdxProtocol doesn't inspect them directly
     //before calling DispatchGetBlockHandler().  We'll have to remove that check
     //anyway if we move to a delegate model.
     BDXHandlers mHandlers;
 
-    WEAVE_ERROR (*mNext)(BDXTransfer &); // Next action to take after the processing of the response
+    WEAVE_ERROR (*mNext)(BDXTransfer &); // Next action to take after the processing of the response, or once scheduled
 
     void Shutdown(void);
 
@@ -306,6 +350,8 @@ struct BDXTransfer
 
     bool IsDriver(void);
 
+    bool IsWindowed(void);
+
     void SetHandlers(BDXHandlers aHandlers);
 
     uint16_t GetDefaultFlags(bool aExpectResponse);
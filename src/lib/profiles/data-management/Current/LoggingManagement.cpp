@@ -27,12 +27,23 @@
 
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/DataManagement.h>
+#include <Weave/Support/WeaveFaultInjection.h>
 
 #include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
 
 #include <SystemLayer/SystemTimer.h>
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#include <sched.h>
+#endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#if WEAVE_SYSTEM_CONFIG_FREERTOS_LOCKING
+#include <FreeRTOS.h>
+#include <task.h>
+#endif // WEAVE_SYSTEM_CONFIG_FREERTOS_LOCKING
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
 #if HAVE_NEW
 #include <new>
 #else
@@ -60,6 +71,34 @@ namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNames
 // Overhead of embedding something in a (short) byte string: 1 byte control, 1 byte tag, 1 byte length
 #define EXTERNAL_EVENT_BYTE_STRING_TLV_SIZE 3
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+// Largest element with a 1-byte context tag: control byte, tag, and value
+#define CONTEXT_TAGGED_TLV_SIZE(aValueSize) (2 + (aValueSize))
+// Largest anonymous element: control byte and value
+#define ANONYMOUS_TLV_SIZE(aValueSize) (1 + (aValueSize))
+// Related event importance and ID
+#define RELATED_EVENT_TLV_SIZE (CONTEXT_TAGGED_TLV_SIZE(sizeof(uint16_t)) + CONTEXT_TAGGED_TLV_SIZE(sizeof(event_id_t)))
+// Delta time; the UTC delta is the larger of the two
+#define DELTA_TIME_TLV_SIZE CONTEXT_TAGGED_TLV_SIZE(sizeof(int64_t))
+// Profile ID array: the array and its end-of-container, the profile ID, and both schema versions
+#define TRAIT_PROFILE_TLV_SIZE                                                                                                     \
+    (CONTEXT_TAGGED_TLV_SIZE(0) + 1 + ANONYMOUS_TLV_SIZE(sizeof(uint32_t)) + 2 * ANONYMOUS_TLV_SIZE(sizeof(SchemaVersion)))
+// Resource ID, as a byte string with a 1-byte length holding the resource type and ID, and the trait instance ID
+#define EVENT_SOURCE_TLV_SIZE                                                                                                      \
+    (CONTEXT_TAGGED_TLV_SIZE(1 + sizeof(uint16_t) + sizeof(uint64_t)) + CONTEXT_TAGGED_TLV_SIZE(sizeof(uint64_t)))
+// Event type
+#define EVENT_TYPE_TLV_SIZE CONTEXT_TAGGED_TLV_SIZE(sizeof(uint32_t))
+// Largest metadata BlitEvent writes around the data of an event that is not the first in its buffer
+#define EVENT_METADATA_MAX_TLV_SIZE                                                                                                \
+    (EVENT_CONTAINER_OVERHEAD_TLV_SIZE + IMPORTANCE_TLV_SIZE + RELATED_EVENT_TLV_SIZE + DELTA_TIME_TLV_SIZE +                      \
+     TRAIT_PROFILE_TLV_SIZE + EVENT_SOURCE_TLV_SIZE + EVENT_TYPE_TLV_SIZE)
+// The staging gate counts the threads staging events in its low bits, and the threads writing events directly above them
+#define STAGING_GATE_CLOSED 0x10000
+#define STAGING_GATE_STAGERS_MASK (STAGING_GATE_CLOSED - 1)
+// Number of times a thread writing an event directly polls the staging gate before yielding the processor
+#define STAGING_GATE_SPINS 64
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
 // Static instance: embedded platforms not always implement a proper
 // C++ runtime; instead, the instance is initialized via placement new
 // in CreateLoggingManangement.
@@ -77,6 +116,21 @@ struct ReclaimEventCtx
     size_t mSpaceNeededForEvent;
 };
 
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+/**
+ * @brief
+ *   Return the start of the oldest element in a circular buffer.  The
+ *   head of the buffer may point just past the end of its storage;
+ *   map it back to the start.
+ */
+static const uint8_t * GetHeadReadPoint(const WeaveCircularTLVBuffer & inBuffer)
+{
+    const uint8_t * head = inBuffer.QueueHead();
+
+    return (head == inBuffer.GetQueue() + inBuffer.GetQueueSize()) ? inBuffer.GetQueue() : head;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
 WEAVE_ERROR LoggingManagement::AlwaysFail(nl::Weave::TLV::WeaveCircularTLVBuffer & inBuffer, void * inAppData,
                                           nl::Weave::TLV::TLVReader & inReader)
 {
@@ -123,6 +177,10 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
     CircularEventBuffer * eventBuffer = mEventBuffer;
     WeaveCircularTLVBuffer * circularBuffer;
     ReclaimEventCtx ctx;
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    const uint8_t * head;
+    const uint8_t * copyPoint;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
 
     // check whether we actually need to do anything, exit if we don't
     VerifyOrExit(requiredSpace > eventBuffer->mBuffer.AvailableDataLength(), err = WEAVE_NO_ERROR);
@@ -140,8 +198,19 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
 
             circularBuffer->mProcessEvictedElement = EvictEvent;
             circularBuffer->mAppData               = &ctx;
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+            head = GetHeadReadPoint(*circularBuffer);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
             err                                    = circularBuffer->EvictHead();
 
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+            if (err == WEAVE_NO_ERROR)
+            {
+                // the event was dropped from the log
+                AdvanceEventIndexEntry(eventBuffer, head);
+            }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
             // one of two things happened: either the element was evicted,
             // or we figured out how much space we need to evict it into
             // the next buffer
@@ -157,6 +226,9 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+                    copyPoint = eventBuffer->mNext->mBuffer.QueueTail();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
                     err = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
 
@@ -169,6 +241,9 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+                    MoveEventIndexEntry(eventBuffer, head, copyPoint);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -453,6 +528,12 @@ void LoggingManagement::CreateLoggingManagement(nl::Weave::WeaveExchangeManager
  */
 void LoggingManagement::DestroyLoggingManagement(void)
 {
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    // Stop staging events for good; events still staged are dropped
+    // along with the buffers.
+    sInstance.CloseStaging();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     Platform::CriticalSectionEnter();
     sInstance.mState       = kLoggingManagementState_Shutdown;
     sInstance.mEventBuffer = NULL;
@@ -545,6 +626,23 @@ LoggingManagement::LoggingManagement(WeaveExchangeManager * inMgr, size_t inNumB
     mBytesWritten        = 0;
     mUploadRequested     = false;
     mMaxImportanceBuffer = static_cast<ImportanceType>(inNumBuffers);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    for (i = 0; i < kImportanceType_Last; i++)
+    {
+        mEventIndex[i].Reset();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    for (current = mEventBuffer; current != NULL; current = current->mNext)
+    {
+        GetStagingRing(current)->Reset(current->mEventIdCounter->GetValue());
+    }
+    mStagingGate    = STAGING_GATE_CLOSED;
+    mStagingEnabled = false;
+    mDrainRequested = false;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
 }
 
 /**
@@ -599,6 +697,23 @@ LoggingManagement::LoggingManagement(WeaveExchangeManager * inMgr, size_t inNumB
     mBytesWritten        = 0;
     mUploadRequested     = false;
     mMaxImportanceBuffer = static_cast<ImportanceType>(inNumBuffers);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    for (i = 0; i < kImportanceType_Last; i++)
+    {
+        mEventIndex[i].Reset();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    for (current = mEventBuffer; current != NULL; current = current->mNext)
+    {
+        GetStagingRing(current)->Reset(current->mEventIdCounter->GetValue());
+    }
+    mStagingGate    = STAGING_GATE_CLOSED;
+    mStagingEnabled = false;
+    mDrainRequested = false;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
 }
 /**
  * @brief
@@ -610,7 +725,17 @@ LoggingManagement::LoggingManagement(WeaveExchangeManager * inMgr, size_t inNumB
 LoggingManagement::LoggingManagement(void) :
     mEventBuffer(NULL), mExchangeMgr(NULL), mState(kLoggingManagementState_Idle), mBDXUploader(NULL), mBytesWritten(0),
     mThrottled(0), mMaxImportanceBuffer(kImportanceType_Invalid), mUploadRequested(false)
-{ }
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    , mStagingGate(STAGING_GATE_CLOSED), mStagingEnabled(false), mDrainRequested(false)
+#endif
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    for (size_t i = 0; i < kImportanceType_Last; i++)
+    {
+        mEventIndex[i].Reset();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+}
 
 /**
  * @brief
@@ -697,7 +822,20 @@ event_id_t CircularEventBuffer::VendEventID(void)
  */
 event_id_t LoggingManagement::GetLastEventID(ImportanceType inImportance)
 {
-    return GetImportanceBuffer(inImportance)->mLastEventID;
+    CircularEventBuffer * buffer = GetImportanceBuffer(inImportance);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    // Staged events have been vended their IDs already
+    EventStagingRing * ring = GetStagingRing(buffer);
+    event_id_t nextEventID  = ring->mNextEventID;
+
+    if (nextEventID != ring->mDrainEventID)
+    {
+        return nextEventID - 1;
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
+    return buffer->mLastEventID;
 }
 
 /**
@@ -886,8 +1024,17 @@ WEAVE_ERROR LoggingManagement::RegisterEventCallbackForImportance(ImportanceType
     CircularEventBuffer * buf = GetImportanceBuffer(inImportance);
     CircularTLVWriter writer;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    // The external events take their IDs after the events already staged
+    CloseStaging();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     Platform::CriticalSectionEnter();
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    DrainStagedEventsPrivate();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     WeaveCircularTLVBuffer checkpoint = mEventBuffer->mBuffer;
 
     VerifyOrExit(inFetchCallback != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
@@ -933,6 +1080,10 @@ exit:
         }
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    OpenStaging();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     Platform::CriticalSectionExit();
 
     return err;
@@ -1153,91 +1304,169 @@ event_id_t LoggingManagement::LogEvent(const EventSchema & inSchema, EventWriter
 {
     event_id_t event_id = 0;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    if (StageEvent(inSchema, inEventWriter, inAppData, inOptions, event_id))
+    {
+        return event_id;
+    }
+
+    // The event could not be staged; write it directly, after the
+    // events already staged.
+    CloseStaging();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     Platform::CriticalSectionEnter();
 
     // Make sure we're alive.
     VerifyOrExit(mState != kLoggingManagementState_Shutdown, /* no-op */);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    DrainStagedEventsPrivate();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
     event_id = LogEventPrivate(inSchema, inEventWriter, inAppData, inOptions);
 
 exit:
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    OpenStaging();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
     Platform::CriticalSectionExit();
     return event_id;
 }
 
-// Note: the function below must be called with the critical section
-// locked, and only when the logger is not shutting down
-
-inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
-                                                     const EventOptions * inOptions)
+/**
+ * @brief
+ *   Fill in the metadata of an event being logged.
+ *
+ * @param[in]    inOptions The options passed to LogEvent(); may be NULL.
+ *
+ * @param[inout] ioOpts    The options to record with the event; on
+ *                         input, holding the current system time.
+ */
+static void PrepareEventOptions(const EventOptions * inOptions, EventOptions & ioOpts)
 {
-    event_id_t event_id = 0;
-    CircularTLVWriter writer;
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    size_t requestSize = WEAVE_CONFIG_EVENT_SIZE_RESERVE;
-    bool didWriteEvent = false;
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     int32_t ev_opts_deltatime = 0;
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    WeaveCircularTLVBuffer checkpoint = mEventBuffer->mBuffer;
-    EventLoadOutContext ctxt =
-        EventLoadOutContext(writer, inSchema.mImportance, GetImportanceBuffer(inSchema.mImportance)->mLastEventID, NULL);
-    EventOptions opts = EventOptions(static_cast<timestamp_t>(System::Timer::GetCurrentEpoch()));
-
-    // check whether the entry is to be logged or discarded silently
-    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), /* no-op */);
 
     // Create all event specific data
     // Timestamp; encoded as a delta time
     if ((inOptions != NULL) && (inOptions->timestampType == kTimestampType_System))
     {
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-        ev_opts_deltatime = inOptions->timestamp.systemTimestamp - opts.timestamp.systemTimestamp;
+        ev_opts_deltatime = inOptions->timestamp.systemTimestamp - ioOpts.timestamp.systemTimestamp;
 #endif
-        opts.timestamp.systemTimestamp = inOptions->timestamp.systemTimestamp;
-    }
-
-    if (GetImportanceBuffer(inSchema.mImportance)->mFirstEventTimestamp == 0)
-    {
-        GetImportanceBuffer(inSchema.mImportance)->AddEvent(opts.timestamp.systemTimestamp);
+        ioOpts.timestamp.systemTimestamp = inOptions->timestamp.systemTimestamp;
     }
 
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     // UTC timestamp; encoded as a delta time
     if ((inOptions != NULL) && (inOptions->timestampType == kTimestampType_UTC))
     {
-        opts.timestamp.utcTimestamp = inOptions->timestamp.utcTimestamp;
-        opts.timestampType          = kTimestampType_UTC;
+        ioOpts.timestamp.utcTimestamp = inOptions->timestamp.utcTimestamp;
+        ioOpts.timestampType          = kTimestampType_UTC;
     }
     else
     {
         uint64_t utc_tmp;
-        err = System::Layer::GetClock_RealTimeMS(utc_tmp);
+        WEAVE_ERROR err = System::Layer::GetClock_RealTimeMS(utc_tmp);
         if ((err == WEAVE_NO_ERROR) && (utc_tmp != 0))
         {
-            opts.timestamp.utcTimestamp = static_cast<utc_timestamp_t>(utc_tmp + ev_opts_deltatime);
-            opts.timestampType          = kTimestampType_UTC;
+            ioOpts.timestamp.utcTimestamp = static_cast<utc_timestamp_t>(utc_tmp + ev_opts_deltatime);
+            ioOpts.timestampType          = kTimestampType_UTC;
         }
     }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
-    if ((opts.timestampType == kTimestampType_UTC) && (GetImportanceBuffer(inSchema.mImportance)->mFirstEventUTCTimestamp == 0))
+    if (inOptions != NULL)
     {
-        GetImportanceBuffer(inSchema.mImportance)->AddEventUTC(opts.timestamp.utcTimestamp);
+        ioOpts.eventSource       = inOptions->eventSource;
+        ioOpts.relatedEventID    = inOptions->relatedEventID;
+        ioOpts.relatedImportance = inOptions->relatedImportance;
+        ioOpts.urgent            = inOptions->urgent;
     }
-#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+}
 
-    if (inOptions != NULL)
+// Note: the function below must be called with the critical section
+// locked, and only when the logger is not shutting down
+
+inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                                                     const EventOptions * inOptions)
+{
+    event_id_t event_id = 0;
+    EventOptions opts   = EventOptions(static_cast<timestamp_t>(System::Timer::GetCurrentEpoch()));
+    WEAVE_ERROR err;
+
+    // check whether the entry is to be logged or discarded silently
+    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), /* no-op */);
+
+    PrepareEventOptions(inOptions, opts);
+
+    err = WriteEvent(inSchema, inEventWriter, inAppData, opts, event_id);
+    SuccessOrExit(err);
+
+    ScheduleFlushIfNeeded(opts.urgent);
+
+exit:
+    return event_id;
+}
+
+/**
+ * @brief
+ *   Write an event to the event buffers and vend its event ID.
+ *
+ * The function must be called with the critical section locked, and
+ * only when the logger is not shutting down.
+ *
+ * @param[in] inSchema      Schema defining importance, profile ID, and
+ *                          structure type of this event.
+ *
+ * @param[in] inEventWriter The callback to invoke to serialize the event data.
+ *
+ * @param[in] inAppData     Application context for the callback.
+ *
+ * @param[in] inOptions     The complete metadata of the event, as
+ *                          filled in by PrepareEventOptions().
+ *
+ * @param[out] outEventID   The event ID of the event written; left
+ *                          unchanged if the event was not written.
+ *
+ * @retval #WEAVE_NO_ERROR  The event was written to the log.
+ * @retval other            The event could not be written, and no
+ *                          event ID was vended.
+ */
+WEAVE_ERROR LoggingManagement::WriteEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                                          const EventOptions & inOptions, event_id_t & outEventID)
+{
+    event_id_t event_id = 0;
+    CircularTLVWriter writer;
+    WEAVE_ERROR err              = WEAVE_NO_ERROR;
+    size_t requestSize           = WEAVE_CONFIG_EVENT_SIZE_RESERVE;
+    bool didWriteEvent           = false;
+    CircularEventBuffer * buffer = GetImportanceBuffer(inSchema.mImportance);
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    const uint8_t * writePoint = NULL;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    WeaveCircularTLVBuffer checkpoint = mEventBuffer->mBuffer;
+    EventLoadOutContext ctxt          = EventLoadOutContext(writer, inSchema.mImportance, buffer->mLastEventID, NULL);
+
+    if (buffer->mFirstEventTimestamp == 0)
+    {
+        buffer->AddEvent(inOptions.timestamp.systemTimestamp);
+    }
+
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    if ((inOptions.timestampType == kTimestampType_UTC) && (buffer->mFirstEventUTCTimestamp == 0))
     {
-        opts.eventSource       = inOptions->eventSource;
-        opts.relatedEventID    = inOptions->relatedEventID;
-        opts.relatedImportance = inOptions->relatedImportance;
+        buffer->AddEventUTC(inOptions.timestamp.utcTimestamp);
     }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
     ctxt.mFirst          = false;
-    ctxt.mCurrentEventID = GetImportanceBuffer(inSchema.mImportance)->mLastEventID;
-    ctxt.mCurrentTime    = GetImportanceBuffer(inSchema.mImportance)->mLastEventTimestamp;
+    ctxt.mCurrentEventID = buffer->mLastEventID;
+    ctxt.mCurrentTime    = buffer->mLastEventTimestamp;
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    ctxt.mCurrentUTCTime = GetImportanceBuffer(inSchema.mImportance)->mLastEventUTCTimestamp;
+    ctxt.mCurrentUTCTime = buffer->mLastEventUTCTimestamp;
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
     // Begin writing
@@ -1257,11 +1486,14 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
         // be affected by the writes to the `writer` below, and thus
         // that's the only thing we need to checkpoint.
         checkpoint = mEventBuffer->mBuffer;
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+        writePoint = mEventBuffer->mBuffer.QueueTail();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
 
         // Start the event container (anonymous structure) in the circular buffer
         writer.Init(&(mEventBuffer->mBuffer));
 
-        err = BlitEvent(&ctxt, inSchema, inEventWriter, inAppData, &opts);
+        err = BlitEvent(&ctxt, inSchema, inEventWriter, inAppData, &inOptions);
 
         if (err == WEAVE_ERROR_NO_MEMORY)
         {
@@ -1278,14 +1510,14 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
     {
         // Check the number of bytes written.  If the event is loo large
         // to be evicted from subsequent buffers, drop it now.
-        CircularEventBuffer * buffer = mEventBuffer;
+        CircularEventBuffer * nextBuffer = mEventBuffer;
         do
         {
-            VerifyOrExit(buffer->mBuffer.GetQueueSize() >= writer.GetLengthWritten(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
-            if (buffer->IsFinalDestinationForImportance(inSchema.mImportance))
+            VerifyOrExit(nextBuffer->mBuffer.GetQueueSize() >= writer.GetLengthWritten(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+            if (nextBuffer->IsFinalDestinationForImportance(inSchema.mImportance))
                 break;
             else
-                buffer = buffer->mNext;
+                nextBuffer = nextBuffer->mNext;
         } while (true);
     }
 
@@ -1297,200 +1529,728 @@ exit:
     {
         mEventBuffer->mBuffer = checkpoint;
     }
-    else if (inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId))
+    else
     {
-        event_id = GetImportanceBuffer(inSchema.mImportance)->VendEventID();
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+        // index the event before its ID is vended and its timestamp recorded
+        AddEventIndexEntry(writePoint, writer.GetLengthWritten());
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+        event_id = buffer->VendEventID();
 
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-        if (opts.timestampType == kTimestampType_UTC)
+        if (inOptions.timestampType == kTimestampType_UTC)
         {
-            GetImportanceBuffer(inSchema.mImportance)->AddEventUTC(opts.timestamp.utcTimestamp);
+            buffer->AddEventUTC(inOptions.timestamp.utcTimestamp);
 
 #if WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
             WeaveLogDetail(
                 EventLogging, "LogEvent event id: %u importance: %u profile id: 0x%x structure id: 0x%x utc timestamp: 0x%" PRIx64,
-                event_id, inSchema.mImportance, inSchema.mProfileId, inSchema.mStructureType, opts.timestamp.utcTimestamp);
+                event_id, inSchema.mImportance, inSchema.mProfileId, inSchema.mStructureType, inOptions.timestamp.utcTimestamp);
 #endif // WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         }
         else
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
         {
-            GetImportanceBuffer(inSchema.mImportance)->AddEvent(opts.timestamp.systemTimestamp);
+            buffer->AddEvent(inOptions.timestamp.systemTimestamp);
 
 #if WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
             WeaveLogDetail(
                 EventLogging, "LogEvent event id: %u importance: %u profile id: 0x%x structure id: 0x%x sys timestamp: 0x%" PRIx32,
-                event_id, inSchema.mImportance, inSchema.mProfileId, inSchema.mStructureType, opts.timestamp.systemTimestamp);
+                event_id, inSchema.mImportance, inSchema.mProfileId, inSchema.mStructureType, inOptions.timestamp.systemTimestamp);
 #endif // WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         }
 
-        ScheduleFlushIfNeeded(inOptions == NULL ? false : inOptions->urgent);
+        outEventID = event_id;
     }
 
-    return event_id;
+    return err;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
 /**
  * @brief
- *   ThrottleLogger elevates the effective logging level to the Production level.
+ *   Empty the ring, and have the next staged event take the given event ID.
  *
+ * @param[in] inNextEventID The event ID the next staged event reserves.
  */
-void LoggingManagement::ThrottleLogger(void)
+void EventStagingRing::Reset(event_id_t inNextEventID)
 {
-    WeaveLogProgress(EventLogging, "LogThrottle on");
+    mNextEventID  = inNextEventID;
+    mDrainEventID = inNextEventID;
 
-    __sync_add_and_fetch(&mThrottled, 1);
+    // Slots hold no event until an ID from inNextEventID onwards is published
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS; i++)
+    {
+        mPublishedEventID[i] = inNextEventID - 1;
+    }
 }
 
 /**
  * @brief
- *   UnthrottleLogger restores the effective logging level to the configured logging level.
+ *   Stage an event for the Weave thread to write to the event buffers.
+ *
+ * The event is filtered and its metadata prepared as in
+ * LogEventPrivate(); its data is serialized into a staging slot,
+ * whose event ID is reserved without taking the critical section.
+ * The event is not staged when staging is disabled, when it might
+ * not fit the event buffers from a slot, when the slots of its event
+ * ID space are all taken, or while a thread is writing an event
+ * directly.  An event that is not staged is written directly, so that
+ * the caller learns whether it was logged.
+ *
+ * @param[in]  inSchema      Schema defining importance, profile ID, and
+ *                           structure type of this event.
+ *
+ * @param[in]  inEventWriter The callback to invoke to serialize the event data.
  *
+ * @param[in]  inAppData     Application context for the callback.
+ *
+ * @param[in]  inOptions     The options for the event metadata. May be NULL.
+ *
+ * @param[out] outEventID    The event ID of the staged event, or 0 if
+ *                           the event was discarded.
+ *
+ * @retval true  The event was staged or discarded.
+ * @retval false The event must be written directly.
  */
-void LoggingManagement::UnthrottleLogger(void)
+bool LoggingManagement::StageEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                                   const EventOptions * inOptions, event_id_t & outEventID)
 {
-    uint32_t throttled = __sync_sub_and_fetch(&mThrottled, 1);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    StagedEvent event;
+    TLVWriter writer;
+    TLVType containerType;
+    CircularEventBuffer * buffer;
+    EventStagingRing * ring;
+    StagedEvent * slot;
+    event_id_t event_id  = 0;
+    bool didEnterStaging = false;
+    bool didStageEvent   = false;
+    bool retval          = false;
 
-    if (throttled == 0)
-    {
-        WeaveLogProgress(EventLogging, "LogThrottle off");
-    }
-}
+    VerifyOrExit(mStagingEnabled, /* no-op: write the event directly */);
 
+    // check whether the entry is to be logged or discarded silently
+    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), retval = true);
 
-// internal API, used to copy events to external buffers
-WEAVE_ERROR LoggingManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * aContext)
-{
-    TLVReader reader;
-    TLVType containerType;
-    CopyAndAdjustDeltaTimeContext context(&aWriter, aContext);
-    const bool recurse = false;
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    event.mSchema = inSchema;
 
-    reader.Init(aReader);
-    err = reader.EnterContainer(containerType);
-    SuccessOrExit(err);
+    writer.Init(event.mData, sizeof(event.mData));
 
-    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
     SuccessOrExit(err);
 
-    err = nl::Weave::TLV::Utilities::Iterate(reader, CopyAndAdjustDeltaTime, &context, recurse);
-    VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
-
-    err = aWriter.EndContainer(containerType);
+    err = inEventWriter(writer, kTag_EventData, inAppData);
     SuccessOrExit(err);
 
-    err = aWriter.Finalize();
+    err = writer.EndContainer(containerType);
+    SuccessOrExit(err);
 
-exit:
-    return err;
-}
+    err = writer.Finalize();
+    SuccessOrExit(err);
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    event.mDataLength = static_cast<uint16_t>(writer.GetLengthWritten());
 
-WEAVE_ERROR LoggingManagement::FindExternalEvents(const TLVReader & aReader, size_t aDepth, void * aContext)
-{
-    WEAVE_ERROR err;
-    EventLoadOutContext * context = static_cast<EventLoadOutContext *>(aContext);
+    didEnterStaging = EnterStaging();
+    VerifyOrExit(didEnterStaging, /* no-op: write the event directly */);
 
-    err = EventIterator(aReader, aDepth, aContext);
-    if (err == WEAVE_EVENT_ID_FOUND)
-    {
-        err = WEAVE_NO_ERROR;
-    }
-    if ((err == WEAVE_END_OF_TLV) && context->mExternalEvents->IsValid())
+    // The event must be sure to fit every buffer it passes through,
+    // since it cannot be dropped once its event ID is reserved; an
+    // event that might not is written directly, where a failure is
+    // returned to the caller.
+    buffer = mEventBuffer;
+    while (true)
     {
-        err = WEAVE_ERROR_MAX;
+        VerifyOrExit(buffer->mBuffer.GetQueueSize() >= static_cast<size_t>(event.mDataLength + EVENT_METADATA_MAX_TLV_SIZE),
+                     err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+        if (buffer->IsFinalDestinationForImportance(inSchema.mImportance))
+            break;
+        buffer = buffer->mNext;
     }
-    return err;
-}
 
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    // Reserve the next event ID, and with it a slot.
+    ring = GetStagingRing(buffer);
+    do
+    {
+        event_id = ring->mNextEventID;
+        VerifyOrExit(event_id - ring->mDrainEventID < WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS, err = WEAVE_ERROR_NO_MEMORY);
+    } while (!__sync_bool_compare_and_swap(&ring->mNextEventID, event_id, event_id + 1));
 
-/**
- * @brief Internal iterator function used to scan and filter though event logs
- *
- * The function is used to scan through the event log to find events matching the spec in the supplied context.
- */
+    slot              = &ring->mEvents[event_id % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+    slot->mSchema     = event.mSchema;
+    slot->mDataLength = event.mDataLength;
+    memcpy(slot->mData, event.mData, event.mDataLength);
 
-WEAVE_ERROR LoggingManagement::EventIterator(const TLVReader & aReader, size_t aDepth, void * aContext)
-{
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    const bool recurse = false;
-    TLVReader innerReader;
-    TLVType tlvType;
-    EventEnvelopeContext event;
-    EventLoadOutContext * loadOutContext = static_cast<EventLoadOutContext *>(aContext);
+    // Timestamp the event only now that its ID is reserved, so that
+    // events staged concurrently are timestamped in event ID order.
+    slot->mOptions = EventOptions(static_cast<timestamp_t>(System::Timer::GetCurrentEpoch()));
+    PrepareEventOptions(inOptions, slot->mOptions);
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
-    event.mExternalEvents = loadOutContext->mExternalEvents;
-    if (event.mExternalEvents != NULL)
+    if (slot->mOptions.eventSource != NULL)
     {
-        event.mExternalEvents->Invalidate();
+        slot->mEventSource = *slot->mOptions.eventSource;
     }
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
-    innerReader.Init(aReader);
-    err = innerReader.EnterContainer(tlvType);
-    SuccessOrExit(err);
+    // Publish the event only once the slot is complete.
+    __sync_synchronize();
+    ring->mPublishedEventID[event_id % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS] = event_id;
 
-    err = nl::Weave::TLV::Utilities::Iterate(innerReader, FetchEventParameters, &event, recurse);
-    VerifyOrExit(event.mNumFieldsToRead == 0, err = WEAVE_NO_ERROR);
+    outEventID    = event_id;
+    didStageEvent = true;
+    retval        = true;
 
-    err = WEAVE_NO_ERROR;
+exit:
+    if (didEnterStaging)
+    {
+        ExitStaging();
+    }
 
-    if (event.mImportance == loadOutContext->mImportance)
+    // Have the Weave thread write the staged events.
+    if (didStageEvent && __sync_bool_compare_and_swap(&mDrainRequested, false, true))
     {
+        err = WEAVE_ERROR_INCORRECT_STATE;
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
-        if ((event.mExternalEvents != NULL) && (event.mExternalEvents->IsValid()))
+        if ((mExchangeMgr != NULL) && (mExchangeMgr->MessageLayer != NULL) && (mExchangeMgr->MessageLayer->SystemLayer != NULL))
         {
-            // external event structure for the thing we want to read
-            // out.  if there is a chance this is to be written out by
-            // the app, kick it up to FetchEventsSince, otherwise skip
-            // over the block of external events.
-
-            // if we're in the process of writing, kick it up to FetchEventsSince
-            VerifyOrExit(loadOutContext->mCurrentEventID < loadOutContext->mStartingEventID, err = WEAVE_END_OF_TLV);
-
-            // if the external events are of interest, kick it up to the caller
-            VerifyOrExit(event.mExternalEvents->mLastEventID < loadOutContext->mStartingEventID, err = WEAVE_END_OF_TLV);
-
-            // otherwise, skip over the block of external events
-            loadOutContext->mCurrentEventID = event.mExternalEvents->mLastEventID + 1;
+            err = mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(LoggingDrainHandler, this);
+            if (err != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(EventLogging, "%s failed to schedule drain: %s", __FUNCTION__, ErrorStr(err));
+            }
         }
-        else
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
+        // Without a drain scheduled, let the next staged event try again;
+        // in the meantime the events are written when next fetched.
+        if (err != WEAVE_NO_ERROR)
         {
-            loadOutContext->mCurrentTime += event.mDeltaTime;
-#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-            loadOutContext->mCurrentUTCTime += event.mDeltaUtc;
-#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-            VerifyOrExit(loadOutContext->mCurrentEventID < loadOutContext->mStartingEventID, err = WEAVE_EVENT_ID_FOUND);
-            loadOutContext->mCurrentEventID++;
+            mDrainRequested = false;
         }
     }
 
-exit:
-    return err;
+    return retval;
+}
+
+EventStagingRing * LoggingManagement::GetStagingRing(const CircularEventBuffer * inBuffer)
+{
+    return &mStagingRing[inBuffer->mImportance - kImportanceType_First];
 }
 
 /**
  * @brief
- *   Internal API used to implement #FetchEventsSince
- *
- * Iterator function to used to copy an event from the log into a
- * TLVWriter. The included aContext contains the context of the copy
- * operation, including the TLVWriter that will hold the copy of an
- * event.  If event cannot be written as a whole, the TLVWriter will
- * be rolled back to event boundary.
+ *   Count the calling thread in among the threads staging events.
  *
- * @retval #WEAVE_END_OF_TLV             Function reached the end of the event
- * @retval #WEAVE_ERROR_NO_MEMORY        Function could not write a portion of
- *                                       the event to the TLVWriter.
- * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL Function could not write a
- *                                       portion of the event to the TLVWriter.
+ * @retval true  The thread may stage an event; call ExitStaging() when done.
+ * @retval false A thread is writing an event directly.
+ */
+bool LoggingManagement::EnterStaging(void)
+{
+    uint32_t gate;
+
+    do
+    {
+        gate = mStagingGate;
+        if (gate >= STAGING_GATE_CLOSED)
+            return false;
+    } while (!__sync_bool_compare_and_swap(&mStagingGate, gate, gate + 1));
+
+    return true;
+}
+
+void LoggingManagement::ExitStaging(void)
+{
+    __sync_sub_and_fetch(&mStagingGate, 1);
+}
+
+/**
+ * @brief
+ *   Stop threads from staging events, and wait for those staging an
+ *   event to publish it.
+ *
+ * Called before writing an event directly, so that every event ID
+ * reserved in a staging ring is published, and can be drained, by
+ * the time the critical section is taken.  Staging an event never
+ * blocks, so the wait is short, unless a thread staging an event is
+ * preempted; after polling briefly, the function yields the
+ * processor between polls, where the system locking model offers a
+ * way to, so that such a thread can run.
+ */
+void LoggingManagement::CloseStaging(void)
+{
+    __sync_add_and_fetch(&mStagingGate, STAGING_GATE_CLOSED);
+
+    for (uint32_t spins = 0; (mStagingGate & STAGING_GATE_STAGERS_MASK) != 0; spins++)
+    {
+        if (spins >= STAGING_GATE_SPINS)
+        {
+#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+            sched_yield();
+#elif WEAVE_SYSTEM_CONFIG_FREERTOS_LOCKING
+            taskYIELD();
+#endif
+        }
+    }
+}
+
+/**
+ * @brief
+ *   Let threads stage events again after writing events directly.
+ *
+ * Events written directly take their event IDs straight from the
+ * counters, so the staging rings restart from the counters' current
+ * values.  The function must be called with the critical section
+ * locked, after the staged events have been drained.  While staging
+ * is disabled, the gate stays closed.
+ */
+void LoggingManagement::OpenStaging(void)
+{
+    if (mStagingEnabled)
+    {
+        for (CircularEventBuffer * buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+        {
+            GetStagingRing(buffer)->Reset(buffer->mEventIdCounter->GetValue());
+        }
+    }
+
+    __sync_sub_and_fetch(&mStagingGate, STAGING_GATE_CLOSED);
+}
+
+/**
+ * @brief
+ *   Have LogEvent() stage events rather than write them directly.
+ *
+ * Staging is disabled when the logging subsystem is created.  Once
+ * enabled, LogEvent() returns as soon as an event is staged, and the
+ * event appears in the log once the Weave thread, or
+ * DrainStagedEvents(), writes it.
+ */
+void LoggingManagement::EnableStaging(void)
+{
+    Platform::CriticalSectionEnter();
+
+    if (!mStagingEnabled)
+    {
+        mStagingEnabled = true;
+        OpenStaging();
+    }
+
+    Platform::CriticalSectionExit();
+}
+
+/**
+ * @brief
+ *   Have LogEvent() write every event directly, after writing the
+ *   events already staged.
+ */
+void LoggingManagement::DisableStaging(void)
+{
+    Platform::CriticalSectionEnter();
+
+    if (mStagingEnabled)
+    {
+        // Threads staging events do not take the critical section, so
+        // they finish while it is held.
+        CloseStaging();
+        DrainStagedEventsPrivate();
+        mStagingEnabled = false;
+    }
+
+    Platform::CriticalSectionExit();
+}
+
+/**
+ * @brief
+ *   Write the staged events to the event buffers.
+ *
+ * LogEvent() returns as soon as an event is staged, and the Weave
+ * thread writes the staged events when it next runs; the function
+ * lets applications that log events without a Weave thread write the
+ * staged events at a time of their choosing.  Events are also written
+ * before events are fetched from the log.
+ */
+void LoggingManagement::DrainStagedEvents(void)
+{
+    Platform::CriticalSectionEnter();
+
+    // Make sure we're alive.
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, /* no-op */);
+
+    DrainStagedEventsPrivate();
+
+exit:
+    Platform::CriticalSectionExit();
+}
+
+// Note: the function below must be called with the critical section
+// locked
+
+void LoggingManagement::DrainStagedEventsPrivate(void)
+{
+    CircularEventBuffer * buffer;
+    EventStagingRing * ring;
+    StagedEvent * slot;
+    EventOptions opts;
+    event_id_t event_id;
+    event_id_t written_id;
+    WEAVE_ERROR err;
+    bool didDrainEvent = false;
+    bool urgent        = false;
+
+    for (buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+    {
+        ring = GetStagingRing(buffer);
+
+        // Write the events in event ID order, up to the first one
+        // still being staged.
+        for (event_id = ring->mDrainEventID; event_id != ring->mNextEventID; event_id++)
+        {
+            if (ring->mPublishedEventID[event_id % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS] != event_id)
+                break;
+
+            __sync_synchronize();
+
+            slot = &ring->mEvents[event_id % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+            opts = slot->mOptions;
+            if (opts.eventSource != NULL)
+            {
+                opts.eventSource = &slot->mEventSource;
+            }
+
+            // StageEvent() only stages events that fit every buffer
+            // they pass through, so the write is not expected to fail.
+            written_id = 0;
+            err        = WEAVE_NO_ERROR;
+            WEAVE_FAULT_INJECT(FaultInjection::kFault_WDM_StagedEventWrite, err = WEAVE_ERROR_NO_MEMORY);
+            if (err == WEAVE_NO_ERROR)
+            {
+                err = WriteEvent(slot->mSchema, CopyStagedEventData, slot, opts, written_id);
+            }
+            if (err != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(EventLogging, "%s failed to write staged event %u importance %u: %s", __FUNCTION__, event_id,
+                              slot->mSchema.mImportance, ErrorStr(err));
+
+                // The event ID was returned to the caller when the
+                // event was staged; consume it regardless, so that the
+                // events after it keep the IDs returned for them.
+                err = SkipStagedEvent(*slot, opts);
+                if (err != WEAVE_NO_ERROR)
+                {
+                    WeaveLogError(EventLogging, "%s failed to skip staged event %u importance %u: %s", __FUNCTION__, event_id,
+                                  slot->mSchema.mImportance, ErrorStr(err));
+                }
+            }
+            else if (written_id != event_id)
+            {
+                WeaveLogError(EventLogging, "%s wrote staged event %u importance %u as event %u", __FUNCTION__, event_id,
+                              slot->mSchema.mImportance, written_id);
+            }
+
+            didDrainEvent = true;
+            urgent |= opts.urgent;
+
+            // Release the slot only once the event has been written.
+            __sync_synchronize();
+            ring->mDrainEventID = event_id + 1;
+        }
+    }
+
+    if (didDrainEvent)
+    {
+        ScheduleFlushIfNeeded(urgent);
+    }
+}
+
+/**
+ * @brief
+ *   Consume the event ID of a staged event that could not be written.
+ *
+ * With external event support, the ID is covered by a block of
+ * external events without callbacks, which fetches skip over like an
+ * unregistered block.  Otherwise, an event with the schema of the
+ * staged event but no data is written in its place.
+ *
+ * The function must be called with the critical section locked.
+ *
+ * @param[in] inEvent   The staged event.
+ *
+ * @param[in] inOptions The metadata of the staged event.
+ */
+WEAVE_ERROR LoggingManagement::SkipStagedEvent(const StagedEvent & inEvent, const EventOptions & inOptions)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    ExternalEvents ev;
+    CircularEventBuffer * buf = GetImportanceBuffer(inEvent.mSchema.mImportance);
+    CircularTLVWriter writer;
+    WeaveCircularTLVBuffer checkpoint = mEventBuffer->mBuffer;
+
+    err = EnsureSpace(sizeof(ExternalEvents) + EVENT_CONTAINER_OVERHEAD_TLV_SIZE + IMPORTANCE_TLV_SIZE +
+                      EXTERNAL_EVENT_BYTE_STRING_TLV_SIZE);
+    SuccessOrExit(err);
+
+    checkpoint = mEventBuffer->mBuffer;
+
+    // The block covers only the event ID about to be vended.
+    ev.mFirstEventID             = buf->mEventIdCounter->GetValue();
+    ev.mLastEventID              = ev.mFirstEventID;
+    ev.mNotifyEventsEvictedFunct = NULL;
+
+    writer.Init(&(mEventBuffer->mBuffer));
+
+    err = BlitExternalEvent(writer, inEvent.mSchema.mImportance, ev);
+    SuccessOrExit(err);
+
+    mBytesWritten += writer.GetLengthWritten();
+
+    buf->VendEventID();
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        mEventBuffer->mBuffer = checkpoint;
+    }
+#else
+    event_id_t event_id = 0;
+
+    err = WriteEvent(inEvent.mSchema, WriteEmptyEventData, NULL, inOptions, event_id);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+    return err;
+}
+
+#if !WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+/**
+ * @brief
+ *   An EventWriterFunct that writes an empty event data structure.
+ */
+WEAVE_ERROR LoggingManagement::WriteEmptyEventData(TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData)
+{
+    WEAVE_ERROR err;
+    TLVType containerType;
+
+    err = ioWriter.StartContainer(ContextTag(inDataTag), kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = ioWriter.EndContainer(containerType);
+
+exit:
+    return err;
+}
+#endif // !WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+void LoggingManagement::LoggingDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err)
+{
+    LoggingManagement * logger = static_cast<LoggingManagement *>(appState);
+
+    // Clear the request first, so that events staged from here on
+    // schedule another drain.
+    logger->mDrainRequested = false;
+    logger->DrainStagedEvents();
+}
+
+/**
+ * @brief
+ *   An EventWriterFunct that writes the data of a staged event.
+ *
+ * @param[in] ioWriter  The writer to write the event data to.
+ *
+ * @param[in] inDataTag Unused; the staged event data carries its tag.
+ *
+ * @param[in] inAppData The StagedEvent.
+ */
+WEAVE_ERROR LoggingManagement::CopyStagedEventData(TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData)
+{
+    WEAVE_ERROR err           = WEAVE_NO_ERROR;
+    const StagedEvent * event = static_cast<const StagedEvent *>(inAppData);
+    TLVReader reader;
+    TLVType containerType;
+
+    reader.Init(event->mData, event->mDataLength);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.EnterContainer(containerType);
+    SuccessOrExit(err);
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = ioWriter.CopyElement(reader);
+        SuccessOrExit(err);
+    }
+
+    if (err == WEAVE_END_OF_TLV)
+    {
+        err = WEAVE_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
+/**
+ * @brief
+ *   ThrottleLogger elevates the effective logging level to the Production level.
+ *
+ */
+void LoggingManagement::ThrottleLogger(void)
+{
+    WeaveLogProgress(EventLogging, "LogThrottle on");
+
+    __sync_add_and_fetch(&mThrottled, 1);
+}
+
+/**
+ * @brief
+ *   UnthrottleLogger restores the effective logging level to the configured logging level.
+ *
+ */
+void LoggingManagement::UnthrottleLogger(void)
+{
+    uint32_t throttled = __sync_sub_and_fetch(&mThrottled, 1);
+
+    if (throttled == 0)
+    {
+        WeaveLogProgress(EventLogging, "LogThrottle off");
+    }
+}
+
+
+// internal API, used to copy events to external buffers
+WEAVE_ERROR LoggingManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * aContext)
+{
+    TLVReader reader;
+    TLVType containerType;
+    CopyAndAdjustDeltaTimeContext context(&aWriter, aContext);
+    const bool recurse = false;
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+
+    reader.Init(aReader);
+    err = reader.EnterContainer(containerType);
+    SuccessOrExit(err);
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = nl::Weave::TLV::Utilities::Iterate(reader, CopyAndAdjustDeltaTime, &context, recurse);
+    VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
+
+    err = aWriter.EndContainer(containerType);
+    SuccessOrExit(err);
+
+    err = aWriter.Finalize();
+
+exit:
+    return err;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+WEAVE_ERROR LoggingManagement::FindExternalEvents(const TLVReader & aReader, size_t aDepth, void * aContext)
+{
+    WEAVE_ERROR err;
+    EventLoadOutContext * context = static_cast<EventLoadOutContext *>(aContext);
+
+    err = EventIterator(aReader, aDepth, aContext);
+    if (err == WEAVE_EVENT_ID_FOUND)
+    {
+        err = WEAVE_NO_ERROR;
+    }
+    if ((err == WEAVE_END_OF_TLV) && context->mExternalEvents->IsValid())
+    {
+        err = WEAVE_ERROR_MAX;
+    }
+    return err;
+}
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+/**
+ * @brief Internal iterator function used to scan and filter though event logs
+ *
+ * The function is used to scan through the event log to find events matching the spec in the supplied context.
+ */
+
+WEAVE_ERROR LoggingManagement::EventIterator(const TLVReader & aReader, size_t aDepth, void * aContext)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const bool recurse = false;
+    TLVReader innerReader;
+    TLVType tlvType;
+    EventEnvelopeContext event;
+    EventLoadOutContext * loadOutContext = static_cast<EventLoadOutContext *>(aContext);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    event.mExternalEvents = loadOutContext->mExternalEvents;
+    if (event.mExternalEvents != NULL)
+    {
+        event.mExternalEvents->Invalidate();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+    innerReader.Init(aReader);
+    err = innerReader.EnterContainer(tlvType);
+    SuccessOrExit(err);
+
+    err = nl::Weave::TLV::Utilities::Iterate(innerReader, FetchEventParameters, &event, recurse);
+    VerifyOrExit(event.mNumFieldsToRead == 0, err = WEAVE_NO_ERROR);
+
+    err = WEAVE_NO_ERROR;
+
+    if (event.mImportance == loadOutContext->mImportance)
+    {
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+        if ((event.mExternalEvents != NULL) && (event.mExternalEvents->IsValid()))
+        {
+            // external event structure for the thing we want to read
+            // out.  if there is a chance this is to be written out by
+            // the app, kick it up to FetchEventsSince, otherwise skip
+            // over the block of external events.
+
+            // if we're in the process of writing, kick it up to FetchEventsSince
+            VerifyOrExit(loadOutContext->mCurrentEventID < loadOutContext->mStartingEventID, err = WEAVE_END_OF_TLV);
+
+            // if the external events are of interest, kick it up to the caller
+            VerifyOrExit(event.mExternalEvents->mLastEventID < loadOutContext->mStartingEventID, err = WEAVE_END_OF_TLV);
+
+            // otherwise, skip over the block of external events
+            loadOutContext->mCurrentEventID = event.mExternalEvents->mLastEventID + 1;
+        }
+        else
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+        {
+            loadOutContext->mCurrentTime += event.mDeltaTime;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            loadOutContext->mCurrentUTCTime += event.mDeltaUtc;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            VerifyOrExit(loadOutContext->mCurrentEventID < loadOutContext->mStartingEventID, err = WEAVE_EVENT_ID_FOUND);
+            loadOutContext->mCurrentEventID++;
+        }
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Internal API used to implement #FetchEventsSince
+ *
+ * Iterator function to used to copy an event from the log into a
+ * TLVWriter. The included aContext contains the context of the copy
+ * operation, including the TLVWriter that will hold the copy of an
+ * event.  If event cannot be written as a whole, the TLVWriter will
+ * be rolled back to event boundary.
+ *
+ * @retval #WEAVE_END_OF_TLV             Function reached the end of the event
+ * @retval #WEAVE_ERROR_NO_MEMORY        Function could not write a portion of
+ *                                       the event to the TLVWriter.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL Function could not write a
+ *                                       portion of the event to the TLVWriter.
  */
 WEAVE_ERROR LoggingManagement::CopyEventsSince(const TLVReader & aReader, size_t aDepth, void * aContext)
 {
@@ -1566,20 +2326,13 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
     EventLoadOutContext aContext(ioWriter, inImportance, ioEventID, NULL);
 #endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
-    CircularEventBuffer * buf = mEventBuffer;
     Platform::CriticalSectionEnter();
 
-    while (!buf->IsFinalDestinationForImportance(inImportance))
-    {
-        buf = buf->mNext;
-    }
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    DrainStagedEventsPrivate();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
 
-    aContext.mCurrentTime = buf->mFirstEventTimestamp;
-#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    aContext.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
-#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    aContext.mCurrentEventID = buf->mFirstEventID;
-    err                      = GetEventReader(reader, inImportance);
+    err = SeekEventReader(reader, inImportance, aContext);
     SuccessOrExit(err);
 
     err = nl::Weave::TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, recurse);
@@ -1641,6 +2394,94 @@ exit:
     return err;
 }
 
+/**
+ * @brief
+ *   Position a reader for scanning the events of the specified
+ *   importance from a given event ID onwards.
+ *
+ * The function initializes the reader and the event ID and timestamp
+ * state of the context so that iterating over the reader with
+ * #EventIterator visits the event with ID `ioContext.mStartingEventID`.
+ * Without an event ID index the reader is positioned at the start of
+ * the log; with the index it is positioned at the closest indexed
+ * event that precedes the requested one.
+ *
+ * @param[inout] ioReader  A reference to the reader to initialize.
+ *
+ * @param[in] inImportance The importance of the events to be read.
+ *
+ * @param[inout] ioContext The context of the scan; on input,
+ *                         mStartingEventID identifies the event of
+ *                         interest.
+ *
+ * @return                 #WEAVE_NO_ERROR on success, other errors
+ *                         as returned by #GetEventReader.
+ */
+WEAVE_ERROR LoggingManagement::SeekEventReader(TLVReader & ioReader, ImportanceType inImportance, EventLoadOutContext & ioContext)
+{
+    WEAVE_ERROR err           = WEAVE_NO_ERROR;
+    CircularEventBuffer * buf = GetImportanceBuffer(inImportance);
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    CircularEventBuffer * indexedBuf;
+    CircularEventReader reader;
+    EventIndex * index;
+    size_t slot;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+    ioContext.mCurrentTime = buf->mFirstEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    ioContext.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    ioContext.mCurrentEventID = buf->mFirstEventID;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    if (GetEventIndex(buf) != NULL)
+    {
+        slot = buf->mImportance - kImportanceType_First;
+
+        // Events of this importance are read from the final buffer
+        // back towards mEventBuffer; walk the indexes from the newest
+        // entry, and settle on the first one that precedes the
+        // requested event.
+        for (indexedBuf = mEventBuffer; indexedBuf != buf->mNext; indexedBuf = indexedBuf->mNext)
+        {
+            index = GetEventIndex(indexedBuf);
+            if (index == NULL)
+                continue;
+
+            for (size_t i = index->Count(); i > 0; i--)
+            {
+                const EventIndexEntry & entry = (*index)[i - 1];
+
+                if ((entry.mNextEventID[slot] > ioContext.mStartingEventID) || (entry.mNextEventID[slot] < buf->mFirstEventID))
+                    continue;
+
+                ioContext.mCurrentEventID = entry.mNextEventID[slot];
+                if (entry.mTimestamp[slot] != 0)
+                {
+                    ioContext.mCurrentTime = entry.mTimestamp[slot];
+                }
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+                if (entry.mUTCTimestamp[slot] != 0)
+                {
+                    ioContext.mCurrentUTCTime = entry.mUTCTimestamp[slot];
+                }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+                reader.Init(indexedBuf, entry.mReadPoint);
+                ioReader.Init(reader);
+                ExitNow();
+            }
+        }
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+    err = GetEventReader(ioReader, inImportance);
+
+exit:
+    return err;
+}
+
 // internal API
 WEAVE_ERROR LoggingManagement::FetchEventParameters(const TLVReader & aReader, size_t aDepth, void * aContext)
 {
@@ -2061,23 +2902,11 @@ WEAVE_ERROR LoggingManagement::GetExternalEventsFromEventId(ImportanceType inImp
     const bool recurse = false;
     TLVWriter writer;
     EventLoadOutContext aContext(writer, inImportance, inEventID, outExternalEvents);
-    CircularEventBuffer * buf = mEventBuffer;
     TLVReader resultReader;
 
     writer.Init(static_cast<uint8_t *>(static_cast<void *>(&dummyBuf)), sizeof(uint32_t));
 
-    while (!buf->IsFinalDestinationForImportance(inImportance))
-    {
-        buf = buf->mNext;
-    }
-
-    aContext.mCurrentTime = buf->mFirstEventTimestamp;
-
-#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    aContext.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
-#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    aContext.mCurrentEventID = buf->mFirstEventID;
-    err                      = GetEventReader(outReader, inImportance);
+    err = SeekEventReader(outReader, inImportance, aContext);
     SuccessOrExit(err);
 
     err = nl::Weave::TLV::Utilities::Find(outReader, FindExternalEvents, &aContext, resultReader, recurse);
@@ -2190,6 +3019,171 @@ void CircularEventBuffer::RemoveEvent(size_t aNumEvents)
     mFirstEventID += aNumEvents;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+void EventIndex::Reset(void)
+{
+    mHead                = 0;
+    mCount               = 0;
+    mBytesSinceLastEntry = 0;
+}
+
+void EventIndex::PushBack(const EventIndexEntry & inEntry)
+{
+    if (mCount == kCapacity)
+    {
+        // Out of room: drop every other entry, so that the remaining
+        // ones still span the whole buffer.
+        for (size_t i = 1; 2 * i < mCount; i++)
+        {
+            (*this)[i] = (*this)[2 * i];
+        }
+        mCount = (mCount + 1) / 2;
+    }
+
+    (*this)[mCount] = inEntry;
+    mCount++;
+}
+
+void EventIndex::PopFront(void)
+{
+    mHead = (mHead + 1) % kCapacity;
+    mCount--;
+}
+
+EventIndex * LoggingManagement::GetEventIndex(const CircularEventBuffer * inBuffer)
+{
+    size_t slot = inBuffer->mImportance - kImportanceType_First;
+
+    return (slot < kImportanceType_Last) ? &mEventIndex[slot] : NULL;
+}
+
+/**
+ * @brief
+ *   Index an event that has just been written to mEventBuffer.
+ *
+ * Entries are spaced so that the index of mEventBuffer covers the
+ * whole buffer.  The entry captures the state of every importance
+ * level at the event, so the function must be called before the
+ * event's ID is vended and its timestamp recorded.
+ *
+ * @param[in] inReadPoint   The start of the event in the buffer storage.
+ *
+ * @param[in] inEventLength The length of the event.
+ */
+void LoggingManagement::AddEventIndexEntry(const uint8_t * inReadPoint, size_t inEventLength)
+{
+    EventIndex * index = GetEventIndex(mEventBuffer);
+    CircularEventBuffer * buffer;
+    EventIndexEntry entry;
+    size_t slot;
+
+    VerifyOrExit(index != NULL, /* no-op */);
+
+    index->mBytesSinceLastEntry += inEventLength;
+    VerifyOrExit(index->mBytesSinceLastEntry >= mEventBuffer->mBuffer.GetQueueSize() / WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE,
+                 /* no-op */);
+
+    entry.mReadPoint = inReadPoint;
+
+    for (buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+    {
+        VerifyOrExit(GetEventIndex(buffer) != NULL, /* no-op */);
+
+        slot                     = buffer->mImportance - kImportanceType_First;
+        entry.mNextEventID[slot] = buffer->mEventIdCounter->GetValue();
+        entry.mTimestamp[slot]   = buffer->mLastEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        entry.mUTCTimestamp[slot] = buffer->mUTCInitialized ? buffer->mLastEventUTCTimestamp : 0;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    }
+
+    index->PushBack(entry);
+    index->mBytesSinceLastEntry = 0;
+
+exit:
+    return;
+}
+
+/**
+ * @brief
+ *   Follow an indexed event that was copied from the head of a buffer
+ *   into the next buffer.
+ *
+ * @param[in] inBuffer    The buffer the event was evicted from.
+ *
+ * @param[in] inOldHead   The start of the event in inBuffer.
+ *
+ * @param[in] inCopyPoint The start of the copy in the next buffer.
+ */
+void LoggingManagement::MoveEventIndexEntry(CircularEventBuffer * inBuffer, const uint8_t * inOldHead, const uint8_t * inCopyPoint)
+{
+    EventIndex * index     = GetEventIndex(inBuffer);
+    EventIndex * nextIndex = GetEventIndex(inBuffer->mNext);
+    EventIndexEntry entry;
+
+    VerifyOrExit((index != NULL) && (index->Count() > 0) && ((*index)[0].mReadPoint == inOldHead), /* no-op */);
+
+    if (nextIndex != NULL)
+    {
+        // The copy is appended to the next buffer, and thus follows
+        // all the events already indexed there.
+        entry            = (*index)[0];
+        entry.mReadPoint = inCopyPoint;
+        nextIndex->PushBack(entry);
+    }
+
+    index->PopFront();
+
+exit:
+    return;
+}
+
+/**
+ * @brief
+ *   Move an index entry off an event dropped from the head of a
+ *   buffer and onto the event that follows it.
+ *
+ * The buffer is the final destination of the dropped event, so
+ * readers of the dropped event's importance now start at the new
+ * head; their state at the entry is the first event state of the
+ * buffer.  The state of all other importance levels is unchanged.
+ *
+ * @param[in] inBuffer  The buffer the event was dropped from.
+ *
+ * @param[in] inOldHead The start of the dropped event.
+ */
+void LoggingManagement::AdvanceEventIndexEntry(CircularEventBuffer * inBuffer, const uint8_t * inOldHead)
+{
+    EventIndex * index = GetEventIndex(inBuffer);
+    const uint8_t * head;
+    size_t slot;
+
+    VerifyOrExit((index != NULL) && (index->Count() > 0) && ((*index)[0].mReadPoint == inOldHead), /* no-op */);
+
+    head = GetHeadReadPoint(inBuffer->mBuffer);
+
+    if ((inBuffer->mBuffer.DataLength() == 0) || ((index->Count() > 1) && ((*index)[1].mReadPoint == head)))
+    {
+        index->PopFront();
+    }
+    else
+    {
+        EventIndexEntry & entry = (*index)[0];
+
+        slot                     = inBuffer->mImportance - kImportanceType_First;
+        entry.mReadPoint         = head;
+        entry.mNextEventID[slot] = inBuffer->mFirstEventID;
+        entry.mTimestamp[slot]   = inBuffer->mFirstEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        entry.mUTCTimestamp[slot] = inBuffer->mUTCInitialized ? inBuffer->mFirstEventUTCTimestamp : 0;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    }
+
+exit:
+    return;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
 /**
  * @brief
  *   Initializes a TLVReader object backed by CircularEventBuffer
@@ -2216,6 +3210,42 @@ void CircularEventReader::Init(CircularEventBuffer * inBuf)
     }
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+/**
+ * @brief
+ *   Initializes a TLVReader object backed by CircularEventBuffer,
+ *   positioned at an element inside the buffer.
+ *
+ * @param[in] inBuf       A pointer to a fully initialized CircularEventBuffer
+ *
+ * @param[in] inReadPoint The start of an element stored in inBuf
+ *
+ */
+void CircularEventReader::Init(CircularEventBuffer * inBuf, const uint8_t * inReadPoint)
+{
+    const WeaveCircularTLVBuffer & buffer = inBuf->mBuffer;
+    size_t skipped;
+
+    Init(inBuf);
+
+    // The reader now spans the contiguous data from the head of the
+    // buffer; the element is either within it, or within the data
+    // that wraps around to the start of the storage.
+    if ((inReadPoint >= mReadPoint) && (inReadPoint < mBufEnd))
+    {
+        skipped = inReadPoint - mReadPoint;
+    }
+    else
+    {
+        skipped = (mBufEnd - mReadPoint) + (inReadPoint - buffer.GetQueue());
+        mBufEnd = buffer.QueueTail();
+    }
+
+    mReadPoint = inReadPoint;
+    mMaxLen -= skipped;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
 WEAVE_ERROR CircularEventBuffer::GetNextBufferFunct(TLVReader & ioReader, uintptr_t & inBufHandle, const uint8_t *& outBufStart,
                                                     uint32_t & outBufLen)
 {
@@ -104,8 +104,102 @@ class CircularEventReader : public nl::Weave::TLV::TLVReader
 
 public:
     void Init(CircularEventBuffer * inBuf);
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    void Init(CircularEventBuffer * inBuf, const uint8_t * inReadPoint);
+#endif
+};
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+/**
+ * @brief
+ *   A point in the event log from which events can be read without
+ *   scanning the log from its start.
+ *
+ * The entry locates the start of an event in a CircularEventBuffer.
+ * For each event buffer, indexed by its importance, it records the
+ * state an event reader starting at that buffer would have on
+ * reaching the event: the ID of the next event of that importance,
+ * and the timestamps the delta times of the following events are
+ * relative to.  A timestamp of 0 means that no such event had been
+ * logged yet.
+ */
+struct EventIndexEntry
+{
+    const uint8_t * mReadPoint; //< The start of the event element in the buffer storage
+
+    event_id_t mNextEventID[kImportanceType_Last]; //< The ID of the next event of each importance
+    timestamp_t mTimestamp[kImportanceType_Last];  //< The system timestamp preceding that event
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    utc_timestamp_t mUTCTimestamp[kImportanceType_Last]; //< The UTC timestamp preceding that event
+#endif
+};
+
+/**
+ * @brief
+ *   A sparse index of the events stored in one CircularEventBuffer,
+ *   ordered from the oldest event to the newest.
+ */
+struct EventIndex
+{
+    enum
+    {
+        kCapacity = WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE + 1
+    };
+
+    void Reset(void);
+    size_t Count(void) const { return mCount; };
+    EventIndexEntry & operator[](size_t inIndex) { return mEntries[(mHead + inIndex) % kCapacity]; };
+    void PushBack(const EventIndexEntry & inEntry);
+    void PopFront(void);
+
+    EventIndexEntry mEntries[kCapacity];
+    size_t mHead;
+    size_t mCount;
+    size_t mBytesSinceLastEntry; //< Bytes logged into the buffer since the newest entry was added
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+/**
+ * @brief
+ *   An event passed to LogEvent() that has not been written to the
+ *   event buffers yet.
+ *
+ * The event data is held in its serialized TLV form, wrapped in an
+ * anonymous structure.  The event source is copied out of the
+ * caller's storage.
+ */
+struct StagedEvent
+{
+    EventSchema mSchema;
+    EventOptions mOptions;
+    DetailedRootSection mEventSource;
+    uint16_t mDataLength;
+    uint8_t mData[WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE];
 };
 
+/**
+ * @brief
+ *   The events staged for one event ID space.
+ *
+ * Logging threads reserve consecutive event IDs at the tail of the
+ * ring and fill the matching slots; the Weave thread writes the
+ * events to the event buffers from the head, in event ID order.  A
+ * slot is ready once its published event ID matches the ID it was
+ * reserved for.
+ */
+struct EventStagingRing
+{
+    void Reset(event_id_t inNextEventID);
+
+    volatile event_id_t mNextEventID;  //< The event ID the next staged event reserves
+    volatile event_id_t mDrainEventID; //< The event ID of the oldest event not yet written to the event buffers
+
+    volatile event_id_t mPublishedEventID[WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS]; //< The ID of the event each slot holds
+    StagedEvent mEvents[WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
 /**
  * @brief
  *  Internal structure for traversing event list.
@@ -226,9 +320,35 @@ public:
 #if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
     bool CheckShouldRunWDM(void);
 #endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    void EnableStaging(void);
+    void DisableStaging(void);
+    void DrainStagedEvents(void);
+#endif
 private:
     event_id_t LogEventPrivate(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
                                const EventOptions * inOptions);
+    WEAVE_ERROR WriteEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                           const EventOptions & inOptions, event_id_t & outEventID);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    bool StageEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData, const EventOptions * inOptions,
+                    event_id_t & outEventID);
+    EventStagingRing * GetStagingRing(const CircularEventBuffer * inBuffer);
+    bool EnterStaging(void);
+    void ExitStaging(void);
+    void CloseStaging(void);
+    void OpenStaging(void);
+    void DrainStagedEventsPrivate(void);
+    WEAVE_ERROR SkipStagedEvent(const StagedEvent & inEvent, const EventOptions & inOptions);
+
+    static void LoggingDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
+    static WEAVE_ERROR CopyStagedEventData(nl::Weave::TLV::TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData);
+#if !WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    static WEAVE_ERROR WriteEmptyEventData(nl::Weave::TLV::TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData);
+#endif // !WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
 
     void FlushHandler(System::Layer * inSystemLayer, INET_ERROR inErr);
     void SignalUploadDone(void);
@@ -257,6 +377,15 @@ private:
 
 private:
     CircularEventBuffer * GetImportanceBuffer(ImportanceType inImportance) const;
+    WEAVE_ERROR SeekEventReader(nl::Weave::TLV::TLVReader & ioReader, ImportanceType inImportance,
+                                EventLoadOutContext & ioContext);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    EventIndex * GetEventIndex(const CircularEventBuffer * inBuffer);
+    void AddEventIndexEntry(const uint8_t * inReadPoint, size_t inEventLength);
+    void MoveEventIndexEntry(CircularEventBuffer * inBuffer, const uint8_t * inOldHead, const uint8_t * inCopyPoint);
+    void AdvanceEventIndexEntry(CircularEventBuffer * inBuffer, const uint8_t * inOldHead);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
 
 #if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
     static WEAVE_ERROR FindExternalEvents(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
@@ -271,6 +400,15 @@ private:
     uint32_t mThrottled;
     ImportanceType mMaxImportanceBuffer;
     bool mUploadRequested;
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    EventIndex mEventIndex[kImportanceType_Last];
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    EventStagingRing mStagingRing[kImportanceType_Last];
+    volatile uint32_t mStagingGate; //< Logging threads staging events, and requests to write events directly
+    volatile bool mStagingEnabled;
+    bool mDrainRequested;
+#endif
 };
 
 namespace Platform {
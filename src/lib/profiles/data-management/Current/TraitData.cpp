@@ -566,6 +566,35 @@ bool TraitSchemaEngine::IsParent(PropertyPathHandle aChildHandle, PropertyPathHa
     VerifyOrExit(aChildHandle != kNullPropertyPathHandle &&
                  aParentHandle != kNullPropertyPathHandle, );
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    {
+        const PropertyIndexEntry * index        = GetPropertyIndex();
+        PropertySchemaHandle childSchemaHandle  = GetPropertySchemaHandle(aChildHandle);
+        PropertySchemaHandle parentSchemaHandle = GetPropertySchemaHandle(aParentHandle);
+        PropertyDictionaryKey dictionaryKey     = GetPropertyDictionaryKey(aChildHandle);
+
+        if (index != NULL)
+        {
+            VerifyOrExit(childSchemaHandle <= mSchema.mNumSchemaHandleEntries + 1 &&
+                         parentSchemaHandle <= mSchema.mNumSchemaHandleEntries + 1, );
+
+            const PropertyIndexEntry & child  = index[childSchemaHandle - 1];
+            const PropertyIndexEntry & parent = index[parentSchemaHandle - 1];
+
+            VerifyOrExit(childSchemaHandle != kRootPropertyPathHandle && parent.mPreOrder < child.mPreOrder &&
+                         child.mPreOrder <= parent.mLastDescendant, );
+
+            // Walking up from the child keeps its dictionary key until it steps onto a dictionary.
+            if (child.mDictionary != kNullPropertyPathHandle && index[child.mDictionary - 1].mDepth >= parent.mDepth)
+            {
+                dictionaryKey = 0;
+            }
+
+            ExitNow(retval = (GetPropertyDictionaryKey(aParentHandle) == dictionaryKey));
+        }
+    }
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
     do
     {
         aChildHandle = GetParent(aChildHandle);
@@ -616,6 +645,46 @@ PropertyPathHandle TraitSchemaEngine::GetNextChild(PropertyPathHandle aParentHan
     PropertySchemaHandle childSchemaHandle    = GetPropertySchemaHandle(aChildHandle);
     PropertyDictionaryKey parentDictionaryKey = GetPropertyDictionaryKey(aParentHandle);
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    const PropertyIndexEntry * index = GetPropertyIndex();
+
+    if (index != NULL)
+    {
+        PropertySchemaHandle nextSchemaHandle = kNullPropertyPathHandle;
+
+        if (parentSchemaHandle == kNullPropertyPathHandle || parentSchemaHandle > mSchema.mNumSchemaHandleEntries + 1 ||
+            childSchemaHandle == kNullPropertyPathHandle || childSchemaHandle > mSchema.mNumSchemaHandleEntries + 1)
+        {
+            return kNullPropertyPathHandle;
+        }
+
+        if (childSchemaHandle == kRootPropertyPathHandle)
+        {
+            nextSchemaHandle = index[parentSchemaHandle - 1].mFirstChild;
+        }
+        else if (mSchema.mSchemaHandleTbl[childSchemaHandle - kHandleTableOffset].mParentHandle == parentSchemaHandle)
+        {
+            nextSchemaHandle = index[childSchemaHandle - 1].mNextSibling;
+        }
+        else
+        {
+            // Not a child of this parent; find the first child that follows it in the table.
+            for (nextSchemaHandle = index[parentSchemaHandle - 1].mFirstChild;
+                 nextSchemaHandle != kNullPropertyPathHandle && nextSchemaHandle <= childSchemaHandle;
+                 nextSchemaHandle = index[nextSchemaHandle - 1].mNextSibling)
+            {
+            }
+        }
+
+        if (nextSchemaHandle == kNullPropertyPathHandle)
+        {
+            return kNullPropertyPathHandle;
+        }
+
+        return CreatePropertyPathHandle(nextSchemaHandle, parentDictionaryKey);
+    }
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
     // Starting from 1 node after the child node that's been passed in, iterate till we find the next child belonging to aParentId.
     for (i = (childSchemaHandle - 1); i < mSchema.mNumSchemaHandleEntries; i++)
     {
@@ -647,6 +716,47 @@ PropertyPathHandle TraitSchemaEngine::GetChildHandle(PropertyPathHandle aParentH
 
 PropertyPathHandle TraitSchemaEngine::_GetChildHandle(PropertyPathHandle aParentHandle, uint8_t aContextTag) const
 {
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    const PropertyIndexEntry * index = GetPropertyIndex();
+
+    if (index != NULL)
+    {
+        PropertySchemaHandle parentSchemaHandle = GetPropertySchemaHandle(aParentHandle);
+        uint32_t low, high;
+
+        if (parentSchemaHandle == kNullPropertyPathHandle || parentSchemaHandle > mSchema.mNumSchemaHandleEntries + 1)
+        {
+            return kNullPropertyPathHandle;
+        }
+
+        // Binary search the parent's tag-sorted children for the first one with this tag.
+        low  = index[parentSchemaHandle - 1].mTagSortedOffset;
+        high = low + index[parentSchemaHandle - 1].mNumChildren;
+
+        while (low < high)
+        {
+            const uint32_t mid = (low + high) / 2;
+
+            if (mSchema.mSchemaHandleTbl[index[mid].mTagSortedChild - kHandleTableOffset].mContextTag < aContextTag)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        if (low == index[parentSchemaHandle - 1].mTagSortedOffset + index[parentSchemaHandle - 1].mNumChildren ||
+            mSchema.mSchemaHandleTbl[index[low].mTagSortedChild - kHandleTableOffset].mContextTag != aContextTag)
+        {
+            return kNullPropertyPathHandle;
+        }
+
+        return CreatePropertyPathHandle(index[low].mTagSortedChild, GetPropertyDictionaryKey(aParentHandle));
+    }
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
     for (PropertyPathHandle childProperty = GetFirstChild(aParentHandle); !IsNullPropertyPathHandle(childProperty);
          childProperty                    = GetNextChild(aParentHandle, childProperty))
     {
@@ -681,6 +791,16 @@ bool TraitSchemaEngine::IsLeaf(PropertyPathHandle aHandle) const
     }
     else
     {
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        const PropertyIndexEntry * index = GetPropertyIndex();
+
+        if (index != NULL)
+        {
+            return (schemaHandle == kNullPropertyPathHandle || schemaHandle > mSchema.mNumSchemaHandleEntries + 1 ||
+                    index[schemaHandle - 1].mFirstChild == kNullPropertyPathHandle);
+        }
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
         for (unsigned int i = 0; i < mSchema.mNumSchemaHandleEntries; i++)
         {
             if (mSchema.mSchemaHandleTbl[i].mParentHandle == schemaHandle)
@@ -703,6 +823,17 @@ int32_t TraitSchemaEngine::GetDepth(PropertyPathHandle aHandle) const
         return -1;
     }
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    {
+        const PropertyIndexEntry * index = GetPropertyIndex();
+
+        if (index != NULL && schemaHandle != kNullPropertyPathHandle)
+        {
+            return index[schemaHandle - 1].mDepth;
+        }
+    }
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
     while (schemaHandle != kRootPropertyPathHandle)
     {
         depth++;
@@ -766,6 +897,116 @@ PropertyPathHandle TraitSchemaEngine::FindLowestCommonAncestor(PropertyPathHandl
     return aHandle1;
 }
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+const TraitSchemaEngine::PropertyIndexEntry * TraitSchemaEngine::GetPropertyIndex(void) const
+{
+    PropertyIndexEntry * index = mSchema.mPropertyIndex;
+
+    // Every property descends from the root, so the root has a child in any schema that has properties; a root without one
+    // marks an index that has not been built yet.
+    if (index != NULL && index[0].mFirstChild == kNullPropertyPathHandle && mSchema.mNumSchemaHandleEntries > 0)
+    {
+        BuildPropertyIndex();
+    }
+
+    return index;
+}
+
+void TraitSchemaEngine::BuildPropertyIndex(void) const
+{
+    PropertyIndexEntry * index = mSchema.mPropertyIndex;
+    const uint32_t numEntries  = mSchema.mNumSchemaHandleEntries + 1;
+    uint32_t offset            = 0;
+
+    memset(index, 0, numEntries * sizeof(PropertyIndexEntry));
+
+    // Link every handle into its parent's list of children. Walking the table backwards leaves each list in table order.
+    for (uint32_t i = mSchema.mNumSchemaHandleEntries; i > 0; i--)
+    {
+        const PropertySchemaHandle handle       = static_cast<PropertySchemaHandle>(i - 1 + kHandleTableOffset);
+        const PropertySchemaHandle parentHandle = mSchema.mSchemaHandleTbl[i - 1].mParentHandle;
+
+        if (parentHandle == kNullPropertyPathHandle || parentHandle > numEntries)
+        {
+            continue;
+        }
+
+        index[handle - 1].mNextSibling = index[parentHandle - 1].mFirstChild;
+        index[parentHandle - 1].mFirstChild = handle;
+        index[parentHandle - 1].mNumChildren++;
+    }
+
+    // Give each handle a run of entries for its children, and insertion sort them into it by context tag. The sort is stable, so
+    // children sharing a tag stay in table order, as a scan of the table would find them.
+    for (uint32_t i = 0; i < numEntries; i++)
+    {
+        uint32_t numSorted = 0;
+
+        index[i].mTagSortedOffset = static_cast<PropertySchemaHandle>(offset);
+
+        for (PropertySchemaHandle child = index[i].mFirstChild; child != kNullPropertyPathHandle; child = index[child - 1].mNextSibling)
+        {
+            const uint8_t tag = mSchema.mSchemaHandleTbl[child - kHandleTableOffset].mContextTag;
+            uint32_t j        = offset + numSorted;
+
+            while (j > offset && mSchema.mSchemaHandleTbl[index[j - 1].mTagSortedChild - kHandleTableOffset].mContextTag > tag)
+            {
+                index[j].mTagSortedChild = index[j - 1].mTagSortedChild;
+                j--;
+            }
+
+            index[j].mTagSortedChild = child;
+            numSorted++;
+        }
+
+        offset += numSorted;
+    }
+
+    // Number the handles in pre-order, climbing back up through the parents once a subtree is done.
+    offset = 0;
+
+    for (PropertySchemaHandle handle = kRootPropertyPathHandle; handle != kNullPropertyPathHandle;)
+    {
+        PropertyIndexEntry & entry = index[handle - 1];
+
+        entry.mPreOrder = static_cast<PropertySchemaHandle>(offset++);
+
+        if (handle != kRootPropertyPathHandle)
+        {
+            const PropertySchemaHandle parentHandle = mSchema.mSchemaHandleTbl[handle - kHandleTableOffset].mParentHandle;
+
+            entry.mDepth      = static_cast<PropertySchemaHandle>(index[parentHandle - 1].mDepth + 1);
+            entry.mDictionary = IsDictionary(parentHandle) ? parentHandle : index[parentHandle - 1].mDictionary;
+        }
+
+        if (entry.mFirstChild != kNullPropertyPathHandle)
+        {
+            handle = entry.mFirstChild;
+            continue;
+        }
+
+        while (handle != kNullPropertyPathHandle)
+        {
+            index[handle - 1].mLastDescendant = static_cast<PropertySchemaHandle>(offset - 1);
+
+            if (handle == kRootPropertyPathHandle)
+            {
+                handle = kNullPropertyPathHandle;
+            }
+            else if (index[handle - 1].mNextSibling != kNullPropertyPathHandle)
+            {
+                handle = index[handle - 1].mNextSibling;
+                break;
+            }
+            else
+            {
+                handle = mSchema.mSchemaHandleTbl[handle - kHandleTableOffset].mParentHandle;
+            }
+        }
+    }
+}
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
 const TraitSchemaEngine::PropertyInfo * TraitSchemaEngine::GetMap(PropertyPathHandle aHandle) const
 {
     PropertySchemaHandle schemaHandle = GetPropertySchemaHandle(aHandle);
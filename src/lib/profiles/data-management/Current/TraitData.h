@@ -176,6 +176,26 @@ public:
         uint8_t mContextTag;
     };
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    /* Index entry for a particular schema handle, linking it to its children and siblings. The children of every handle are
+     * also listed, sorted by context tag, in the mTagSortedChild fields of a run of consecutive entries. The pre-order
+     * numbers of a handle and its last descendant bound the interval holding the pre-order numbers of all its descendants,
+     * which answers ancestor queries without walking up the tree.
+     */
+    struct PropertyIndexEntry
+    {
+        PropertySchemaHandle mFirstChild;      //< The first child in table order, or kNullPropertyPathHandle for a leaf.
+        PropertySchemaHandle mNextSibling;     //< The next child of the same parent in table order, or kNullPropertyPathHandle.
+        PropertySchemaHandle mNumChildren;     //< The number of children.
+        PropertySchemaHandle mTagSortedOffset; //< The entry at which the tag-sorted list of children starts.
+        PropertySchemaHandle mTagSortedChild;  //< The element of the tag-sorted lists of children held by this entry.
+        PropertySchemaHandle mPreOrder;        //< The position of this handle in a pre-order walk of the tree, the root being 0.
+        PropertySchemaHandle mLastDescendant;  //< The pre-order position of the last descendant, or mPreOrder for a leaf.
+        PropertySchemaHandle mDepth;           //< The number of ancestors.
+        PropertySchemaHandle mDictionary;      //< The closest ancestor that is a dictionary, or kNullPropertyPathHandle.
+    };
+#endif
+
     /**
      *  @brief
      *    The main schema structure that houses the schema information.
@@ -200,6 +220,11 @@ public:
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         const ConstSchemaVersionRange *mVersionRange;     //< Range of versions supported by this trait
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndexEntry *mPropertyIndex;    //< Storage for mNumSchemaHandleEntries + 1 entries, the first for the root, into
+                                               //which an index of the schema tree is built on first use. If NULL, the schema
+                                               //handle table is searched instead.
 #endif
     };
 
@@ -522,6 +547,10 @@ public:
 private:
     PropertyPathHandle _GetChildHandle(PropertyPathHandle aParentHandle, uint8_t aContextTag) const;
     bool GetBitFromPathHandleBitfield(uint8_t * aBitfield, PropertyPathHandle aPathHandle) const;
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    const PropertyIndexEntry * GetPropertyIndex(void) const;
+    void BuildPropertyIndex(void) const;
+#endif
 
 public:
     const Schema mSchema;
@@ -58,6 +58,11 @@ TraitPathStore::TraitPathStore()
  */
 void TraitPathStore::Init(TraitPathStore::Record *aRecordArray, size_t aArrayLength)
 {
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    // Records are chained by 16-bit index.
+    VerifyOrDie(aArrayLength < kNoRecord);
+#endif
+
     mStore = aRecordArray;
     mStoreSize = aArrayLength;
 
@@ -110,6 +115,11 @@ WEAVE_ERROR TraitPathStore::AddItem(const TraitPath &aItem, Flags aFlags)
     SetItem(i, aItem, aFlags);
     mNumItems++;
 
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    LinkItem(i);
+    mFirstFreeHint = i + 1;
+#endif
+
 exit:
     return err;
 }
@@ -195,6 +205,11 @@ WEAVE_ERROR TraitPathStore::InsertItemAt(size_t aIndex, const TraitPath &aItem,
     SetItem(aIndex, aItem, aFlags);
     mNumItems++;
 
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    // The items after aIndex have moved up a slot.
+    RebuildIndex();
+#endif
+
 exit:
     return err;
 }
@@ -206,10 +221,13 @@ exit:
  */
 void TraitPathStore::RemoveTrait(TraitDataHandle aDataHandle)
 {
+    size_t next;
+
     for (size_t i = GetFirstValidItem(aDataHandle);
             i < mStoreSize;
-            i = GetNextValidItem(i, aDataHandle))
+            i = next)
     {
+        next = GetNextValidItem(i, aDataHandle);
         RemoveItemAt(i);
     }
 }
@@ -261,6 +279,14 @@ void TraitPathStore::RemoveItemAt(size_t aIndex)
 
     if (IsItemInUse(aIndex))
     {
+#if TDM_PATH_STORE_INDEX_SUPPORT
+        UnlinkItem(aIndex);
+        if (aIndex < mFirstFreeHint)
+        {
+            mFirstFreeHint = aIndex;
+        }
+#endif
+
         ClearItem(aIndex);
         mNumItems--;
     }
@@ -294,6 +320,10 @@ void TraitPathStore::Compact()
         memmove(&mStore[i], &mStore[i+1], numBytesToMove);
         SetFlags(lastIndex, kFlag_InUse, false);
     }
+
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    RebuildIndex();
+#endif
 }
 
 /**
@@ -305,7 +335,9 @@ void TraitPathStore::Compact()
  */
 bool TraitPathStore::IsPresent(const TraitPath &aItem) const
 {
-    for (size_t i = GetFirstValidItem(); i < mStoreSize; i = GetNextValidItem(i))
+    TraitDataHandle dataHandle = aItem.mTraitDataHandle;
+
+    for (size_t i = GetFirstValidItem(dataHandle); i < mStoreSize; i = GetNextValidItem(i, dataHandle))
     {
         if (mStore[i].mTraitPath == aItem)
         {
@@ -390,6 +422,15 @@ void TraitPathStore::Clear()
     {
         ClearItem(i);
     }
+
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    for (size_t i = 0; i < TDM_PATH_STORE_NUM_BUCKETS; i++)
+    {
+        mBucketHead[i] = kNoRecord;
+    }
+
+    mFirstFreeHint = 0;
+#endif
 }
 
 /**
@@ -440,6 +481,9 @@ size_t TraitPathStore::GetNextValidItem(size_t aIndex) const
  */
 size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
 {
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    return GetFirstValidItemInBucket(mBucketHead[GetBucket(aTDH)], aTDH);
+#else
     size_t i = GetFirstValidItem();
 
     while (i < mStoreSize && mStore[i].mTraitPath.mTraitDataHandle != aTDH)
@@ -448,6 +492,7 @@ size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
     }
 
     return i;
+#endif
 }
 
 /**
@@ -460,6 +505,28 @@ size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
  */
 size_t TraitPathStore::GetNextValidItem(size_t aIndex, TraitDataHandle aTDH) const
 {
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    size_t next;
+
+    if (aIndex >= mStoreSize)
+    {
+        return aIndex + 1;
+    }
+
+    if (IsItemInUse(aIndex) && GetBucket(mStore[aIndex].mTraitPath.mTraitDataHandle) == GetBucket(aTDH))
+    {
+        next = mStore[aIndex].mNextInBucket;
+    }
+    else
+    {
+        // aIndex is not in the bucket, typically because it was just removed; find the first record after it.
+        for (next = mBucketHead[GetBucket(aTDH)]; next != kNoRecord && next <= aIndex; next = mStore[next].mNextInBucket)
+        {
+        }
+    }
+
+    return GetFirstValidItemInBucket(next, aTDH);
+#else
     do
     {
         aIndex = GetNextValidItem(aIndex);
@@ -467,6 +534,7 @@ size_t TraitPathStore::GetNextValidItem(size_t aIndex, TraitDataHandle aTDH) con
     while (aIndex < mStoreSize && mStore[aIndex].mTraitPath.mTraitDataHandle != aTDH);
 
     return aIndex;
+#endif
 }
 
 bool TraitPathStore::AreFlagsSet(size_t aIndex, Flags aFlags) const
@@ -483,7 +551,12 @@ bool TraitPathStore::AreFlagsSet(size_t aIndex, Flags aFlags) const
 
 size_t TraitPathStore::FindFirstAvailableItem() const
 {
+#if TDM_PATH_STORE_INDEX_SUPPORT
+    // Every slot below mFirstFreeHint is in use.
+    size_t i = mFirstFreeHint;
+#else
     size_t i = 0;
+#endif
 
     while (i < mStoreSize && IsItemInUse(i))
     {
@@ -515,3 +588,82 @@ void TraitPathStore::SetFlags(size_t aIndex, Flags aFlags, bool aValue)
         mStore[aIndex].mFlags |= aFlags;
     }
 }
+
+#if TDM_PATH_STORE_INDEX_SUPPORT
+/**
+ * @param[in] aIndex    The index of a record in the bucket of aTDH, or kNoRecord.
+ * @param[in] aTDH      The TraitDataHandle of the trait instance to iterate on.
+ *
+ * @return The index of the first valid item at or after aIndex in the bucket
+ *          which refers to aTDH, or mStoreSize if there is none.
+ */
+size_t TraitPathStore::GetFirstValidItemInBucket(size_t aIndex, TraitDataHandle aTDH) const
+{
+    while (aIndex != kNoRecord && (mStore[aIndex].mTraitPath.mTraitDataHandle != aTDH || IsItemFailed(aIndex)))
+    {
+        aIndex = mStore[aIndex].mNextInBucket;
+    }
+
+    return (aIndex == kNoRecord) ? mStoreSize : aIndex;
+}
+
+void TraitPathStore::LinkItem(size_t aIndex)
+{
+    uint16_t *link = &mBucketHead[GetBucket(mStore[aIndex].mTraitPath.mTraitDataHandle)];
+
+    // Keep each bucket in store order, which is the order callers iterate in.
+    while (*link != kNoRecord && *link < aIndex)
+    {
+        link = &mStore[*link].mNextInBucket;
+    }
+
+    mStore[aIndex].mNextInBucket = *link;
+    *link = static_cast<uint16_t>(aIndex);
+}
+
+void TraitPathStore::UnlinkItem(size_t aIndex)
+{
+    uint16_t *link = &mBucketHead[GetBucket(mStore[aIndex].mTraitPath.mTraitDataHandle)];
+
+    while (*link != kNoRecord && *link != aIndex)
+    {
+        link = &mStore[*link].mNextInBucket;
+    }
+
+    if (*link == aIndex)
+    {
+        *link = mStore[aIndex].mNextInBucket;
+    }
+
+    mStore[aIndex].mNextInBucket = kNoRecord;
+}
+
+/**
+ * Rebuilds the bucket chains after records have been moved within the store.
+ */
+void TraitPathStore::RebuildIndex()
+{
+    for (size_t i = 0; i < TDM_PATH_STORE_NUM_BUCKETS; i++)
+    {
+        mBucketHead[i] = kNoRecord;
+    }
+
+    mFirstFreeHint = mStoreSize;
+
+    // Walking the store backwards and pushing onto the front of each bucket leaves the buckets in store order.
+    for (size_t i = mStoreSize; i > 0; i--)
+    {
+        if (IsItemInUse(i - 1))
+        {
+            uint16_t &head = mBucketHead[GetBucket(mStore[i - 1].mTraitPath.mTraitDataHandle)];
+
+            mStore[i - 1].mNextInBucket = head;
+            head = static_cast<uint16_t>(i - 1);
+        }
+        else
+        {
+            mFirstFreeHint = i - 1;
+        }
+    }
+}
+#endif // TDM_PATH_STORE_INDEX_SUPPORT
@@ -52,6 +52,10 @@ struct TraitPathStore
         struct Record {
             Flags mFlags;
             TraitPath mTraitPath;
+#if TDM_PATH_STORE_INDEX_SUPPORT
+            uint16_t mNextInBucket; /**< The index of the next record in use in the same bucket, or kNoRecord.
+                                      */
+#endif
         };
 
         TraitPathStore();
@@ -108,6 +112,21 @@ struct TraitPathStore
 
         size_t mStoreSize;
         size_t mNumItems;
+
+#if TDM_PATH_STORE_INDEX_SUPPORT
+        enum {
+            kNoRecord = UINT16_MAX,
+        };
+
+        static size_t GetBucket(TraitDataHandle aDataHandle) { return aDataHandle % TDM_PATH_STORE_NUM_BUCKETS; }
+        size_t GetFirstValidItemInBucket(size_t aIndex, TraitDataHandle aDataHandle) const;
+        void LinkItem(size_t aIndex);
+        void UnlinkItem(size_t aIndex);
+        void RebuildIndex();
+
+        uint16_t mBucketHead[TDM_PATH_STORE_NUM_BUCKETS];
+        size_t mFirstFreeHint;
+#endif
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
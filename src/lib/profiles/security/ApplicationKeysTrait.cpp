@@ -43,6 +43,14 @@ namespace ApplicationKeysTrait {
         { kPropertyHandle_Root, 2 }, // master_keys
     };
 
+    //
+    // Property Index
+    //
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
     //
     // Schema
     //
@@ -68,6 +76,9 @@ namespace ApplicationKeysTrait {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
             NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+            PropertyIndex,
 #endif
         }
     };
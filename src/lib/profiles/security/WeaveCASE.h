@@ -208,6 +208,58 @@ public:
 };
 
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+enum
+{
+    kCASEResumptionIdLength                     = 16,
+    kCASEResumptionSecretLength                 = SHA256::kHashLength,
+    kCASEResumeRandomLength                     = 16,
+    kCASEResumeConfirmHashLength                = SHA256::kHashLength,
+};
+
+/**
+ * Holds the secret retained from a completed CASE session, from which a later session with the
+ * same peer can be established without repeating the ECDH exchange or certificate validation.
+ */
+class SessionResumptionInfo
+{
+public:
+    uint64_t PeerNodeId;                                // Node id of the peer
+    uint32_t ExpiryTime;                                // Monotonic time, in seconds, after which the entry is unusable; 0 if unused
+    uint8_t Id[kCASEResumptionIdLength];                // Identifier under which both peers hold the secret
+    uint8_t Secret[kCASEResumptionSecretLength];        // Resumption secret
+    uint8_t CertType;                                   // Type of certificate the peer authenticated with
+    bool IsInitiator;                                   // True if the local node initiated the session
+};
+
+/**
+ * A fixed-size store of CASE session resumption secrets.
+ */
+class NL_DLL_EXPORT SessionResumptionCache
+{
+public:
+    enum
+    {
+        kMaxEntries                             = WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+    };
+
+    void Init(void);
+    void Clear(void);
+    void Add(const SessionResumptionInfo & info);
+    const SessionResumptionInfo * FindByPeer(uint64_t peerNodeId, bool isInitiator, uint32_t now);
+    const SessionResumptionInfo * FindById(const uint8_t * id, uint32_t now);
+    void Remove(uint64_t peerNodeId, bool isInitiator);
+
+private:
+    SessionResumptionInfo mEntries[kMaxEntries];
+
+    static void ClearEntry(SessionResumptionInfo & entry);
+};
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+
 /**
  * Abstract interface to which authentication actions are delegated during CASE
  * session establishment.
@@ -403,7 +455,9 @@ public:
         kState_BeginRequestProcessed            = 3,
         kState_BeginResponseGenerated           = 4,
         kState_Complete                         = 5,
-        kState_Failed                           = 6
+        kState_Failed                           = 6,
+        kState_ResumeRequestGenerated           = 7,
+        kState_ResumeRequestProcessed           = 8
     };
 
     WeaveCASEAuthDelegate *AuthDelegate;                // Authentication delegate object
@@ -436,6 +490,21 @@ public:
 
     WEAVE_ERROR GetSessionKey(const WeaveEncryptionKey *& encKey);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    WEAVE_ERROR GetResumptionInfo(SessionResumptionInfo & info);
+
+    WEAVE_ERROR GenerateResumeSessionRequest(const SessionResumptionInfo & info, uint16_t sessionKeyId, uint8_t encType,
+                                             PacketBuffer * msgBuf);
+
+    WEAVE_ERROR ProcessResumeSessionRequest(PacketBuffer * msgBuf, const uint8_t *& resumptionId);
+
+    WEAVE_ERROR GenerateResumeSessionResponse(const SessionResumptionInfo & info, PacketBuffer * msgBuf);
+
+    WEAVE_ERROR ProcessResumeSessionResponse(PacketBuffer * msgBuf);
+
+    bool IsResumedSession() const;
+#endif
+
     bool IsInitiator() const;
     uint32_t SelectedConfig() const;
     uint32_t SelectedCurve() const;
@@ -468,6 +537,16 @@ private:
         kMaxECDHSharedSecretSize                = kMaxECDHPrivateKeySize
     };
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    enum
+    {
+        // Control header, session key id, resumption id and initiator random.
+        kResumeRequestHeadLength                = 1 + 2 + kCASEResumptionIdLength + kCASEResumeRandomLength,
+        kResumeRequestLength                    = kResumeRequestHeadLength + SHA256::kHashLength,
+        kResumeResponseLength                   = kCASEResumeRandomLength + kCASEResumeConfirmHashLength
+    };
+#endif
+
     enum
     {
         kFlag_IsInitiator                       = 0x80,
@@ -495,12 +574,28 @@ private:
         {
             WeaveEncryptionKey EncryptionKey;
             uint8_t InitiatorKeyConfirmHash[kMaxHashLength];
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+            uint8_t ResumptionId[kCASEResumptionIdLength];
+            uint8_t ResumptionSecret[kCASEResumptionSecretLength];
+#endif
         } AfterKeyGen;
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        struct
+        {
+            uint8_t Secret[kCASEResumptionSecretLength];
+            uint8_t RequestHead[kResumeRequestHeadLength];
+            uint8_t RequestMAC[SHA256::kHashLength];
+            uint8_t CertType;
+        } Resumption;
+#endif
     } mSecureState;
     uint32_t mCurveId;
     uint8_t mAllowedCurves;
     uint8_t mFlags;
     uint8_t mCertType;
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    bool mIsResumedSession;
+#endif
 
     bool IsUsingConfig1() const;
     void SetSelectedConfig(uint32_t config);
@@ -523,6 +618,9 @@ private:
     WEAVE_ERROR DeriveSessionKeys(EncodedECPublicKey & pubKey, const uint8_t * respMsgHash, uint8_t * responderKeyConfirmHash);
     void GenerateHash(const uint8_t * inData, uint16_t inDataLen, uint8_t * hash);
     void GenerateKeyConfirmHashes(const uint8_t * keyConfirmKey, uint8_t * singleHash, uint8_t * doubleHash);
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    WEAVE_ERROR DeriveResumedSessionKeys(const uint8_t * respRandom, uint8_t * responderConfirmHash);
+#endif
 };
 
 
@@ -777,6 +875,13 @@ inline void WeaveCASEEngine::SetCertType(uint8_t certType)
     mCertType = certType;
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+inline bool WeaveCASEEngine::IsResumedSession() const
+{
+    return mIsResumedSession;
+}
+#endif
+
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
 
 inline bool WeaveCASEEngine::UseKnownECDHKey() const
@@ -40,6 +40,8 @@
 #include <Weave/Support/crypto/WeaveCrypto.h>
 #include <Weave/Support/crypto/HashAlgos.h>
 #include <Weave/Support/crypto/EllipticCurve.h>
+#include <Weave/Support/crypto/HKDF.h>
+#include <Weave/Support/crypto/HMAC.h>
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 
@@ -55,6 +57,12 @@ using namespace nl::Weave::Encoding;
 using namespace nl::Weave::TLV;
 using namespace nl::Weave::ASN1;
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+// HKDF info labels that separate the resumption key data from the session keys derived alongside it.
+static const uint8_t kResumptionSecretInfo[] = { 'C', 'A', 'S', 'E', ' ', 'R', 'e', 's', 'u', 'm', 'p', 't', 'i', 'o', 'n' };
+static const uint8_t kResumedSessionKeyInfo[] = { 'C', 'A', 'S', 'E', ' ', 'R', 'e', 's', 'u', 'm', 'e' };
+#endif
+
 #undef CASE_PRINT_CRYPTO_DATA
 #ifdef CASE_PRINT_CRYPTO_DATA
 static void PrintHex(const uint8_t *data, uint16_t len)
@@ -478,6 +486,197 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ * Get the secret under which the just-completed session may later be resumed.
+ *
+ * Only a session established by a full CASE exchange yields a resumption secret.  The caller
+ * is responsible for setting the PeerNodeId and ExpiryTime fields.
+ */
+WEAVE_ERROR WeaveCASEEngine::GetResumptionInfo(SessionResumptionInfo & info)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(State == kState_Complete && !mIsResumedSession, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    memcpy(info.Id, mSecureState.AfterKeyGen.ResumptionId, kCASEResumptionIdLength);
+    memcpy(info.Secret, mSecureState.AfterKeyGen.ResumptionSecret, kCASEResumptionSecretLength);
+    info.CertType = mCertType;
+    info.IsInitiator = IsInitiator();
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR WeaveCASEEngine::GenerateResumeSessionRequest(const SessionResumptionInfo & info, uint16_t sessionKeyId,
+                                                          uint8_t encType, PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    uint8_t * p;
+    HMACSHA256 hmac;
+
+    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Only AES128CTRSHA1 keys supported for now.
+    VerifyOrExit(encType == kWeaveEncryptionType_AES128CTRSHA1, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    VerifyOrExit(msgBuf->AvailableDataLength() >= kResumeRequestLength, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    WeaveLogDetail(SecurityManager, "CASE:GenerateResumeSessionRequest");
+
+    SetIsInitiator(true);
+    EncryptionType = encType;
+    SessionKeyId = sessionKeyId;
+
+    // Encode the head of the message: control header, proposed session key id, resumption id and
+    // a fresh random value.
+    p = msgBuf->Start();
+    *p++ = encType & kCASEHeader_EncryptionTypeMask;
+    LittleEndian::Write16(p, sessionKeyId);
+    memcpy(p, info.Id, kCASEResumptionIdLength);
+    p += kCASEResumptionIdLength;
+    err = Platform::Security::GetSecureRandomData(p, kCASEResumeRandomLength);
+    SuccessOrExit(err);
+    p += kCASEResumeRandomLength;
+
+    // Prove possession of the resumption secret by appending a MAC over the head.
+    hmac.Begin(info.Secret, kCASEResumptionSecretLength);
+    hmac.AddData(msgBuf->Start(), kResumeRequestHeadLength);
+    hmac.Finish(p);
+
+    msgBuf->SetDataLength(kResumeRequestLength);
+
+    // Retain what is needed to derive the session keys once the response arrives.
+    memcpy(mSecureState.Resumption.Secret, info.Secret, kCASEResumptionSecretLength);
+    memcpy(mSecureState.Resumption.RequestHead, msgBuf->Start(), kResumeRequestHeadLength);
+    mSecureState.Resumption.CertType = info.CertType;
+
+    State = kState_ResumeRequestGenerated;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+/**
+ * Decode a ResumeSessionRequest message.
+ *
+ * On success, resumptionId points to the resumption id proposed by the initiator, which the
+ * caller uses to look up the corresponding secret before calling GenerateResumeSessionResponse().
+ */
+WEAVE_ERROR WeaveCASEEngine::ProcessResumeSessionRequest(PacketBuffer * msgBuf, const uint8_t *& resumptionId)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint8_t * p = msgBuf->Start();
+    uint8_t controlHeader;
+
+    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    WeaveLogDetail(SecurityManager, "CASE:ProcessResumeSessionRequest");
+
+    VerifyOrExit(msgBuf->DataLength() == kResumeRequestLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    controlHeader = *p++;
+    VerifyOrExit((controlHeader & ~kCASEHeader_EncryptionTypeMask) == 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    EncryptionType = controlHeader & kCASEHeader_EncryptionTypeMask;
+    VerifyOrExit(EncryptionType == kWeaveEncryptionType_AES128CTRSHA1, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    SessionKeyId = LittleEndian::Read16(p);
+    VerifyOrExit(WeaveKeyId::IsSessionKey(SessionKeyId), err = WEAVE_ERROR_WRONG_KEY_TYPE);
+
+    SetIsInitiator(false);
+
+    memcpy(mSecureState.Resumption.RequestHead, msgBuf->Start(), kResumeRequestHeadLength);
+    memcpy(mSecureState.Resumption.RequestMAC, msgBuf->Start() + kResumeRequestHeadLength, SHA256::kHashLength);
+
+    resumptionId = mSecureState.Resumption.RequestHead + 1 + 2;
+
+    State = kState_ResumeRequestProcessed;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+WEAVE_ERROR WeaveCASEEngine::GenerateResumeSessionResponse(const SessionResumptionInfo & info, PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    uint8_t * respRandom = msgBuf->Start();
+    uint8_t expectedMAC[SHA256::kHashLength];
+    HMACSHA256 hmac;
+
+    VerifyOrExit(State == kState_ResumeRequestProcessed, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    VerifyOrExit(msgBuf->AvailableDataLength() >= kResumeResponseLength, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    WeaveLogDetail(SecurityManager, "CASE:GenerateResumeSessionResponse");
+
+    // Verify that the initiator holds the resumption secret.
+    hmac.Begin(info.Secret, kCASEResumptionSecretLength);
+    hmac.AddData(mSecureState.Resumption.RequestHead, kResumeRequestHeadLength);
+    hmac.Finish(expectedMAC);
+    VerifyOrExit(ConstantTimeCompare(expectedMAC, mSecureState.Resumption.RequestMAC, SHA256::kHashLength),
+                 err = WEAVE_ERROR_KEY_CONFIRMATION_FAILED);
+
+    memcpy(mSecureState.Resumption.Secret, info.Secret, kCASEResumptionSecretLength);
+    mSecureState.Resumption.CertType = info.CertType;
+
+    err = Platform::Security::GetSecureRandomData(respRandom, kCASEResumeRandomLength);
+    SuccessOrExit(err);
+
+    // Derive the session keys and append the confirmation hash, with which the initiator confirms
+    // that both sides hold the same keys.
+    err = DeriveResumedSessionKeys(respRandom, respRandom + kCASEResumeRandomLength);
+    SuccessOrExit(err);
+
+    msgBuf->SetDataLength(kResumeResponseLength);
+
+    // As the request carries nothing fresh from the responder, a replayed request is answered as readily as
+    // the original.  So, as after a BeginSessionResponse, the session is only complete once the initiator
+    // has confirmed the keys with an InitiatorKeyConfirm message.
+    State = kState_BeginResponseGenerated;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+WEAVE_ERROR WeaveCASEEngine::ProcessResumeSessionResponse(PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    uint8_t expectedConfirmHash[kCASEResumeConfirmHashLength];
+    const uint8_t * respRandom = msgBuf->Start();
+
+    VerifyOrExit(State == kState_ResumeRequestGenerated, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    WeaveLogDetail(SecurityManager, "CASE:ProcessResumeSessionResponse");
+
+    VerifyOrExit(msgBuf->DataLength() == kResumeResponseLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    err = DeriveResumedSessionKeys(respRandom, expectedConfirmHash);
+    SuccessOrExit(err);
+
+    WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_CASEKeyConfirm, ExitNow(err = WEAVE_ERROR_KEY_CONFIRMATION_FAILED));
+
+    VerifyOrExit(ConstantTimeCompare(respRandom + kCASEResumeRandomLength, expectedConfirmHash, kCASEResumeConfirmHashLength),
+                 err = WEAVE_ERROR_KEY_CONFIRMATION_FAILED);
+
+    // The session is complete once the InitiatorKeyConfirm message has been generated.
+    State = kState_BeginResponseProcessed;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 WEAVE_ERROR WeaveCASEEngine::VerifyProposedConfig(BeginSessionRequestContext & reqCtx, uint32_t & selectedAltConfig)
 {
     WEAVE_ERROR err = WEAVE_ERROR_UNSUPPORTED_CASE_CONFIGURATION;
@@ -968,10 +1167,179 @@ WEAVE_ERROR WeaveCASEEngine::DeriveSessionKeys(EncodedECPublicKey & pubKey, cons
         ClearSecretData(sessionKeyData, sizeof(sessionKeyData));
     }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Derive the id and secret under which the session may later be resumed.  Being expanded with
+    // a distinct info label, these are independent of the session keys.
+    {
+        uint8_t resumptionData[kCASEResumptionIdLength + kCASEResumptionSecretLength];
+
+        err = hkdf.ExpandKey(kResumptionSecretInfo, sizeof(kResumptionSecretInfo), sizeof(resumptionData), resumptionData);
+        SuccessOrExit(err);
+
+        memcpy(mSecureState.AfterKeyGen.ResumptionId, resumptionData, kCASEResumptionIdLength);
+        memcpy(mSecureState.AfterKeyGen.ResumptionSecret, resumptionData + kCASEResumptionIdLength, kCASEResumptionSecretLength);
+
+        ClearSecretData(resumptionData, sizeof(resumptionData));
+    }
+#endif
+
 exit:
     return err;
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+WEAVE_ERROR WeaveCASEEngine::DeriveResumedSessionKeys(const uint8_t * respRandom, uint8_t * responderConfirmHash)
+{
+    WEAVE_ERROR err;
+    HKDFSHA256 hkdf;
+    uint8_t keySalt[2 * kCASEResumeRandomLength];
+    uint8_t sessionKeyData[WeaveEncryptionKey_AES128CTRSHA1::KeySize + SHA256::kHashLength];
+    uint8_t * keyConfirmKey = sessionKeyData + WeaveEncryptionKey_AES128CTRSHA1::KeySize;
+    uint8_t initiatorConfirmHash[SHA256::kHashLength];
+    uint8_t certType = mSecureState.Resumption.CertType;
+
+    WeaveLogDetail(SecurityManager, "CASE:DeriveResumedSessionKeys");
+
+    // The salt combines the random values contributed by both parties, such that every resumed
+    // session has fresh keys.
+    memcpy(keySalt, mSecureState.Resumption.RequestHead + kResumeRequestHeadLength - kCASEResumeRandomLength,
+           kCASEResumeRandomLength);
+    memcpy(keySalt + kCASEResumeRandomLength, respRandom, kCASEResumeRandomLength);
+
+    hkdf.BeginExtractKey(keySalt, sizeof(keySalt));
+    hkdf.AddKeyMaterial(mSecureState.Resumption.Secret, kCASEResumptionSecretLength);
+    err = hkdf.FinishExtractKey();
+    SuccessOrExit(err);
+
+    err = hkdf.ExpandKey(kResumedSessionKeyInfo, sizeof(kResumedSessionKeyInfo), sizeof(sessionKeyData), sessionKeyData);
+    SuccessOrExit(err);
+
+    // Key confirmation uses SHA-256 hashes, as in CASE config 2.  The responder proves possession of the keys
+    // with the double hash of the key confirmation key, and the initiator with the single hash.
+    SetSelectedConfig(kCASEConfig_Config2);
+    SetPerformingKeyConfirm(true);
+    GenerateKeyConfirmHashes(keyConfirmKey, initiatorConfirmHash, responderConfirmHash);
+
+    // The resumption state shares storage with the session key, so it is cleared before the key is set.
+    ClearSecretData((uint8_t *)&mSecureState, sizeof(mSecureState));
+
+    memcpy(mSecureState.AfterKeyGen.EncryptionKey.AES128CTRSHA1.DataKey,
+           sessionKeyData,
+           WeaveEncryptionKey_AES128CTRSHA1::DataKeySize);
+    memcpy(mSecureState.AfterKeyGen.EncryptionKey.AES128CTRSHA1.IntegrityKey,
+           sessionKeyData + WeaveEncryptionKey_AES128CTRSHA1::DataKeySize,
+           WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+    memcpy(mSecureState.AfterKeyGen.InitiatorKeyConfirmHash, initiatorConfirmHash, sizeof(initiatorConfirmHash));
+
+    mCertType = certType;
+    mIsResumedSession = true;
+
+exit:
+    ClearSecretData(sessionKeyData, sizeof(sessionKeyData));
+    ClearSecretData(initiatorConfirmHash, sizeof(initiatorConfirmHash));
+    return err;
+}
+
+void SessionResumptionCache::Init(void)
+{
+    for (int i = 0; i < kMaxEntries; i++)
+        ClearEntry(mEntries[i]);
+}
+
+void SessionResumptionCache::Clear(void)
+{
+    Init();
+}
+
+/**
+ * Store a resumption secret, replacing any held for the same peer and role.
+ *
+ * When the cache is full, the entry closest to expiry is replaced.
+ */
+void SessionResumptionCache::Add(const SessionResumptionInfo & info)
+{
+    SessionResumptionInfo * slot = NULL;
+
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        SessionResumptionInfo & entry = mEntries[i];
+
+        if (entry.ExpiryTime != 0 && entry.PeerNodeId == info.PeerNodeId && entry.IsInitiator == info.IsInitiator)
+        {
+            slot = &entry;
+            break;
+        }
+
+        if (slot == NULL || entry.ExpiryTime < slot->ExpiryTime)
+            slot = &entry;
+    }
+
+    *slot = info;
+}
+
+const SessionResumptionInfo * SessionResumptionCache::FindByPeer(uint64_t peerNodeId, bool isInitiator, uint32_t now)
+{
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        SessionResumptionInfo & entry = mEntries[i];
+
+        if (entry.ExpiryTime == 0)
+            continue;
+
+        if (entry.ExpiryTime <= now)
+        {
+            ClearEntry(entry);
+            continue;
+        }
+
+        if (entry.PeerNodeId == peerNodeId && entry.IsInitiator == isInitiator)
+            return &entry;
+    }
+
+    return NULL;
+}
+
+const SessionResumptionInfo * SessionResumptionCache::FindById(const uint8_t * id, uint32_t now)
+{
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        SessionResumptionInfo & entry = mEntries[i];
+
+        if (entry.ExpiryTime == 0)
+            continue;
+
+        if (entry.ExpiryTime <= now)
+        {
+            ClearEntry(entry);
+            continue;
+        }
+
+        if (!entry.IsInitiator && ConstantTimeCompare(entry.Id, id, kCASEResumptionIdLength))
+            return &entry;
+    }
+
+    return NULL;
+}
+
+void SessionResumptionCache::Remove(uint64_t peerNodeId, bool isInitiator)
+{
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        SessionResumptionInfo & entry = mEntries[i];
+
+        if (entry.ExpiryTime != 0 && entry.PeerNodeId == peerNodeId && entry.IsInitiator == isInitiator)
+            ClearEntry(entry);
+    }
+}
+
+void SessionResumptionCache::ClearEntry(SessionResumptionInfo & entry)
+{
+    ClearSecretData((uint8_t *)&entry, sizeof(entry));
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 void WeaveCASEEngine::GenerateHash(const uint8_t * inData, uint16_t inDataLen, uint8_t * hash)
 {
     if (IsUsingConfig1())
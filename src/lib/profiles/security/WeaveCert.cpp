@@ -574,6 +574,11 @@ WEAVE_ERROR WeaveCertificateSet::ValidateCert(WeaveCertificateData& cert, Valida
 	if (err != WEAVE_NO_ERROR)
 		ExitNow(err = WEAVE_ERROR_CA_CERT_NOT_FOUND);
 
+    // If the signature of the current certificate has already been verified against the public key of the same CA
+    // certificate, the current certificate is valid.
+    if (context.ValidationCache != NULL && context.ValidationCache->Lookup(cert, *caCert, context.EffectiveTime))
+        ExitNow(err = WEAVE_NO_ERROR);
+
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
 	// succeeds, the current certificate is valid.
     hashLen = (cert.SigAlgoOID == kOID_SigAlgo_ECDSAWithSHA256)
@@ -582,6 +587,9 @@ WEAVE_ERROR WeaveCertificateSet::ValidateCert(WeaveCertificateData& cert, Valida
     err = VerifyECDSASignature(cert.TBSHash, hashLen, cert.Signature.EC, *caCert);
     SuccessOrExit(err);
 
+    if (context.ValidationCache != NULL)
+        context.ValidationCache->Add(cert, *caCert);
+
 exit:
 
 #if WEAVE_CONFIG_DEBUG_CERT_VALIDATION
@@ -708,6 +716,205 @@ bool CertificateKeyId::IsEqual(const CertificateKeyId& other) const
     return Id != NULL && other.Id != NULL && Len == other.Len && memcmp(Id, other.Id, Len) == 0;
 }
 
+CertValidationCache::CertValidationCache()
+{
+    memset(mEntries, 0, sizeof(mEntries));
+    mUseSeqNum = 0;
+    HitCount = 0;
+    MissCount = 0;
+}
+
+/**
+ * @brief
+ *   Initialize the cache, which starts out empty.
+ *
+ * @retval  #WEAVE_NO_ERROR     On success.
+ * @retval  other               If the cache's lock could not be initialized.
+ */
+WEAVE_ERROR CertValidationCache::Init()
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    err = System::Mutex::Init(mLock);
+    SuccessOrExit(err);
+#endif
+
+    memset(mEntries, 0, sizeof(mEntries));
+    mUseSeqNum = 0;
+    HitCount = 0;
+    MissCount = 0;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Forget all verified signatures, for example after a trust anchor has been revoked.
+ *   The hit and miss counters are left unchanged.
+ */
+void CertValidationCache::Clear()
+{
+    Lock();
+    memset(mEntries, 0, sizeof(mEntries));
+    Unlock();
+}
+
+/**
+ * @brief
+ *   Determine whether the signature of a certificate has already been verified against the
+ *   public key of a given CA certificate.
+ *
+ * @details
+ *   Only the signature verification is covered by the cache.  The caller remains responsible
+ *   for all other checks on the two certificates.  An entry is not used, and is discarded, if
+ *   the effective time falls outside the period in which both certificates were valid.
+ *
+ * @param cert
+ *   The certificate, which must have its TBS hash present.
+ *
+ * @param caCert
+ *   The CA certificate that issued the certificate.
+ *
+ * @param effectiveTime
+ *   The packed certificate date/time at which the certificates are being validated.
+ *
+ * @return
+ *   True if the signature was found to have been verified; false otherwise.
+ */
+bool CertValidationCache::Lookup(const WeaveCertificateData& cert, const WeaveCertificateData& caCert, uint32_t effectiveTime)
+{
+    enum { kLastSecondOfDay = kSecondsPerDay - 1 };
+    uint8_t digest[kDigestLen];
+    bool found = false;
+
+    ComputeDigest(cert, caCert, digest);
+
+    Lock();
+
+    for (uint8_t i = 0; i < kMaxEntries; i++)
+    {
+        Entry& entry = mEntries[i];
+
+        if (entry.LastUsed == 0 || memcmp(entry.Digest, digest, kDigestLen) != 0)
+            continue;
+
+        if ((entry.NotBeforeDate != 0 && effectiveTime < PackedCertDateToTime(entry.NotBeforeDate)) ||
+            (entry.NotAfterDate != 0 && effectiveTime > PackedCertDateToTime(entry.NotAfterDate) + kLastSecondOfDay))
+        {
+            entry.LastUsed = 0;
+            break;
+        }
+
+        entry.LastUsed = ++mUseSeqNum;
+        found = true;
+        break;
+    }
+
+    if (found)
+        HitCount++;
+    else
+        MissCount++;
+
+    Unlock();
+
+    return found;
+}
+
+/**
+ * @brief
+ *   Record that the signature of a certificate has been verified against the public key of a
+ *   given CA certificate, replacing the least recently used entry if the cache is full.
+ *
+ * @param cert
+ *   The certificate, which must have its TBS hash present.
+ *
+ * @param caCert
+ *   The CA certificate whose public key verified the certificate's signature.
+ */
+void CertValidationCache::Add(const WeaveCertificateData& cert, const WeaveCertificateData& caCert)
+{
+    uint8_t digest[kDigestLen];
+    Entry *entry = NULL;
+
+    ComputeDigest(cert, caCert, digest);
+
+    Lock();
+
+    for (uint8_t i = 0; i < kMaxEntries; i++)
+    {
+        Entry& candidate = mEntries[i];
+
+        if (candidate.LastUsed != 0 && memcmp(candidate.Digest, digest, kDigestLen) == 0)
+        {
+            entry = &candidate;
+            break;
+        }
+
+        if (entry == NULL || candidate.LastUsed < entry->LastUsed)
+            entry = &candidate;
+    }
+
+    memcpy(entry->Digest, digest, kDigestLen);
+    entry->LastUsed = ++mUseSeqNum;
+
+    // The entry is good for as long as both certificates are valid.
+    entry->NotBeforeDate = cert.NotBeforeDate;
+    if (caCert.NotBeforeDate > entry->NotBeforeDate)
+        entry->NotBeforeDate = caCert.NotBeforeDate;
+    entry->NotAfterDate = cert.NotAfterDate;
+    if (caCert.NotAfterDate != 0 && (entry->NotAfterDate == 0 || caCert.NotAfterDate < entry->NotAfterDate))
+        entry->NotAfterDate = caCert.NotAfterDate;
+
+    Unlock();
+}
+
+// Compute the key under which the verification of a certificate's signature by a CA certificate is cached.
+// This covers everything the verification depends on: the certificate's TBS hash and signature, and the
+// public key of the CA certificate.
+void CertValidationCache::ComputeDigest(const WeaveCertificateData& cert, const WeaveCertificateData& caCert, uint8_t *digest)
+{
+    Platform::Security::SHA256 sha256;
+    uint8_t hashLen = (cert.SigAlgoOID == kOID_SigAlgo_ECDSAWithSHA256)
+                      ? (uint8_t)Platform::Security::SHA256::kHashLength
+                      : (uint8_t)Platform::Security::SHA1::kHashLength;
+    uint8_t encodedInt[4];
+
+    sha256.Begin();
+
+    Encoding::LittleEndian::Put16(encodedInt, cert.SigAlgoOID);
+    sha256.AddData(encodedInt, 2);
+    sha256.AddData(cert.TBSHash, hashLen);
+
+    sha256.AddData(&cert.Signature.EC.RLen, 1);
+    sha256.AddData(cert.Signature.EC.R, cert.Signature.EC.RLen);
+    sha256.AddData(&cert.Signature.EC.SLen, 1);
+    sha256.AddData(cert.Signature.EC.S, cert.Signature.EC.SLen);
+
+    Encoding::LittleEndian::Put32(encodedInt, caCert.PubKeyCurveId);
+    sha256.AddData(encodedInt, 4);
+    Encoding::LittleEndian::Put16(encodedInt, caCert.PublicKey.EC.ECPointLen);
+    sha256.AddData(encodedInt, 2);
+    sha256.AddData(caCert.PublicKey.EC.ECPoint, caCert.PublicKey.EC.ECPointLen);
+
+    sha256.Finish(digest);
+}
+
+void CertValidationCache::Lock()
+{
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    mLock.Lock();
+#endif
+}
+
+void CertValidationCache::Unlock()
+{
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    mLock.Unlock();
+#endif
+}
+
 /**
  * @brief
  *   Convert a certificate date/time (in the form of an ASN.1 universal time structure) into a packed
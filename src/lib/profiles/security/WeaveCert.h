@@ -33,6 +33,7 @@
 #include <Weave/Support/ASN1.h>
 #include <Weave/Support/crypto/EllipticCurve.h>
 #include <Weave/Support/crypto/HashAlgos.h>
+#include <SystemLayer/SystemMutex.h>
 
 namespace nl {
 namespace Weave {
@@ -197,6 +198,8 @@ public:
 };
 
 
+class CertValidationCache;
+
 // ValidationContext -- Context information used during certification validation.
 class ValidationContext
 {
@@ -204,6 +207,7 @@ public:
     uint32_t EffectiveTime;
     WeaveCertificateData *TrustAnchor;
     WeaveCertificateData *SigningCert;
+    CertValidationCache *ValidationCache;       // Optional cache of verified certificate signatures
     uint16_t RequiredKeyUsages;
     uint16_t ValidateFlags;
 #if WEAVE_CONFIG_DEBUG_CERT_VALIDATION
@@ -217,6 +221,54 @@ public:
 };
 
 
+// CertValidationCache -- Bounded cache of certificate signatures that have been verified
+//   against the public key of the issuing CA certificate.  May be shared by any number of
+//   certificate sets, and by multiple threads on platforms with locking.
+class NL_DLL_EXPORT CertValidationCache
+{
+public:
+    enum
+    {
+        kMaxEntries = WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+    };
+
+    uint32_t HitCount;                          // [READ-ONLY] Number of signature verifications skipped
+    uint32_t MissCount;                         // [READ-ONLY] Number of signature verifications performed
+
+    CertValidationCache(void);
+
+    WEAVE_ERROR Init(void);
+    void Clear(void);
+
+    bool Lookup(const WeaveCertificateData& cert, const WeaveCertificateData& caCert, uint32_t effectiveTime);
+    void Add(const WeaveCertificateData& cert, const WeaveCertificateData& caCert);
+
+private:
+    enum
+    {
+        kDigestLen = nl::Weave::Platform::Security::SHA256::kHashLength
+    };
+
+    struct Entry
+    {
+        uint8_t Digest[kDigestLen];             // Hash of the certificate's TBS hash and signature, and the CA's key
+        uint32_t LastUsed;                      // Use sequence number; 0 if the entry is free
+        uint16_t NotBeforeDate;                 // Start of the period in which both certificates are valid
+        uint16_t NotAfterDate;                  // End of the period in which both certificates are valid
+    };
+
+    Entry mEntries[kMaxEntries];
+    uint32_t mUseSeqNum;
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    nl::Weave::System::Mutex mLock;
+#endif
+
+    static void ComputeDigest(const WeaveCertificateData& cert, const WeaveCertificateData& caCert, uint8_t *digest);
+    void Lock(void);
+    void Unlock(void);
+};
+
+
 // WeaveCertificateSet -- Collection of Weave certificate data providing methods for
 //   certificate validation and signature verification.
 class NL_DLL_EXPORT WeaveCertificateSet
@@ -60,6 +60,8 @@ enum
     kMsgType_CASEBeginSessionResponse           = 11,
     kMsgType_CASEInitiatorKeyConfirm            = 12,
     kMsgType_CASEReconfigure                    = 13,
+    kMsgType_CASEResumeSessionRequest           = 14,
+    kMsgType_CASEResumeSessionResponse          = 15,
 
     // ---- TAKE Protocol Messages ----
     kMsgType_TAKEIdentifyToken                  = 20,
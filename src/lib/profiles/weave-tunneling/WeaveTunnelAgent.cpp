@@ -237,6 +237,16 @@ WEAVE_ERROR WeaveTunnelAgent::ConfigureAndInit (InetLayer *inet, WeaveExchangeMa
 
     mTunEP->AppState = this;
 
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    // The remaining queues share the handler of the first.
+
+    for (int i = 1; i < WEAVE_CONFIG_TUNNEL_TUN_QUEUES; i++)
+    {
+        mTunQueueEP[i]->OnPacketReceived = RecvdFromTunnelEndPoint;
+        mTunQueueEP[i]->AppState = this;
+    }
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+
 #if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
     // Enable Shortcut tunneling advertisments
 
@@ -1040,7 +1050,30 @@ WEAVE_ERROR WeaveTunnelAgent::CreateTunEndPoint(void)
 
     mTunEP->Init(mInet);
 
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    mTunQueueEP[0] = mTunEP;
+
+    for (int i = 1; i < WEAVE_CONFIG_TUNNEL_TUN_QUEUES; i++)
+    {
+        mTunQueueEP[i] = NULL;
+    }
+
+    for (int i = 1; i < WEAVE_CONFIG_TUNNEL_TUN_QUEUES; i++)
+    {
+        res = mInet->NewTunEndPoint(&mTunQueueEP[i]);
+        SuccessOrExit(res);
+
+        mTunQueueEP[i]->Init(mInet);
+    }
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+
 exit:
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    if (res != WEAVE_NO_ERROR && mTunEP != NULL)
+    {
+        FreeTunQueues();
+    }
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
 
     return res;
 }
@@ -1054,6 +1087,16 @@ WEAVE_ERROR WeaveTunnelAgent::SetupTunEndPoint(void)
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     err = mTunEP->Open();
+#elif WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    // Every queue must attach to the same, named, interface.
+
+    VerifyOrExit(mIntfName[0] != '\0', err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_TUN_QUEUES; i++)
+    {
+        err = mTunQueueEP[i]->Open(mIntfName, true);
+        SuccessOrExit(err);
+    }
 #else
     err = mTunEP->Open(mIntfName);
 #endif
@@ -1075,8 +1118,12 @@ WEAVE_ERROR WeaveTunnelAgent::SetupTunEndPoint(void)
 exit:
     if (err != WEAVE_NO_ERROR)
     {
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+        FreeTunQueues();
+#else
         mTunEP->Free();
         mTunEP = NULL;
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
     }
 
     return err;
@@ -1104,13 +1151,71 @@ WEAVE_ERROR WeaveTunnelAgent::TeardownTunEndPoint(void)
         }
         // Free Tunnel Endpoint
 
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+        FreeTunQueues();
+#else
         mTunEP->Free();
         mTunEP = NULL;
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
     }
 
     return err;
 }
 
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+/**
+ * Free every queue of the tunnel interface, including mTunEP.
+ */
+void WeaveTunnelAgent::FreeTunQueues(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_TUN_QUEUES; i++)
+    {
+        if (mTunQueueEP[i] != NULL)
+        {
+            mTunQueueEP[i]->Free();
+            mTunQueueEP[i] = NULL;
+        }
+    }
+
+    mTunEP = NULL;
+}
+
+/**
+ * Select the queue of the tunnel interface to write an IPv6 packet to.
+ *
+ * The queue is picked by a hash of the source and destination addresses, flow label and next header of the
+ * packet, so all the packets of a flow are written, and so delivered, in order.
+ *
+ * @param[in]  inMsg        A constant reference to the PacketBuffer object containing the IPv6 packet.
+ *
+ * @return A pointer to the TunEndPoint object of the selected queue.
+ *
+ */
+TunEndPoint *WeaveTunnelAgent::SelectTunQueue(const PacketBuffer &inMsg) const
+{
+    const struct ip6_hdr *ip6hdr = reinterpret_cast<const struct ip6_hdr *>(inMsg.Start());
+    const uint8_t *p;
+    uint32_t hash;
+
+    if (inMsg.DataLength() < sizeof(struct ip6_hdr))
+    {
+        return mTunEP;
+    }
+
+    // Fold the flow label and next header, then the source and destination addresses, in with FNV-1a.
+
+    hash = 2166136261UL ^ (ntohl(ip6hdr->ip6_flow) & 0x000FFFFF) ^ (static_cast<uint32_t>(ip6hdr->ip6_nxt) << 24);
+
+    p = reinterpret_cast<const uint8_t *>(&ip6hdr->ip6_src);
+    for (size_t i = 0; i < 2 * sizeof(struct in6_addr); i++)
+    {
+        hash = (hash ^ p[i]) * 16777619UL;
+    }
+
+    return mTunQueueEP[hash % WEAVE_CONFIG_TUNNEL_TUN_QUEUES];
+}
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+
 /**
  * Utility function for populating a message header.
  */
@@ -1390,7 +1495,11 @@ WEAVE_ERROR WeaveTunnelAgent::HandleTunneledReceive(PacketBuffer *msg, TunnelTyp
         destIP6Addr.Subnet() == kWeaveSubnetId_PrimaryWiFi ||
         destIP6Addr.Subnet() == kWeaveSubnetId_ThreadMesh)
     {
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+        SelectTunQueue(*msg)->Send(msg);
+#else
         mTunEP->Send(msg);
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
         msg = NULL;
     }
 
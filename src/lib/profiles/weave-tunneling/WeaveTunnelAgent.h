@@ -577,6 +577,12 @@ private:
 
     TunEndPoint *mTunEP;
 
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    // Queues of the multi-queue tunnel interface; the first is mTunEP.
+
+    TunEndPoint *mTunQueueEP[WEAVE_CONFIG_TUNNEL_TUN_QUEUES];
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+
     // Handle to the WeaveExchangeManager object.
 
     WeaveExchangeManager *mExchangeMgr;
@@ -618,6 +624,10 @@ private:
     WEAVE_ERROR CreateTunEndPoint(void);
     WEAVE_ERROR SetupTunEndPoint(void);
     WEAVE_ERROR TeardownTunEndPoint(void);
+#if WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
+    void FreeTunQueues(void);
+    TunEndPoint *SelectTunQueue(const PacketBuffer &inMsg) const;
+#endif // WEAVE_CONFIG_TUNNEL_TUN_QUEUES > 1
 
     // Tunnel management and maintenance functions
 
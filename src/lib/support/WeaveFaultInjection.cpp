@@ -72,6 +72,7 @@ static const nl::FaultInjection::Name sFaultNames[] = {
     "WDMUpdateResponseBusy",
     "WDMPathStoreFull",
     "WDMTreatNotifyAsCancel",
+    "WDMStagedEventWrite",
     "CASEKeyConfirm",
     "SecMgrBusy",
 #if WEAVE_CONFIG_ENABLE_TUNNELING
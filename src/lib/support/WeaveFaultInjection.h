@@ -90,6 +90,7 @@ typedef enum
     kFault_WDM_UpdateResponseBusy,              /**< Inject a status code busy in the StatusList */
     kFault_WDM_PathStoreFull,                   /**< Inject a WDM_PATH_STORE_FULL error */
     kFault_WDM_TreatNotifyAsCancel,             /**< Process a Notify request as a CancelSubscription request */
+    kFault_WDM_StagedEventWrite,                /**< Fail to write a staged event to the event log as the staged events are drained */
     kFault_CASEKeyConfirm,                      /**< Trigger a WEAVE_ERROR_KEY_CONFIRMATION_FAILED error in WeaveCASEEngine */
     kFault_SecMgrBusy,                          /**< Trigger a WEAVE_ERROR_SECURITY_MANAGER_BUSY when starting an authentication session */
 #if WEAVE_CONFIG_ENABLE_TUNNELING
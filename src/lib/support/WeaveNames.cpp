@@ -192,6 +192,8 @@ const char *GetMessageName(uint32_t profileId, uint8_t msgType)
         case Security::kMsgType_CASEBeginSessionResponse                    : return "CASEBeginSessionResponse";
         case Security::kMsgType_CASEInitiatorKeyConfirm                     : return "CASEInitiatorKeyConfirm";
         case Security::kMsgType_CASEReconfigure                             : return "CASEReconfigure";
+        case Security::kMsgType_CASEResumeSessionRequest                    : return "CASEResumeSessionRequest";
+        case Security::kMsgType_CASEResumeSessionResponse                   : return "CASEResumeSessionResponse";
         case Security::kMsgType_TAKEIdentifyToken                           : return "TAKEIdentifyToken";
         case Security::kMsgType_TAKEIdentifyTokenResponse                   : return "TAKEIdentifyTokenResponse";
         case Security::kMsgType_TAKETokenReconfigure                        : return "TAKETokenReconfigure";
@@ -27,6 +27,7 @@
 
 #include "WeaveCrypto.h"
 #include "AESBlockCipher.h"
+#include <Weave/Core/WeaveEncoding.h>
 
 #if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
 
@@ -40,6 +41,77 @@ namespace Security {
 
 using namespace nl::Weave::Crypto;
 
+/**
+ * Encrypt a group of blocks with their AES rounds interleaved, so that the latency of each
+ * AESENC instruction is hidden behind those of the other blocks in the group.
+ */
+template <int kRoundCount, size_t kGroupSize>
+static inline void EncryptBlockGroup(const __m128i *key, __m128i *blocks)
+{
+    for (size_t i = 0; i < kGroupSize; i++)
+        blocks[i] = _mm_xor_si128(blocks[i], key[0]);
+
+    for (int round = 1; round < kRoundCount; round++)
+        for (size_t i = 0; i < kGroupSize; i++)
+            blocks[i] = _mm_aesenc_si128(blocks[i], key[round]);
+
+    for (size_t i = 0; i < kGroupSize; i++)
+        blocks[i] = _mm_aesenclast_si128(blocks[i], key[kRoundCount]);
+}
+
+/**
+ * XOR a group of data blocks with the CTR-mode keystream for consecutive counter values.
+ */
+template <int kRoundCount, size_t kGroupSize>
+static inline void EncryptCTRBlockGroup(const __m128i *key, __m128i counterPrefix, uint32_t &blockCounter,
+                                        const uint8_t *&inData, uint8_t *&outData)
+{
+    __m128i blocks[kGroupSize];
+
+    // The block counter occupies the last four bytes of the counter block, in big-endian order.
+    for (size_t i = 0; i < kGroupSize; i++)
+        blocks[i] = _mm_or_si128(counterPrefix,
+                                 _mm_set_epi32((int)nl::Weave::Encoding::BigEndian::HostSwap32(blockCounter++), 0, 0, 0));
+
+    EncryptBlockGroup<kRoundCount, kGroupSize>(key, blocks);
+
+    for (size_t i = 0; i < kGroupSize; i++)
+    {
+        blocks[i] = _mm_xor_si128(blocks[i], _mm_loadu_si128((const __m128i *)inData));
+        _mm_storeu_si128((__m128i *)outData, blocks[i]);
+        inData += 16;
+        outData += 16;
+    }
+
+    ClearSecretData((uint8_t *)blocks, sizeof(blocks));
+}
+
+/**
+ * XOR whole blocks of data with the CTR-mode keystream starting at the given counter block,
+ * encrypting up to kCTRParallelBlocks counter blocks at a time.
+ *
+ * As in CTRMode, only the 32 least-significant bits of the counter are incremented. On return
+ * the counter holds the value for the block following the last one processed.
+ */
+template <int kRoundCount, size_t kCTRParallelBlocks>
+static void EncryptCTRBlocks(const __m128i *key, uint8_t *counter, const uint8_t *inData, uint8_t *outData, size_t blockCount)
+{
+    uint32_t blockCounter = nl::Weave::Encoding::BigEndian::Get32(counter + 12);
+    __m128i counterPrefix = _mm_and_si128(_mm_loadu_si128((const __m128i *)counter), _mm_set_epi32(0, -1, -1, -1));
+
+    for (; blockCount >= kCTRParallelBlocks; blockCount -= kCTRParallelBlocks)
+        EncryptCTRBlockGroup<kRoundCount, kCTRParallelBlocks>(key, counterPrefix, blockCounter, inData, outData);
+
+    if (blockCount & 4)
+        EncryptCTRBlockGroup<kRoundCount, 4>(key, counterPrefix, blockCounter, inData, outData);
+    if (blockCount & 2)
+        EncryptCTRBlockGroup<kRoundCount, 2>(key, counterPrefix, blockCounter, inData, outData);
+    if (blockCount & 1)
+        EncryptCTRBlockGroup<kRoundCount, 1>(key, counterPrefix, blockCounter, inData, outData);
+
+    nl::Weave::Encoding::BigEndian::Put32(counter + 12, blockCounter);
+}
+
 AES128BlockCipher::AES128BlockCipher()
 {
     memset(&mKey, 0, sizeof(mKey));
@@ -108,6 +180,11 @@ void AES128BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES128BlockCipherEnc::EncryptCTRBlocks(uint8_t *counter, const uint8_t *inData, uint8_t *outData, size_t blockCount)
+{
+    ::nl::Weave::Platform::Security::EncryptCTRBlocks<kRoundCount, kCTRParallelBlocks>(mKey, counter, inData, outData, blockCount);
+}
+
 void AES128BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
@@ -234,6 +311,11 @@ void AES256BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES256BlockCipherEnc::EncryptCTRBlocks(uint8_t *counter, const uint8_t *inData, uint8_t *outData, size_t blockCount)
+{
+    ::nl::Weave::Platform::Security::EncryptCTRBlocks<kRoundCount, kCTRParallelBlocks>(mKey, counter, inData, outData, blockCount);
+}
+
 void AES256BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
@@ -81,6 +81,15 @@ class NL_DLL_EXPORT AES128BlockCipherEnc : public AES128BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    enum
+    {
+        kCTRParallelBlocks = 8      /**< Number of counter blocks encrypted in parallel by EncryptCTRBlocks(). */
+    };
+
+    void EncryptCTRBlocks(uint8_t *counter, const uint8_t *inData, uint8_t *outData, size_t blockCount);
+#endif
 };
 
 class NL_DLL_EXPORT AES128BlockCipherDec : public AES128BlockCipher
@@ -123,6 +132,15 @@ class NL_DLL_EXPORT AES256BlockCipherEnc : public AES256BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    enum
+    {
+        kCTRParallelBlocks = 8      /**< Number of counter blocks encrypted in parallel by EncryptCTRBlocks(). */
+    };
+
+    void EncryptCTRBlocks(uint8_t *counter, const uint8_t *inData, uint8_t *outData, size_t blockCount);
+#endif
 };
 
 class NL_DLL_EXPORT AES256BlockCipherDec : public AES256BlockCipher
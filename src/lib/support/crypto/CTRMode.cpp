@@ -55,6 +55,13 @@ void CTRMode<BlockCipher>::SetKey(const uint8_t *key)
     mBlockCipher.SetKey(key);
 }
 
+// Adopt the round keys of a block cipher already keyed by the caller, rather than expanding the key again.
+template <class BlockCipher>
+void CTRMode<BlockCipher>::SetKey(const BlockCipher &keyedBlockCipher)
+{
+    mBlockCipher = keyedBlockCipher;
+}
+
 template <class BlockCipher>
 void CTRMode<BlockCipher>::SetCounter(const uint8_t *counter)
 {
@@ -93,9 +100,36 @@ void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen,
 {
     // Index to next byte of encrypted counter to be used.
     uint32_t encryptedCounterIndex = mMsgIndex % kCounterLength;
+    uint16_t dataIndex = 0;
+
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    // Use up any remaining bytes of the current encrypted counter.
+    for (; encryptedCounterIndex != 0 && dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
+    {
+        outData[dataIndex] = inData[dataIndex] ^ mEncryptedCounter[encryptedCounterIndex];
+        encryptedCounterIndex = (encryptedCounterIndex + 1) % kCounterLength;
+    }
+
+    // Process whole blocks in bulk, letting the block cipher encrypt several counter blocks in parallel.
+    // Any trailing partial block is handled one byte at a time below.
+    if (encryptedCounterIndex == 0)
+    {
+        size_t blockCount = (dataLen - dataIndex) / kCounterLength;
+
+        if (blockCount > (UINT32_MAX - mMsgIndex) / kCounterLength)
+            blockCount = (UINT32_MAX - mMsgIndex) / kCounterLength;
+
+        if (blockCount > 0)
+        {
+            mBlockCipher.EncryptCTRBlocks(Counter, inData + dataIndex, outData + dataIndex, blockCount);
+            dataIndex += static_cast<uint16_t>(blockCount * kCounterLength);
+            mMsgIndex += static_cast<uint32_t>(blockCount * kCounterLength);
+        }
+    }
+#endif // WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
 
     // For each byte of input data...
-    for (uint16_t dataIndex = 0; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
+    for (; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
     {
         // If we need more encrypted counter bytes...
         if (encryptedCounterIndex == 0)
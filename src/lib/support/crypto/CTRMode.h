@@ -53,6 +53,7 @@ public:
     uint8_t Counter[kCounterLength];
 
     void SetKey(const uint8_t *key);
+    void SetKey(const BlockCipher &keyedBlockCipher);
     void SetCounter(const uint8_t *counter);
     void SetWeaveMessageCounter(uint64_t sendingNodeId, uint32_t msgId);
     void EncryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData);
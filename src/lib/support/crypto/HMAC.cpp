@@ -84,6 +84,16 @@ void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
     ClearSecretData(pad, sizeof(kBlockLength));
 }
 
+template <class H>
+void HMAC<H>::Begin(const KeySchedule &keySchedule)
+{
+    Reset();
+
+    // Resume the inner hash from the point where the key schedule absorbed the inner pad.
+    mHash = keySchedule.mInnerHash;
+    mKeySchedule = &keySchedule;
+}
+
 template <class H>
 void HMAC<H>::AddData(const uint8_t *msgData, uint16_t dataLen)
 {
@@ -109,6 +119,18 @@ void HMAC<H>::Finish(uint8_t *hashBuf)
     // Finalize the inner hash.
     mHash.Finish(innerHash);
 
+    // If begun from a key schedule, generate the outer hash from its precomputed state.
+    if (mKeySchedule != NULL)
+    {
+        mHash = mKeySchedule->mOuterHash;
+        mHash.AddData(innerHash, kDigestLength);
+        mHash.Finish(hashBuf);
+
+        Reset();
+        ClearSecretData(innerHash, sizeof(innerHash));
+        return;
+    }
+
     // Form the pad for the outer hash.
     memcpy(pad, mKey, mKeyLen);
     if (mKeyLen < kBlockLength)
@@ -134,6 +156,47 @@ void HMAC<H>::Reset()
     mHash.Reset();
     ClearSecretData(mKey, sizeof(mKey));
     mKeyLen = 0;
+    mKeySchedule = NULL;
+}
+
+template <class H>
+void HMAC<H>::KeySchedule::Init(const uint8_t *key, uint16_t keyLen)
+{
+    uint8_t keyBlock[kBlockLength];
+    uint8_t pad[kBlockLength];
+
+    // Zero-pad the key to a full block. If the key is larger than a block, hash it and use the result as the key.
+    memset(keyBlock, 0, kBlockLength);
+    if (keyLen > kBlockLength)
+    {
+        mInnerHash.Begin();
+        mInnerHash.AddData(key, keyLen);
+        mInnerHash.Finish(keyBlock);
+    }
+    else
+        memcpy(keyBlock, key, keyLen);
+
+    // Absorb the inner pad into the inner hash.
+    for (size_t i = 0; i < kBlockLength; i++)
+        pad[i] = keyBlock[i] ^ 0x36;
+    mInnerHash.Begin();
+    mInnerHash.AddData(pad, kBlockLength);
+
+    // Absorb the outer pad into the outer hash.
+    for (size_t i = 0; i < kBlockLength; i++)
+        pad[i] = keyBlock[i] ^ 0x5c;
+    mOuterHash.Begin();
+    mOuterHash.AddData(pad, kBlockLength);
+
+    ClearSecretData(keyBlock, sizeof(keyBlock));
+    ClearSecretData(pad, sizeof(pad));
+}
+
+template <class H>
+void HMAC<H>::KeySchedule::Reset()
+{
+    mInnerHash.Reset();
+    mOuterHash.Reset();
 }
 
 template class HMAC<Platform::Security::SHA1>;
@@ -43,10 +43,30 @@ public:
         kDigestLength           = H::kHashLength
     };
 
+    /**
+     * The inner and outer hash states for a given HMAC key.
+     *
+     * A key schedule is computed once per key and can then begin any number of HMAC computations
+     * with that key, sparing each of them the hashing of the key pads.
+     */
+    class KeySchedule
+    {
+    public:
+        void Init(const uint8_t *keyData, uint16_t keyLen);
+        void Reset(void);
+
+    private:
+        friend class HMAC;
+
+        H mInnerHash;
+        H mOuterHash;
+    };
+
     HMAC(void);
     ~HMAC(void);
 
     void Begin(const uint8_t *keyData, uint16_t keyLen);
+    void Begin(const KeySchedule &keySchedule);
     void AddData(const uint8_t *msgData, uint16_t dataLen);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
@@ -63,6 +83,7 @@ private:
     H mHash;
     uint8_t mKey[kBlockLength];
     uint16_t mKeyLen;
+    const KeySchedule *mKeySchedule;
 };
 
 typedef HMAC<Platform::Security::SHA1> HMACSHA1;
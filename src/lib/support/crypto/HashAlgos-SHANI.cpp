@@ -0,0 +1,600 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements SHA1 and SHA256 hash functions for the Weave layer
+ *      using the Intel SHA extensions when the CPU supports them, as reported
+ *      by CPUID at run time, and portable C code otherwise.
+ *      This implementation is used when #WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+ *      is enabled (1).
+ *
+ */
+
+#include <string.h>
+
+#include "WeaveCrypto.h"
+#include "HashAlgos.h"
+#include <Weave/Core/WeaveEncoding.h>
+
+#if WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+
+// The SHA extensions code relies on the GCC/Clang target attribute, so that it can live alongside
+// the portable code in a binary built for CPUs without them.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define WEAVE_SHANI_SUPPORTED 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define WEAVE_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#else
+#define WEAVE_SHANI_SUPPORTED 0
+#endif
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+using namespace nl::Weave::Crypto;
+using namespace nl::Weave::Encoding;
+
+typedef void (*HashBlocksFunct)(uint32_t *state, const uint8_t *data, size_t blockCount);
+
+static const uint32_t kSHA1InitialState[5] =
+{
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+};
+
+static const uint32_t kSHA256InitialState[8] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint32_t kSHA256RoundConstants[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+static inline uint32_t RotateLeft(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+static inline uint32_t RotateRight(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+// ==================== Portable implementation ====================
+
+static void SHA1Blocks_Portable(uint32_t *state, const uint8_t *data, size_t blockCount)
+{
+    uint32_t w[80];
+
+    for (; blockCount > 0; blockCount--, data += SHA1::kBlockLength)
+    {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        for (int i = 0; i < 16; i++)
+            w[i] = BigEndian::Get32(data + 4 * i);
+        for (int i = 16; i < 80; i++)
+            w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+#define SHA1_PORTABLE_ROUND(F, K, I)                            \
+    do {                                                        \
+        uint32_t t = RotateLeft(a, 5) + (F) + e + (K) + w[I];   \
+        e = d;                                                  \
+        d = c;                                                  \
+        c = RotateLeft(b, 30);                                  \
+        b = a;                                                  \
+        a = t;                                                  \
+    } while (0)
+
+        for (int i = 0; i < 20; i++)
+            SHA1_PORTABLE_ROUND((b & c) | (~b & d), 0x5A827999, i);
+        for (int i = 20; i < 40; i++)
+            SHA1_PORTABLE_ROUND(b ^ c ^ d, 0x6ED9EBA1, i);
+        for (int i = 40; i < 60; i++)
+            SHA1_PORTABLE_ROUND((b & c) | (b & d) | (c & d), 0x8F1BBCDC, i);
+        for (int i = 60; i < 80; i++)
+            SHA1_PORTABLE_ROUND(b ^ c ^ d, 0xCA62C1D6, i);
+
+#undef SHA1_PORTABLE_ROUND
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+
+    ClearSecretData((uint8_t *)w, sizeof(w));
+}
+
+static void SHA256Blocks_Portable(uint32_t *state, const uint8_t *data, size_t blockCount)
+{
+    uint32_t w[64];
+
+    for (; blockCount > 0; blockCount--, data += SHA256::kBlockLength)
+    {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 16; i++)
+            w[i] = BigEndian::Get32(data + 4 * i);
+        for (int i = 16; i < 64; i++)
+        {
+            const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        for (int i = 0; i < 64; i++)
+        {
+            const uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            const uint32_t ch = (e & f) ^ (~e & g);
+            const uint32_t t1 = h + s1 + ch + kSHA256RoundConstants[i] + w[i];
+            const uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t t2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    ClearSecretData((uint8_t *)w, sizeof(w));
+}
+
+// ==================== SHA extensions implementation ====================
+
+#if WEAVE_SHANI_SUPPORTED
+
+/**
+ * Check, once, whether the CPU implements the SHA extensions, and the SSSE3 and SSE4.1
+ * instructions used alongside them.
+ */
+static bool CPUSupportsSHAExtensions(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0, NULL) < 7)
+        return false;
+
+    __cpuid_count(1, 0, eax, ebx, ecx, edx);
+    if ((ecx & (1 << 9)) == 0 || (ecx & (1 << 19)) == 0)    // SSSE3, SSE4.1
+        return false;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1 << 29)) != 0;                          // SHA
+}
+
+// Four SHA-1 rounds: fold the next message words into E, and run the rounds from the current state.
+#define SHA1_ROUNDS_4(E_CUR, E_NEXT, MSG, FUNC)              \
+do {                                                         \
+    E_CUR = _mm_sha1nexte_epu32(E_CUR, MSG);                 \
+    E_NEXT = abcd;                                           \
+    abcd = _mm_sha1rnds4_epu32(abcd, E_CUR, FUNC);           \
+} while (0)
+
+WEAVE_SHANI_TARGET
+static void SHA1Blocks_SHANI(uint32_t *state, const uint8_t *data, size_t blockCount)
+{
+    const __m128i kByteSwapMask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL);
+    __m128i abcd, e0, e1, abcdSave, e0Save;
+    __m128i msg0, msg1, msg2, msg3;
+
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0x1B);
+    e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    for (; blockCount > 0; blockCount--, data += SHA1::kBlockLength)
+    {
+        abcdSave = abcd;
+        e0Save = e0;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), kByteSwapMask);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), kByteSwapMask);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), kByteSwapMask);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), kByteSwapMask);
+
+        // Rounds 0-3
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        // Rounds 4-79. Each group of four rounds also advances the message schedule: it completes the
+        // next message words (SHA1MSG2), and starts those for the groups further ahead (SHA1MSG1, XOR).
+        SHA1_ROUNDS_4(e1, e0, msg1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        SHA1_ROUNDS_4(e0, e1, msg2, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        SHA1_ROUNDS_4(e1, e0, msg3, 0);
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        SHA1_ROUNDS_4(e0, e1, msg0, 0);
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        SHA1_ROUNDS_4(e1, e0, msg1, 1);
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        SHA1_ROUNDS_4(e0, e1, msg2, 1);
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        SHA1_ROUNDS_4(e1, e0, msg3, 1);
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        SHA1_ROUNDS_4(e0, e1, msg0, 1);
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        SHA1_ROUNDS_4(e1, e0, msg1, 1);
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        SHA1_ROUNDS_4(e0, e1, msg2, 2);
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        SHA1_ROUNDS_4(e1, e0, msg3, 2);
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        SHA1_ROUNDS_4(e0, e1, msg0, 2);
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        SHA1_ROUNDS_4(e1, e0, msg1, 2);
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        SHA1_ROUNDS_4(e0, e1, msg2, 2);
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        SHA1_ROUNDS_4(e1, e0, msg3, 3);
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        SHA1_ROUNDS_4(e0, e1, msg0, 3);
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        SHA1_ROUNDS_4(e1, e0, msg1, 3);
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        SHA1_ROUNDS_4(e0, e1, msg2, 3);
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        SHA1_ROUNDS_4(e1, e0, msg3, 3);
+
+        // Add this block's result to the state.
+        e0 = _mm_sha1nexte_epu32(e0, e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+// Four SHA-256 rounds, using message words MSG and round constants 4*GROUP to 4*GROUP+3.
+#define SHA256_ROUNDS_4(MSG, GROUP)                                                                     \
+do {                                                                                                    \
+    __m128i wk = _mm_add_epi32(MSG, _mm_loadu_si128((const __m128i *)&kSHA256RoundConstants[4 * (GROUP)])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, wk);                                                 \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));                        \
+} while (0)
+
+// Complete the message words NEXT from those of the two preceding groups, CUR and PREV.
+#define SHA256_SCHEDULE(NEXT, CUR, PREV)                                                                \
+do {                                                                                                    \
+    NEXT = _mm_add_epi32(NEXT, _mm_alignr_epi8(CUR, PREV, 4));                                          \
+    NEXT = _mm_sha256msg2_epu32(NEXT, CUR);                                                             \
+} while (0)
+
+WEAVE_SHANI_TARGET
+static void SHA256Blocks_SHANI(uint32_t *state, const uint8_t *data, size_t blockCount)
+{
+    const __m128i kByteSwapMask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+    __m128i state0, state1, tmp, abefSave, cdghSave;
+    __m128i msg0, msg1, msg2, msg3;
+
+    // The SHA-256 instructions hold the state as ABEF and CDGH.
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);    // CDAB
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B); // EFGH
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                       // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                    // CDGH
+
+    for (; blockCount > 0; blockCount--, data += SHA256::kBlockLength)
+    {
+        abefSave = state0;
+        cdghSave = state1;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), kByteSwapMask);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), kByteSwapMask);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), kByteSwapMask);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), kByteSwapMask);
+
+        // Each group of four rounds also advances the message schedule: it completes the next
+        // message words (SHA256MSG2), and starts those for three groups ahead (SHA256MSG1).
+        SHA256_ROUNDS_4(msg0, 0);
+        SHA256_ROUNDS_4(msg1, 1);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHA256_ROUNDS_4(msg2, 2);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHA256_ROUNDS_4(msg3, 3);
+        SHA256_SCHEDULE(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHA256_ROUNDS_4(msg0, 4);
+        SHA256_SCHEDULE(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHA256_ROUNDS_4(msg1, 5);
+        SHA256_SCHEDULE(msg2, msg1, msg0);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHA256_ROUNDS_4(msg2, 6);
+        SHA256_SCHEDULE(msg3, msg2, msg1);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHA256_ROUNDS_4(msg3, 7);
+        SHA256_SCHEDULE(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHA256_ROUNDS_4(msg0, 8);
+        SHA256_SCHEDULE(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHA256_ROUNDS_4(msg1, 9);
+        SHA256_SCHEDULE(msg2, msg1, msg0);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHA256_ROUNDS_4(msg2, 10);
+        SHA256_SCHEDULE(msg3, msg2, msg1);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHA256_ROUNDS_4(msg3, 11);
+        SHA256_SCHEDULE(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHA256_ROUNDS_4(msg0, 12);
+        SHA256_SCHEDULE(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHA256_ROUNDS_4(msg1, 13);
+        SHA256_SCHEDULE(msg2, msg1, msg0);
+        SHA256_ROUNDS_4(msg2, 14);
+        SHA256_SCHEDULE(msg3, msg2, msg1);
+        SHA256_ROUNDS_4(msg3, 15);
+
+        // Add this block's result to the state.
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                                          // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                                       // DCHG
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));     // DCBA
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));        // HGFE
+}
+
+#endif // WEAVE_SHANI_SUPPORTED
+
+// ==================== Implementation selection ====================
+
+struct HashBlocksFuncts
+{
+    HashBlocksFunct SHA1Blocks;
+    HashBlocksFunct SHA256Blocks;
+};
+
+static const HashBlocksFuncts sPortableHashBlocksFuncts = { SHA1Blocks_Portable, SHA256Blocks_Portable };
+
+#if WEAVE_SHANI_SUPPORTED
+
+static const HashBlocksFuncts sSHANIHashBlocksFuncts = { SHA1Blocks_SHANI, SHA256Blocks_SHANI };
+
+static const HashBlocksFuncts *sHashBlocksFuncts;
+
+/**
+ * Return the block functions for this CPU, selecting them on first use.
+ *
+ * Both functions are published with a single pointer store, so a thread never sees one selected without the other.
+ * Concurrent first calls may both make the selection; they store the same value.
+ */
+static const HashBlocksFuncts *GetHashBlocksFuncts(void)
+{
+    const HashBlocksFuncts *funcs = __atomic_load_n(&sHashBlocksFuncts, __ATOMIC_ACQUIRE);
+
+    if (funcs == NULL)
+    {
+        funcs = CPUSupportsSHAExtensions() ? &sSHANIHashBlocksFuncts : &sPortableHashBlocksFuncts;
+        __atomic_store_n(&sHashBlocksFuncts, funcs, __ATOMIC_RELEASE);
+    }
+
+    return funcs;
+}
+
+#else // WEAVE_SHANI_SUPPORTED
+
+static inline const HashBlocksFuncts *GetHashBlocksFuncts(void)
+{
+    return &sPortableHashBlocksFuncts;
+}
+
+#endif // WEAVE_SHANI_SUPPORTED
+
+// ==================== Message padding and buffering ====================
+
+static void HashBegin(SHA_CTX_SHANI &ctx, const uint32_t *initialState, size_t stateWords)
+{
+    memset(&ctx, 0, sizeof(ctx));
+    memcpy(ctx.State, initialState, stateWords * sizeof(uint32_t));
+}
+
+static void HashAddData(SHA_CTX_SHANI &ctx, HashBlocksFunct hashBlocks, const uint8_t *data, size_t dataLen)
+{
+    size_t bufferedLen = (size_t)(ctx.Length % sizeof(ctx.Buffer));
+
+    ctx.Length += dataLen;
+
+    // Complete and hash a partially filled block.
+    if (bufferedLen > 0)
+    {
+        size_t copyLen = sizeof(ctx.Buffer) - bufferedLen;
+
+        if (copyLen > dataLen)
+            copyLen = dataLen;
+
+        memcpy(ctx.Buffer + bufferedLen, data, copyLen);
+        data += copyLen;
+        dataLen -= copyLen;
+        bufferedLen += copyLen;
+
+        if (bufferedLen < sizeof(ctx.Buffer))
+            return;
+
+        hashBlocks(ctx.State, ctx.Buffer, 1);
+    }
+
+    // Hash whole blocks directly from the input.
+    if (dataLen >= sizeof(ctx.Buffer))
+    {
+        const size_t blockCount = dataLen / sizeof(ctx.Buffer);
+
+        hashBlocks(ctx.State, data, blockCount);
+        data += blockCount * sizeof(ctx.Buffer);
+        dataLen -= blockCount * sizeof(ctx.Buffer);
+    }
+
+    // Keep any remainder for later.
+    memcpy(ctx.Buffer, data, dataLen);
+}
+
+static void HashFinish(SHA_CTX_SHANI &ctx, HashBlocksFunct hashBlocks, uint8_t *hashBuf, size_t stateWords)
+{
+    const uint64_t bitLength = ctx.Length * 8;
+    size_t bufferedLen = (size_t)(ctx.Length % sizeof(ctx.Buffer));
+
+    // Append the 1 bit, then zeros up to the 64-bit message length at the end of the final block.
+    ctx.Buffer[bufferedLen++] = 0x80;
+
+    if (bufferedLen > sizeof(ctx.Buffer) - sizeof(uint64_t))
+    {
+        memset(ctx.Buffer + bufferedLen, 0, sizeof(ctx.Buffer) - bufferedLen);
+        hashBlocks(ctx.State, ctx.Buffer, 1);
+        bufferedLen = 0;
+    }
+
+    memset(ctx.Buffer + bufferedLen, 0, sizeof(ctx.Buffer) - sizeof(uint64_t) - bufferedLen);
+    BigEndian::Put64(ctx.Buffer + sizeof(ctx.Buffer) - sizeof(uint64_t), bitLength);
+    hashBlocks(ctx.State, ctx.Buffer, 1);
+
+    for (size_t i = 0; i < stateWords; i++)
+        BigEndian::Put32(hashBuf + 4 * i, ctx.State[i]);
+
+    ClearSecretData((uint8_t *)&ctx, sizeof(ctx));
+}
+
+// ==================== SHA1 and SHA256 ====================
+
+SHA1::SHA1()
+{
+}
+
+SHA1::~SHA1()
+{
+}
+
+void SHA1::Begin()
+{
+    HashBegin(mSHACtx, kSHA1InitialState, kHashLength / sizeof(uint32_t));
+}
+
+void SHA1::AddData(const uint8_t *data, uint16_t dataLen)
+{
+    HashAddData(mSHACtx, GetHashBlocksFuncts()->SHA1Blocks, data, dataLen);
+}
+
+void SHA1::Finish(uint8_t *hashBuf)
+{
+    HashFinish(mSHACtx, GetHashBlocksFuncts()->SHA1Blocks, hashBuf, kHashLength / sizeof(uint32_t));
+}
+
+void SHA1::Reset()
+{
+    memset(this, 0, sizeof(*this));
+}
+
+SHA256::SHA256()
+{
+}
+
+SHA256::~SHA256()
+{
+}
+
+void SHA256::Begin()
+{
+    HashBegin(mSHACtx, kSHA256InitialState, kHashLength / sizeof(uint32_t));
+}
+
+void SHA256::AddData(const uint8_t *data, uint16_t dataLen)
+{
+    HashAddData(mSHACtx, GetHashBlocksFuncts()->SHA256Blocks, data, dataLen);
+}
+
+void SHA256::Finish(uint8_t *hashBuf)
+{
+    HashFinish(mSHACtx, GetHashBlocksFuncts()->SHA256Blocks, hashBuf, kHashLength / sizeof(uint32_t));
+}
+
+void SHA256::Reset()
+{
+    memset(this, 0, sizeof(*this));
+}
+
+} /* namespace Security */
+} /* namespace Platform */
+} /* namespace Weave */
+} /* namespace nl */
+
+#endif // WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
@@ -68,6 +68,16 @@
 #include "WeaveProjectHashAlgos.h"
 #endif
 
+#if WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+// Hash state for the Weave SHA1 and SHA256 implementation in HashAlgos-SHANI.cpp.
+typedef struct
+{
+    uint32_t State[8];          // Intermediate hash value; SHA1 uses the first five words.
+    uint64_t Length;            // Number of bytes added to the hash.
+    uint8_t Buffer[64];         // Partial block not yet hashed.
+} SHA_CTX_SHANI;
+#endif
+
 namespace nl {
 namespace Weave {
 namespace Platform {
@@ -100,6 +110,8 @@ private:
     MINCRYPT_SHA_CTX mSHACtx;
 #elif WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
     SHA_CTX_PLATFORM mSHACtx;
+#elif WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+    SHA_CTX_SHANI mSHACtx;
 #endif
 };
 
@@ -130,6 +142,8 @@ private:
     MINCRYPT_SHA256_CTX mSHACtx;
 #elif WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
     SHA256_CTX_PLATFORM mSHACtx;
+#elif WEAVE_CONFIG_HASH_IMPLEMENTATION_SHANI
+    SHA_CTX_SHANI mSHACtx;
 #endif
 };
 
@@ -329,6 +329,94 @@
 #endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 #endif /* !WEAVE_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+ *
+ *  @brief
+ *      The number of small packet buffers, of #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL bytes each, in the BSD sockets
+ *      packet buffer pool, in addition to the #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC full-size buffers.
+ *
+ *      \c PacketBuffer::NewWithAvailableSize serves each request from the smallest buffer size class that fits it, falling back
+ *      to larger classes when that class is exhausted, so that short messages (e.g. WRMP acknowledgements) do not each occupy
+ *      a full-size buffer. \c PacketBuffer::RightSize moves a message into a smaller class after the fact.
+ *
+ *      The default (0) disables this size class. Size classes are only supported with a packet buffer pool
+ *      (#WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC non-zero).
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL
+ *
+ *  @brief
+ *      The capacity, in bytes, of a small packet buffer. See #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL 128
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+ *
+ *  @brief
+ *      The number of medium packet buffers, of #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM bytes each, in the BSD sockets
+ *      packet buffer pool. See #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL.
+ *
+ *      The default (0) disables this size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM
+ *
+ *  @brief
+ *      The capacity, in bytes, of a medium packet buffer. See #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM 512
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM */
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+#error "Packet buffer size classes require the BSD sockets packet buffer pool."
+#endif /* WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC */
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL >= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM || \
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM >= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
+#error "Packet buffer size class capacities must be increasing and below WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX."
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL >= ... */
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+ *
+ *  @brief
+ *      The number of free packet buffers each thread may keep in a private cache (a "magazine") in front of the shared packet
+ *      buffer pool.
+ *
+ *      When non-zero, \c PacketBuffer::New and \c PacketBuffer::Free are served from the calling thread's magazine without
+ *      taking the buffer pool lock. An empty magazine is refilled, and a full one drained, half a magazine at a time through a
+ *      lock-free free list, so threads that allocate messages and the network thread that frees them no longer contend on a
+ *      mutex for every buffer.
+ *
+ *      Buffers parked in a magazine are unavailable to other threads until it is drained, so this value should be small
+ *      relative to #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC divided by the number of threads that handle packet buffers.
+ *
+ *      This is only supported by the BSD sockets pool allocator (#WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC non-zero) with
+ *      POSIX locking. The default (0) disables the magazines.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE */
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE && \
+    (WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC || !WEAVE_SYSTEM_CONFIG_POSIX_LOCKING)
+#error "WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE requires the packet buffer pool and POSIX locking."
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE && ... */
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -452,6 +540,50 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* WEAVE_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      This boolean configuration option is (1) if armed timers should be kept in a hierarchical timer wheel, indexed by
+ *      callback and application state, rather than being found by scanning the whole timer pool on every event loop iteration.
+ *
+ *      With the wheel, Timer::Start(), Timer::Cancel() and Layer::CancelTimer() run in constant time and each event loop
+ *      iteration costs time proportional to the number of expiring timers, at the expense of a fixed table of slot heads in
+ *      each Layer object and one index bucket per timer in the pool. This is worthwhile when WEAVE_SYSTEM_CONFIG_NUM_TIMERS is
+ *      large.
+ *
+ *  @note
+ *      When enabled, Timer::Start() and Timer::Cancel() must be called on the thread driving the event loop; Layer::ScheduleWork()
+ *      remains safe to call from any thread.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#error "WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL requires WEAVE_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      This boolean configuration option is (1) if the BSD sockets event loop should be driven by an edge-triggered Linux
+ *      epoll(7) instance and an eventfd(2) wake descriptor, rather than by placing every endpoint socket and a wake pipe into the
+ *      select() descriptor sets.
+ *
+ *      When enabled, the existing PrepareSelect() / select() / HandleSelectResult() contract is retained, but only the epoll and
+ *      eventfd descriptors are placed in the descriptor sets, making the per-iteration cost proportional to the number of ready
+ *      endpoints rather than to the number of open endpoints.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#define WEAVE_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#error "WEAVE_SYSTEM_CONFIG_USE_EPOLL requires WEAVE_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -47,6 +47,12 @@
 #include <errno.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <string.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if !WEAVE_SYSTEM_CONFIG_PLATFORM_PROVIDES_EVENT_FUNCTIONS
 #include <lwip/err.h>
@@ -100,8 +106,13 @@ Layer::Layer()
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    this->mEPollFD = -1;
+    this->mWakeEventFD = -1;
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     this->mWakePipeIn = 0;
     this->mWakePipeOut = 0;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
@@ -112,10 +123,10 @@ Layer::Layer()
 Error Layer::Init(void* aContext)
 {
     Error lReturn;
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     int lPipeFDs[2];
     int lOSReturn, lFlags;
-#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
     if (this->mLayerState != kLayerState_NotInitialized)
         return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
@@ -127,7 +138,21 @@ Error Layer::Init(void* aContext)
     this->AddEventHandlerDelegate(sSystemEventHandlerDelegate);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Create the epoll instance with which endpoint sockets register for edge-triggered readiness notification.
+    this->mEPollFD = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(this->mEPollFD >= 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+
+    // Create an eventfd counter to allow an arbitrary thread to wake the thread in the select loop.
+    this->mWakeEventFD = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->mWakeEventFD < 0)
+    {
+        lReturn = nl::Weave::System::MapErrorPOSIX(errno);
+        ::close(this->mEPollFD);
+        this->mEPollFD = -1;
+        ExitNow();
+    }
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     // Create a Unix pipe to allow an arbitrary thread to wake the thread in the select loop.
     lOSReturn = ::pipe(lPipeFDs);
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
@@ -145,6 +170,10 @@ Error Layer::Init(void* aContext)
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    this->mTimerWheel.Init(Timer::GetCurrentEpoch());
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext = aContext;
 
@@ -165,7 +194,19 @@ Error Layer::Shutdown()
     lReturn = Platform::Layer::WillShutdown(*this, lContext);
     SuccessOrExit(lReturn);
 
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    if (this->mWakeEventFD != -1)
+    {
+        ::close(this->mWakeEventFD);
+        this->mWakeEventFD = -1;
+    }
+
+    if (this->mEPollFD != -1)
+    {
+        ::close(this->mEPollFD);
+        this->mEPollFD = -1;
+    }
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     if (this->mWakePipeOut != -1)
     {
         ::close(this->mWakePipeOut);
@@ -184,6 +225,11 @@ Error Layer::Shutdown()
         }
     }
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // Release any cancelled work that is still waiting to be handed to the wheel.
+    this->mTimerWheel.Shutdown();
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     this->mContext = NULL;
     this->mLayerState = kLayerState_NotInitialized;
 
@@ -288,6 +334,19 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void* aAppState)
     if (this->State() != kLayerState_Initialized)
         return;
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer* lTimer;
+
+    // Work scheduled from any thread is only indexed once it has been handed over to this thread.
+    this->mTimerWheel.DrainScheduledWork();
+
+    lTimer = this->mTimerWheel.Find(aOnComplete, aAppState);
+
+    if (lTimer != NULL)
+    {
+        lTimer->Cancel();
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -298,6 +357,7 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void* aAppState)
             break;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 }
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
@@ -558,14 +618,34 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
     if (this->State() != kLayerState_Initialized)
         return;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // The epoll descriptor becomes readable whenever any registered socket has a pending edge; the sockets themselves are never
+    // placed in the descriptor sets.
+    if (this->mEPollFD + 1 > aSetSize)
+        aSetSize = this->mEPollFD + 1;
+
+    FD_SET(this->mEPollFD, aReadSet);
+
+    if (this->mWakeEventFD + 1 > aSetSize)
+        aSetSize = this->mWakeEventFD + 1;
+
+    FD_SET(this->mWakeEventFD, aReadSet);
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     if (this->mWakePipeIn + 1 > aSetSize)
         aSetSize = this->mWakePipeIn + 1;
 
     FD_SET(this->mWakePipeIn, aReadSet);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch = kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + aSleepTime.tv_usec / 1000;
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    const Timer::Epoch kTimerSleepTime = this->mTimerWheel.GetSleepTime(kCurrentEpoch);
+
+    if (kTimerSleepTime != TimerWheel::kNoTimers && Timer::IsEarlierEpoch(kCurrentEpoch + kTimerSleepTime, lAwakenEpoch))
+        lAwakenEpoch = kCurrentEpoch + kTimerSleepTime;
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -582,6 +662,7 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
                 lAwakenEpoch = lTimer->mAwakenEpoch;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     const Timer::Epoch kSleepTime = lAwakenEpoch - kCurrentEpoch;
     aSleepTime.tv_sec = kSleepTime / 1000;
@@ -621,6 +702,16 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
 
     if (aSetSize > 0)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // If we woke because of someone signalling the wake eventfd, reset its counter before returning. A single read
+        // consumes all accumulated wakes.
+        if (FD_ISSET(this->mWakeEventFD, aReadSet))
+        {
+            uint64_t lCount;
+            const ssize_t kIOResult = ::read(this->mWakeEventFD, &lCount, sizeof(lCount));
+            static_cast<void>(kIOResult);
+        }
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
         // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
         if (FD_ISSET(this->mWakePipeIn, aReadSet))
         {
@@ -632,6 +723,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
                     break;
             }
         }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
@@ -640,6 +732,9 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
     this->mHandleSelectThread = lThreadSelf;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    this->mTimerWheel.HandleExpiredTimers(kCurrentEpoch);
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -649,6 +744,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
             lTimer->HandleComplete();
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
@@ -677,12 +773,93 @@ void Layer::WakeSelect()
     }
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Increment the wake eventfd counter to wake up the select call.
+    const uint64_t kIncrement = 1;
+    const ssize_t kIOResult = ::write(this->mWakeEventFD, &kIncrement, sizeof(kIncrement));
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     // Write a single byte to the wake pipe to wake up the select call.
     const uint8_t kByte = 0;
     const ssize_t kIOResult = ::write(this->mWakePipeOut, &kByte, 1);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     static_cast<void>(kIOResult);
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ * Register a socket with the layer's epoll instance for edge-triggered readability, writability and error notification.
+ *
+ *  @note
+ *      Because notification is edge-triggered, the socket is registered once, for all events, for its entire lifetime. Callers are
+ *      expected to latch the reported events and to consider an event consumed only once the corresponding I/O operation returns
+ *      @p EAGAIN.
+ *
+ *  @param[in]  aSocket     The socket descriptor to watch.
+ *  @param[in]  aContext    An opaque pointer returned with each event reported for @p aSocket by GetSocketEvents().
+ *
+ *  @retval #WEAVE_SYSTEM_NO_ERROR                  On success.
+ *  @retval #WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE    If the layer is not initialized.
+ *  @retval other                                   A mapped POSIX error from @p epoll_ctl().
+ */
+Error Layer::WatchSocket(int aSocket, void* aContext)
+{
+    struct epoll_event lEvent;
+
+    if (this->State() != kLayerState_Initialized)
+        return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    lEvent.events = EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLRDHUP | EPOLLET;
+    lEvent.data.ptr = aContext;
+
+    if (::epoll_ctl(this->mEPollFD, EPOLL_CTL_ADD, aSocket, &lEvent) != 0)
+        return nl::Weave::System::MapErrorPOSIX(errno);
+
+    return WEAVE_SYSTEM_NO_ERROR;
+}
+
+/**
+ * Deregister a socket previously registered with WatchSocket(). This must be called before the socket is closed so that no
+ * further events are reported against the now-stale context.
+ *
+ *  @param[in]  aSocket     The socket descriptor to stop watching.
+ */
+void Layer::UnwatchSocket(int aSocket)
+{
+    struct epoll_event lEvent;
+
+    if (this->mEPollFD < 0)
+        return;
+
+    // A non-NULL event argument is required by kernels prior to 2.6.9.
+    memset(&lEvent, 0, sizeof(lEvent));
+    ::epoll_ctl(this->mEPollFD, EPOLL_CTL_DEL, aSocket, &lEvent);
+}
+
+/**
+ * Harvest, without blocking, the readiness events reported for watched sockets since the previous call.
+ *
+ *  @param[out] aEvents     An array to receive the events; the @p data.ptr member of each holds the context registered with
+ *                          WatchSocket().
+ *  @param[in]  aMaxEvents  The capacity of @p aEvents.
+ *
+ *  @return The number of events stored in @p aEvents, which is zero if there are none or on error.
+ */
+int Layer::GetSocketEvents(struct epoll_event* aEvents, int aMaxEvents)
+{
+    int lCount;
+
+    if (this->State() != kLayerState_Initialized)
+        return 0;
+
+    do
+    {
+        lCount = ::epoll_wait(this->mEPollFD, aEvents, aMaxEvents, 0);
+    } while (lCount < 0 && errno == EINTR);
+
+    return (lCount < 0) ? 0 : lCount;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
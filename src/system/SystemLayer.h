@@ -34,6 +34,10 @@
 #include <sys/select.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 #include <pthread.h>
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
@@ -44,6 +48,10 @@
 #include <SystemLayer/SystemObject.h>
 #include <SystemLayer/SystemEvent.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#include <SystemLayer/SystemTimer.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
 namespace nl {
@@ -129,7 +137,8 @@ private:
  *      This provides access to timers according to the configured event handling model.
  *
  *      For \c WEAVE_SYSTEM_CONFIG_USE_SOCKETS, event readiness notification is handled via traditional poll/select implementation on
- *      the platform adaptation.
+ *      the platform adaptation. When \c WEAVE_SYSTEM_CONFIG_USE_EPOLL is also set, sockets are instead registered with an
+ *      edge-triggered epoll instance owned by the layer, and only the epoll and wake descriptors are placed in the select sets.
  *
  *      For \c WEAVE_SYSTEM_CONFIG_USE_LWIP, event readiness notification is handle via events / messages and platform- and
  *      system-specific hooks for the event/message system.
@@ -161,6 +170,12 @@ public:
     void WakeSelect(void);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    Error WatchSocket(int aSocket, void* aContext);
+    void UnwatchSocket(int aSocket);
+    int GetSocketEvents(struct epoll_event* aEvents, int aMaxEvents);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     typedef Error (*EventHandler)(Object& aTarget, EventType aEventType, uintptr_t aArgument);
     Error AddEventHandlerDelegate(LwIPEventHandlerDelegate& aDelegate);
@@ -196,12 +211,21 @@ private:
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    int mEPollFD;
+    int mWakeEventFD;
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     int mWakePipeIn;
     int mWakePipeOut;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    TimerWheel mTimerWheel;
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
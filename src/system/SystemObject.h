@@ -240,8 +240,8 @@ inline T* ObjectPool<T, N>::TryCreate(Layer& aLayer)
     {
         T& lObject = reinterpret_cast<T*>(mArena.uMemory)[lIndex];
 
-
-        if (lObject.TryCreate(aLayer, sizeof(T)))
+        // Skip retained objects without the cost of a failed compare-and-swap.
+        if (lObject.mSystemLayer == NULL && lObject.TryCreate(aLayer, sizeof(T)))
         {
             lReturn = &lObject;
             break;
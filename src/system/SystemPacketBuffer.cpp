@@ -44,6 +44,10 @@
 #include <stdlib.h>
 #include <stddef.h>
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+#include <pthread.h>
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/pbuf.h>
 #include <lwip/mem.h>
@@ -64,9 +68,88 @@ namespace System {
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL];
+} SmallBufferPoolElement;
+
+static SmallBufferPoolElement sSmallBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL];
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM];
+} MediumBufferPoolElement;
+
+static MediumBufferPoolElement sMediumBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM];
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+
 static BufferPoolElement sBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
 
-PacketBuffer* PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+// The size classes of the buffer pool, in increasing order of capacity; the last class holds the full-size buffers.
+struct BufferPoolClass
+{
+    uint8_t* mBase;
+    size_t mBlockSize;
+    size_t mNumBlocks;
+    size_t mCapacity;
+};
+
+#define BUFFER_POOL_CLASS(aPool) \
+    { aPool[0].Block, sizeof(aPool[0]), sizeof(aPool) / sizeof(aPool[0]), sizeof(aPool[0].Block) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE }
+
+static const BufferPoolClass sBufferPoolClasses[] =
+{
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+    BUFFER_POOL_CLASS(sSmallBufferPool),
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+    BUFFER_POOL_CLASS(sMediumBufferPool),
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+    BUFFER_POOL_CLASS(sBufferPool)
+};
+
+static const size_t kNumBufferPoolClasses = sizeof(sBufferPoolClasses) / sizeof(sBufferPoolClasses[0]);
+
+/**
+ * Return the smallest size class whose buffers hold at least \c aAllocSize bytes.
+ */
+static inline size_t BufferPoolClassFor(size_t aAllocSize)
+{
+    size_t lClass = 0;
+
+    while (lClass < kNumBufferPoolClasses - 1 && sBufferPoolClasses[lClass].mCapacity < aAllocSize)
+        lClass++;
+
+    return lClass;
+}
+
+/**
+ * Return the size class of a pool buffer.
+ */
+static inline size_t BufferPoolClassOf(const PacketBuffer* aPacket)
+{
+    const uint8_t* const lAddress = reinterpret_cast<const uint8_t*>(aPacket);
+    size_t lClass = 0;
+
+    while (lClass < kNumBufferPoolClasses - 1 &&
+           (lAddress < sBufferPoolClasses[lClass].mBase ||
+            lAddress >= sBufferPoolClasses[lClass].mBase + sBufferPoolClasses[lClass].mNumBlocks * sBufferPoolClasses[lClass].mBlockSize))
+        lClass++;
+
+    return lClass;
+}
+
+static inline PacketBuffer* BufferPoolBlock(size_t aClass, size_t aIndex)
+{
+    return reinterpret_cast<PacketBuffer*>(sBufferPoolClasses[aClass].mBase + aIndex * sBufferPoolClasses[aClass].mBlockSize);
+}
+
+const bool PacketBuffer::sFreeListsBuilt = PacketBuffer::BuildFreeLists();
 
 #if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
 static Mutex sBufferPoolMutex;
@@ -75,6 +158,55 @@ static Mutex sBufferPoolMutex;
 #define UNLOCK_BUF_POOL()   do { sBufferPoolMutex.Unlock(); } while (0)
 #endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+// Shared lock-free free lists of pool buffers, one per size class, linked through their next pointers. Each head word holds
+// the index within its class of the first free buffer plus one (zero when the list is empty) in its low half and a
+// modification tag in its high half. The tag makes a compare-and-swap fail if other threads popped and pushed back the head
+// buffer in the meantime (ABA).
+static volatile uint64_t sFreeListHeads[kNumBufferPoolClasses];
+
+// Per-thread cache of free buffers for each size class, used as a stack so the most recently freed (and cache-warm) buffer is
+// reused first.
+struct PacketBufferMagazine
+{
+    PacketBuffer* mBuffers[kNumBufferPoolClasses][WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE];
+    uint16_t mCount[kNumBufferPoolClasses];
+    bool mRegistered;
+};
+
+static __thread PacketBufferMagazine sMagazine;
+
+// Used only to return the buffers in a thread's magazine to the shared free lists when that thread exits.
+static pthread_key_t sMagazineKey;
+
+// Number of buffers moved between a magazine and the shared free list at a time.
+static const uint16_t kMagazineTransferSize = (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE + 1) / 2;
+
+static inline PacketBuffer* FreeListHeadBuffer(size_t aClass, uint64_t aHead)
+{
+    const uint32_t lIndex = static_cast<uint32_t>(aHead);
+
+    return (lIndex != 0) ? BufferPoolBlock(aClass, lIndex - 1) : NULL;
+}
+
+static inline uint64_t MakeFreeListHead(size_t aClass, PacketBuffer* aFirst, uint64_t aPrevHead)
+{
+    const uint64_t lTag = (aPrevHead >> 32) + 1;
+    uint64_t lIndex = 0;
+
+    if (aFirst != NULL)
+        lIndex = static_cast<uint64_t>(reinterpret_cast<uint8_t*>(aFirst) - sBufferPoolClasses[aClass].mBase) / sBufferPoolClasses[aClass].mBlockSize + 1;
+
+    return (lTag << 32) | lIndex;
+}
+
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+static PacketBuffer* sFreeLists[kNumBufferPoolClasses];
+
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
 #endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
 #ifndef LOCK_BUF_POOL
@@ -418,11 +550,13 @@ void PacketBuffer::AddRef()
 {
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     pbuf_ref(this);
-#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#elif WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+    __sync_fetch_and_add(&this->ref, 1);
+#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
     LOCK_BUF_POOL();
     ++this->ref;
     UNLOCK_BUF_POOL();
-#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
 }
 
 /**
@@ -460,16 +594,7 @@ PacketBuffer* PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 
     static_cast<void>(lBlockSize);
 
-    LOCK_BUF_POOL();
-
-    lPacket = sFreeList;
-    if (lPacket != NULL)
-    {
-        sFreeList = static_cast<PacketBuffer*>(lPacket->next);
-        SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
-    }
-
-    UNLOCK_BUF_POOL();
+    lPacket = AllocFromPool(BufferPoolClassFor(lAllocSize), kNumBufferPoolClasses);
 
 #else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
@@ -569,7 +694,28 @@ void PacketBuffer::Free(PacketBuffer* aPacket)
         SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS();
     }
 
-#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#elif WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+    while (aPacket != NULL)
+    {
+        PacketBuffer* lNextPacket = static_cast<PacketBuffer*>(aPacket->next);
+        const uint16_t lPrevRef = __sync_fetch_and_sub(&aPacket->ref, 1);
+
+        VerifyOrDieWithMsg(lPrevRef > 0, WeaveSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
+
+        if (lPrevRef == 1)
+        {
+            SYSTEM_STATS_SUBTRACT_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs, 1);
+            ReturnToMagazine(BufferPoolClassOf(aPacket), aPacket);
+            aPacket = lNextPacket;
+        }
+        else
+        {
+            aPacket = NULL;
+        }
+    }
+
+#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
 
     LOCK_BUF_POOL();
 
@@ -584,8 +730,10 @@ void PacketBuffer::Free(PacketBuffer* aPacket)
         {
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket->next = sFreeList;
-            sFreeList = aPacket;
+            const size_t lClass = BufferPoolClassOf(aPacket);
+
+            aPacket->next = sFreeLists[lClass];
+            sFreeLists[lClass] = aPacket;
 #else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
             free(aPacket);
 #endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
@@ -599,7 +747,7 @@ void PacketBuffer::Free(PacketBuffer* aPacket)
 
     UNLOCK_BUF_POOL();
 
-#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
 }
 
 /**
@@ -622,7 +770,9 @@ PacketBuffer* PacketBuffer::FreeHead(PacketBuffer* aPacket)
 
 /**
  * Copy the given buffer to a right-sized buffer if applicable.
- * This function is a no-op for sockets.
+ *
+ * For sockets, this moves a single, unshared buffer into the smallest packet buffer pool size class that holds its reserved
+ * space and data, when such a class is configured and has a free buffer. Otherwise it is a no-op.
  *
  *  @param[in] aPacket - buffer or buffer chain.
  *
@@ -639,31 +789,266 @@ PacketBuffer* PacketBuffer::RightSize(PacketBuffer *aPacket)
 
         WeaveLogProgress(WeaveSystemLayer, "PacketBuffer: RightSize Copied");
     }
+#elif !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    if (aPacket != NULL && aPacket->next == NULL && aPacket->ref == 1)
+    {
+        const uint16_t lReservedSize = aPacket->ReservedSize();
+        const size_t lClass = BufferPoolClassOf(aPacket);
+        const size_t lNewClass = BufferPoolClassFor(static_cast<size_t>(lReservedSize) + aPacket->len);
+
+        if (lNewClass < lClass)
+        {
+            PacketBuffer* lSmallerPacket = AllocFromPool(lNewClass, lClass);
+
+            if (lSmallerPacket != NULL)
+            {
+                lSmallerPacket->payload = reinterpret_cast<uint8_t*>(lSmallerPacket) + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + lReservedSize;
+                lSmallerPacket->len = lSmallerPacket->tot_len = aPacket->len;
+                lSmallerPacket->next = NULL;
+                lSmallerPacket->ref = 1;
+
+                memcpy(lSmallerPacket->payload, aPacket->payload, aPacket->len);
+
+                PacketBuffer::Free(aPacket);
+                lNewPacket = lSmallerPacket;
+            }
+        }
+    }
 #endif
     return lNewPacket;
 }
 
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
-PacketBuffer* PacketBuffer::BuildFreeList()
+bool PacketBuffer::BuildFreeLists()
 {
-    PacketBuffer* lHead = NULL;
-
-    for (int i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+    for (size_t lClass = 0; lClass < kNumBufferPoolClasses; lClass++)
     {
-        PacketBuffer* lCursor = &sBufferPool[i].Header;
-        lCursor->next = lHead;
-        lCursor->ref = 0;
-        lHead = lCursor;
+        PacketBuffer* lHead = NULL;
+
+        for (size_t i = 0; i < sBufferPoolClasses[lClass].mNumBlocks; i++)
+        {
+            PacketBuffer* lCursor = BufferPoolBlock(lClass, i);
+            lCursor->next = lHead;
+            lCursor->ref = 0;
+            lHead = lCursor;
+        }
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+        sFreeListHeads[lClass] = MakeFreeListHead(lClass, lHead, 0);
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+        sFreeLists[lClass] = lHead;
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
     }
 
     Mutex::Init(sBufferPoolMutex);
 
-    return lHead;
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+    pthread_key_create(&sMagazineKey, FlushMagazine);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+    return true;
+}
+
+/**
+ * Take a free buffer from the pool, trying the size classes from \c aFirstClass up to, but not including, \c aEndClass in
+ * turn.
+ *
+ *  @return     The buffer, with its capacity recorded if the pool has size classes, or \c NULL if those classes are exhausted.
+ */
+PacketBuffer* PacketBuffer::AllocFromPool(size_t aFirstClass, size_t aEndClass)
+{
+    PacketBuffer* lPacket = NULL;
+
+    for (size_t lClass = aFirstClass; lPacket == NULL && lClass < aEndClass; lClass++)
+    {
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+        lPacket = AllocFromMagazine(lClass);
+        if (lPacket != NULL)
+        {
+            SYSTEM_STATS_ADD_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs, 1);
+        }
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+        LOCK_BUF_POOL();
+
+        lPacket = sFreeLists[lClass];
+        if (lPacket != NULL)
+        {
+            sFreeLists[lClass] = static_cast<PacketBuffer*>(lPacket->next);
+            SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+        }
+
+        UNLOCK_BUF_POOL();
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+#if WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+        if (lPacket != NULL)
+        {
+            lPacket->alloc_size = static_cast<uint16_t>(sBufferPoolClasses[lClass].mCapacity);
+        }
+#endif // WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    }
+
+    return lPacket;
 }
 
 #endif //  !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
+/**
+ * Detach up to \c aMaxCount buffers from the head of the shared free list of a size class.
+ *
+ *  @return     The detached buffers, linked through their next pointers and NULL-terminated, or \c NULL if the list is empty.
+ */
+PacketBuffer* PacketBuffer::PopFreeList(size_t aClass, uint16_t aMaxCount)
+{
+    uint64_t lHead;
+    PacketBuffer* lFirst;
+    PacketBuffer* lLast;
+
+    do
+    {
+        lHead = sFreeListHeads[aClass];
+        lFirst = FreeListHeadBuffer(aClass, lHead);
+
+        if (lFirst == NULL)
+            return NULL;
+
+        // If another thread changes the list while we walk it, the links read here may be stale, but every buffer reached is
+        // still in the pool, the walk is bounded, and the tag in the head makes the compare-and-swap below fail.
+        lLast = lFirst;
+        for (uint16_t i = 1; i < aMaxCount && lLast->next != NULL; i++)
+            lLast = static_cast<PacketBuffer*>(lLast->next);
+    }
+    while (!__sync_bool_compare_and_swap(&sFreeListHeads[aClass], lHead,
+                                         MakeFreeListHead(aClass, static_cast<PacketBuffer*>(lLast->next), lHead)));
+
+    lLast->next = NULL;
+
+    return lFirst;
+}
+
+/**
+ * Prepend a chain of buffers of a size class, linked through their next pointers from \c aFirst to \c aLast, to the shared
+ * free list of that class.
+ */
+void PacketBuffer::PushFreeList(size_t aClass, PacketBuffer* aFirst, PacketBuffer* aLast)
+{
+    uint64_t lHead;
+
+    do
+    {
+        lHead = sFreeListHeads[aClass];
+        aLast->next = FreeListHeadBuffer(aClass, lHead);
+    }
+    while (!__sync_bool_compare_and_swap(&sFreeListHeads[aClass], lHead, MakeFreeListHead(aClass, aFirst, lHead)));
+}
+
+static inline void RegisterMagazine(PacketBufferMagazine& aMagazine)
+{
+    if (!aMagazine.mRegistered)
+    {
+        pthread_setspecific(sMagazineKey, &aMagazine);
+        aMagazine.mRegistered = true;
+    }
+}
+
+/**
+ * Take a free buffer of a size class from the calling thread's magazine, refilling the magazine from the shared free list if it
+ * is empty.
+ *
+ *  @return     A free buffer, or \c NULL if the magazine and the shared free list are both empty.
+ */
+PacketBuffer* PacketBuffer::AllocFromMagazine(size_t aClass)
+{
+    PacketBufferMagazine& lMagazine = sMagazine;
+    uint16_t& lCount = lMagazine.mCount[aClass];
+
+    if (lCount == 0)
+    {
+        PacketBuffer* lPacket = PopFreeList(aClass, kMagazineTransferSize);
+
+        if (lPacket == NULL)
+            return NULL;
+
+        RegisterMagazine(lMagazine);
+
+        while (lPacket != NULL)
+        {
+            lMagazine.mBuffers[aClass][lCount++] = lPacket;
+            lPacket = static_cast<PacketBuffer*>(lPacket->next);
+        }
+
+        SYSTEM_STATS_ADD_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufsCached, lCount);
+    }
+
+    SYSTEM_STATS_SUBTRACT_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufsCached, 1);
+
+    return lMagazine.mBuffers[aClass][--lCount];
+}
+
+/**
+ * Put a buffer whose last reference has been released into the calling thread's magazine for its size class, first returning
+ * the older half of that magazine to the shared free list if it is full.
+ */
+void PacketBuffer::ReturnToMagazine(size_t aClass, PacketBuffer* aPacket)
+{
+    PacketBufferMagazine& lMagazine = sMagazine;
+    PacketBuffer** const lBuffers = lMagazine.mBuffers[aClass];
+    uint16_t& lCount = lMagazine.mCount[aClass];
+
+    RegisterMagazine(lMagazine);
+
+    if (lCount == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE)
+    {
+        for (uint16_t i = 0; i < kMagazineTransferSize - 1; i++)
+            lBuffers[i]->next = lBuffers[i + 1];
+
+        PushFreeList(aClass, lBuffers[0], lBuffers[kMagazineTransferSize - 1]);
+
+        lCount -= kMagazineTransferSize;
+        memmove(&lBuffers[0], &lBuffers[kMagazineTransferSize], lCount * sizeof(PacketBuffer*));
+
+        SYSTEM_STATS_SUBTRACT_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufsCached, kMagazineTransferSize);
+    }
+
+    lBuffers[lCount++] = aPacket;
+
+    SYSTEM_STATS_ADD_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufsCached, 1);
+}
+
+/**
+ * Return every buffer in a magazine to the shared free lists. Called with the exiting thread's magazine when a thread that used
+ * packet buffers exits.
+ */
+void PacketBuffer::FlushMagazine(void* aMagazine)
+{
+    PacketBufferMagazine& lMagazine = *static_cast<PacketBufferMagazine*>(aMagazine);
+
+    lMagazine.mRegistered = false;
+
+    for (size_t lClass = 0; lClass < kNumBufferPoolClasses; lClass++)
+    {
+        PacketBuffer** const lBuffers = lMagazine.mBuffers[lClass];
+        const uint16_t lCount = lMagazine.mCount[lClass];
+
+        if (lCount == 0)
+            continue;
+
+        for (uint16_t i = 0; i < lCount - 1; i++)
+            lBuffers[i]->next = lBuffers[i + 1];
+
+        PushFreeList(lClass, lBuffers[0], lBuffers[lCount - 1]);
+
+        lMagazine.mCount[lClass] = 0;
+
+        SYSTEM_STATS_SUBTRACT_ATOMIC(nl::Weave::System::Stats::kSystemLayer_NumPacketBufsCached, lCount);
+    }
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+
 } // namespace System
 } // namespace Weave
 } // namespace nl
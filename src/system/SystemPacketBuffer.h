@@ -43,6 +43,15 @@
 #include <lwip/memp.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+/**
+ * @def WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+ *
+ *  Non-zero when the packet buffer pool has size classes smaller than #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX, in which
+ *  case each buffer records its capacity.
+ */
+#define WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES \
+    (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM)
+
 namespace nl {
 namespace Weave {
 namespace System {
@@ -55,9 +64,9 @@ struct pbuf
     uint16_t tot_len;
     uint16_t len;
     uint16_t ref;
-#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
     uint16_t alloc_size;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
 };
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 
@@ -135,10 +144,20 @@ public:
 
 private:
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-    static PacketBuffer* sFreeList;
+    static const bool sFreeListsBuilt;
 
-    static PacketBuffer* BuildFreeList(void);
+    static bool BuildFreeLists(void);
+    static PacketBuffer* AllocFromPool(size_t aFirstClass, size_t aEndClass);
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+    static PacketBuffer* PopFreeList(size_t aClass, uint16_t aMaxCount);
+    static void PushFreeList(size_t aClass, PacketBuffer* aFirst, PacketBuffer* aLast);
+
+    static PacketBuffer* AllocFromMagazine(size_t aClass);
+    static void ReturnToMagazine(size_t aClass, PacketBuffer* aPacket);
+    static void FlushMagazine(void* aMagazine);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
 };
 
 } // namespace System
@@ -222,12 +241,12 @@ inline size_t PacketBuffer::AllocSize(void) const
     return LWIP_MEM_ALIGN_SIZE(PBUF_POOL_BUFSIZE) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
 #endif // !LWIP_PBUF_FROM_CUSTOM_POOLS
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
-#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
     return static_cast<size_t>(this->alloc_size);
-#else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+#else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0 && !WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
     extern BufferPoolElement gDummyBufferPoolElement;
     return sizeof(gDummyBufferPoolElement.Block) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0 && !WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 }
 
@@ -46,6 +46,9 @@ static const Label sStatsStrings[nl::Weave::System::Stats::kNumEntries] =
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+    "SystemLayer_NumPacketBufsCached",
+#endif
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -136,6 +139,14 @@ bool Difference(Snapshot &result, Snapshot &after, Snapshot &before)
         result.mResourcesInUse[i] = after.mResourcesInUse[i] - before.mResourcesInUse[i];
         result.mHighWatermarks[i] = after.mHighWatermarks[i] - before.mHighWatermarks[i];
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+        // Free buffers parked in per-thread magazines are not in use.
+        if (i == kSystemLayer_NumPacketBufsCached)
+        {
+            continue;
+        }
+#endif
+
         if (result.mResourcesInUse[i] > 0)
         {
             leak = true;
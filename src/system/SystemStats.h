@@ -55,6 +55,9 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE
+    kSystemLayer_NumPacketBufsCached,
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -160,6 +163,24 @@ const Label *GetStrings(void);
         nl::Weave::System::Stats::GetResourcesInUse()[entry] -= (count); \
     } while (0);
 
+// Variants of the above for counters updated concurrently from several threads without a common lock.
+#define SYSTEM_STATS_ADD_ATOMIC(entry, count) \
+    do { \
+        nl::Weave::System::Stats::count_t new_value = \
+            __sync_add_and_fetch(&nl::Weave::System::Stats::GetResourcesInUse()[entry], (count)); \
+        nl::Weave::System::Stats::count_t old_mark = nl::Weave::System::Stats::GetHighWatermarks()[entry]; \
+        while (old_mark < new_value && \
+               !__sync_bool_compare_and_swap(&nl::Weave::System::Stats::GetHighWatermarks()[entry], old_mark, new_value)) \
+        { \
+            old_mark = nl::Weave::System::Stats::GetHighWatermarks()[entry]; \
+        } \
+    } while (0);
+
+#define SYSTEM_STATS_SUBTRACT_ATOMIC(entry, count) \
+    do { \
+        __sync_sub_and_fetch(&nl::Weave::System::Stats::GetResourcesInUse()[entry], (count)); \
+    } while (0);
+
 #define SYSTEM_STATS_SET(entry, count) \
     do { \
         nl::Weave::System::Stats::count_t new_value = nl::Weave::System::Stats::GetResourcesInUse()[entry] = (count); \
@@ -192,6 +213,10 @@ const Label *GetStrings(void);
 
 #define SYSTEM_STATS_DECREMENT_BY_N(entry, count)
 
+#define SYSTEM_STATS_ADD_ATOMIC(entry, count)
+
+#define SYSTEM_STATS_SUBTRACT_ATOMIC(entry, count)
+
 #define SYSTEM_STATS_RESET(entry)
 
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
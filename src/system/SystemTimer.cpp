@@ -125,9 +125,9 @@ bool Timer::IsEarlierEpoch(const Timer::Epoch &inFirst, const Timer::Epoch &inSe
  */
 Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, void* aAppState)
 {
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Layer& lLayer = this->SystemLayer();
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     WEAVE_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, aDelayMilliseconds = 0);
 
@@ -174,6 +174,10 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
     }
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.Insert(*this);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     return WEAVE_SYSTEM_NO_ERROR;
 }
 
@@ -192,6 +196,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     err = lLayer.PostEvent(*this, Weave::System::kEvent_ScheduleWork, 0);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.ScheduleWork(*this);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     lLayer.WakeSelect();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -206,9 +213,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
  */
 Error Timer::Cancel()
 {
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Layer& lLayer = this->SystemLayer();
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -246,6 +253,10 @@ Error Timer::Cancel()
     }
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.Remove(*this);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     this->Release();
 exit:
     return WEAVE_SYSTEM_NO_ERROR;
@@ -266,6 +277,10 @@ void Timer::HandleComplete()
     // Atomically disarm if the value has not changed.
     VerifyOrExit(__sync_bool_compare_and_swap(&this->OnComplete, lOnComplete, NULL), );
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.Remove(*this);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     // Since this thread changed the state of OnComplete, release the timer.
     AppState = NULL;
     this->Release();
@@ -349,6 +364,421 @@ Error Timer::HandleExpiredTimers(Layer& aLayer)
 }
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+const Timer::Epoch TimerWheel::kNoTimers;
+const Timer::Epoch TimerWheel::kMaxPlacedDelay;
+
+/**
+ *  Returns the circular distance from \c aStart to the first set bit of a bitmap of \c aNumBits bits, or \c aNumBits if no bit
+ *  is set. \c aNumBits must be a power of two multiple of 64.
+ */
+static unsigned int FindNextOccupied(const uint64_t* aWords, unsigned int aNumBits, unsigned int aStart)
+{
+    unsigned int lDistance = 0;
+
+    while (lDistance < aNumBits)
+    {
+        const unsigned int kBit = (aStart + lDistance) & (aNumBits - 1);
+        const uint64_t kWord = aWords[kBit / 64] >> (kBit % 64);
+
+        if (kWord != 0)
+        {
+            lDistance += __builtin_ctzll(kWord);
+            break;
+        }
+
+        lDistance += 64 - (kBit % 64);
+    }
+
+    return (lDistance < aNumBits) ? lDistance : aNumBits;
+}
+
+/**
+ *  Empties the wheel and sets its current tick.
+ *
+ *  @param[in]  aCurrentEpoch   The current time, in milliseconds.
+ */
+void TimerWheel::Init(Timer::Epoch aCurrentEpoch)
+{
+    this->mCurrentTick = aCurrentEpoch;
+    memset(this->mSlots, 0, sizeof(this->mSlots));
+    memset(this->mOccupied, 0, sizeof(this->mOccupied));
+    this->mExpired = NULL;
+    this->mExpiredTail = &this->mExpired;
+    this->mScheduledWork = NULL;
+    memset(this->mBuckets, 0, sizeof(this->mBuckets));
+}
+
+/**
+ *  Adds an armed timer to the wheel and to the callback index.
+ *
+ *  @param[in]  aTimer  The timer, which must have its callback, application state and awaken epoch set.
+ */
+void TimerWheel::Insert(Timer& aTimer)
+{
+    this->Index(aTimer);
+    this->Place(aTimer);
+}
+
+/**
+ *  Removes a timer from the wheel and from the callback index. It's harmless to remove a timer that is not on the wheel.
+ *
+ *  @param[in]  aTimer  The timer.
+ */
+void TimerWheel::Remove(Timer& aTimer)
+{
+    this->Unlink(aTimer);
+
+    if (aTimer.mIndexedLink != NULL)
+    {
+        *aTimer.mIndexedLink = aTimer.mNextIndexed;
+        if (aTimer.mNextIndexed != NULL)
+            aTimer.mNextIndexed->mIndexedLink = aTimer.mIndexedLink;
+
+        aTimer.mNextIndexed = NULL;
+        aTimer.mIndexedLink = NULL;
+    }
+}
+
+/**
+ *  Returns an armed timer with the given callback and application state, or NULL if there is none.
+ */
+Timer* TimerWheel::Find(Timer::OnCompleteFunct aOnComplete, void* aAppState) const
+{
+    Timer* lTimer = this->mBuckets[Bucket(aOnComplete, aAppState)];
+
+    while (lTimer != NULL && (lTimer->OnComplete != aOnComplete || lTimer->AppState != aAppState))
+        lTimer = lTimer->mNextIndexed;
+
+    return lTimer;
+}
+
+/**
+ *  Hands a timer armed by Timer::ScheduleWork() to the thread driving the event loop. This may be called from any thread.
+ *
+ *  The timer is retained until the event loop has moved it to the list of expired timers, so that it may safely be cancelled
+ *  in the meantime.
+ */
+void TimerWheel::ScheduleWork(Timer& aTimer)
+{
+    Timer* lHead;
+
+    aTimer.Retain();
+
+    do
+    {
+        lHead = this->mScheduledWork;
+        aTimer.mNextTimer = lHead;
+    } while (!__sync_bool_compare_and_swap(&this->mScheduledWork, lHead, &aTimer));
+}
+
+/**
+ *  Returns the number of milliseconds from \c aCurrentEpoch until the wheel next needs servicing, or kNoTimers if it holds no
+ *  timers.
+ *
+ *  @note
+ *      Timers on the higher levels of the wheel are only placed on the first level when the wheel reaches the start of their
+ *      slot, so the time returned may be earlier than that of the next timer to expire.
+ */
+Timer::Epoch TimerWheel::GetSleepTime(Timer::Epoch aCurrentEpoch) const
+{
+    Timer::Epoch lNextTick;
+
+    if (this->mExpired != NULL || this->mScheduledWork != NULL)
+        return 0;
+
+    if (!this->GetNextTick(lNextTick))
+        return kNoTimers;
+
+    return Timer::IsEarlierEpoch(aCurrentEpoch, lNextTick) ? lNextTick - aCurrentEpoch : 0;
+}
+
+/**
+ *  Advances the wheel to \c aCurrentEpoch and completes every timer that has expired.
+ *
+ *  Timers armed by the completion callbacks are not completed until the next call, even if they have already expired.
+ *
+ *  @param[in]  aCurrentEpoch   The current time, in milliseconds.
+ */
+void TimerWheel::HandleExpiredTimers(Timer::Epoch aCurrentEpoch)
+{
+    Timer* lExpired;
+
+    this->DrainScheduledWork();
+
+    // Only stop at ticks where a first-level slot holds timers or a higher-level slot holding timers must be cascaded, so that
+    // the cost of advancing does not depend on how long the event loop slept.
+    while (Timer::IsEarlierEpoch(this->mCurrentTick, aCurrentEpoch))
+    {
+        Timer::Epoch lNextTick;
+
+        if (!this->GetNextTick(lNextTick) || Timer::IsEarlierEpoch(aCurrentEpoch, lNextTick))
+        {
+            this->mCurrentTick = aCurrentEpoch;
+            break;
+        }
+
+        this->mCurrentTick = lNextTick;
+        this->ProcessTick();
+    }
+
+    // Take the list of expired timers private before completing them; a callback may cancel any timer on it.
+    lExpired = this->mExpired;
+    if (lExpired != NULL)
+    {
+        lExpired->mTimerLink = &lExpired;
+        this->mExpired = NULL;
+        this->mExpiredTail = &this->mExpired;
+    }
+
+    while (lExpired != NULL)
+    {
+        Timer& lTimer = *lExpired;
+
+        this->Unlink(lTimer);
+        lTimer.HandleComplete();
+    }
+}
+
+/**
+ *  Releases any work scheduled from another thread that has not yet been moved onto the wheel. Called by Layer::Shutdown(),
+ *  after every timer has been cancelled.
+ */
+void TimerWheel::Shutdown(void)
+{
+    this->DrainScheduledWork();
+}
+
+void TimerWheel::Index(Timer& aTimer)
+{
+    Timer*& lBucket = this->mBuckets[Bucket(aTimer.OnComplete, aTimer.AppState)];
+
+    aTimer.mNextIndexed = lBucket;
+    if (lBucket != NULL)
+        lBucket->mIndexedLink = &aTimer.mNextIndexed;
+    aTimer.mIndexedLink = &lBucket;
+    lBucket = &aTimer;
+}
+
+void TimerWheel::Link(Timer*& aHead, Timer& aTimer)
+{
+    aTimer.mNextTimer = aHead;
+    if (aHead != NULL)
+        aHead->mTimerLink = &aTimer.mNextTimer;
+    aTimer.mTimerLink = &aHead;
+    aHead = &aTimer;
+}
+
+void TimerWheel::Unlink(Timer& aTimer)
+{
+    Timer** const lLink = aTimer.mTimerLink;
+
+    if (lLink == NULL)
+        return;
+
+    *lLink = aTimer.mNextTimer;
+
+    if (aTimer.mNextTimer != NULL)
+        aTimer.mNextTimer->mTimerLink = lLink;
+    else if (this->mExpiredTail == &aTimer.mNextTimer)
+        this->mExpiredTail = lLink;
+
+    // If the timer was the only one in a wheel slot, mark the slot empty.
+    if (lLink >= &this->mSlots[0] && lLink < &this->mSlots[kNumSlots] && *lLink == NULL)
+    {
+        const size_t kIndex = static_cast<size_t>(lLink - &this->mSlots[0]);
+
+        this->mOccupied[kIndex / 64] &= ~(static_cast<uint64_t>(1) << (kIndex % 64));
+    }
+
+    aTimer.mNextTimer = NULL;
+    aTimer.mTimerLink = NULL;
+}
+
+/**
+ *  Puts a timer that is not on any list in the wheel slot for its awaken epoch, relative to the current tick, or on the list of
+ *  expired timers if that epoch has been reached.
+ */
+void TimerWheel::Place(Timer& aTimer)
+{
+    Timer::Epoch lTick = aTimer.mAwakenEpoch;
+    Timer::Epoch lDelay;
+    unsigned int lLevel, lSlot;
+
+    if (!Timer::IsEarlierEpoch(this->mCurrentTick, lTick))
+    {
+        aTimer.mNextTimer = NULL;
+        aTimer.mTimerLink = this->mExpiredTail;
+        *this->mExpiredTail = &aTimer;
+        this->mExpiredTail = &aTimer.mNextTimer;
+        return;
+    }
+
+    // A timer further out than the wheel spans is placed in the last slot reachable; it is re-placed, against its full awaken
+    // epoch, when that slot is cascaded. The top level spans no more than one slot short of a full turn, so that a delay close
+    // to 2^32 ms cannot wrap around into the top-level slot the wheel is in now.
+    lDelay = lTick - this->mCurrentTick;
+    if (lDelay > kMaxPlacedDelay)
+    {
+        lDelay = kMaxPlacedDelay;
+        lTick = this->mCurrentTick + lDelay;
+    }
+
+    for (lLevel = 0; lLevel < kNumLevels - 1; lLevel++)
+    {
+        if (lDelay < (static_cast<Timer::Epoch>(1) << LevelShift(lLevel + 1)))
+            break;
+    }
+
+    lSlot = static_cast<unsigned int>(lTick >> LevelShift(lLevel)) & ((lLevel == 0) ? (kLevel0Slots - 1) : (kLevelNSlots - 1));
+    lSlot = SlotIndex(lLevel, lSlot);
+
+    this->Link(this->mSlots[lSlot], aTimer);
+    this->mOccupied[lSlot / 64] |= static_cast<uint64_t>(1) << (lSlot % 64);
+}
+
+/**
+ *  Re-places every timer in a higher-level slot, once the wheel has reached the start of that slot.
+ */
+void TimerWheel::Cascade(unsigned int aLevel, unsigned int aSlot)
+{
+    Timer*& lHead = this->mSlots[SlotIndex(aLevel, aSlot)];
+
+    while (lHead != NULL)
+    {
+        Timer& lTimer = *lHead;
+
+        this->Unlink(lTimer);
+        this->Place(lTimer);
+    }
+}
+
+/**
+ *  Cascades any higher-level slots that start at the current tick, then moves the timers of the current first-level slot to the
+ *  list of expired timers.
+ */
+void TimerWheel::ProcessTick(void)
+{
+    const unsigned int kIndex = static_cast<unsigned int>(this->mCurrentTick) & (kLevel0Slots - 1);
+
+    if (kIndex == 0)
+    {
+        for (unsigned int lLevel = 1; lLevel < kNumLevels; lLevel++)
+        {
+            const unsigned int kSlot = static_cast<unsigned int>(this->mCurrentTick >> LevelShift(lLevel)) & (kLevelNSlots - 1);
+
+            this->Cascade(lLevel, kSlot);
+
+            if (kSlot != 0)
+                break;
+        }
+    }
+
+    this->Cascade(0, kIndex);
+}
+
+/**
+ *  Finds the next tick, after the current one, at which a first-level slot holds timers or a higher-level slot holding timers
+ *  must be cascaded.
+ *
+ *  @return true if the wheel holds any timers, false otherwise.
+ */
+bool TimerWheel::GetNextTick(Timer::Epoch& aTick) const
+{
+    bool lFound = false;
+    unsigned int lDistance;
+
+    lDistance = FindNextOccupied(&this->mOccupied[0], kLevel0Slots,
+        static_cast<unsigned int>(this->mCurrentTick + 1) & (kLevel0Slots - 1));
+
+    if (lDistance < kLevel0Slots)
+    {
+        aTick = this->mCurrentTick + 1 + lDistance;
+        lFound = true;
+    }
+
+    for (unsigned int lLevel = 1; lLevel < kNumLevels; lLevel++)
+    {
+        const Timer::Epoch kCurrentSlot = this->mCurrentTick >> LevelShift(lLevel);
+
+        lDistance = FindNextOccupied(&this->mOccupied[SlotIndex(lLevel, 0) / 64], kLevelNSlots,
+            static_cast<unsigned int>(kCurrentSlot + 1) & (kLevelNSlots - 1));
+
+        if (lDistance < kLevelNSlots)
+        {
+            const Timer::Epoch kTick = (kCurrentSlot + 1 + lDistance) << LevelShift(lLevel);
+
+            if (!lFound || Timer::IsEarlierEpoch(kTick, aTick))
+            {
+                aTick = kTick;
+                lFound = true;
+            }
+        }
+    }
+
+    return lFound;
+}
+
+/**
+ *  Moves work scheduled from any thread onto the list of expired timers, in the order it was scheduled, indexes it so that
+ *  Layer::CancelTimer() can find it, and drops the reference held for the hand-off. Work that was cancelled in the meantime is
+ *  released. Must be called on the thread driving the event loop.
+ */
+void TimerWheel::DrainScheduledWork(void)
+{
+    Timer* lList = __sync_lock_test_and_set(&this->mScheduledWork, static_cast<Timer*>(NULL));
+    Timer* lReversed = NULL;
+
+    while (lList != NULL)
+    {
+        Timer* const lNext = lList->mNextTimer;
+
+        lList->mNextTimer = lReversed;
+        lReversed = lList;
+        lList = lNext;
+    }
+
+    while (lReversed != NULL)
+    {
+        Timer& lTimer = *lReversed;
+
+        lReversed = lTimer.mNextTimer;
+        lTimer.mNextTimer = NULL;
+
+        if (lTimer.OnComplete != NULL)
+        {
+            this->Index(lTimer);
+
+            lTimer.mTimerLink = this->mExpiredTail;
+            *this->mExpiredTail = &lTimer;
+            this->mExpiredTail = &lTimer.mNextTimer;
+        }
+
+        lTimer.Release();
+    }
+}
+
+unsigned int TimerWheel::LevelShift(unsigned int aLevel)
+{
+    return (aLevel == 0) ? 0 : kLevel0Bits + (aLevel - 1) * kLevelNBits;
+}
+
+unsigned int TimerWheel::SlotIndex(unsigned int aLevel, unsigned int aSlot)
+{
+    return (aLevel == 0) ? aSlot : kLevel0Slots + (aLevel - 1) * kLevelNSlots + aSlot;
+}
+
+size_t TimerWheel::Bucket(Timer::OnCompleteFunct aOnComplete, void* aAppState)
+{
+    uint64_t lKey = reinterpret_cast<uintptr_t>(aOnComplete);
+
+    lKey = (lKey * 0x9E3779B97F4A7C15ULL) ^ reinterpret_cast<uintptr_t>(aAppState);
+    lKey *= 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<size_t>((lKey >> 32) % kNumBuckets);
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 } // namespace System
 } // namespace Weave
 } // namespace nl
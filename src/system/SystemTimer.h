@@ -54,6 +54,7 @@ namespace Weave {
 namespace System {
 
 class Layer;
+class TimerWheel;
 
 /**
  * @class Timer
@@ -67,6 +68,9 @@ class Layer;
 class NL_DLL_EXPORT Timer : public Object
 {
     friend class Layer;
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    friend class TimerWheel;
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 public:
     /**
@@ -115,12 +119,88 @@ private:
     static Error HandleExpiredTimers(Layer& aLayer);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer* mNextTimer;      /**< Next timer in the same wheel slot, or in the expired or scheduled work list. */
+    Timer** mTimerLink;     /**< Pointer that points at this timer in its list, or NULL if not on a list. */
+    Timer* mNextIndexed;    /**< Next timer in the same index bucket. */
+    Timer** mIndexedLink;   /**< Pointer that points at this timer in its index bucket, or NULL if not indexed. */
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     // Not defined
     Timer(const Timer&);
     Timer& operator =(const Timer&);
 };
 
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ * @class TimerWheel
+ *
+ * @brief
+ *  This is an internal class to Weave System Layer, used to hold the armed timers of one Layer object on a hierarchical timer
+ *  wheel with a millisecond tick.
+ *
+ *  The first level of the wheel has one slot per tick for the next 256 ticks; each of the four further levels has 64 slots, each
+ *  spanning one full turn of the level below, so that the wheel spans the full 32-bit range of timer delays. Timers are moved down a
+ *  level when the wheel reaches the start of their slot, and expire from the first level. A timer due more than 63 top-level slots
+ *  ahead is held in the furthest of them until it is cascaded, so that it never shares the current top-level slot. Armed timers
+ *  are also indexed by callback and application state so that Layer::CancelTimer() need not scan the timer pool.
+ */
+class TimerWheel
+{
+public:
+    void Init(Timer::Epoch aCurrentEpoch);
+
+    void Insert(Timer& aTimer);
+    void Remove(Timer& aTimer);
+    Timer* Find(Timer::OnCompleteFunct aOnComplete, void* aAppState) const;
+
+    void ScheduleWork(Timer& aTimer);
+    void DrainScheduledWork(void);
+
+    Timer::Epoch GetSleepTime(Timer::Epoch aCurrentEpoch) const;
+    void HandleExpiredTimers(Timer::Epoch aCurrentEpoch);
+    void Shutdown(void);
+
+    static const Timer::Epoch kNoTimers = ~static_cast<Timer::Epoch>(0);
+
+private:
+    enum
+    {
+        kLevel0Bits     = 8,
+        kLevelNBits     = 6,
+        kNumLevels      = 5,
+        kLevel0Slots    = 1 << kLevel0Bits,
+        kLevelNSlots    = 1 << kLevelNBits,
+        kNumSlots       = kLevel0Slots + (kNumLevels - 1) * kLevelNSlots,
+        kNumBuckets     = WEAVE_SYSTEM_CONFIG_NUM_TIMERS
+    };
+
+    static const Timer::Epoch kMaxPlacedDelay = static_cast<Timer::Epoch>(kLevelNSlots - 1) <<
+        (kLevel0Bits + (kNumLevels - 2) * kLevelNBits);
+
+    Timer::Epoch mCurrentTick;
+    Timer* mSlots[kNumSlots];
+    uint64_t mOccupied[kNumSlots / 64];
+    Timer* mExpired;
+    Timer** mExpiredTail;
+    Timer* volatile mScheduledWork;
+    Timer* mBuckets[kNumBuckets];
+
+    void Index(Timer& aTimer);
+    void Link(Timer*& aHead, Timer& aTimer);
+    void Unlink(Timer& aTimer);
+    void Place(Timer& aTimer);
+    void Cascade(unsigned int aLevel, unsigned int aSlot);
+    void ProcessTick(void);
+    bool GetNextTick(Timer::Epoch& aTick) const;
+
+    static unsigned int LevelShift(unsigned int aLevel);
+    static unsigned int SlotIndex(unsigned int aLevel, unsigned int aSlot);
+    static size_t Bucket(Timer::OnCompleteFunct aOnComplete, void* aAppState);
+};
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 inline void Timer::GetStatistics(nl::Weave::System::Stats::count_t& aNumInUse,
                                  nl::Weave::System::Stats::count_t& aHighWatermark)
 {
@@ -210,6 +210,7 @@ CASEOptions::CASEOptions()
     NodePayload = NULL;
     NodePayloadLength = 0;
     Debug = false;
+    ValidationCache = NULL;
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
     UseKnownECDHKey = false;
 #endif
@@ -564,6 +565,7 @@ WEAVE_ERROR CASEOptions::BeginCertValidation(bool isInitiator, WeaveCertificateS
     validContext.EffectiveTime = SecondsSinceEpochToPackedCertTime(time(NULL));
     validContext.RequiredKeyUsages = kKeyUsageFlag_DigitalSignature;
     validContext.RequiredKeyPurposes = (isInitiator) ? kKeyPurposeFlag_ServerAuth : kKeyPurposeFlag_ClientAuth;
+    validContext.ValidationCache = ValidationCache;
 
     if (Debug)
     {
@@ -60,6 +60,8 @@ public:
 
     bool Debug;
 
+    CertValidationCache *ValidationCache;
+
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
     bool UseKnownECDHKey;
 #endif
@@ -0,0 +1,36 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file builds the Inet Layer's TCP endpoint into
+ *      TestInetEventLoopRecvBuffers, in place of that of the library,
+ *      with the INET_CONFIG_TCP_RECV_MAX_BUFFERS given to the test, so
+ *      that the event loop tests cover reading into several packet
+ *      buffers with each readv(2).
+ *
+ *      The setting only affects TCPEndPoint.cpp, not the layout of any
+ *      class, so the rest of the library is used as built.
+ *
+ */
+
+#if INET_CONFIG_TCP_RECV_MAX_BUFFERS <= 1
+#error "TCPEndPointRecvBuffers.cpp must be built with INET_CONFIG_TCP_RECV_MAX_BUFFERS greater than 1."
+#endif
+
+#include "../inet/TCPEndPoint.cpp"
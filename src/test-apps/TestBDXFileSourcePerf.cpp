@@ -0,0 +1,570 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a benchmark for serving one file image to many concurrent
+ *      transfers in the development BDX profile.
+ *
+ *      The tool's own Weave stack listens for TCP connections on the
+ *      loopback interface and serves a temporary image file.  A peer,
+ *      with a Weave stack of its own, connects to it and downloads the
+ *      whole image over several transfers at once.  Each run is served
+ *      twice: once the usual way, with a file handle and read buffer per
+ *      transfer, and once from a single BdxFileSource shared by all the
+ *      transfers.  The throughput and the memory each transfer needs on
+ *      the server are reported for both.
+ *
+ *      With WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL, the runs double up to
+ *      256 simultaneous transfers; otherwise they stop at
+ *      WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS.  Either way, each transfer
+ *      takes an exchange context and a response timer on both stacks,
+ *      so the count is also bounded by WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
+ *      and WEAVE_SYSTEM_CONFIG_NUM_TIMERS; raise both in the project
+ *      configuration to benchmark the larger fan-outs.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Profiles;
+using namespace nl::Weave::Profiles::Common;
+using namespace nl::Weave::Profiles::BulkDataTransfer;
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+// Test device 10 is the server; test device 1 is the downloading peer.
+static const uint64_t kServerNodeId = 0x18B430000000000AULL;
+static const uint64_t kPeerNodeId = 0x18B4300000000001ULL;
+static const uint16_t kBlockSize = 1024;
+static const uint32_t kImageSize = 256 * 1024;
+#if WEAVE_CONFIG_BDX_DYNAMIC_TRANSFER_POOL
+static const uint32_t kMaxNodeTransfers = (WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS < 256) ?
+                                          WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS : 256;
+#else
+static const uint32_t kMaxNodeTransfers = WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS;
+#endif
+// Leave an exchange context free on each stack for the tool's own use.
+static const uint32_t kMaxExchangeTransfers = (kMaxNodeTransfers < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 1) ?
+                                              kMaxNodeTransfers : WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 1;
+// Both stacks share the system layer's timers; leave a couple free for the tool's own use.
+static const uint32_t kMaxTransfers = (kMaxExchangeTransfers < (WEAVE_SYSTEM_CONFIG_NUM_TIMERS - 2) / 2) ?
+                                      kMaxExchangeTransfers : (WEAVE_SYSTEM_CONFIG_NUM_TIMERS - 2) / 2;
+
+static const char *kFileDesignator = "bdx-file-source-perf";
+
+/**
+ *  A transfer served the usual way, from its own file handle into its own buffer.
+ */
+struct StdioSource
+{
+    FILE *File;
+    uint8_t *Buffer;
+};
+
+/**
+ *  A download in progress on the peer.
+ */
+struct Download
+{
+    uint64_t Offset;
+    bool IsDone;
+};
+
+// The downloading peer.
+static TestBdxPeer sPeer;
+static BdxNode sServer;
+static BdxFileSource sFileSource;
+static WeaveConnection *sCon;
+static char sImagePath[] = "/tmp/weave-bdx-image-XXXXXX";
+static bool sImageCreated;
+
+static StdioSource sStdioSources[kMaxTransfers];
+static Download sDownloads[kMaxTransfers];
+
+static uint32_t sNumTransfers;
+static bool sUseFileSource;
+static uint64_t sBytesDelivered;
+static bool sDataIntact;
+static TestPeerRun sRun;
+
+static uint8_t PatternByte(uint64_t offset)
+{
+    return static_cast<uint8_t>((offset * 7) ^ (offset >> 8));
+}
+
+static bool CreateImage(void)
+{
+    uint8_t chunk[kBlockSize];
+    int fd;
+    bool ok = true;
+
+    fd = mkstemp(sImagePath);
+    if (fd < 0)
+        return false;
+
+    sImageCreated = true;
+
+    for (uint32_t offset = 0; ok && offset < kImageSize; offset += sizeof(chunk))
+    {
+        for (uint32_t i = 0; i < sizeof(chunk); i++)
+            chunk[i] = PatternByte(offset + i);
+
+        ok = (write(fd, chunk, sizeof(chunk)) == static_cast<ssize_t>(sizeof(chunk)));
+    }
+
+    close(fd);
+
+    return ok;
+}
+
+// Server handlers
+
+static void StdioGetBlock(BDXTransfer *xfer, uint64_t *length, uint8_t **dataBlock, bool *lastBlock)
+{
+    StdioSource *source = static_cast<StdioSource *>(xfer->mAppState);
+    size_t count = kBlockSize;
+
+    if (count > *length)
+        count = static_cast<size_t>(*length);
+
+    count = fread(source->Buffer, 1, count, source->File);
+
+    *length = count;
+    *dataBlock = source->Buffer;
+    *lastBlock = (count == 0 || ftell(source->File) >= static_cast<long>(kImageSize));
+}
+
+static void CloseStdioSource(BDXTransfer *xfer)
+{
+    StdioSource *source = static_cast<StdioSource *>(xfer->mAppState);
+
+    if (source != NULL)
+    {
+        if (source->File != NULL)
+            fclose(source->File);
+        free(source->Buffer);
+        source->File = NULL;
+        source->Buffer = NULL;
+        xfer->mAppState = NULL;
+    }
+}
+
+static WEAVE_ERROR OpenStdioSource(BDXTransfer *xfer)
+{
+    StdioSource *source = NULL;
+
+    for (uint32_t i = 0; i < kMaxTransfers && source == NULL; i++)
+    {
+        if (sStdioSources[i].File == NULL)
+            source = &sStdioSources[i];
+    }
+
+    if (source == NULL)
+        return WEAVE_ERROR_NO_MEMORY;
+
+    source->File = fopen(sImagePath, "rb");
+    source->Buffer = static_cast<uint8_t *>(malloc(kBlockSize));
+    xfer->mAppState = source;
+
+    if (source->File == NULL || source->Buffer == NULL)
+    {
+        CloseStdioSource(xfer);
+        return WEAVE_ERROR_NO_MEMORY;
+    }
+
+    xfer->mLength = kImageSize;
+    xfer->mHandlers.mGetBlockHandler = StdioGetBlock;
+
+    return WEAVE_NO_ERROR;
+}
+
+static void ServerXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void ServerXferDone(BDXTransfer *xfer)
+{
+    if (!xfer->mIsCompletedSuccessfully)
+        sRun.NumFailed++;
+
+    if (!sUseFileSource)
+        CloseStdioSource(xfer);
+
+    // Shutting the transfer down also detaches it from the file source.
+    xfer->Shutdown();
+
+    sRun.ToolDone++;
+    sRun.Update();
+}
+
+static void ServerError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static uint16_t HandleReceiveInit(BDXTransfer *xfer, ReceiveInit *receiveInitMsg)
+{
+    BDXHandlers handlers = {
+        NULL,               // SendAcceptHandler
+        NULL,               // ReceiveAcceptHandler
+        NULL,               // RejectHandler
+        NULL,               // GetBlockHandler
+        NULL,               // PutBlockHandler
+        ServerXferError,    // XferErrorHandler
+        ServerXferDone,     // XferDoneHandler
+        ServerError         // ErrorHandler
+    };
+    WEAVE_ERROR err;
+
+    xfer->mHandlers = handlers;
+    xfer->mTransferMode = kMode_SenderDrive;
+
+    if (sUseFileSource)
+        err = sFileSource.AttachTransfer(*xfer);
+    else
+        err = OpenStdioSource(xfer);
+
+    if (err != WEAVE_NO_ERROR)
+        return kStatus_ServerBadState;
+
+    xfer->mIsAccepted = true;
+
+    return kStatus_Success;
+}
+
+// Peer handlers
+
+static WEAVE_ERROR PeerReceiveAccept(BDXTransfer *xfer, ReceiveAccept *receiveAcceptMsg)
+{
+    if (receiveAcceptMsg->mLength != kImageSize)
+        sDataIntact = false;
+
+    return WEAVE_NO_ERROR;
+}
+
+static void PeerReject(BDXTransfer *xfer, StatusReport *report)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void PeerPutBlock(BDXTransfer *xfer, uint64_t length, uint8_t *data, bool isLastBlock)
+{
+    Download *download = static_cast<Download *>(xfer->mAppState);
+
+    for (uint64_t i = 0; i < length; i++)
+    {
+        if (data[i] != PatternByte(download->Offset + i))
+            sDataIntact = false;
+    }
+
+    download->Offset += length;
+    sBytesDelivered += length;
+}
+
+static void PeerXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void PeerXferDone(BDXTransfer *xfer)
+{
+    Download *download = static_cast<Download *>(xfer->mAppState);
+
+    if (!xfer->mIsCompletedSuccessfully || download->Offset != kImageSize)
+        sRun.NumFailed++;
+
+    download->IsDone = true;
+    xfer->Shutdown();
+
+    sRun.PeerDone++;
+    sRun.Update();
+}
+
+static void PeerError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void StartDownload(Download &download)
+{
+    BDXHandlers handlers = {
+        NULL,               // SendAcceptHandler
+        PeerReceiveAccept,  // ReceiveAcceptHandler
+        PeerReject,         // RejectHandler
+        NULL,               // GetBlockHandler
+        PeerPutBlock,       // PutBlockHandler
+        PeerXferError,      // XferErrorHandler
+        PeerXferDone,       // XferDoneHandler
+        PeerError           // ErrorHandler
+    };
+    ReferencedString fileDesignator;
+    BDXTransfer *xfer = NULL;
+    WEAVE_ERROR err;
+
+    err = fileDesignator.init(static_cast<uint16_t>(strlen(kFileDesignator)), const_cast<char *>(kFileDesignator));
+    SuccessOrExit(err);
+
+    err = sPeer.Node.NewTransfer(sCon, handlers, fileDesignator, &download, xfer);
+    SuccessOrExit(err);
+
+    xfer->mMaxBlockSize = kBlockSize;
+
+    err = sPeer.Node.InitBdxReceive(*xfer, false, true, false, NULL);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        if (xfer != NULL)
+            BdxNode::ShutdownTransfer(xfer);
+
+        sRun.NumFailed++;
+        sRun.Update();
+    }
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    if (conErr != WEAVE_NO_ERROR)
+    {
+        sRun.NumFailed++;
+        sRun.Update();
+        return;
+    }
+
+    for (uint32_t i = 0; i < sNumTransfers && sRun.NumFailed == 0; i++)
+        StartDownload(sDownloads[i]);
+}
+
+/**
+ *  Download the image over the given number of simultaneous transfers, and print a result row.
+ */
+static void RunDownloads(nlTestSuite* inSuite, uint32_t numTransfers, bool useFileSource)
+{
+    IPAddress serverAddr;
+    uint64_t start;
+    double elapsedSec;
+    char label[32];
+    WEAVE_ERROR err;
+
+    memset(sDownloads, 0, sizeof(sDownloads));
+
+    sNumTransfers = numTransfers;
+    sUseFileSource = useFileSource;
+    sBytesDelivered = 0;
+    sDataIntact = true;
+    sRun.Start(sNumTransfers);
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+
+    sCon = sPeer.MessageLayer.NewConnection();
+    NL_TEST_ASSERT(inSuite, sCon != NULL);
+    if (sCon == NULL)
+        return;
+
+    IPAddress::FromString("::1", serverAddr);
+
+    sCon->OnConnectionComplete = HandleConnectionComplete;
+
+    err = sCon->Connect(kServerNodeId, kWeaveAuthMode_Unauthenticated, serverAddr, WEAVE_PORT);
+    if (err != WEAVE_NO_ERROR)
+        sRun.NumFailed++;
+    else
+        ServiceNetworkUntil(&sRun.Done, NULL);
+
+    elapsedSec = (System::Layer::GetClock_MonotonicHiRes() - start) / 1000000.0;
+
+    // A stdio transfer holds a FILE, its stdio buffer and a block buffer; a mapped one holds nothing of its own.
+    snprintf(label, sizeof(label), "%s x %u", useFileSource ? "mapped" : "stdio", numTransfers);
+    printf("%-28s %10.1f KB/s, %u bytes/transfer\n", label, sBytesDelivered / 1024.0 / elapsedSec,
+           useFileSource ? 0U : static_cast<unsigned int>(sizeof(FILE) + BUFSIZ + kBlockSize));
+
+    sCon->Close();
+    sCon = NULL;
+
+    NL_TEST_ASSERT(inSuite, sRun.NumFailed == 0);
+    NL_TEST_ASSERT(inSuite, sRun.PeerDone == numTransfers);
+    NL_TEST_ASSERT(inSuite, sBytesDelivered == static_cast<uint64_t>(numTransfers) * kImageSize);
+    NL_TEST_ASSERT(inSuite, sDataIntact);
+    NL_TEST_ASSERT(inSuite, sFileSource.GetNumTransfers() == 0);
+}
+
+static void CheckConcurrentThroughput(nlTestSuite* inSuite, void* inContext)
+{
+    uint32_t numTransfers;
+
+    printf("\n%-28s %10u bytes\n", "image size", static_cast<unsigned int>(kImageSize));
+    printf("%-28s %10u bytes\n", "block size", static_cast<unsigned int>(kBlockSize));
+
+    // Double the number of transfers each time, finishing with as many as the node allows.
+    for (numTransfers = 1; ; numTransfers *= 2)
+    {
+        if (numTransfers > kMaxTransfers)
+            numTransfers = kMaxTransfers;
+
+        RunDownloads(inSuite, numTransfers, false);
+        RunDownloads(inSuite, numTransfers, true);
+
+        if (numTransfers == kMaxTransfers)
+            break;
+    }
+}
+
+static void CheckSourceLifetime(nlTestSuite* inSuite, void* inContext)
+{
+    BdxFileSource source;
+    BDXTransfer xfer;
+    WEAVE_ERROR err;
+
+    xfer.Reset();
+
+    // Nothing can be attached until a file is open.
+    err = source.AttachTransfer(xfer);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INCORRECT_STATE);
+
+    err = source.Open(sImagePath);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, source.GetLength() == kImageSize);
+
+    // A range running past the end of the file is cut to the end of the file.
+    xfer.mStartOffset = kImageSize - 100;
+    xfer.mLength = 1000;
+    err = source.AttachTransfer(xfer);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, xfer.mLength == 100);
+    NL_TEST_ASSERT(inSuite, source.GetNumTransfers() == 1);
+
+    // The source can't go away under an attached transfer.
+    err = source.Close();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INCORRECT_STATE);
+
+    xfer.Shutdown();
+    NL_TEST_ASSERT(inSuite, xfer.mFileSource == NULL);
+    NL_TEST_ASSERT(inSuite, source.GetNumTransfers() == 0);
+
+    err = source.Close();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !source.IsOpen());
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("BDX::BenchmarkConcurrentThroughput",   CheckConcurrentThroughput),
+    NL_TEST_DEF("BDX::CheckSourceLifetime",             CheckSourceLifetime),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-bdx-file-source-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    WEAVE_ERROR err = WEAVE_ERROR_INCORRECT_STATE;
+
+    InitPeerTestTool(kServerNodeId);
+
+    if (CreateImage())
+        err = sFileSource.Open(sImagePath);
+    if (err == WEAVE_NO_ERROR)
+        err = sServer.Init(&ExchangeMgr);
+    if (err == WEAVE_NO_ERROR)
+        err = sServer.AwaitBdxReceiveInit(HandleReceiveInit);
+    if (err == WEAVE_NO_ERROR)
+    {
+        sServer.AllowBdxTransferToRun(true);
+        err = sPeer.Init(kPeerNodeId);
+    }
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (err == WEAVE_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    sPeer.Shutdown();
+
+    sServer.Shutdown();
+    sFileSource.Close();
+
+    if (sImageCreated)
+        unlink(sImagePath);
+
+    ShutdownPeerTestTool();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
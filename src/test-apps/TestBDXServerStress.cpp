@@ -0,0 +1,471 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a stress test for a development BDX server handling many
+ *      downloads at once.
+ *
+ *      The tool's own Weave stack listens for TCP connections on the
+ *      loopback interface and serves generated data.  A peer, with a
+ *      Weave stack of its own, connects to it and starts every download
+ *      at once.  The test checks that the server's transfer pool grows
+ *      past its built-in WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS transfers,
+ *      that the block scheduler keeps the downloads in step with one
+ *      another, and that a transfer's bandwidth cap holds it back without
+ *      holding back the others.
+ *
+ *      Every transfer needs an ExchangeContext and a response timer on
+ *      each end, so the number of downloads is bounded by
+ *      WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS and WEAVE_SYSTEM_CONFIG_NUM_TIMERS;
+ *      raise both, along with WEAVE_CONFIG_BDX_MAX_DYNAMIC_TRANSFERS, to
+ *      stress the server with thousands.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Profiles;
+using namespace nl::Weave::Profiles::Common;
+using namespace nl::Weave::Profiles::BulkDataTransfer;
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+// Test device 10 is the server; test device 1 is the downloading peer.
+static const uint64_t kServerNodeId = 0x18B430000000000AULL;
+static const uint64_t kPeerNodeId = 0x18B4300000000001ULL;
+static const uint16_t kBlockSize = 512;
+static const uint32_t kStressLength = 64 * 1024;
+static const uint32_t kCappedLength = 32 * 1024;
+static const uint32_t kCapBytesPerSec = 16 * 1024;
+
+// Leave an exchange on each end for the connection's own use, and a couple of the timers both ends share.
+static const uint32_t kMaxDownloads = (WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 2 < (WEAVE_SYSTEM_CONFIG_NUM_TIMERS - 2) / 2) ?
+                                      WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 2 : (WEAVE_SYSTEM_CONFIG_NUM_TIMERS - 2) / 2;
+
+static const char *kFileDesignator = "bdx-server-stress";
+static const char *kCappedFileDesignator = "bdx-server-stress-capped";
+
+/**
+ *  A download in progress on the peer.
+ */
+struct Download
+{
+    uint64_t Offset;
+    uint64_t StartTime;
+    uint64_t EndTime;
+    bool IsDone;
+};
+
+// The downloading peer.
+static TestBdxPeer sPeer;
+static BdxNode sServer;
+static WeaveConnection *sCon;
+
+static Download sDownloads[kMaxDownloads];
+
+static uint32_t sNumDownloads;
+static uint32_t sNumCapped;
+static uint32_t sDownloadLength;
+static uint32_t sPeakServerTransfers;
+static uint64_t sMaxSpread;
+static bool sDataIntact;
+static TestPeerRun sRun;
+
+static uint8_t PatternByte(uint64_t offset)
+{
+    return static_cast<uint8_t>((offset * 7) ^ (offset >> 8));
+}
+
+// Server handlers
+
+static void ServerGetBlock(BDXTransfer *xfer, uint64_t *length, uint8_t **dataBlock, bool *lastBlock)
+{
+    uint8_t *block = *dataBlock;
+    uint64_t count = xfer->mLength - xfer->mBytesSent;
+
+    // Generate the block in the space the protocol offers, so it goes out without a copy.
+    if (count > *length)
+        count = *length;
+    if (count > xfer->mMaxBlockSize)
+        count = xfer->mMaxBlockSize;
+
+    for (uint64_t i = 0; i < count; i++)
+        block[i] = PatternByte(xfer->mBytesSent + i);
+
+    xfer->mBytesSent += count;
+
+    *length = count;
+    *lastBlock = (xfer->mBytesSent >= xfer->mLength);
+}
+
+static void ServerXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void ServerXferDone(BDXTransfer *xfer)
+{
+    if (!xfer->mIsCompletedSuccessfully)
+        sRun.NumFailed++;
+
+    xfer->Shutdown();
+
+    sRun.ToolDone++;
+    sRun.Update();
+}
+
+static void ServerError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static uint16_t HandleReceiveInit(BDXTransfer *xfer, ReceiveInit *receiveInitMsg)
+{
+    BDXHandlers handlers = {
+        NULL,               // SendAcceptHandler
+        NULL,               // ReceiveAcceptHandler
+        NULL,               // RejectHandler
+        ServerGetBlock,     // GetBlockHandler
+        NULL,               // PutBlockHandler
+        ServerXferError,    // XferErrorHandler
+        ServerXferDone,     // XferDoneHandler
+        ServerError         // ErrorHandler
+    };
+    xfer->mHandlers = handlers;
+    xfer->mTransferMode = kMode_SenderDrive;
+    xfer->mLength = sDownloadLength;
+    xfer->mBytesSent = 0;
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    const ReferencedString &designator = receiveInitMsg->mFileDesignator;
+
+    if (designator.theLength == strlen(kCappedFileDesignator) &&
+        memcmp(designator.theString, kCappedFileDesignator, designator.theLength) == 0)
+    {
+        xfer->mMaxBytesPerSec = kCapBytesPerSec;
+    }
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+
+    xfer->mIsAccepted = true;
+
+    if (sServer.GetNumTransfers() > sPeakServerTransfers)
+        sPeakServerTransfers = sServer.GetNumTransfers();
+
+    return kStatus_Success;
+}
+
+// Peer handlers
+
+static void PeerReject(BDXTransfer *xfer, StatusReport *report)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void PeerPutBlock(BDXTransfer *xfer, uint64_t length, uint8_t *data, bool isLastBlock)
+{
+    Download *download = static_cast<Download *>(xfer->mAppState);
+    uint64_t least = UINT64_MAX;
+    uint64_t most = 0;
+
+    for (uint64_t i = 0; i < length; i++)
+    {
+        if (data[i] != PatternByte(download->Offset + i))
+            sDataIntact = false;
+    }
+
+    download->Offset += length;
+
+    // How far apart are the uncapped downloads still running?  Capped ones come first in sDownloads.
+    for (uint32_t i = sNumCapped; i < sNumDownloads; i++)
+    {
+        if (sDownloads[i].Offset < least && sDownloads[i].Offset < sDownloadLength)
+            least = sDownloads[i].Offset;
+        if (sDownloads[i].Offset > most)
+            most = sDownloads[i].Offset;
+    }
+
+    if (least != UINT64_MAX && most - least > sMaxSpread)
+        sMaxSpread = most - least;
+}
+
+static void PeerXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void PeerXferDone(BDXTransfer *xfer)
+{
+    Download *download = static_cast<Download *>(xfer->mAppState);
+
+    if (!xfer->mIsCompletedSuccessfully || download->Offset != sDownloadLength)
+        sRun.NumFailed++;
+
+    download->EndTime = System::Layer::GetClock_MonotonicHiRes();
+    download->IsDone = true;
+    xfer->Shutdown();
+
+    sRun.PeerDone++;
+    sRun.Update();
+}
+
+static void PeerError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    sRun.NumFailed++;
+    sRun.Update();
+}
+
+static void StartDownload(Download &download, const char *designator)
+{
+    BDXHandlers handlers = {
+        NULL,               // SendAcceptHandler
+        NULL,               // ReceiveAcceptHandler
+        PeerReject,         // RejectHandler
+        NULL,               // GetBlockHandler
+        PeerPutBlock,       // PutBlockHandler
+        PeerXferError,      // XferErrorHandler
+        PeerXferDone,       // XferDoneHandler
+        PeerError           // ErrorHandler
+    };
+    ReferencedString fileDesignator;
+    BDXTransfer *xfer = NULL;
+    WEAVE_ERROR err;
+
+    err = fileDesignator.init(static_cast<uint16_t>(strlen(designator)), const_cast<char *>(designator));
+    SuccessOrExit(err);
+
+    err = sPeer.Node.NewTransfer(sCon, handlers, fileDesignator, &download, xfer);
+    SuccessOrExit(err);
+
+    xfer->mMaxBlockSize = kBlockSize;
+    download.StartTime = System::Layer::GetClock_MonotonicHiRes();
+
+    err = sPeer.Node.InitBdxReceive(*xfer, false, true, false, NULL);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        if (xfer != NULL)
+            BdxNode::ShutdownTransfer(xfer);
+
+        sRun.NumFailed++;
+        sRun.Update();
+    }
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    if (conErr != WEAVE_NO_ERROR)
+    {
+        sRun.NumFailed++;
+        sRun.Update();
+        return;
+    }
+
+    for (uint32_t i = 0; i < sNumDownloads && sRun.NumFailed == 0; i++)
+        StartDownload(sDownloads[i], (i < sNumCapped) ? kCappedFileDesignator : kFileDesignator);
+}
+
+/**
+ *  Start the given number of downloads at once, the first numCapped of them capped, and wait for them all.
+ */
+static void RunDownloads(nlTestSuite* inSuite, uint32_t numDownloads, uint32_t numCapped, uint32_t length)
+{
+    IPAddress serverAddr;
+    WEAVE_ERROR err;
+
+    memset(sDownloads, 0, sizeof(sDownloads));
+
+    sNumDownloads = numDownloads;
+    sNumCapped = numCapped;
+    sDownloadLength = length;
+    sPeakServerTransfers = 0;
+    sMaxSpread = 0;
+    sDataIntact = true;
+    sRun.Start(sNumDownloads);
+
+    sCon = sPeer.MessageLayer.NewConnection();
+    NL_TEST_ASSERT(inSuite, sCon != NULL);
+    if (sCon == NULL)
+        return;
+
+    IPAddress::FromString("::1", serverAddr);
+
+    sCon->OnConnectionComplete = HandleConnectionComplete;
+
+    err = sCon->Connect(kServerNodeId, kWeaveAuthMode_Unauthenticated, serverAddr, WEAVE_PORT);
+    if (err != WEAVE_NO_ERROR)
+        sRun.NumFailed++;
+    else
+        ServiceNetworkUntil(&sRun.Done, NULL);
+
+    sCon->Close();
+    sCon = NULL;
+
+    NL_TEST_ASSERT(inSuite, sRun.NumFailed == 0);
+    NL_TEST_ASSERT(inSuite, sRun.PeerDone == numDownloads);
+    NL_TEST_ASSERT(inSuite, sDataIntact);
+    NL_TEST_ASSERT(inSuite, sServer.GetNumTransfers() == 0);
+    NL_TEST_ASSERT(inSuite, sPeer.Node.GetNumTransfers() == 0);
+}
+
+static void CheckManyDownloads(nlTestSuite* inSuite, void* inContext)
+{
+    uint64_t start;
+    double elapsedSec;
+
+    printf("\n%-28s %10u\n", "built-in transfers", static_cast<unsigned int>(WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS));
+    printf("%-28s %10u\n", "concurrent downloads", static_cast<unsigned int>(kMaxDownloads));
+    printf("%-28s %10u x %u bytes\n", "download size", static_cast<unsigned int>(kStressLength / kBlockSize),
+           static_cast<unsigned int>(kBlockSize));
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+
+    RunDownloads(inSuite, kMaxDownloads, 0, kStressLength);
+
+    elapsedSec = (System::Layer::GetClock_MonotonicHiRes() - start) / 1000000.0;
+
+    printf("%-28s %10u\n", "peak server transfers", static_cast<unsigned int>(sPeakServerTransfers));
+    printf("%-28s %10.1f KB/s\n", "total throughput", kMaxDownloads * (kStressLength / 1024.0) / elapsedSec);
+    printf("%-28s %10u blocks\n", "largest lead", static_cast<unsigned int>(sMaxSpread / kBlockSize));
+
+    NL_TEST_ASSERT(inSuite, sPeakServerTransfers == kMaxDownloads);
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    // Served round-robin, no download gets more than a couple of blocks ahead of another.
+    NL_TEST_ASSERT(inSuite, sMaxSpread <= 2 * kBlockSize);
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+}
+
+static void CheckBandwidthCap(nlTestSuite* inSuite, void* inContext)
+{
+    double cappedSec;
+    double uncappedSec;
+
+    RunDownloads(inSuite, 2, 1, kCappedLength);
+
+    cappedSec = (sDownloads[0].EndTime - sDownloads[0].StartTime) / 1000000.0;
+    uncappedSec = (sDownloads[1].EndTime - sDownloads[1].StartTime) / 1000000.0;
+
+    printf("\n%-28s %10u bytes/s\n", "bandwidth cap", static_cast<unsigned int>(kCapBytesPerSec));
+    printf("%-28s %10.1f KB/s\n", "capped download", kCappedLength / 1024.0 / cappedSec);
+    printf("%-28s %10.1f KB/s\n", "uncapped download", kCappedLength / 1024.0 / uncappedSec);
+
+#if WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+    // The first block goes out with the accept, before the cap applies.
+    NL_TEST_ASSERT(inSuite, cappedSec >= 0.9 * (kCappedLength - kBlockSize) / kCapBytesPerSec);
+    NL_TEST_ASSERT(inSuite, uncappedSec < cappedSec / 2);
+#endif // WEAVE_CONFIG_BDX_BLOCK_SCHEDULER
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("BDX::CheckManyDownloads",  CheckManyDownloads),
+    NL_TEST_DEF("BDX::CheckBandwidthCap",   CheckBandwidthCap),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-bdx-server-stress",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    WEAVE_ERROR err;
+
+    InitPeerTestTool(kServerNodeId);
+
+    err = sServer.Init(&ExchangeMgr);
+    if (err == WEAVE_NO_ERROR)
+        err = sServer.AwaitBdxReceiveInit(HandleReceiveInit);
+    if (err == WEAVE_NO_ERROR)
+    {
+        sServer.AllowBdxTransferToRun(true);
+        err = sPeer.Init(kPeerNodeId);
+    }
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (err == WEAVE_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    sPeer.Shutdown();
+
+    sServer.Shutdown();
+
+    ShutdownPeerTestTool();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
@@ -0,0 +1,605 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a throughput test for windowed sender-drive transfers in
+ *      the development BDX profile.
+ *
+ *      The tool's own Weave stack listens for TCP connections on the
+ *      loopback interface and receives the transfers.  A peer, with a
+ *      Weave stack of its own, connects to it and sends a fixed amount of
+ *      data for each of several window sizes, and the resulting
+ *      throughput is reported.  A window of one block is the plain
+ *      stop-and-wait sender-drive transfer.
+ *
+ *      Loopback has next to no latency, so every message arriving at the
+ *      sending peer is held back for a fixed delay before it is handled,
+ *      standing in for the round trip of a real link.  This is the cost
+ *      a window hides.  The held messages are copied out of their
+ *      packet buffers while they wait, so the delay itself does not tie
+ *      up the buffer pool.  Both ends share the process's pool, though,
+ *      and a windowed sender holds a buffer for every block in flight,
+ *      so build with WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC comfortably
+ *      above WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE.
+ *
+ *      Finally, the receiver drops one block of a windowed transfer, to
+ *      check that it asks for just that block again and that the data
+ *      still arrives intact and in order.  The receiver holds on to the
+ *      blocks that overtake the lost one as well, so this run uses a
+ *      smaller window to stay within the default pool.
+ *
+ *      Last, the final blocks of a transfer never reach the receiver, so
+ *      the sender hears acks for the blocks before them and then nothing,
+ *      to check that it times out rather than waiting forever.  This run
+ *      uses a short response timeout.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Profiles;
+using namespace nl::Weave::Profiles::Common;
+using namespace nl::Weave::Profiles::BulkDataTransfer;
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+// Test device 10 is the receiver; test device 1 is the sending peer.
+static const uint64_t kReceiverNodeId = 0x18B430000000000AULL;
+static const uint64_t kPeerNodeId = 0x18B4300000000001ULL;
+static const uint16_t kBlockSize = 256;
+static const uint32_t kBlocksPerRun = 64;
+static const uint32_t kDelayMS = 20;
+static const size_t kMaxDelayedMessages = 2 * WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE + 4;
+static const uint16_t kMaxDelayedLength = 64;
+static const uint32_t kDroppedBlock = kBlocksPerRun / 4;
+static const uint8_t kLossyWindowSize = 4;
+static const uint32_t kLostBlocks = 2;
+static const uint32_t kAckTimeoutMS = 10 * kDelayMS;
+
+static const char *kFileDesignator = "bdx-window-perf";
+
+/**
+ *  What is lost on the way between the sending peer and the receiver during a run.
+ */
+enum LossMode
+{
+    kLoss_None,             // Nothing is lost
+    kLoss_OneBlock,         // One block is lost on its way to the receiver
+    kLoss_LastBlocks,       // Every copy of the last kLostBlocks blocks is lost on its way to the receiver
+};
+
+/**
+ *  A message held back on its way to the sending peer's transfer.
+ */
+struct DelayedMessage
+{
+    ExchangeContext *Ec;
+    uint32_t ProfileId;
+    uint8_t MessageType;
+    uint16_t Length;
+    uint8_t Payload[kMaxDelayedLength];
+};
+
+// The sending peer.
+static TestBdxPeer sPeer;
+static BdxNode sReceiver;
+static WeaveConnection *sCon;
+static BDXTransfer *sReceiverXfer;
+
+static DelayedMessage sDelayed[kMaxDelayedMessages];
+static size_t sDelayedHead;
+static size_t sDelayedCount;
+
+static uint8_t sBlock[kBlockSize];
+static uint32_t sBlocksSent;
+static uint32_t sBlocksReceived;
+static uint32_t sBlocksDelivered;
+static uint64_t sBytesDelivered;
+static uint8_t sWindowSize;
+static LossMode sLossMode;
+static bool sDropBlock;
+static bool sSenderTimedOut;
+static bool sDataIntact;
+static bool sSenderDone;
+static bool sReceiverDone;
+static bool sRunDone;
+static size_t sNumFailed;
+
+static uint8_t PatternByte(uint64_t offset)
+{
+    return static_cast<uint8_t>((offset * 7) ^ (offset >> 8));
+}
+
+static void CheckRunDone(void)
+{
+    // A sender that timed out is done whether or not the receiver ever will be.
+    sRunDone = (sSenderDone && (sReceiverDone || sSenderTimedOut)) || sNumFailed != 0;
+}
+
+// Injected delay
+
+static void DeliverDelayedMessage(System::Layer *systemLayer, void *appState, System::Error err)
+{
+    // All messages are held for the same time, so they come due in the order they arrived.
+    DelayedMessage &msg = sDelayed[sDelayedHead];
+    PacketBuffer *payload;
+
+    sDelayedHead = (sDelayedHead + 1) % kMaxDelayedMessages;
+    sDelayedCount--;
+
+    payload = PacketBuffer::NewWithAvailableSize(msg.Length);
+    if (payload == NULL)
+    {
+        sNumFailed++;
+        CheckRunDone();
+        return;
+    }
+
+    memcpy(payload->Start(), msg.Payload, msg.Length);
+    payload->SetDataLength(msg.Length);
+
+    BdxProtocol::HandleResponse(msg.Ec, NULL, NULL, msg.ProfileId, msg.MessageType, payload);
+}
+
+static void DelayMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+                         uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    size_t slot;
+
+    if (sDelayedCount == kMaxDelayedMessages || payload->DataLength() > kMaxDelayedLength)
+    {
+        sNumFailed++;
+        PacketBuffer::Free(payload);
+        CheckRunDone();
+        return;
+    }
+
+    slot = (sDelayedHead + sDelayedCount) % kMaxDelayedMessages;
+    sDelayedCount++;
+
+    sDelayed[slot].Ec = ec;
+    sDelayed[slot].ProfileId = profileId;
+    sDelayed[slot].MessageType = msgType;
+    sDelayed[slot].Length = payload->DataLength();
+    memcpy(sDelayed[slot].Payload, payload->Start(), payload->DataLength());
+
+    PacketBuffer::Free(payload);
+
+    // Each slot is its own timer, so messages in flight at the same time don't cancel one another.
+    SystemLayer.StartTimer(kDelayMS, DeliverDelayedMessage, &sDelayed[slot]);
+}
+
+/**
+ *  Count every block arriving at the receiver, and drop the ones the run asks to lose.
+ */
+static void CountReceivedBlock(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+                               uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    if (profileId == kWeaveProfile_BDX && (msgType == kMsgType_BlockSendV1 || msgType == kMsgType_BlockEOFV1))
+    {
+        sBlocksReceived++;
+
+        if (sDropBlock && sBlocksReceived == kDroppedBlock + 1)
+        {
+            sDropBlock = false;
+            PacketBuffer::Free(payload);
+            return;
+        }
+
+        if (sLossMode == kLoss_LastBlocks && payload->DataLength() >= sizeof(uint32_t) &&
+            Encoding::LittleEndian::Get32(payload->Start()) >= kBlocksPerRun - kLostBlocks)
+        {
+            PacketBuffer::Free(payload);
+            return;
+        }
+    }
+
+    BdxProtocol::HandleResponse(ec, pktInfo, msgInfo, profileId, msgType, payload);
+}
+
+// Receiver handlers
+
+static void ReceiverPutBlock(BDXTransfer *xfer, uint64_t length, uint8_t *data, bool isLastBlock)
+{
+    for (uint64_t i = 0; i < length; i++)
+    {
+        if (data[i] != PatternByte(sBytesDelivered + i))
+            sDataIntact = false;
+    }
+
+    sBytesDelivered += length;
+    sBlocksDelivered++;
+}
+
+static void ReceiverXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sNumFailed++;
+    CheckRunDone();
+}
+
+static void ReceiverXferDone(BDXTransfer *xfer)
+{
+    if (!xfer->mIsCompletedSuccessfully)
+        sNumFailed++;
+
+    sReceiverXfer = NULL;
+    xfer->Shutdown();
+
+    sReceiverDone = true;
+    CheckRunDone();
+}
+
+static void ReceiverError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    sNumFailed++;
+    CheckRunDone();
+}
+
+static uint16_t HandleSendInit(BDXTransfer *xfer, SendInit *sendInitMsg)
+{
+    BDXHandlers handlers = {
+        NULL,               // SendAcceptHandler
+        NULL,               // ReceiveAcceptHandler
+        NULL,               // RejectHandler
+        NULL,               // GetBlockHandler
+        ReceiverPutBlock,   // PutBlockHandler
+        ReceiverXferError,  // XferErrorHandler
+        ReceiverXferDone,   // XferDoneHandler
+        ReceiverError       // ErrorHandler
+    };
+
+    xfer->mHandlers = handlers;
+    xfer->mTransferMode = kMode_SenderDrive;
+    xfer->mWindowSize = WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE;
+    xfer->mIsAccepted = true;
+
+    sReceiverXfer = xfer;
+
+    return kStatus_Success;
+}
+
+// Sender handlers
+
+static WEAVE_ERROR SenderSendAccept(BDXTransfer *xfer, SendAccept *sendAcceptMsg)
+{
+    // The receiver's transfer is set up by now, so start watching the blocks it gets.
+    if (sReceiverXfer != NULL)
+        sReceiverXfer->mExchangeContext->OnMessageReceived = CountReceivedBlock;
+
+    return WEAVE_NO_ERROR;
+}
+
+static void SenderReject(BDXTransfer *xfer, StatusReport *report)
+{
+    sNumFailed++;
+    CheckRunDone();
+}
+
+static void SenderGetBlock(BDXTransfer *xfer, uint64_t *length, uint8_t **dataBlock, bool *lastBlock)
+{
+    uint64_t offset = static_cast<uint64_t>(sBlocksSent) * kBlockSize;
+
+    for (uint16_t i = 0; i < kBlockSize; i++)
+        sBlock[i] = PatternByte(offset + i);
+
+    *length = kBlockSize;
+    *dataBlock = sBlock;
+    *lastBlock = (++sBlocksSent == kBlocksPerRun);
+}
+
+static void SenderXferError(BDXTransfer *xfer, StatusReport *xferError)
+{
+    sNumFailed++;
+    CheckRunDone();
+}
+
+static void SenderXferDone(BDXTransfer *xfer)
+{
+    if (!xfer->mIsCompletedSuccessfully)
+        sNumFailed++;
+
+    xfer->Shutdown();
+
+    sSenderDone = true;
+    CheckRunDone();
+}
+
+static void SenderError(BDXTransfer *xfer, WEAVE_ERROR err)
+{
+    if (sLossMode == kLoss_LastBlocks && err == WEAVE_ERROR_TIMEOUT)
+    {
+        xfer->Shutdown();
+
+        sSenderTimedOut = true;
+        sSenderDone = true;
+    }
+    else
+    {
+        sNumFailed++;
+    }
+
+    CheckRunDone();
+}
+
+static void StartTransfer(void)
+{
+    BDXHandlers handlers = {
+        SenderSendAccept,   // SendAcceptHandler
+        NULL,               // ReceiveAcceptHandler
+        SenderReject,       // RejectHandler
+        SenderGetBlock,     // GetBlockHandler
+        NULL,               // PutBlockHandler
+        SenderXferError,    // XferErrorHandler
+        SenderXferDone,     // XferDoneHandler
+        SenderError         // ErrorHandler
+    };
+    ReferencedString fileDesignator;
+    BDXTransfer *xfer = NULL;
+    WEAVE_ERROR err;
+
+    err = fileDesignator.init(static_cast<uint16_t>(strlen(kFileDesignator)), const_cast<char *>(kFileDesignator));
+    SuccessOrExit(err);
+
+    err = sPeer.Node.NewTransfer(sCon, handlers, fileDesignator, NULL, xfer);
+    SuccessOrExit(err);
+
+    xfer->mMaxBlockSize = kBlockSize;
+    xfer->mLength = static_cast<uint64_t>(kBlocksPerRun) * kBlockSize;
+    xfer->mWindowSize = sWindowSize;
+
+    err = sPeer.Node.InitBdxSend(*xfer, true, false, false, NULL);
+    SuccessOrExit(err);
+
+    // The SendInit has armed the response timer already; every wait for a block ack that follows uses this timeout.
+    if (sLossMode == kLoss_LastBlocks)
+        xfer->mExchangeContext->ResponseTimeout = kAckTimeoutMS;
+
+    // Everything the receiver sends back, starting with its SendAccept, now reaches the peer one delay later.
+    xfer->mExchangeContext->OnMessageReceived = DelayMessage;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        if (xfer != NULL)
+            BdxNode::ShutdownTransfer(xfer);
+
+        sNumFailed++;
+        CheckRunDone();
+    }
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    if (conErr != WEAVE_NO_ERROR)
+    {
+        sNumFailed++;
+        CheckRunDone();
+        return;
+    }
+
+    StartTransfer();
+}
+
+/**
+ *  Send one transfer from the peer to the receiver with the given window size and losses, and print a result row.
+ */
+static void RunTransfer(nlTestSuite* inSuite, uint8_t windowSize, LossMode lossMode, const char *label)
+{
+    IPAddress receiverAddr;
+    uint64_t start;
+    double elapsedSec;
+    WEAVE_ERROR err;
+
+    sBlocksSent = 0;
+    sBlocksReceived = 0;
+    sBlocksDelivered = 0;
+    sBytesDelivered = 0;
+    sWindowSize = windowSize;
+    sLossMode = lossMode;
+    sDropBlock = (lossMode == kLoss_OneBlock);
+    sSenderTimedOut = false;
+    sDataIntact = true;
+    sSenderDone = false;
+    sReceiverDone = false;
+    sRunDone = false;
+    sNumFailed = 0;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+
+    sCon = sPeer.MessageLayer.NewConnection();
+    NL_TEST_ASSERT(inSuite, sCon != NULL);
+    if (sCon == NULL)
+        return;
+
+    IPAddress::FromString("::1", receiverAddr);
+
+    sCon->OnConnectionComplete = HandleConnectionComplete;
+
+    err = sCon->Connect(kReceiverNodeId, kWeaveAuthMode_Unauthenticated, receiverAddr, WEAVE_PORT);
+    if (err != WEAVE_NO_ERROR)
+        sNumFailed++;
+    else
+        ServiceNetworkUntil(&sRunDone, NULL);
+
+    elapsedSec = (System::Layer::GetClock_MonotonicHiRes() - start) / 1000000.0;
+
+    printf("%-28s %10.1f KB/s, %.1f blocks/s, %u blocks sent\n", label, sBytesDelivered / 1024.0 / elapsedSec,
+           sBlocksDelivered / elapsedSec, sBlocksReceived);
+
+    // A receiver still waiting for blocks that will never come is given up on along with the connection.
+    if (sReceiverXfer != NULL)
+    {
+        sReceiverXfer->Shutdown();
+        sReceiverXfer = NULL;
+    }
+
+    sCon->Close();
+    sCon = NULL;
+
+    NL_TEST_ASSERT(inSuite, sNumFailed == 0);
+    NL_TEST_ASSERT(inSuite, sDelayedCount == 0);
+    NL_TEST_ASSERT(inSuite, sDataIntact);
+
+    if (lossMode == kLoss_LastBlocks)
+    {
+        NL_TEST_ASSERT(inSuite, sSenderTimedOut);
+        NL_TEST_ASSERT(inSuite, !sReceiverDone);
+        NL_TEST_ASSERT(inSuite, sBlocksDelivered == kBlocksPerRun - kLostBlocks);
+    }
+    else
+    {
+        NL_TEST_ASSERT(inSuite, !sSenderTimedOut);
+        NL_TEST_ASSERT(inSuite, sBlocksDelivered == kBlocksPerRun);
+        NL_TEST_ASSERT(inSuite, sBytesDelivered == static_cast<uint64_t>(kBlocksPerRun) * kBlockSize);
+    }
+}
+
+static void CheckWindowThroughput(nlTestSuite* inSuite, void* inContext)
+{
+    char label[32];
+    unsigned int windowSize;
+
+    printf("\n%-28s %10u\n", "max window size", static_cast<unsigned int>(WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE));
+    printf("%-28s %10u ms\n", "injected delay", static_cast<unsigned int>(kDelayMS));
+    printf("%-28s %10u x %u bytes\n", "transfer size", static_cast<unsigned int>(kBlocksPerRun),
+           static_cast<unsigned int>(kBlockSize));
+
+    for (windowSize = 1; windowSize <= WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE; windowSize *= 2)
+    {
+        snprintf(label, sizeof(label), "window of %u block(s)", windowSize);
+        RunTransfer(inSuite, static_cast<uint8_t>(windowSize), kLoss_None, label);
+
+        // Without loss, every block is sent exactly once whatever the window.
+        NL_TEST_ASSERT(inSuite, sBlocksReceived == kBlocksPerRun);
+    }
+}
+
+static void CheckSelectiveRetransmit(nlTestSuite* inSuite, void* inContext)
+{
+    printf("\n");
+
+    RunTransfer(inSuite, kLossyWindowSize, kLoss_OneBlock, "one block dropped");
+
+    // Only the dropped block is sent again; the blocks that overtook it are held by the receiver.
+    NL_TEST_ASSERT(inSuite, sBlocksReceived == kBlocksPerRun + 1);
+}
+
+static void CheckWindowAckTimeout(nlTestSuite* inSuite, void* inContext)
+{
+    printf("\n");
+
+    // The acks for the blocks before the lost ones leave the sender with blocks in flight and nothing new to send.
+    RunTransfer(inSuite, kLossyWindowSize, kLoss_LastBlocks, "last blocks dropped");
+
+    // The sender waits out the timeout without sending any block again.
+    NL_TEST_ASSERT(inSuite, sBlocksReceived == kBlocksPerRun);
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("BDX::BenchmarkWindowThroughput",   CheckWindowThroughput),
+    NL_TEST_DEF("BDX::CheckSelectiveRetransmit",    CheckSelectiveRetransmit),
+    NL_TEST_DEF("BDX::CheckWindowAckTimeout",       CheckWindowAckTimeout),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-bdx-window-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    WEAVE_ERROR err;
+
+    InitPeerTestTool(kReceiverNodeId);
+
+    err = sReceiver.Init(&ExchangeMgr);
+    if (err == WEAVE_NO_ERROR)
+        err = sReceiver.AwaitBdxSendInit(HandleSendInit);
+    if (err == WEAVE_NO_ERROR)
+    {
+        sReceiver.AllowBdxTransferToRun(true);
+        err = sPeer.Init(kPeerNodeId);
+    }
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (err == WEAVE_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    sPeer.Shutdown();
+
+    sReceiver.Shutdown();
+
+    ShutdownPeerTestTool();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
@@ -0,0 +1,598 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a load test for CASE session establishment in
+ *      <tt>nl::Weave::WeaveSecurityManager</tt>.
+ *
+ *      The tool's own Weave stack acts as the CASE responder and
+ *      listens for TCP connections on the loopback interface.  An
+ *      increasing number of peers, each with its own fabric state,
+ *      message layer, exchange manager and security manager, then
+ *      repeatedly connect to it and establish a CASE session, and the
+ *      rate of completed handshakes is reported for each peer count,
+ *      along with the number of handshakes the responder turned away
+ *      as busy.
+ *
+ *      Build with WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+ *      set to 1 and to the largest peer count to compare serialized
+ *      against concurrent session establishment.  Raise
+ *      WEAVE_CONFIG_TCP_LISTEN_BACKLOG to the largest peer count as
+ *      well, or connection attempts that overflow the listen backlog
+ *      will dominate the results.
+ *
+ *      The longest delay of a short periodic timer is reported as
+ *      well, as a measure of how long the event loop is kept from
+ *      serving other traffic.  Build with and without
+ *      WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD to compare running the
+ *      handshake cryptography on worker threads against running it on
+ *      the event loop.  With offload, every session in progress holds
+ *      its message buffers until its worker job completes, so size
+ *      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC for at least three
+ *      buffers per peer.
+ *
+ *      Finally, a single peer's handshake rate is reported without a
+ *      certificate validation cache, and with a cold and a warm one,
+ *      to show the cost of the certificate chain signature checks
+ *      that the cache saves.
+ *
+ *      When built with WEAVE_CONFIG_ENABLE_CASE_RESUMPTION, the rate of
+ *      full handshakes is compared against that of handshakes resuming
+ *      an earlier session, and the fallback to a full handshake is
+ *      exercised by having the responder forget its resumption
+ *      secrets.  All other measurements use full handshakes only.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveSecurityMgr.h>
+#include <Weave/Profiles/common/CommonProfile.h>
+#include <Weave/Profiles/security/WeaveCASE.h>
+#include <Weave/Profiles/security/WeaveSig.h>
+#include <Weave/Support/NestCerts.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Profiles::Security;
+using namespace nl::Weave::Profiles::Security::CASE;
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+// Test device 10 is the responder; test devices 1 through 8 are the peers.
+static const uint64_t kResponderNodeId = 0x18B430000000000AULL;
+static const uint64_t kFirstPeerNodeId = 0x18B4300000000001ULL;
+static const size_t kMaxPeers = 8;
+static const size_t kHandshakesPerRun = 64;
+static const uint32_t kProbeIntervalMS = 1;
+
+/**
+ *  CASE authentication delegate for a peer, presenting that peer's test device certificate.
+ *
+ *  Certificate validation is handed off to the tool's CASE options, which do not depend on the local node id.
+ */
+class PeerCASEAuthDelegate : public WeaveCASEAuthDelegate
+{
+public:
+    uint64_t NodeId;
+
+#if !WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+    WEAVE_ERROR EncodeNodeCertInfo(const BeginSessionContext & msgCtx, TLVWriter & writer) __OVERRIDE
+    {
+        const uint8_t * nodeCert;
+        uint16_t nodeCertLen;
+
+        if (!GetTestNodeCert(NodeId, nodeCert, nodeCertLen))
+            return WEAVE_ERROR_CERT_NOT_FOUND;
+
+        return EncodeCASECertInfo(writer, nodeCert, nodeCertLen,
+                                  nl::NestCerts::Development::DeviceCA::Cert, nl::NestCerts::Development::DeviceCA::CertLength);
+    }
+
+    WEAVE_ERROR GenerateNodeSignature(const BeginSessionContext & msgCtx,
+            const uint8_t * msgHash, uint8_t msgHashLen, TLVWriter & writer, uint64_t tag) __OVERRIDE
+    {
+        const uint8_t * nodePrivKey;
+        uint16_t nodePrivKeyLen;
+
+        if (!GetTestNodePrivateKey(NodeId, nodePrivKey, nodePrivKeyLen))
+            return WEAVE_ERROR_KEY_NOT_FOUND;
+
+        return GenerateAndEncodeWeaveECDSASignature(writer, tag, msgHash, msgHashLen, nodePrivKey, nodePrivKeyLen);
+    }
+
+    WEAVE_ERROR EncodeNodePayload(const BeginSessionContext & msgCtx,
+            uint8_t * payloadBuf, uint16_t payloadBufSize, uint16_t & payloadLen) __OVERRIDE
+    {
+        return ToolDelegate().EncodeNodePayload(msgCtx, payloadBuf, payloadBufSize, payloadLen);
+    }
+
+    WEAVE_ERROR BeginValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+            WeaveCertificateSet & certSet) __OVERRIDE
+    {
+        return ToolDelegate().BeginValidation(msgCtx, validCtx, certSet);
+    }
+
+    WEAVE_ERROR HandleValidationResult(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+            WeaveCertificateSet & certSet, WEAVE_ERROR & validRes) __OVERRIDE
+    {
+        return ToolDelegate().HandleValidationResult(msgCtx, validCtx, certSet, validRes);
+    }
+
+    void EndValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+            WeaveCertificateSet & certSet) __OVERRIDE
+    {
+        ToolDelegate().EndValidation(msgCtx, validCtx, certSet);
+    }
+
+#else // !WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+    WEAVE_ERROR GetNodeCertInfo(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & certInfoLen) __OVERRIDE
+    {
+        const uint8_t * nodeCert;
+        uint16_t nodeCertLen;
+
+        if (!GetTestNodeCert(NodeId, nodeCert, nodeCertLen))
+            return WEAVE_ERROR_CERT_NOT_FOUND;
+
+        return EncodeCASECertInfo(buf, bufSize, certInfoLen, nodeCert, nodeCertLen,
+                                  nl::NestCerts::Development::DeviceCA::Cert, nl::NestCerts::Development::DeviceCA::CertLength);
+    }
+
+    WEAVE_ERROR GetNodePrivateKey(bool isInitiator, const uint8_t *& weavePrivKey, uint16_t & weavePrivKeyLen) __OVERRIDE
+    {
+        if (!GetTestNodePrivateKey(NodeId, weavePrivKey, weavePrivKeyLen))
+            return WEAVE_ERROR_KEY_NOT_FOUND;
+
+        return WEAVE_NO_ERROR;
+    }
+
+    WEAVE_ERROR ReleaseNodePrivateKey(const uint8_t * weavePrivKey) __OVERRIDE
+    {
+        return WEAVE_NO_ERROR;
+    }
+
+    WEAVE_ERROR GetNodePayload(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & payloadLen) __OVERRIDE
+    {
+        return ToolDelegate().GetNodePayload(isInitiator, buf, bufSize, payloadLen);
+    }
+
+    WEAVE_ERROR BeginCertValidation(bool isInitiator, WeaveCertificateSet & certSet, ValidationContext & validCtx) __OVERRIDE
+    {
+        return ToolDelegate().BeginCertValidation(isInitiator, certSet, validCtx);
+    }
+
+    WEAVE_ERROR HandleCertValidationResult(bool isInitiator, WEAVE_ERROR & validRes, WeaveCertificateData * peerCert,
+            uint64_t peerNodeId, WeaveCertificateSet & certSet, ValidationContext & validCtx) __OVERRIDE
+    {
+        return ToolDelegate().HandleCertValidationResult(isInitiator, validRes, peerCert, peerNodeId, certSet, validCtx);
+    }
+
+    WEAVE_ERROR EndCertValidation(WeaveCertificateSet & certSet, ValidationContext & validCtx) __OVERRIDE
+    {
+        return ToolDelegate().EndCertValidation(certSet, validCtx);
+    }
+
+#endif // WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+private:
+    static WeaveCASEAuthDelegate & ToolDelegate(void) { return gCASEOptions; }
+};
+
+/**
+ *  A peer node, running a security manager of its own.
+ */
+struct Peer : public TestPeer
+{
+    WeaveSecurityManager SecurityMgr;
+    PeerCASEAuthDelegate AuthDelegate;
+    bool Active;
+};
+
+static Peer sPeers[kMaxPeers];
+static size_t sNumPeers;
+static size_t sNumStarted;
+static size_t sNumEstablished;
+static size_t sNumBusy;
+static size_t sNumFailed;
+static size_t sNumActivePeers;
+static bool sRunDone;
+static uint64_t sProbeDueUS;
+static uint64_t sMaxProbeDelayUS;
+
+static void StartHandshake(Peer *peer);
+
+/**
+ *  Periodic timer recording how late it fires, which is how long the event loop was busy with something else.
+ */
+static void HandleProbeTimer(System::Layer *systemLayer, void *appState, System::Error err)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicHiRes();
+
+    if (now > sProbeDueUS && now - sProbeDueUS > sMaxProbeDelayUS)
+        sMaxProbeDelayUS = now - sProbeDueUS;
+
+    if (!sRunDone)
+    {
+        sProbeDueUS = now + kProbeIntervalMS * 1000;
+        systemLayer->StartTimer(kProbeIntervalMS, HandleProbeTimer, NULL);
+    }
+}
+
+static void HandleSessionEstablished(WeaveSecurityManager *sm, WeaveConnection *con, void *reqState, uint16_t sessionKeyId,
+                                     uint64_t peerNodeId, uint8_t encType)
+{
+    Peer *peer = static_cast<Peer *>(reqState);
+
+    sNumEstablished++;
+
+    // Closing the connection discards the session keys bound to it on both sides.
+    con->Close();
+
+    StartHandshake(peer);
+}
+
+static void HandleSessionError(WeaveSecurityManager *sm, WeaveConnection *con, void *reqState, WEAVE_ERROR localErr,
+                               uint64_t peerNodeId, StatusReport *statusReport)
+{
+    Peer *peer = static_cast<Peer *>(reqState);
+
+    // A busy responder is not a failure; the peer simply tries again.
+    if (statusReport != NULL && statusReport->mProfileId == kWeaveProfile_Common &&
+        statusReport->mStatusCode == Profiles::Common::kStatus_Busy)
+    {
+        sNumBusy++;
+        sNumStarted--;
+    }
+    else
+        sNumFailed++;
+
+    if (con != NULL)
+        con->Close();
+
+    StartHandshake(peer);
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    Peer *peer = static_cast<Peer *>(con->AppState);
+
+    if (conErr == WEAVE_NO_ERROR)
+    {
+        conErr = peer->SecurityMgr.StartCASESession(con, kResponderNodeId, con->PeerAddr, con->PeerPort,
+                                                    kWeaveAuthMode_CASE_AnyCert, peer, HandleSessionEstablished,
+                                                    HandleSessionError, &peer->AuthDelegate);
+    }
+
+    if (conErr != WEAVE_NO_ERROR)
+    {
+        sNumFailed++;
+
+        con->Close();
+
+        StartHandshake(peer);
+    }
+}
+
+/**
+ *  Mark a peer as done for this run; the run ends when the last peer is done.
+ */
+static void StopPeer(Peer *peer)
+{
+    if (peer->Active)
+    {
+        peer->Active = false;
+        sNumActivePeers--;
+        sRunDone = (sNumActivePeers == 0);
+    }
+}
+
+/**
+ *  Open a fresh connection to the responder and, once it is up, start a CASE session over it.
+ */
+static void StartHandshake(Peer *peer)
+{
+    WeaveConnection *con;
+    IPAddress responderAddr;
+    WEAVE_ERROR err;
+
+    if (sNumStarted >= kHandshakesPerRun)
+    {
+        StopPeer(peer);
+        return;
+    }
+
+    con = peer->MessageLayer.NewConnection();
+    if (con == NULL)
+    {
+        StopPeer(peer);
+        return;
+    }
+
+    sNumStarted++;
+
+    IPAddress::FromString("::1", responderAddr);
+
+    con->AppState = peer;
+    con->OnConnectionComplete = HandleConnectionComplete;
+
+    err = con->Connect(kResponderNodeId, kWeaveAuthMode_Unauthenticated, responderAddr, WEAVE_PORT);
+    if (err != WEAVE_NO_ERROR)
+    {
+        sNumFailed++;
+
+        con->Close();
+        StopPeer(peer);
+    }
+}
+
+static WEAVE_ERROR InitPeer(Peer &peer, uint64_t nodeId)
+{
+    WEAVE_ERROR err;
+
+    err = peer.Init(nodeId);
+    SuccessOrExit(err);
+
+    peer.AuthDelegate.NodeId = nodeId;
+
+    err = peer.SecurityMgr.Init(peer.ExchangeMgr, SystemLayer);
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Measure full handshakes unless a test asks for resumption.
+    peer.SecurityMgr.InitiatorResumeCASESessions = false;
+#endif
+
+exit:
+    return err;
+}
+
+static void ShutdownPeer(Peer &peer)
+{
+    peer.SecurityMgr.Shutdown();
+    peer.Shutdown();
+}
+
+/**
+ *  Run handshakes from the given number of peers until the run's quota is established, and print a result row.
+ */
+static void RunHandshakes(nlTestSuite* inSuite, size_t numPeers, const char *label)
+{
+    uint64_t start;
+    double elapsedSec;
+    size_t i;
+
+    sNumStarted = 0;
+    sNumEstablished = 0;
+    sNumBusy = 0;
+    sNumFailed = 0;
+    sNumActivePeers = numPeers;
+    sRunDone = false;
+    sMaxProbeDelayUS = 0;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+
+    sProbeDueUS = start + kProbeIntervalMS * 1000;
+    SystemLayer.StartTimer(kProbeIntervalMS, HandleProbeTimer, NULL);
+
+    for (i = 0; i < numPeers; i++)
+    {
+        sPeers[i].Active = true;
+        StartHandshake(&sPeers[i]);
+    }
+
+    ServiceNetworkUntil(&sRunDone, NULL);
+
+    elapsedSec = (System::Layer::GetClock_MonotonicHiRes() - start) / 1000000.0;
+
+    printf("%-28s %10.1f handshakes/s, %u busy, %.1f ms max event loop stall\n", label, sNumEstablished / elapsedSec,
+           static_cast<unsigned int>(sNumBusy), sMaxProbeDelayUS / 1000.0);
+
+    SystemLayer.CancelTimer(HandleProbeTimer, NULL);
+
+    NL_TEST_ASSERT(inSuite, sNumFailed == 0);
+    NL_TEST_ASSERT(inSuite, sNumEstablished == kHandshakesPerRun);
+}
+
+static void CheckHandshakeRate(nlTestSuite* inSuite, void* inContext)
+{
+    char label[32];
+    size_t numPeers;
+
+    printf("\n%-28s %10u\n", "max concurrent sessions", static_cast<unsigned int>(WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS));
+#if WEAVE_CONFIG_SECURITY_MGR_CRYPTO_OFFLOAD
+    printf("%-28s %10u\n", "crypto worker threads", static_cast<unsigned int>(WEAVE_CONFIG_SECURITY_MGR_CRYPTO_WORKER_THREADS));
+#else
+    printf("%-28s %10s\n", "crypto worker threads", "none");
+#endif
+
+    for (numPeers = 1; numPeers <= sNumPeers; numPeers *= 2)
+    {
+        snprintf(label, sizeof(label), "%u peer(s)", static_cast<unsigned int>(numPeers));
+        RunHandshakes(inSuite, numPeers, label);
+    }
+}
+
+static void CheckWarmCertCacheHandshakeRate(nlTestSuite* inSuite, void* inContext)
+{
+    CertValidationCache cache;
+    uint32_t hitCount;
+    uint32_t missCount;
+    WEAVE_ERROR err;
+
+    err = cache.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    printf("\n%-28s %10u\n", "cert validation cache size", static_cast<unsigned int>(CertValidationCache::kMaxEntries));
+
+    RunHandshakes(inSuite, 1, "no cache");
+
+    // Both the responder and the peers validate certificates through the tool's CASE options.
+    gCASEOptions.ValidationCache = &cache;
+
+    RunHandshakes(inSuite, 1, "cold cache");
+    printf("%-28s %10u hits, %u misses\n", "", cache.HitCount, cache.MissCount);
+
+    hitCount = cache.HitCount;
+    missCount = cache.MissCount;
+
+    RunHandshakes(inSuite, 1, "warm cache");
+    printf("%-28s %10u hits, %u misses\n", "", cache.HitCount - hitCount, cache.MissCount - missCount);
+
+    // Once warm, every signature in the peers' certificate chains is found in the cache.
+    NL_TEST_ASSERT(inSuite, cache.MissCount == missCount);
+    NL_TEST_ASSERT(inSuite, cache.HitCount > hitCount);
+
+    gCASEOptions.ValidationCache = NULL;
+}
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+static void SetPeersResumeSessions(bool resume)
+{
+    for (size_t i = 0; i < sNumPeers; i++)
+        sPeers[i].SecurityMgr.InitiatorResumeCASESessions = resume;
+}
+
+static void CheckResumedHandshakeRate(nlTestSuite* inSuite, void* inContext)
+{
+    CertValidationCache cache;
+    WEAVE_ERROR err;
+
+    err = cache.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    printf("\n%-28s %10u\n", "resumption cache size", static_cast<unsigned int>(SessionResumptionCache::kMaxEntries));
+
+    // Full handshakes, each of which leaves both sides holding a resumption secret.
+    RunHandshakes(inSuite, 1, "full handshake");
+
+    SetPeersResumeSessions(true);
+
+    // Resumed handshakes validate no certificates, which the validation cache's counters confirm.
+    gCASEOptions.ValidationCache = &cache;
+
+    RunHandshakes(inSuite, 1, "resumed handshake");
+    printf("%-28s %10u certificate checks\n", "", cache.HitCount + cache.MissCount);
+
+    NL_TEST_ASSERT(inSuite, cache.HitCount + cache.MissCount == 0);
+
+    gCASEOptions.ValidationCache = NULL;
+
+    // Once the responder has forgotten its secrets, the peer's first attempt falls back to a full handshake.
+    SecurityMgr.ClearCASEResumptionSecrets();
+
+    RunHandshakes(inSuite, 1, "after responder reset");
+
+    SetPeersResumeSessions(false);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("SecurityMgr::BenchmarkCASEHandshakeRate",   CheckHandshakeRate),
+    NL_TEST_DEF("SecurityMgr::BenchmarkCASEWarmCertCache",   CheckWarmCertCacheHandshakeRate),
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    NL_TEST_DEF("SecurityMgr::BenchmarkCASEResumption",      CheckResumedHandshakeRate),
+#endif
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-case-load-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    size_t i;
+
+    InitPeerTestTool(kResponderNodeId);
+
+    for (i = 0; i < kMaxPeers; i++)
+    {
+        if (InitPeer(sPeers[i], kFirstPeerNodeId + i) != WEAVE_NO_ERROR)
+            break;
+    }
+
+    sNumPeers = i;
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (sNumPeers > 0) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    for (size_t i = 0; i < sNumPeers; i++)
+    {
+        ShutdownPeer(sPeers[i]);
+    }
+
+    ShutdownPeerTestTool();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
@@ -0,0 +1,392 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test and benchmark for coalescing the messages
+ *      sent over a TCP WeaveConnection.
+ *
+ *      The tool's own Weave stack accepts a connection on the loopback
+ *      interface from a peer with a Weave stack of its own.  The test
+ *      checks that coalesced messages arrive whole and in order, and
+ *      that they are held back until the flush delay elapses, Flush()
+ *      or DisableCoalescing() is called, or the connection is closed.
+ *
+ *      The benchmark reports the cost per message of sending bursts of
+ *      small messages with and without coalescing.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Core/WeaveCore.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+// Test device 10 is the receiving end; test device 1 is the sending peer.
+static const uint64_t kServerNodeId = 0x18B430000000000AULL;
+static const uint64_t kPeerNodeId = 0x18B4300000000001ULL;
+static const uint32_t kFlushDelayMS = 200;
+static const uint16_t kMessageSize = 32;
+static const uint32_t kBenchmarkBursts = 2000;
+static const size_t kBurstSizes[] = { 1, 4, 16, 32 };
+
+// The sending peer.
+static TestPeer sPeer;
+static WeaveConnection *sCon;
+static WeaveConnection *sServerCon;
+
+static uint32_t sNumSent;
+static uint32_t sNumReceived;
+static bool sInOrder;
+static bool sConnected;
+static bool sServerClosed;
+static bool sDone;
+
+static void HandleServerMessageReceived(WeaveConnection *con, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
+{
+    uint32_t seq = 0;
+
+    if (msgBuf->DataLength() >= sizeof(seq))
+        memcpy(&seq, msgBuf->Start(), sizeof(seq));
+
+    if (seq != sNumReceived || msgBuf->DataLength() != kMessageSize)
+        sInOrder = false;
+
+    sNumReceived++;
+
+    PacketBuffer::Free(msgBuf);
+}
+
+static void HandleServerConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    sServerClosed = true;
+
+    if (con == sServerCon)
+        sServerCon = NULL;
+
+    con->Close();
+}
+
+static void HandleConnectionReceived(WeaveMessageLayer *msgLayer, WeaveConnection *con)
+{
+    con->OnMessageReceived = HandleServerMessageReceived;
+    con->OnConnectionClosed = HandleServerConnectionClosed;
+    sServerCon = con;
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    sConnected = (conErr == WEAVE_NO_ERROR);
+    sDone = true;
+}
+
+static WEAVE_ERROR SendTestMessage(void)
+{
+    WeaveMessageInfo msgInfo;
+    PacketBuffer *msgBuf = PacketBuffer::New();
+
+    if (msgBuf == NULL)
+        return WEAVE_ERROR_NO_MEMORY;
+
+    memset(msgBuf->Start(), 0x5A, kMessageSize);
+    memcpy(msgBuf->Start(), &sNumSent, sizeof(sNumSent));
+    msgBuf->SetDataLength(kMessageSize);
+
+    msgInfo.Clear();
+    msgInfo.MessageVersion = kWeaveMessageVersion_V1;
+    msgInfo.Flags = 0;
+    msgInfo.DestNodeId = kServerNodeId;
+    msgInfo.EncryptionType = kWeaveEncryptionType_None;
+    msgInfo.KeyId = WeaveKeyId::kNone;
+
+    sNumSent++;
+
+    return sCon->SendMessage(&msgInfo, msgBuf);
+}
+
+// Service the network until the given number of messages has been received, or the time limit passes.
+static void ServiceUntilReceived(uint32_t numMessages, uint32_t limitMS)
+{
+    const uint64_t start = System::Layer::GetClock_MonotonicMS();
+    struct timeval sleepTime;
+
+    sleepTime.tv_sec = 0;
+    sleepTime.tv_usec = 10000;
+
+    while (sNumReceived < numMessages && System::Layer::GetClock_MonotonicMS() - start < limitMS)
+        ServiceNetwork(sleepTime);
+}
+
+static void OpenConnection(nlTestSuite* inSuite)
+{
+    IPAddress serverAddr;
+    WEAVE_ERROR err;
+
+    sNumSent = 0;
+    sNumReceived = 0;
+    sInOrder = true;
+    sConnected = false;
+    sServerClosed = false;
+    sDone = false;
+    sServerCon = NULL;
+
+    sCon = sPeer.MessageLayer.NewConnection();
+    NL_TEST_ASSERT(inSuite, sCon != NULL);
+    if (sCon == NULL)
+        return;
+
+    IPAddress::FromString("::1", serverAddr);
+
+    sCon->OnConnectionComplete = HandleConnectionComplete;
+
+    err = sCon->Connect(kServerNodeId, kWeaveAuthMode_Unauthenticated, serverAddr, WEAVE_PORT);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    if (err == WEAVE_NO_ERROR)
+        ServiceNetworkUntil(&sDone, NULL);
+
+    NL_TEST_ASSERT(inSuite, sConnected);
+
+    // Let the listening side accept the connection too.
+    for (int i = 0; i < 100 && sServerCon == NULL; i++)
+        ServiceUntilReceived(1, 10);
+
+    NL_TEST_ASSERT(inSuite, sServerCon != NULL);
+}
+
+static void CloseConnection(void)
+{
+    if (sCon != NULL)
+    {
+        sCon->Close();
+        sCon = NULL;
+    }
+
+    // Wait for the listening side to see the close.
+    for (int i = 0; i < 100 && !sServerClosed; i++)
+        ServiceUntilReceived(UINT32_MAX, 10);
+}
+
+static void CheckDelivery(nlTestSuite* inSuite, void* inContext)
+{
+    WEAVE_ERROR err;
+
+    OpenConnection(inSuite);
+    VerifyOrExit(sConnected && sServerCon != NULL, );
+
+    err = sCon->EnableCoalescing(kFlushDelayMS);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // Messages are held back until the flush delay elapses.
+    for (int i = 0; i < 10; i++)
+    {
+        err = SendTestMessage();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    ServiceUntilReceived(UINT32_MAX, kFlushDelayMS / 4);
+    NL_TEST_ASSERT(inSuite, sNumReceived == 0);
+
+    ServiceUntilReceived(sNumSent, 5 * kFlushDelayMS);
+    NL_TEST_ASSERT(inSuite, sNumReceived == sNumSent);
+
+    // Flush() writes them out straight away.
+    for (int i = 0; i < 3; i++)
+        SendTestMessage();
+
+    err = sCon->Flush();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    ServiceUntilReceived(sNumSent, kFlushDelayMS / 4);
+    NL_TEST_ASSERT(inSuite, sNumReceived == sNumSent);
+
+    // More messages than fit in one buffer go out as each buffer fills.
+    for (int i = 0; i < 200; i++)
+        SendTestMessage();
+
+    ServiceUntilReceived(sNumSent - 10, kFlushDelayMS / 4);
+    NL_TEST_ASSERT(inSuite, sNumReceived >= sNumSent - 10);
+
+    // DisableCoalescing() writes out the rest.
+    err = sCon->DisableCoalescing();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    ServiceUntilReceived(sNumSent, kFlushDelayMS / 4);
+    NL_TEST_ASSERT(inSuite, sNumReceived == sNumSent);
+
+    // A graceful close delivers pending messages.
+    sCon->EnableCoalescing(kFlushDelayMS);
+
+    for (int i = 0; i < 5; i++)
+        SendTestMessage();
+
+    sCon->Close();
+    sCon = NULL;
+
+    ServiceUntilReceived(sNumSent, kFlushDelayMS / 4);
+    NL_TEST_ASSERT(inSuite, sNumReceived == sNumSent);
+
+    NL_TEST_ASSERT(inSuite, sInOrder);
+
+exit:
+    CloseConnection();
+}
+
+static double RunBursts(nlTestSuite* inSuite, size_t burst, bool coalesce)
+{
+    uint64_t start;
+    double elapsedUS;
+
+    OpenConnection(inSuite);
+    if (!sConnected || sServerCon == NULL)
+    {
+        CloseConnection();
+        return 0;
+    }
+
+    if (coalesce)
+        sCon->EnableCoalescing(0);
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+
+    // Send a burst, as a tunnel or subscription would when several messages become ready at once, then service the network
+    // until all of it has been received.
+    for (uint32_t i = 0; i < kBenchmarkBursts; i++)
+    {
+        for (size_t j = 0; j < burst; j++)
+            SendTestMessage();
+
+        ServiceUntilReceived(sNumSent, 1000);
+    }
+
+    elapsedUS = static_cast<double>(System::Layer::GetClock_MonotonicHiRes() - start);
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == kBenchmarkBursts * burst);
+    NL_TEST_ASSERT(inSuite, sInOrder);
+
+    CloseConnection();
+
+    return (elapsedUS * 1000.0) / (kBenchmarkBursts * burst);
+}
+
+static void CheckThroughput(nlTestSuite* inSuite, void* inContext)
+{
+    printf("\nTCP loopback, %u-byte messages\n", static_cast<unsigned int>(kMessageSize));
+    printf("%10s %12s %16s %16s\n", "burst", "messages", "plain ns/msg", "coalesced ns/msg");
+
+    for (size_t b = 0; b < sizeof(kBurstSizes) / sizeof(kBurstSizes[0]); b++)
+    {
+        const size_t burst = kBurstSizes[b];
+        const double plain = RunBursts(inSuite, burst, false);
+        const double coalesced = RunBursts(inSuite, burst, true);
+
+        printf("%10u %12u %16.1f %16.1f\n", static_cast<unsigned int>(burst),
+               static_cast<unsigned int>(kBenchmarkBursts * burst), plain, coalesced);
+    }
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("WeaveConnection::CheckDelivery",     CheckDelivery),
+    NL_TEST_DEF("WeaveConnection::CheckThroughput",   CheckThroughput),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-connection-coalescing",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    WEAVE_ERROR err;
+
+    InitPeerTestTool(kServerNodeId);
+
+    MessageLayer.OnConnectionReceived = HandleConnectionReceived;
+
+    // The peer sends over a bare connection, without an exchange manager.
+    err = sPeer.Init(kPeerNodeId, false);
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (err == WEAVE_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    sPeer.Shutdown();
+
+    ShutdownPeerTestTool();
+
+    return (SUCCESS);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+
+int main(int argc, char *argv[])
+{
+#if WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+#else // !WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+    return 0;
+#endif // !WEAVE_CONFIG_ENABLE_CONNECTION_COALESCING
+}
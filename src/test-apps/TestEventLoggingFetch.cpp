@@ -0,0 +1,438 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests and a benchmark for fetching
+ *      events from the in-memory event log with
+ *      LoggingManagement::FetchEventsSince, with or without the event
+ *      ID index (WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE).
+ *
+ *      The tests log events of mixed importance and size until the
+ *      buffers have wrapped several times, and check that fetches
+ *      starting at every stored event return the right events with
+ *      the right timestamps.  The benchmark fills large buffers and
+ *      has many subscribers each fetch a notification's worth of
+ *      events from its own position in the log.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include <SystemLayer/SystemClock.h>
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+    // for unit tests, the dummy critical section is sufficient.
+    void CriticalSectionEnter()
+    {
+        return;
+    }
+
+    void CriticalSectionExit()
+    {
+        return;
+    }
+} // Platform
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // Profiles
+} // Weave
+} // nl
+
+enum
+{
+    kNumImportances     = kImportanceType_Last,
+    kMaxEventsLogged    = 40000,
+    kMaxPayloadSize     = 120,
+    kNotificationSize   = 1024,
+    kNumSubscribers     = 64,
+    kBenchmarkRounds    = 20,
+};
+
+static const uint32_t kTestProfileId = 0x235A00AA;
+
+// Small buffers for the correctness checks, so that events wrap around and travel between buffers often.
+static uint64_t sSmallBuffers[kNumImportances][512];
+
+// Large buffers for the benchmark.
+static uint64_t sLargeBuffers[kNumImportances][8192];
+
+// Expected timestamp of every event logged, by importance and event ID.
+static uint64_t sTimestamps[kNumImportances][kMaxEventsLogged];
+static size_t sNumLogged[kNumImportances];
+
+static uint8_t sNotification[kNotificationSize];
+
+static void InitializeEventLogging(uint64_t * inBuffers, size_t inBufferSize)
+{
+    size_t sizes[kNumImportances];
+    void * buffers[kNumImportances];
+
+    // The first buffer takes the least important events.
+    for (size_t i = 0; i < kNumImportances; i++)
+    {
+        sizes[i]   = inBufferSize;
+        buffers[i] = inBuffers + i * inBufferSize / sizeof(uint64_t);
+        sNumLogged[i] = 0;
+    }
+
+    LoggingManagement::CreateLoggingManagement(NULL, kNumImportances, sizes, buffers, NULL, NULL, NULL);
+    LoggingConfiguration::GetInstance().mGlobalImportance = nl::Weave::Profiles::DataManagement::Debug;
+}
+
+static WEAVE_ERROR WritePayload(TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData)
+{
+    static const uint8_t payload[kMaxPayloadSize] = { 0 };
+    TLVType containerType;
+    WEAVE_ERROR err;
+
+    err = ioWriter.StartContainer(ContextTag(kTag_EventData), kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = ioWriter.PutBytes(ContextTag(1), payload, *static_cast<uint32_t *>(inAppData));
+    SuccessOrExit(err);
+
+    err = ioWriter.EndContainer(containerType);
+
+exit:
+    return err;
+}
+
+/**
+ *  Log an event of random size, mostly of lesser importance, and remember its timestamp.
+ */
+static event_id_t LogRandomEvent(nlTestSuite * inSuite, uint64_t & ioNow)
+{
+    const int pick            = rand() % 100;
+    ImportanceType importance = (pick < 50) ? nl::Weave::Profiles::DataManagement::Debug :
+                                (pick < 80) ? Info :
+                                (pick < 95) ? Production : ProductionCritical;
+    EventSchema schema        = { kTestProfileId, 1, importance, 1, 1 };
+    uint32_t payloadSize      = 4 + rand() % (kMaxPayloadSize - 4);
+    event_id_t eventId;
+
+    // Timestamps may go backwards as well as forwards.
+    ioNow += rand() % 1000;
+    ioNow -= rand() % 100;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    EventOptions options(static_cast<utc_timestamp_t>(ioNow));
+#else
+    EventOptions options(static_cast<timestamp_t>(ioNow));
+#endif
+
+    eventId = LogEvent(schema, WritePayload, &payloadSize, &options);
+
+    NL_TEST_ASSERT(inSuite, eventId < kMaxEventsLogged);
+    if (eventId < kMaxEventsLogged)
+    {
+        sTimestamps[importance - kImportanceType_First][eventId] = ioNow;
+        sNumLogged[importance - kImportanceType_First]++;
+    }
+
+    return eventId;
+}
+
+/**
+ *  Fetch a notification's worth of events starting at the given event, and check their IDs and timestamps.
+ */
+static void CheckFetch(nlTestSuite * inSuite, ImportanceType inImportance, event_id_t inStartingEventID)
+{
+    LoggingManagement & logger = LoggingManagement::GetInstance();
+    const event_id_t lastEventId = logger.GetLastEventID(inImportance);
+    event_id_t eventId = inStartingEventID;
+    event_id_t expectedEventId = inStartingEventID;
+    uint64_t timestamp = 0;
+    size_t numEvents = 0;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType containerType;
+    WEAVE_ERROR err;
+
+    writer.Init(sNotification, sizeof(sNotification));
+
+    err = logger.FetchEventsSince(writer, inImportance, eventId);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV || err == WEAVE_ERROR_NO_MEMORY || err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    reader.Init(sNotification, writer.GetLengthWritten());
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = reader.EnterContainer(containerType);
+        SuccessOrExit(err);
+
+        while ((err = reader.Next()) == WEAVE_NO_ERROR)
+        {
+            const uint64_t tag = reader.GetTag();
+
+            if (tag == ContextTag(kTag_EventID))
+            {
+                err = reader.Get(expectedEventId);
+                NL_TEST_ASSERT(inSuite, numEvents == 0 && expectedEventId == inStartingEventID);
+            }
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            else if (tag == ContextTag(kTag_EventUTCTimestamp))
+            {
+                err = reader.Get(timestamp);
+                NL_TEST_ASSERT(inSuite, numEvents == 0);
+            }
+            else if (tag == ContextTag(kTag_EventDeltaUTCTime))
+            {
+                int64_t delta;
+                err = reader.Get(delta);
+                timestamp += delta;
+            }
+#else
+            else if (tag == ContextTag(kTag_EventSystemTimestamp))
+            {
+                uint32_t systemTimestamp;
+                err = reader.Get(systemTimestamp);
+                timestamp = systemTimestamp;
+                NL_TEST_ASSERT(inSuite, numEvents == 0);
+            }
+            else if (tag == ContextTag(kTag_EventDeltaSystemTime))
+            {
+                int32_t delta;
+                err = reader.Get(delta);
+                timestamp = static_cast<uint32_t>(timestamp + delta);
+            }
+#endif
+            SuccessOrExit(err);
+        }
+
+        err = reader.ExitContainer(containerType);
+        SuccessOrExit(err);
+
+        NL_TEST_ASSERT(inSuite, expectedEventId <= lastEventId);
+        NL_TEST_ASSERT(inSuite, timestamp == sTimestamps[inImportance - kImportanceType_First][expectedEventId]);
+
+        expectedEventId++;
+        numEvents++;
+    }
+
+    // Every fetch makes progress, and the event ID returned follows the last event fetched.  Until an
+    // event of this importance is logged, the fetch has nothing to follow and returns the first event ID.
+    if (sNumLogged[inImportance - kImportanceType_First] > 0)
+    {
+        NL_TEST_ASSERT(inSuite, numEvents > 0 || inStartingEventID > lastEventId);
+        NL_TEST_ASSERT(inSuite, eventId == expectedEventId);
+    }
+    else
+    {
+        NL_TEST_ASSERT(inSuite, numEvents == 0 && eventId == logger.GetFirstEventID(inImportance));
+    }
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+}
+
+static void CheckAllFetches(nlTestSuite * inSuite)
+{
+    LoggingManagement & logger = LoggingManagement::GetInstance();
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        const ImportanceType importance = static_cast<ImportanceType>(i);
+        const event_id_t lastEventId = logger.GetLastEventID(importance);
+
+        for (event_id_t eventId = logger.GetFirstEventID(importance); eventId <= lastEventId + 1; eventId++)
+        {
+            CheckFetch(inSuite, importance, eventId);
+        }
+    }
+}
+
+static void CheckFetchWhileLogging(nlTestSuite * inSuite, void * inContext)
+{
+    uint64_t now = 1000000;
+
+    srand(1);
+    InitializeEventLogging(&sSmallBuffers[0][0], sizeof(sSmallBuffers[0]));
+
+    // Before anything is logged, fetches come back empty.
+    CheckAllFetches(inSuite);
+
+    // Check every stored event at frequent intervals, while the buffers wrap and events are dropped and promoted.
+    for (int i = 0; i < 4000; i++)
+    {
+        LogRandomEvent(inSuite, now);
+
+        if ((i < 200) || (i % 97 == 0))
+        {
+            CheckAllFetches(inSuite);
+        }
+    }
+
+    CheckAllFetches(inSuite);
+
+    LoggingManagement::DestroyLoggingManagement();
+}
+
+static void CheckFetchLargeBuffers(nlTestSuite * inSuite, void * inContext)
+{
+    uint64_t now = 1000000;
+
+    srand(2);
+    InitializeEventLogging(&sLargeBuffers[0][0], sizeof(sLargeBuffers[0]));
+
+    for (int i = 0; i < 20000; i++)
+    {
+        LogRandomEvent(inSuite, now);
+    }
+
+    CheckAllFetches(inSuite);
+
+    LoggingManagement::DestroyLoggingManagement();
+}
+
+static void CheckFetchPerf(nlTestSuite * inSuite, void * inContext)
+{
+    LoggingManagement & logger = LoggingManagement::GetInstance();
+    event_id_t positions[kNumSubscribers];
+    uint64_t now = 1000000;
+    uint64_t start, elapsed;
+    size_t numFetches;
+    TLVWriter writer;
+
+    srand(3);
+    InitializeEventLogging(&sLargeBuffers[0][0], sizeof(sLargeBuffers[0]));
+
+    for (int i = 0; i < 20000; i++)
+    {
+        LogRandomEvent(inSuite, now);
+    }
+
+#if WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE
+    printf("\nindexed (%u entries per buffer), ", static_cast<unsigned int>(WEAVE_CONFIG_EVENT_LOGGING_ID_INDEX_SIZE));
+#else
+    printf("\nunindexed, ");
+#endif
+    printf("%u bytes per buffer, %u subscribers, %u-byte notifications\n", static_cast<unsigned int>(sizeof(sLargeBuffers[0])),
+           static_cast<unsigned int>(kNumSubscribers), static_cast<unsigned int>(kNotificationSize));
+    printf("%-12s %10s %10s %14s\n", "importance", "events", "fetches", "us per fetch");
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        const ImportanceType importance = static_cast<ImportanceType>(i);
+        const event_id_t firstEventId = logger.GetFirstEventID(importance);
+        const event_id_t numEvents = logger.GetLastEventID(importance) - firstEventId + 1;
+
+        // Spread the subscribers out over the log; each one fetches from where it left off, and starts over once it has
+        // caught up.
+        for (size_t s = 0; s < kNumSubscribers; s++)
+        {
+            positions[s] = firstEventId + (numEvents * s) / kNumSubscribers;
+        }
+
+        numFetches = 0;
+        start = System::Layer::GetClock_MonotonicHiRes();
+
+        for (uint32_t round = 0; round < kBenchmarkRounds; round++)
+        {
+            for (size_t s = 0; s < kNumSubscribers; s++)
+            {
+                writer.Init(sNotification, sizeof(sNotification));
+                logger.FetchEventsSince(writer, importance, positions[s]);
+                numFetches++;
+
+                if (positions[s] > logger.GetLastEventID(importance))
+                {
+                    positions[s] = firstEventId;
+                }
+            }
+        }
+
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+        printf("%-12d %10u %10u %14.2f\n", i, static_cast<unsigned int>(numEvents), static_cast<unsigned int>(numFetches),
+               static_cast<double>(elapsed) / numFetches);
+    }
+
+    LoggingManagement::DestroyLoggingManagement();
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Fetch while logging",  CheckFetchWhileLogging),
+    NL_TEST_DEF("Fetch from large buffers",  CheckFetchLargeBuffers),
+    NL_TEST_DEF("Benchmark fetch",  CheckFetchPerf),
+
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    return 0;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void *inContext)
+{
+    return 0;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    nlTestSuite theSuite = {
+        "weave-event-logging-fetch",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,694 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests and a contention benchmark for
+ *      logging events from several threads at once, with or without
+ *      event staging (WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS and
+ *      LoggingManagement::EnableStaging()).
+ *
+ *      The tests have several application threads log events of
+ *      mixed importance, some too large to be staged, while a network
+ *      thread writes the staged events to the event buffers.  They
+ *      then check that every event ID was vended once, and that the
+ *      log holds every event under its ID, with its timestamp, and in
+ *      the order each thread logged it.  The benchmark reports the
+ *      time application threads spend in LogEvent() as their number
+ *      grows, while the network thread also fetches events from the
+ *      log; it is kept short, so that it can run with the other
+ *      checks.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <nlunit-test.h>
+
+#include <SystemLayer/SystemClock.h>
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+#include <Weave/Support/WeaveFaultInjection.h>
+
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+
+static pthread_mutex_t sCriticalSection = PTHREAD_MUTEX_INITIALIZER;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+    // the threads below log concurrently, so the critical section must be real.
+    void CriticalSectionEnter()
+    {
+        pthread_mutex_lock(&sCriticalSection);
+    }
+
+    void CriticalSectionExit()
+    {
+        pthread_mutex_unlock(&sCriticalSection);
+    }
+} // Platform
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // Profiles
+} // Weave
+} // nl
+
+enum
+{
+    kNumImportances      = kImportanceType_Last,
+    kMaxAppThreads       = 8,
+    kEventsPerThread     = 600,
+    kLargeEventInterval  = 40,
+    kSmallPayloadSize    = 8,
+    kLargePayloadSize    = 300,
+    kFetchBufferSize     = 2048,
+    kBenchmarkEvents     = 8000,
+    kDrainFailureEvents  = 4,
+};
+
+static const uint32_t kTestProfileId = 0x235A00AB;
+
+// Large enough that the correctness checks drop no events.
+static uint64_t sBuffers[kNumImportances][32768];
+
+// The thread and sequence number of every event logged, by importance and event ID.
+struct LoggedEvent
+{
+    volatile uint32_t mCount;
+    uint32_t mThread;
+    uint32_t mSequence;
+};
+
+static LoggedEvent sLogged[kNumImportances][kMaxAppThreads * kEventsPerThread];
+
+struct AppThread
+{
+    uint32_t mThread;
+    uint32_t mNumEvents;
+    bool mCheckEvents;
+    volatile uint32_t mNumErrors;
+    uint64_t mLogTime;    // Time spent in LogEvent(), in microseconds
+    uint64_t mMaxLogTime; // Longest LogEvent() call, in microseconds
+};
+
+static AppThread sAppThreads[kMaxAppThreads];
+static volatile bool sAppThreadsDone;
+
+// Whether the tests stage the events they log.
+static bool sStaging;
+
+static uint8_t sFetchBuffer[kFetchBufferSize];
+static uint8_t sNotification[kFetchBufferSize];
+
+struct Payload
+{
+    uint32_t mThread;
+    uint32_t mSequence;
+    uint32_t mPaddingSize;
+};
+
+static void InitializeEventLogging(void)
+{
+    size_t sizes[kNumImportances];
+    void * buffers[kNumImportances];
+
+    // The first buffer takes the least important events.
+    for (size_t i = 0; i < kNumImportances; i++)
+    {
+        sizes[i]   = sizeof(sBuffers[i]);
+        buffers[i] = &sBuffers[i][0];
+    }
+
+    memset(sLogged, 0, sizeof(sLogged));
+
+    LoggingManagement::CreateLoggingManagement(NULL, kNumImportances, sizes, buffers, NULL, NULL, NULL);
+    LoggingConfiguration::GetInstance().mGlobalImportance = nl::Weave::Profiles::DataManagement::Debug;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    if (sStaging)
+    {
+        LoggingManagement::GetInstance().EnableStaging();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+}
+
+static WEAVE_ERROR WritePayload(TLVWriter & ioWriter, uint8_t inDataTag, void * inAppData)
+{
+    static const uint8_t padding[kLargePayloadSize] = { 0 };
+    const Payload * payload = static_cast<const Payload *>(inAppData);
+    TLVType containerType;
+    WEAVE_ERROR err;
+
+    err = ioWriter.StartContainer(ContextTag(inDataTag), kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = ioWriter.Put(ContextTag(1), payload->mThread);
+    SuccessOrExit(err);
+
+    err = ioWriter.Put(ContextTag(2), payload->mSequence);
+    SuccessOrExit(err);
+
+    err = ioWriter.PutBytes(ContextTag(3), padding, payload->mPaddingSize);
+    SuccessOrExit(err);
+
+    err = ioWriter.EndContainer(containerType);
+
+exit:
+    return err;
+}
+
+// Each thread logs its events with timestamps derived from the thread and sequence number, so that the log can be checked
+// for the timestamp of every event.
+static uint64_t EventTimestamp(uint32_t inThread, uint32_t inSequence)
+{
+    return 1000000 + inThread * 7919 + inSequence * 13;
+}
+
+static void * AppThreadMain(void * inArg)
+{
+    AppThread * thread = static_cast<AppThread *>(inArg);
+    Payload payload;
+    event_id_t eventId;
+    uint64_t start, elapsed;
+    unsigned int seed = thread->mThread;
+
+    payload.mThread     = thread->mThread;
+    thread->mLogTime    = 0;
+    thread->mMaxLogTime = 0;
+
+    for (uint32_t i = 0; i < thread->mNumEvents; i++)
+    {
+        const int pick            = rand_r(&seed) % 100;
+        ImportanceType importance = (pick < 40) ? nl::Weave::Profiles::DataManagement::Debug :
+                                    (pick < 70) ? Info :
+                                    (pick < 90) ? Production : ProductionCritical;
+        EventSchema schema        = { kTestProfileId, 1, importance, 1, 1 };
+        const uint64_t timestamp  = EventTimestamp(thread->mThread, i);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        EventOptions options(static_cast<utc_timestamp_t>(timestamp));
+#else
+        EventOptions options(static_cast<timestamp_t>(timestamp));
+#endif
+
+        payload.mSequence    = i;
+        payload.mPaddingSize = (i % kLargeEventInterval == 0) ? kLargePayloadSize : kSmallPayloadSize;
+
+        start   = nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+        eventId = LogEvent(schema, WritePayload, &payload, &options);
+        elapsed = nl::Weave::System::Layer::GetClock_MonotonicHiRes() - start;
+
+        thread->mLogTime += elapsed;
+        if (elapsed > thread->mMaxLogTime)
+            thread->mMaxLogTime = elapsed;
+
+        if (!thread->mCheckEvents)
+            continue;
+
+        if (eventId < kMaxAppThreads * kEventsPerThread)
+        {
+            LoggedEvent & logged = sLogged[importance - kImportanceType_First][eventId];
+
+            logged.mThread   = thread->mThread;
+            logged.mSequence = i;
+
+            // Every event ID must be vended exactly once.
+            if (__sync_add_and_fetch(&logged.mCount, 1) != 1)
+                __sync_add_and_fetch(&thread->mNumErrors, 1);
+        }
+        else
+        {
+            __sync_add_and_fetch(&thread->mNumErrors, 1);
+        }
+    }
+
+    return NULL;
+}
+
+// Stands in for the Weave thread, which writes the staged events to the event buffers, and fetches events for a
+// subscriber.
+static void * NetworkThreadMain(void * inArg)
+{
+    LoggingManagement & logger = LoggingManagement::GetInstance();
+    event_id_t eventId         = 0;
+    TLVWriter writer;
+
+    while (!sAppThreadsDone)
+    {
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+        logger.DrainStagedEvents();
+#endif
+
+        writer.Init(sNotification, sizeof(sNotification));
+        if (logger.FetchEventsSince(writer, Info, eventId) == WEAVE_END_OF_TLV)
+        {
+            eventId = logger.GetFirstEventID(Info);
+        }
+
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+static void RunAppThreads(nlTestSuite * inSuite, size_t inNumThreads, uint32_t inNumEvents, bool inCheckEvents)
+{
+    pthread_t appThreads[kMaxAppThreads];
+    pthread_t networkThread;
+    size_t i;
+
+    sAppThreadsDone = false;
+
+    NL_TEST_ASSERT(inSuite, pthread_create(&networkThread, NULL, NetworkThreadMain, NULL) == 0);
+
+    for (i = 0; i < inNumThreads; i++)
+    {
+        sAppThreads[i].mThread      = i;
+        sAppThreads[i].mNumEvents   = inNumEvents;
+        sAppThreads[i].mCheckEvents = inCheckEvents;
+        sAppThreads[i].mNumErrors   = 0;
+        NL_TEST_ASSERT(inSuite, pthread_create(&appThreads[i], NULL, AppThreadMain, &sAppThreads[i]) == 0);
+    }
+
+    for (i = 0; i < inNumThreads; i++)
+    {
+        pthread_join(appThreads[i], NULL);
+        NL_TEST_ASSERT(inSuite, sAppThreads[i].mNumErrors == 0);
+    }
+
+    sAppThreadsDone = true;
+    pthread_join(networkThread, NULL);
+}
+
+/**
+ *  Read the events in a fetched notification, and check each against the event logged under its ID.
+ */
+static WEAVE_ERROR CheckFetchedEvents(nlTestSuite * inSuite, ImportanceType inImportance, event_id_t inStartingEventID,
+                                      size_t inLength, uint32_t * ioNextSequence, size_t & ioNumEvents)
+{
+    event_id_t eventId = inStartingEventID;
+    uint64_t timestamp = 0;
+    uint32_t thread    = UINT32_MAX;
+    uint32_t sequence  = UINT32_MAX;
+    TLVReader reader;
+    TLVType containerType;
+    TLVType dataContainerType;
+    WEAVE_ERROR err;
+
+    reader.Init(sFetchBuffer, inLength);
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = reader.EnterContainer(containerType);
+        SuccessOrExit(err);
+
+        while ((err = reader.Next()) == WEAVE_NO_ERROR)
+        {
+            const uint64_t tag = reader.GetTag();
+
+            if (tag == ContextTag(kTag_EventID))
+            {
+                err = reader.Get(eventId);
+                NL_TEST_ASSERT(inSuite, eventId == inStartingEventID);
+            }
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            else if (tag == ContextTag(kTag_EventUTCTimestamp))
+            {
+                err = reader.Get(timestamp);
+            }
+            else if (tag == ContextTag(kTag_EventDeltaUTCTime))
+            {
+                int64_t delta;
+                err = reader.Get(delta);
+                timestamp += delta;
+            }
+#else
+            else if (tag == ContextTag(kTag_EventSystemTimestamp))
+            {
+                uint32_t systemTimestamp;
+                err = reader.Get(systemTimestamp);
+                timestamp = systemTimestamp;
+            }
+            else if (tag == ContextTag(kTag_EventDeltaSystemTime))
+            {
+                int32_t delta;
+                err = reader.Get(delta);
+                timestamp = static_cast<uint32_t>(timestamp + delta);
+            }
+#endif
+            else if (tag == ContextTag(kTag_EventData))
+            {
+                err = reader.EnterContainer(dataContainerType);
+                SuccessOrExit(err);
+
+                while ((err = reader.Next()) == WEAVE_NO_ERROR)
+                {
+                    if (reader.GetTag() == ContextTag(1))
+                        err = reader.Get(thread);
+                    else if (reader.GetTag() == ContextTag(2))
+                        err = reader.Get(sequence);
+                    SuccessOrExit(err);
+                }
+
+                err = reader.ExitContainer(dataContainerType);
+            }
+            SuccessOrExit(err);
+        }
+
+        err = reader.ExitContainer(containerType);
+        SuccessOrExit(err);
+
+        {
+            const LoggedEvent & logged = sLogged[inImportance - kImportanceType_First][eventId];
+
+            NL_TEST_ASSERT(inSuite, logged.mCount == 1);
+            NL_TEST_ASSERT(inSuite, logged.mThread == thread && logged.mSequence == sequence);
+            NL_TEST_ASSERT(inSuite, timestamp == EventTimestamp(thread, sequence));
+
+            // Each thread's events appear in the order the thread logged them.
+            NL_TEST_ASSERT(inSuite, thread < kMaxAppThreads && sequence >= ioNextSequence[thread]);
+            if (thread < kMaxAppThreads)
+                ioNextSequence[thread] = sequence + 1;
+        }
+
+        eventId++;
+        ioNumEvents++;
+    }
+
+exit:
+    return err;
+}
+
+static void CheckLog(nlTestSuite * inSuite, size_t inNumThreads)
+{
+    LoggingManagement & logger = LoggingManagement::GetInstance();
+    size_t numEvents           = 0;
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        const ImportanceType importance = static_cast<ImportanceType>(i);
+        const event_id_t lastEventId    = logger.GetLastEventID(importance);
+        uint32_t nextSequence[kMaxAppThreads] = { 0 };
+        size_t numImportanceEvents            = 0;
+        event_id_t eventId                    = logger.GetFirstEventID(importance);
+        event_id_t startingEventId;
+        TLVWriter writer;
+        WEAVE_ERROR err;
+
+        // No events were dropped.
+        NL_TEST_ASSERT(inSuite, eventId == 0);
+
+        do
+        {
+            writer.Init(sFetchBuffer, sizeof(sFetchBuffer));
+            startingEventId = eventId;
+
+            err = logger.FetchEventsSince(writer, importance, eventId);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV || err == WEAVE_ERROR_NO_MEMORY || err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+            NL_TEST_ASSERT(inSuite,
+                           CheckFetchedEvents(inSuite, importance, startingEventId, writer.GetLengthWritten(), nextSequence,
+                                              numImportanceEvents) == WEAVE_END_OF_TLV);
+            NL_TEST_ASSERT(inSuite, eventId == numImportanceEvents);
+        } while ((err != WEAVE_END_OF_TLV) && (eventId != startingEventId));
+
+        // The log holds every event ID vended, consecutively.
+        NL_TEST_ASSERT(inSuite, numImportanceEvents == lastEventId + 1);
+        for (event_id_t id = 0; id <= lastEventId; id++)
+        {
+            NL_TEST_ASSERT(inSuite, sLogged[i - kImportanceType_First][id].mCount == 1);
+        }
+
+        numEvents += numImportanceEvents;
+    }
+
+    NL_TEST_ASSERT(inSuite, numEvents == inNumThreads * kEventsPerThread);
+}
+
+static void CheckConcurrentLogging(nlTestSuite * inSuite, void * inContext)
+{
+    InitializeEventLogging();
+
+    RunAppThreads(inSuite, kMaxAppThreads, kEventsPerThread, true);
+
+    CheckLog(inSuite, kMaxAppThreads);
+
+    LoggingManagement::DestroyLoggingManagement();
+}
+
+static void CheckLoggingWithoutNetworkThread(nlTestSuite * inSuite, void * inContext)
+{
+    InitializeEventLogging();
+
+    // Without a thread to write them, staged events fill the slots and the rest are written directly; fetching the events
+    // writes whatever is still staged.
+    sAppThreads[0].mThread      = 0;
+    sAppThreads[0].mNumEvents   = kEventsPerThread;
+    sAppThreads[0].mCheckEvents = true;
+    sAppThreads[0].mNumErrors   = 0;
+    AppThreadMain(&sAppThreads[0]);
+    NL_TEST_ASSERT(inSuite, sAppThreads[0].mNumErrors == 0);
+
+    CheckLog(inSuite, 1);
+
+    LoggingManagement::DestroyLoggingManagement();
+}
+
+static void CheckLoggingPerf(nlTestSuite * inSuite, void * inContext)
+{
+    static const size_t kThreadCounts[] = { 1, 2, 4, 8 };
+    uint64_t start, elapsed, logTime, maxLogTime;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    if (sStaging)
+        printf("\nstaged (%u slots per event ID space), ", static_cast<unsigned int>(WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS));
+    else
+#endif
+        printf("\ndirect, ");
+    printf("%u bytes per buffer, one large event in %u\n", static_cast<unsigned int>(sizeof(sBuffers[0])),
+           static_cast<unsigned int>(kLargeEventInterval));
+    printf("%-12s %10s %14s %16s %16s\n", "threads", "events", "ns per event", "ns per LogEvent", "longest LogEvent");
+
+    for (size_t i = 0; i < sizeof(kThreadCounts) / sizeof(kThreadCounts[0]); i++)
+    {
+        const uint32_t numEvents = kBenchmarkEvents / kThreadCounts[i];
+
+        InitializeEventLogging();
+
+        start = nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+        RunAppThreads(inSuite, kThreadCounts[i], numEvents, false);
+        elapsed = nl::Weave::System::Layer::GetClock_MonotonicHiRes() - start;
+
+        logTime    = 0;
+        maxLogTime = 0;
+        for (size_t t = 0; t < kThreadCounts[i]; t++)
+        {
+            logTime += sAppThreads[t].mLogTime;
+            if (sAppThreads[t].mMaxLogTime > maxLogTime)
+                maxLogTime = sAppThreads[t].mMaxLogTime;
+        }
+
+        printf("%-12u %10u %14.1f %16.1f %16u\n", static_cast<unsigned int>(kThreadCounts[i]),
+               static_cast<unsigned int>(numEvents * kThreadCounts[i]), (elapsed * 1000.0) / (numEvents * kThreadCounts[i]),
+               (logTime * 1000.0) / (numEvents * kThreadCounts[i]), static_cast<unsigned int>(maxLogTime * 1000));
+
+        LoggingManagement::DestroyLoggingManagement();
+    }
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+static void CheckConcurrentStagedLogging(nlTestSuite * inSuite, void * inContext)
+{
+    sStaging = true;
+    CheckConcurrentLogging(inSuite, inContext);
+    sStaging = false;
+}
+
+static void CheckStagedLoggingWithoutNetworkThread(nlTestSuite * inSuite, void * inContext)
+{
+    sStaging = true;
+    CheckLoggingWithoutNetworkThread(inSuite, inContext);
+    sStaging = false;
+}
+
+static void CheckStagedLoggingPerf(nlTestSuite * inSuite, void * inContext)
+{
+    sStaging = true;
+    CheckLoggingPerf(inSuite, inContext);
+    sStaging = false;
+}
+
+#if WEAVE_CONFIG_TEST && WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+static event_id_t LogDrainFailureEvent(uint32_t inSequence)
+{
+    const EventSchema schema = { kTestProfileId, 1, Info, 1, 1 };
+    Payload payload          = { 0, inSequence, kSmallPayloadSize };
+    event_id_t eventId;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    EventOptions options(static_cast<utc_timestamp_t>(EventTimestamp(0, inSequence)));
+#else
+    EventOptions options(static_cast<timestamp_t>(EventTimestamp(0, inSequence)));
+#endif
+
+    eventId = LogEvent(schema, WritePayload, &payload, &options);
+    if (eventId < kMaxAppThreads * kEventsPerThread)
+    {
+        LoggedEvent & logged = sLogged[Info - kImportanceType_First][eventId];
+
+        logged.mThread   = 0;
+        logged.mSequence = inSequence;
+        logged.mCount++;
+    }
+
+    return eventId;
+}
+
+/**
+ *  Fetch the Info events from inEventID up to the last one logged, and return the number fetched.
+ */
+static size_t FetchDrainFailureEvents(nlTestSuite * inSuite, event_id_t & ioEventID)
+{
+    LoggingManagement & logger            = LoggingManagement::GetInstance();
+    const event_id_t lastEventId          = logger.GetLastEventID(Info);
+    uint32_t nextSequence[kMaxAppThreads] = { 0 };
+    size_t numEvents                      = 0;
+    event_id_t startingEventId;
+    TLVWriter writer;
+    WEAVE_ERROR err;
+
+    do
+    {
+        writer.Init(sFetchBuffer, sizeof(sFetchBuffer));
+        startingEventId = ioEventID;
+
+        err = logger.FetchEventsSince(writer, Info, ioEventID);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+        NL_TEST_ASSERT(inSuite,
+                       CheckFetchedEvents(inSuite, Info, startingEventId, writer.GetLengthWritten(), nextSequence, numEvents) ==
+                           WEAVE_END_OF_TLV);
+    } while ((ioEventID <= lastEventId) && (ioEventID != startingEventId));
+
+    NL_TEST_ASSERT(inSuite, ioEventID == lastEventId + 1);
+
+    return numEvents;
+}
+
+static void CheckStagedEventDrainFailure(nlTestSuite * inSuite, void * inContext)
+{
+    event_id_t eventId = 0;
+
+    sStaging = true;
+    InitializeEventLogging();
+
+    // Without a network thread, the events stay staged until they are fetched.
+    for (uint32_t i = 0; i < kDrainFailureEvents; i++)
+    {
+        NL_TEST_ASSERT(inSuite, LogDrainFailureEvent(i) == i);
+    }
+
+    // Fail to write the second event as the events are drained.
+    nl::Weave::FaultInjection::GetManager().FailAtFault(nl::Weave::FaultInjection::kFault_WDM_StagedEventWrite, 1, 1);
+
+    // The event is lost, but its ID is not reused: every other event is fetched under the ID returned when it was logged.
+    NL_TEST_ASSERT(inSuite, FetchDrainFailureEvents(inSuite, eventId) == kDrainFailureEvents - 1);
+    NL_TEST_ASSERT(inSuite, LoggingManagement::GetInstance().GetLastEventID(Info) == kDrainFailureEvents - 1);
+
+    // Nor is it reused by the events logged after the failure.
+    NL_TEST_ASSERT(inSuite, LogDrainFailureEvent(kDrainFailureEvents) == kDrainFailureEvents);
+    NL_TEST_ASSERT(inSuite, FetchDrainFailureEvents(inSuite, eventId) == 1);
+
+    LoggingManagement::DestroyLoggingManagement();
+    sStaging = false;
+}
+#endif // WEAVE_CONFIG_TEST && WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Concurrent logging",  CheckConcurrentLogging),
+    NL_TEST_DEF("Logging without a network thread",  CheckLoggingWithoutNetworkThread),
+    NL_TEST_DEF("Benchmark concurrent logging",  CheckLoggingPerf),
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+    NL_TEST_DEF("Concurrent staged logging",  CheckConcurrentStagedLogging),
+    NL_TEST_DEF("Staged logging without a network thread",  CheckStagedLoggingWithoutNetworkThread),
+    NL_TEST_DEF("Benchmark concurrent staged logging",  CheckStagedLoggingPerf),
+#if WEAVE_CONFIG_TEST && WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    NL_TEST_DEF("Staged event that fails to drain",  CheckStagedEventDrainFailure),
+#endif
+#endif
+
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    return 0;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void *inContext)
+{
+    return 0;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    nlTestSuite theSuite = {
+        "weave-event-logging-staging",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,294 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a micro-benchmark for inbound message dispatch in
+ *      <tt>nl::Weave::WeaveExchangeManager</tt> with a large number of
+ *      live exchange contexts and unsolicited message handlers.
+ *
+ *      Messages are handed straight to the exchange manager, as the
+ *      message layer does once a message has been received and decoded,
+ *      and the cost per message is reported for messages that belong to
+ *      an existing exchange, for unsolicited messages that open a new
+ *      exchange, and for unsolicited messages that no handler accepts.
+ *
+ *      Build with large WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS and
+ *      WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS, with and without
+ *      WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX, to compare the exchange
+ *      indexes against scanning the pools.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Encoding;
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+static const uint32_t kFirstProfileId = 0x235A8000;
+static const uint64_t kFirstPeerNodeId = 0x18B4300000000001ULL;
+static const uint8_t kMsgType = 1;
+static const size_t kMessagesPerRun = 100000;
+
+static ExchangeContext* sContexts[WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS];
+static size_t sNumContexts;
+static size_t sNumHandlers;
+static size_t sNumReceived;
+static uint32_t sNextMessageId;
+
+static void HandleExchangeMessage(ExchangeContext* ec, const IPPacketInfo* pktInfo, const WeaveMessageInfo* msgInfo,
+                                  uint32_t profileId, uint8_t msgType, PacketBuffer* payload)
+{
+    sNumReceived++;
+    PacketBuffer::Free(payload);
+}
+
+static void HandleUnsolicitedMessage(ExchangeContext* ec, const IPPacketInfo* pktInfo, const WeaveMessageInfo* msgInfo,
+                                     uint32_t profileId, uint8_t msgType, PacketBuffer* payload)
+{
+    sNumReceived++;
+    PacketBuffer::Free(payload);
+    ec->Close();
+}
+
+static double NanosecondsPer(uint64_t aStartUS, size_t aCount)
+{
+    return ((System::Layer::GetClock_MonotonicHiRes() - aStartUS) * 1000.0) / aCount;
+}
+
+/**
+ *  Hand a message with an empty payload to the exchange manager, as if just received over UDP.
+ */
+static void DispatchMessage(uint64_t aSourceNodeId, uint32_t aProfileId, uint16_t aExchangeId, bool aFromInitiator)
+{
+    PacketBuffer* lBuffer = PacketBuffer::New();
+    WeaveMessageInfo lMsgInfo;
+    uint8_t* p;
+
+    if (lBuffer == NULL)
+        return;
+
+    p = lBuffer->Start();
+    Write8(p, (kWeaveExchangeVersion_V1 << 4) | (aFromInitiator ? kWeaveExchangeFlag_Initiator : 0));
+    Write8(p, kMsgType);
+    LittleEndian::Write16(p, aExchangeId);
+    LittleEndian::Write32(p, aProfileId);
+    lBuffer->SetDataLength(static_cast<uint16_t>(p - lBuffer->Start()));
+
+    lMsgInfo.Clear();
+    lMsgInfo.SourceNodeId = aSourceNodeId;
+    lMsgInfo.DestNodeId = FabricState.LocalNodeId;
+    lMsgInfo.MessageId = sNextMessageId++;
+    lMsgInfo.MessageVersion = kWeaveMessageVersion_V1;
+    lMsgInfo.EncryptionType = kWeaveEncryptionType_None;
+    lMsgInfo.KeyId = WeaveKeyId::kNone;
+
+    MessageLayer.OnMessageReceived(&MessageLayer, &lMsgInfo, lBuffer);
+}
+
+static void CheckSolicitedDispatch(nlTestSuite* inSuite, void* inContext)
+{
+    uint64_t lStart;
+    size_t i;
+
+    printf("\n%s\n", WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX ? "exchange index" : "exchange pool scan");
+
+    // Open as many exchanges as the pool holds, leaving one context for unsolicited messages.
+    for (i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 1; i++)
+    {
+        ExchangeContext* ec = ExchangeMgr.NewContext(kFirstPeerNodeId + i, IPAddress::Any, NULL);
+
+        if (ec == NULL)
+            break;
+
+        ec->OnMessageReceived = HandleExchangeMessage;
+        sContexts[i] = ec;
+    }
+
+    sNumContexts = i;
+    NL_TEST_ASSERT(inSuite, sNumContexts > 0);
+    if (sNumContexts == 0)
+        return;
+
+    // Register as many unsolicited message handlers as the pool holds, each for its own profile.
+    for (i = 0; ExchangeMgr.RegisterUnsolicitedMessageHandler(kFirstProfileId + i, HandleUnsolicitedMessage, NULL) == WEAVE_NO_ERROR; i++)
+        ;
+
+    sNumHandlers = i;
+    NL_TEST_ASSERT(inSuite, sNumHandlers > 0);
+
+    printf("%-28s %10u\n", "live exchange contexts", static_cast<unsigned int>(sNumContexts));
+    printf("%-28s %10u\n", "unsolicited msg handlers", static_cast<unsigned int>(sNumHandlers));
+
+    // Deliver responses to the open exchanges, round-robin.
+    sNumReceived = 0;
+    lStart = System::Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kMessagesPerRun; i++)
+    {
+        ExchangeContext* ec = sContexts[i % sNumContexts];
+
+        DispatchMessage(ec->PeerNodeId, kFirstProfileId, ec->ExchangeId, false);
+    }
+
+    printf("%-28s %10.1f ns/msg\n", "existing exchange", NanosecondsPer(lStart, kMessagesPerRun));
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == kMessagesPerRun);
+}
+
+static void CheckUnsolicitedDispatch(nlTestSuite* inSuite, void* inContext)
+{
+    uint64_t lStart;
+    size_t i;
+
+    if (sNumContexts == 0 || sNumHandlers == 0)
+        return;
+
+    // Deliver unsolicited messages for the most recently registered profile; each opens, and closes, an exchange.
+    sNumReceived = 0;
+    lStart = System::Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kMessagesPerRun; i++)
+    {
+        DispatchMessage(kFirstPeerNodeId + i % sNumContexts, kFirstProfileId + sNumHandlers - 1, static_cast<uint16_t>(i), true);
+    }
+
+    printf("%-28s %10.1f ns/msg\n", "unsolicited, handled", NanosecondsPer(lStart, kMessagesPerRun));
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == kMessagesPerRun);
+
+    // Deliver unsolicited messages for a profile no handler is registered for.
+    sNumReceived = 0;
+    lStart = System::Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kMessagesPerRun; i++)
+    {
+        DispatchMessage(kFirstPeerNodeId + i % sNumContexts, kFirstProfileId - 1, static_cast<uint16_t>(i), true);
+    }
+
+    printf("%-28s %10.1f ns/msg\n", "unsolicited, unhandled", NanosecondsPer(lStart, kMessagesPerRun));
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == 0);
+
+    for (i = 0; i < sNumHandlers; i++)
+    {
+        ExchangeMgr.UnregisterUnsolicitedMessageHandler(kFirstProfileId + i);
+    }
+
+    for (i = 0; i < sNumContexts; i++)
+    {
+        sContexts[i]->Close();
+    }
+
+    // Messages for the closed exchanges, and for the unregistered profiles, must no longer be delivered.
+    sNumReceived = 0;
+
+    for (i = 0; i < sNumContexts; i++)
+    {
+        DispatchMessage(sContexts[i]->PeerNodeId, kFirstProfileId, sContexts[i]->ExchangeId, false);
+        DispatchMessage(kFirstPeerNodeId + i, kFirstProfileId + i % sNumHandlers, static_cast<uint16_t>(i), true);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == 0);
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Exchange::BenchmarkSolicitedDispatch",     CheckSolicitedDispatch),
+    NL_TEST_DEF("Exchange::BenchmarkUnsolicitedDispatch",   CheckUnsolicitedDispatch),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-exchange-dispatch-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(false, true);
+
+    // Keep per-message logging out of the measurements.
+    nl::Weave::Logging::SetLogFilter(nl::Weave::Logging::kLogCategory_None);
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
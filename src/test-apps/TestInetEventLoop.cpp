@@ -0,0 +1,1019 @@
+/*
+ *
+ *    Copyright (c) 2016-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite and benchmark for the sockets event
+ *      loop of the InetLayer, i.e. <tt>PrepareSelect</tt> and
+ *      <tt>HandleSelectResult</tt>, in either its select() or its
+ *      edge-triggered epoll (WEAVE_SYSTEM_CONFIG_USE_EPOLL) form.
+ *
+ *      The benchmark reports the cost of delivering one datagram to
+ *      one of a growing number of open UDP endpoints. Build with and
+ *      without --enable-epoll to compare the two backends.
+ *
+ *      A second benchmark reports the cost per datagram of sending
+ *      bursts of datagrams over loopback, one SendTo() at a time or
+ *      with UDPEndPoint::SendMessages(), and receiving them. Build
+ *      with INET_CONFIG_UDP_RECV_BATCH_SIZE greater than 1 to compare
+ *      batched reception with recvmmsg() against one datagram per
+ *      recvmsg().
+ *
+ *      A third benchmark reports the cost per message of sending
+ *      bursts of small messages over a loopback TCP connection, which
+ *      TCPEndPoint gathers into one sendmsg() call per burst. Build
+ *      with INET_CONFIG_TCP_RECV_MAX_BUFFERS greater than 1 to read
+ *      each burst with readv() into several buffers at once; such a
+ *      build, TestInetEventLoopRecvBuffers, also checks that one read
+ *      fills the free space at the end of the receive queue and
+ *      chains several new buffers after it.
+ *
+ *      A fourth benchmark reports the packets per second read from a
+ *      loopback tun harness: UDP flows are routed out of a tunnel
+ *      interface opened with one or more queues, each its own
+ *      TunEndPoint. Build with INET_CONFIG_TUN_RECV_BATCH_SIZE greater
+ *      than 1 to read several packets each time a queue is serviced.
+ *      The benchmark is skipped unless the tun device can be opened.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <InetLayer/InetLayer.h>
+#include <SystemLayer/SystemLayer.h>
+#include <SystemLayer/SystemPacketBuffer.h>
+
+#include <Weave/Support/ErrorStr.h>
+
+#include <nlunit-test.h>
+
+using nl::ErrorStr;
+using namespace nl::Inet;
+using namespace nl::Weave::System;
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_IPV4
+
+// Test input vector format.
+
+struct TestContext {
+    Layer* mSystemLayer;
+    InetLayer* mInetLayer;
+    nlTestSuite* mTestSuite;
+};
+
+// Test input data.
+
+static struct TestContext sContext;
+
+static const uint16_t kBasePort             = 41000;
+static const uint32_t kBenchmarkEvents      = 20000;
+static const size_t kEndPointCounts[]       = { 1, 4, 16, 32, INET_CONFIG_NUM_UDP_ENDPOINTS };
+static const uint32_t kBenchmarkBursts      = 2000;
+static const size_t kBurstSizes[]           = { 1, 4, 16, 32 };
+static const uint16_t kTCPMessageSizes[]    = { 64, 512 };
+static const size_t kTCPBurstSizes[]        = { 1, 2, 4, 8 }; // Sender and receiver buffers must fit the packet buffer pool.
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+static const char kTunIntfName[]            = "weav-bench0";
+static const size_t kTunQueueCounts[]       = { 1, 2, 4 };
+static const size_t kTunMaxQueues           = 4;
+static const size_t kTunFlows               = 8;
+static const size_t kTunBurstSize           = 8;
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+static uint32_t sNumReceived;
+static uint32_t sNumBatches;
+static uint16_t sLastSrcPort;
+static uint32_t sNumTCPBytesReceived;
+static bool sTCPConnected;
+static TCPEndPoint* sAcceptedEndPoint;
+#if INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+static uint32_t sNumTCPReceives;
+static size_t sTCPReceiveChainLength;
+static bool sTCPReceiveIntact;
+#endif // INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+static uint32_t sNumTunPacketsReceived;
+static uint32_t sNumTunQueuesUsed;
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+static void ServiceEvents(TestContext& aContext, uint32_t aSleepMS)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+    struct timeval sleepTime;
+
+    sleepTime.tv_sec = aSleepMS / 1000;
+    sleepTime.tv_usec = (aSleepMS % 1000) * 1000;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    aContext.mSystemLayer->PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    aContext.mInetLayer->PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aContext.mSystemLayer->HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    aContext.mInetLayer->HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+static void HandleMessageReceived(IPEndPointBasis* aEndPoint, PacketBuffer* aMessage, const IPPacketInfo* aPacketInfo)
+{
+    sNumReceived++;
+    sLastSrcPort = aPacketInfo->SrcPort;
+    PacketBuffer::Free(aMessage);
+}
+
+static void HandleMessagesReceived(IPEndPointBasis* aEndPoint, PacketBuffer** aMessages, const IPPacketInfo* aPacketInfos,
+    size_t aCount)
+{
+    sNumBatches++;
+
+    for (size_t i = 0; i < aCount; i++)
+        HandleMessageReceived(aEndPoint, aMessages[i], &aPacketInfos[i]);
+}
+
+static size_t OpenEndPoints(TestContext& aContext, UDPEndPoint** aEndPoints, size_t aCount)
+{
+    IPAddress lLoopback;
+    size_t lOpened;
+
+    IPAddress::FromString("127.0.0.1", lLoopback);
+
+    for (lOpened = 0; lOpened < aCount; lOpened++)
+    {
+        UDPEndPoint* lEndPoint = NULL;
+
+        if (aContext.mInetLayer->NewUDPEndPoint(&lEndPoint) != INET_NO_ERROR)
+            break;
+
+        if (lEndPoint->Bind(kIPAddressType_IPv4, lLoopback, static_cast<uint16_t>(kBasePort + lOpened)) != INET_NO_ERROR)
+        {
+            lEndPoint->Free();
+            break;
+        }
+
+        lEndPoint->OnMessageReceived = HandleMessageReceived;
+        lEndPoint->Listen();
+
+        aEndPoints[lOpened] = lEndPoint;
+    }
+
+    return lOpened;
+}
+
+static void CloseEndPoints(UDPEndPoint** aEndPoints, size_t aCount)
+{
+    for (size_t i = 0; i < aCount; i++)
+        aEndPoints[i]->Free();
+}
+
+static int OpenSender(void)
+{
+    return socket(AF_INET, SOCK_DGRAM, 0);
+}
+
+static void SendDatagram(int aSocket, uint16_t aPort)
+{
+    static const uint8_t kPayload[32] = { 0 };
+    struct sockaddr_in lAddr;
+
+    memset(&lAddr, 0, sizeof(lAddr));
+    lAddr.sin_family = AF_INET;
+    lAddr.sin_port = htons(aPort);
+    lAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    sendto(aSocket, kPayload, sizeof(kPayload), 0, reinterpret_cast<struct sockaddr*>(&lAddr), sizeof(lAddr));
+}
+
+static void WaitForReceived(TestContext& aContext, uint32_t aExpected)
+{
+    for (uint32_t lSpins = 0; sNumReceived < aExpected && lSpins < 1000; lSpins++)
+        ServiceEvents(aContext, 10);
+}
+
+static void CheckUDPDelivery(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    UDPEndPoint* lEndPoints[INET_CONFIG_NUM_UDP_ENDPOINTS];
+    const size_t lCount = OpenEndPoints(lContext, lEndPoints, 8);
+    const int lSender = OpenSender();
+
+    NL_TEST_ASSERT(inSuite, lCount == 8);
+    NL_TEST_ASSERT(inSuite, lSender >= 0);
+
+    // Several datagrams queued on one socket must all be delivered, even though, with edge-triggered notification, only one edge
+    // is reported for them.
+    sNumReceived = 0;
+    for (size_t i = 0; i < lCount; i++)
+    {
+        SendDatagram(lSender, static_cast<uint16_t>(kBasePort + i));
+        SendDatagram(lSender, static_cast<uint16_t>(kBasePort + i));
+        SendDatagram(lSender, static_cast<uint16_t>(kBasePort + i));
+    }
+
+    WaitForReceived(lContext, 3 * lCount);
+    NL_TEST_ASSERT(inSuite, sNumReceived == 3 * lCount);
+
+    // Datagrams arriving while an endpoint has no receive handler must be delivered once it listens again with one.
+    lEndPoints[0]->OnMessageReceived = NULL;
+    SendDatagram(lSender, kBasePort);
+    ServiceEvents(lContext, 10);
+    ServiceEvents(lContext, 0);
+
+    sNumReceived = 0;
+    lEndPoints[0]->OnMessageReceived = HandleMessageReceived;
+    lEndPoints[0]->Listen();
+    WaitForReceived(lContext, 1);
+    NL_TEST_ASSERT(inSuite, sNumReceived == 1);
+
+    close(lSender);
+    CloseEndPoints(lEndPoints, lCount);
+}
+
+static UDPEndPoint* OpenSenderEndPoint(TestContext& aContext, uint16_t aPort)
+{
+    UDPEndPoint* lEndPoint = NULL;
+    IPAddress lLoopback;
+
+    IPAddress::FromString("127.0.0.1", lLoopback);
+
+    if (aContext.mInetLayer->NewUDPEndPoint(&lEndPoint) != INET_NO_ERROR)
+        return NULL;
+
+    if (lEndPoint->Bind(kIPAddressType_IPv4, lLoopback, aPort) != INET_NO_ERROR)
+    {
+        lEndPoint->Free();
+        return NULL;
+    }
+
+    return lEndPoint;
+}
+
+static void CheckUDPBatchDelivery(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    UDPEndPoint* lEndPoints[INET_CONFIG_NUM_UDP_ENDPOINTS];
+    const size_t lCount = OpenEndPoints(lContext, lEndPoints, 4);
+    const uint16_t lSenderPort = static_cast<uint16_t>(kBasePort + INET_CONFIG_NUM_UDP_ENDPOINTS);
+    UDPEndPoint* lSender = OpenSenderEndPoint(lContext, lSenderPort);
+    const size_t kPerEndPoint = 10;
+    IPPacketInfo lPacketInfos[4 * kPerEndPoint];
+    PacketBuffer* lMessages[4 * kPerEndPoint];
+    PacketBuffer* lBuffer = PacketBuffer::New(0);
+    INET_ERROR lError;
+
+    NL_TEST_ASSERT(inSuite, lCount == 4);
+    NL_TEST_ASSERT(inSuite, lSender != NULL);
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+
+    if (lCount != 4 || lSender == NULL || lBuffer == NULL)
+        goto exit;
+
+    memset(lBuffer->Start(), 0x5A, 64);
+    lBuffer->SetDataLength(64);
+
+    for (size_t i = 0; i < lCount; i++)
+        lEndPoints[i]->OnMessagesReceived = HandleMessagesReceived;
+
+    // Interleave the destinations, sending the same retained buffer to each.
+    for (size_t i = 0; i < lCount * kPerEndPoint; i++)
+    {
+        lPacketInfos[i].Clear();
+        IPAddress::FromString("127.0.0.1", lPacketInfos[i].DestAddress);
+        lPacketInfos[i].DestPort = static_cast<uint16_t>(kBasePort + (i % lCount));
+        lMessages[i] = lBuffer;
+    }
+
+    sNumReceived = 0;
+    sNumBatches = 0;
+    sLastSrcPort = 0;
+
+    lError = lSender->SendMessages(lPacketInfos, lMessages, lCount * kPerEndPoint, UDPEndPoint::kSendFlag_RetainBuffer);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+
+    WaitForReceived(lContext, lCount * kPerEndPoint);
+    NL_TEST_ASSERT(inSuite, sNumReceived == lCount * kPerEndPoint);
+    NL_TEST_ASSERT(inSuite, sLastSrcPort == lSenderPort);
+
+    // Messages are handed over in batches only when more than one datagram is read per system call.
+    NL_TEST_ASSERT(inSuite, (INET_CONFIG_UDP_RECV_BATCH_SIZE > 1) || sNumBatches == 0);
+    NL_TEST_ASSERT(inSuite, sNumBatches <= sNumReceived);
+
+    // A message that cannot be sent must not prevent the rest of the batch from being sent.
+    {
+        PacketBuffer* lChained = PacketBuffer::New(0);
+
+        NL_TEST_ASSERT(inSuite, lChained != NULL);
+
+        if (lChained != NULL)
+        {
+            lChained->SetDataLength(8);
+            lChained->AddToEnd(PacketBuffer::New(0));
+
+            lMessages[1] = lChained;
+
+            sNumReceived = 0;
+            lError = lSender->SendMessages(lPacketInfos, lMessages, 3, UDPEndPoint::kSendFlag_RetainBuffer);
+            NL_TEST_ASSERT(inSuite, lError == INET_ERROR_MESSAGE_TOO_LONG);
+
+            WaitForReceived(lContext, 2);
+            NL_TEST_ASSERT(inSuite, sNumReceived == 2);
+
+            PacketBuffer::Free(lChained);
+        }
+    }
+
+exit:
+    if (lBuffer != NULL)
+        PacketBuffer::Free(lBuffer);
+    if (lSender != NULL)
+        lSender->Free();
+    CloseEndPoints(lEndPoints, lCount);
+}
+
+static void HandleTCPDataReceived(TCPEndPoint* aEndPoint, PacketBuffer* aData)
+{
+    const uint16_t lLength = aData->TotalLength();
+
+    sNumTCPBytesReceived += lLength;
+    aEndPoint->AckReceive(lLength);
+    PacketBuffer::Free(aData);
+}
+
+static void HandleTCPConnectionReceived(TCPEndPoint* aListenEndPoint, TCPEndPoint* aEndPoint, const IPAddress& aPeerAddr,
+    uint16_t aPeerPort)
+{
+    aEndPoint->OnDataReceived = HandleTCPDataReceived;
+    sAcceptedEndPoint = aEndPoint;
+}
+
+static void HandleTCPConnectComplete(TCPEndPoint* aEndPoint, INET_ERROR aError)
+{
+    sTCPConnected = (aError == INET_NO_ERROR);
+}
+
+static void OpenTCPConnection(nlTestSuite* inSuite, TestContext& aContext, uint16_t aPort, TCPEndPoint*& aListenEndPoint,
+    TCPEndPoint*& aClientEndPoint)
+{
+    IPAddress lLoopback;
+    INET_ERROR lError;
+
+    IPAddress::FromString("127.0.0.1", lLoopback);
+
+    sTCPConnected = false;
+    sAcceptedEndPoint = NULL;
+    sNumTCPBytesReceived = 0;
+
+    lError = aContext.mInetLayer->NewTCPEndPoint(&aListenEndPoint);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+    lError = aListenEndPoint->Bind(kIPAddressType_IPv4, lLoopback, aPort, true);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+    aListenEndPoint->OnConnectionReceived = HandleTCPConnectionReceived;
+    lError = aListenEndPoint->Listen(1);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+
+    lError = aContext.mInetLayer->NewTCPEndPoint(&aClientEndPoint);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+    aClientEndPoint->OnConnectComplete = HandleTCPConnectComplete;
+    lError = aClientEndPoint->Connect(lLoopback, aPort);
+    NL_TEST_ASSERT(inSuite, lError == INET_NO_ERROR);
+
+    for (uint32_t lSpins = 0; (!sTCPConnected || sAcceptedEndPoint == NULL) && lSpins < 500; lSpins++)
+        ServiceEvents(aContext, 10);
+
+    NL_TEST_ASSERT(inSuite, sTCPConnected);
+    NL_TEST_ASSERT(inSuite, sAcceptedEndPoint != NULL);
+}
+
+static void CloseTCPConnection(TCPEndPoint* aListenEndPoint, TCPEndPoint* aClientEndPoint)
+{
+    aClientEndPoint->Free();
+    if (sAcceptedEndPoint != NULL)
+        sAcceptedEndPoint->Free();
+    aListenEndPoint->Free();
+}
+
+static void CheckTCPDelivery(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    TCPEndPoint* lListenEndPoint = NULL;
+    TCPEndPoint* lClientEndPoint = NULL;
+    const uint16_t kChunkSize = 1000;
+    const uint32_t kChunksPerBurst = 4;
+    const uint32_t kTotalSize = 64 * kChunksPerBurst * kChunkSize;
+
+    OpenTCPConnection(inSuite, lContext, kBasePort, lListenEndPoint, lClientEndPoint);
+
+    // Send in bursts of a few buffers, so that the transfer fits the packet buffer pool while still requiring both endpoints to be
+    // serviced many times over the life of the connection.
+    for (uint32_t lQueued = 0; lQueued < kTotalSize && sNumTCPBytesReceived == lQueued; )
+    {
+        for (uint32_t i = 0; i < kChunksPerBurst; i++, lQueued += kChunkSize)
+        {
+            PacketBuffer* lBuffer = PacketBuffer::New(0);
+
+            if (lBuffer == NULL)
+                break;
+
+            memset(lBuffer->Start(), 0xA5, kChunkSize);
+            lBuffer->SetDataLength(kChunkSize);
+            lClientEndPoint->Send(lBuffer, i == kChunksPerBurst - 1);
+        }
+
+        for (uint32_t lSpins = 0; sNumTCPBytesReceived < lQueued && lSpins < 500; lSpins++)
+            ServiceEvents(lContext, 10);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumTCPBytesReceived == kTotalSize);
+
+    CloseTCPConnection(lListenEndPoint, lClientEndPoint);
+}
+
+#if INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+
+// The value of the byte at the given offset into the stream sent by CheckTCPReceiveChaining.
+static uint8_t TCPStreamByte(uint32_t aOffset)
+{
+    return static_cast<uint8_t>(aOffset % 251);
+}
+
+// Check the whole of the receive queue, and then put it back, so that the next read starts in the free space at its end.
+static void HandleTCPDataHeld(TCPEndPoint* aEndPoint, PacketBuffer* aData)
+{
+    uint32_t lOffset = 0;
+
+    sNumTCPReceives++;
+    sNumTCPBytesReceived = aData->TotalLength();
+    sTCPReceiveChainLength = 0;
+    sTCPReceiveIntact = true;
+
+    for (PacketBuffer* lBuffer = aData; lBuffer != NULL; lBuffer = lBuffer->Next())
+    {
+        const uint8_t* lData = lBuffer->Start();
+
+        sTCPReceiveChainLength++;
+
+        for (uint16_t i = 0; i < lBuffer->DataLength(); i++, lOffset++)
+        {
+            if (lData[i] != TCPStreamByte(lOffset))
+                sTCPReceiveIntact = false;
+        }
+    }
+
+    aEndPoint->PutBackReceivedData(aData);
+}
+
+// Send the given number of bytes of the stream, in full buffers, pushing only the last.
+static void SendTCPStream(TCPEndPoint* aEndPoint, uint32_t& aOffset, uint32_t aLength)
+{
+    const uint32_t lEnd = aOffset + aLength;
+
+    while (aOffset < lEnd)
+    {
+        PacketBuffer* lBuffer = PacketBuffer::New(0);
+        uint16_t lLength;
+
+        if (lBuffer == NULL)
+            break;
+
+        lLength = lBuffer->AvailableDataLength();
+        if (lEnd - aOffset < lLength)
+            lLength = static_cast<uint16_t>(lEnd - aOffset);
+
+        for (uint16_t i = 0; i < lLength; i++)
+            lBuffer->Start()[i] = TCPStreamByte(aOffset + i);
+
+        lBuffer->SetDataLength(lLength);
+        aOffset += lLength;
+        aEndPoint->Send(lBuffer, aOffset == lEnd);
+    }
+}
+
+static void CheckTCPReceiveChaining(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    TCPEndPoint* lListenEndPoint = NULL;
+    TCPEndPoint* lClientEndPoint = NULL;
+    PacketBuffer* lBuffer;
+    uint16_t lBufferSize;
+    uint32_t lSent = 0;
+
+    lBuffer = PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+    if (lBuffer == NULL)
+        return;
+
+    lBufferSize = lBuffer->AvailableDataLength();
+    PacketBuffer::Free(lBuffer);
+
+    OpenTCPConnection(inSuite, lContext, static_cast<uint16_t>(kBasePort + 2), lListenEndPoint, lClientEndPoint);
+    if (sAcceptedEndPoint == NULL)
+        goto exit;
+
+    sAcceptedEndPoint->OnDataReceived = HandleTCPDataHeld;
+    sNumTCPReceives = 0;
+
+    // A burst that takes every buffer of one read, the last of them only half full, into an empty receive queue.
+    SendTCPStream(lClientEndPoint, lSent, (INET_CONFIG_TCP_RECV_MAX_BUFFERS - 1) * lBufferSize + lBufferSize / 2);
+
+    for (uint32_t lSpins = 0; sNumTCPBytesReceived < lSent && lSpins < 500; lSpins++)
+        ServiceEvents(lContext, 10);
+
+    NL_TEST_ASSERT(inSuite, sNumTCPReceives == 1);
+    NL_TEST_ASSERT(inSuite, sNumTCPBytesReceived == lSent);
+    NL_TEST_ASSERT(inSuite, sTCPReceiveChainLength == INET_CONFIG_TCP_RECV_MAX_BUFFERS);
+    NL_TEST_ASSERT(inSuite, sTCPReceiveIntact);
+
+    // A burst of one buffer's worth, which the next read splits between the free half of the tail buffer and a new buffer.
+    SendTCPStream(lClientEndPoint, lSent, lBufferSize);
+
+    for (uint32_t lSpins = 0; sNumTCPBytesReceived < lSent && lSpins < 500; lSpins++)
+        ServiceEvents(lContext, 10);
+
+    NL_TEST_ASSERT(inSuite, sNumTCPReceives == 2);
+    NL_TEST_ASSERT(inSuite, sNumTCPBytesReceived == lSent);
+    NL_TEST_ASSERT(inSuite, sTCPReceiveChainLength == INET_CONFIG_TCP_RECV_MAX_BUFFERS + 1);
+    NL_TEST_ASSERT(inSuite, sTCPReceiveIntact);
+
+exit:
+    CloseTCPConnection(lListenEndPoint, lClientEndPoint);
+}
+
+#endif // INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+
+static void CheckEventCost(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    UDPEndPoint* lEndPoints[INET_CONFIG_NUM_UDP_ENDPOINTS];
+    const int lSender = OpenSender();
+
+    NL_TEST_ASSERT(inSuite, lSender >= 0);
+
+    printf("\n%s backend\n", WEAVE_SYSTEM_CONFIG_USE_EPOLL ? "epoll" : "select");
+    printf("%10s %12s %14s\n", "endpoints", "events", "ns/event");
+
+    for (size_t c = 0; c < sizeof(kEndPointCounts) / sizeof(kEndPointCounts[0]); c++)
+    {
+        const size_t lCount = OpenEndPoints(lContext, lEndPoints, kEndPointCounts[c]);
+        uint64_t lStart, lElapsed;
+
+        if (lCount == 0)
+            continue;
+
+        sNumReceived = 0;
+        lStart = Layer::GetClock_MonotonicHiRes();
+
+        // Deliver one datagram at a time, round-robin across the open endpoints, so that each loop iteration services exactly one
+        // ready endpoint while all of the others are idle.
+        for (uint32_t i = 0; i < kBenchmarkEvents; i++)
+        {
+            SendDatagram(lSender, static_cast<uint16_t>(kBasePort + (i % lCount)));
+
+            while (sNumReceived <= i)
+                ServiceEvents(lContext, 100);
+        }
+
+        lElapsed = Layer::GetClock_MonotonicHiRes() - lStart;
+
+        NL_TEST_ASSERT(inSuite, sNumReceived == kBenchmarkEvents);
+
+        printf("%10u %12u %14.1f\n", static_cast<unsigned int>(lCount), static_cast<unsigned int>(kBenchmarkEvents),
+            (lElapsed * 1000.0) / kBenchmarkEvents);
+
+        CloseEndPoints(lEndPoints, lCount);
+
+        // Let any latched readiness for the closed endpoints drain.
+        ServiceEvents(lContext, 0);
+    }
+
+    close(lSender);
+}
+
+static void CheckUDPThroughput(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    UDPEndPoint* lReceiver;
+    UDPEndPoint* lSender = OpenSenderEndPoint(lContext, static_cast<uint16_t>(kBasePort + INET_CONFIG_NUM_UDP_ENDPOINTS));
+    const size_t lOpened = OpenEndPoints(lContext, &lReceiver, 1);
+    PacketBuffer* lBuffer = PacketBuffer::New(0);
+    IPPacketInfo lPacketInfos[32];
+    PacketBuffer* lMessages[32];
+
+    NL_TEST_ASSERT(inSuite, lSender != NULL);
+    NL_TEST_ASSERT(inSuite, lOpened == 1);
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+
+    if (lSender == NULL || lOpened != 1 || lBuffer == NULL)
+        goto exit;
+
+    memset(lBuffer->Start(), 0, 64);
+    lBuffer->SetDataLength(64);
+
+    for (size_t i = 0; i < 32; i++)
+    {
+        lPacketInfos[i].Clear();
+        IPAddress::FromString("127.0.0.1", lPacketInfos[i].DestAddress);
+        lPacketInfos[i].DestPort = kBasePort;
+        lMessages[i] = lBuffer;
+    }
+
+    printf("\nUDP loopback, 64-byte datagrams, receive batch size %u\n", static_cast<unsigned int>(INET_CONFIG_UDP_RECV_BATCH_SIZE));
+    printf("%10s %12s %18s %18s\n", "burst", "datagrams", "SendTo ns/dgram", "SendMessages ns/dgram");
+
+    for (size_t b = 0; b < sizeof(kBurstSizes) / sizeof(kBurstSizes[0]); b++)
+    {
+        const size_t lBurst = kBurstSizes[b];
+        const uint32_t lTotal = static_cast<uint32_t>(kBenchmarkBursts * lBurst);
+        double lNanoseconds[2];
+
+        for (int lBatched = 0; lBatched < 2; lBatched++)
+        {
+            uint64_t lStart;
+
+            sNumReceived = 0;
+            lStart = Layer::GetClock_MonotonicHiRes();
+
+            // Send a burst, then service the event loop until all of it has been received.
+            for (uint32_t i = 0; i < kBenchmarkBursts; i++)
+            {
+                if (lBatched)
+                {
+                    lSender->SendMessages(lPacketInfos, lMessages, lBurst, UDPEndPoint::kSendFlag_RetainBuffer);
+                }
+                else
+                {
+                    for (size_t j = 0; j < lBurst; j++)
+                        lSender->SendTo(lPacketInfos[j].DestAddress, kBasePort, lBuffer, UDPEndPoint::kSendFlag_RetainBuffer);
+                }
+
+                for (uint32_t lSpins = 0; sNumReceived < (i + 1) * lBurst && lSpins < 1000; lSpins++)
+                    ServiceEvents(lContext, 100);
+            }
+
+            lNanoseconds[lBatched] = ((Layer::GetClock_MonotonicHiRes() - lStart) * 1000.0) / lTotal;
+
+            NL_TEST_ASSERT(inSuite, sNumReceived == lTotal);
+        }
+
+        printf("%10u %12u %18.1f %18.1f\n", static_cast<unsigned int>(lBurst), static_cast<unsigned int>(lTotal), lNanoseconds[0],
+            lNanoseconds[1]);
+    }
+
+exit:
+    if (lBuffer != NULL)
+        PacketBuffer::Free(lBuffer);
+    if (lSender != NULL)
+        lSender->Free();
+    if (lOpened == 1)
+        CloseEndPoints(&lReceiver, 1);
+}
+
+static void CheckTCPThroughput(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    TCPEndPoint* lListenEndPoint = NULL;
+    TCPEndPoint* lClientEndPoint = NULL;
+
+    OpenTCPConnection(inSuite, lContext, static_cast<uint16_t>(kBasePort + 1), lListenEndPoint, lClientEndPoint);
+
+    printf("\nTCP loopback, send gather limit %u, receive buffers %u\n", static_cast<unsigned int>(INET_CONFIG_TCP_SEND_MAX_IOVECS),
+        static_cast<unsigned int>(INET_CONFIG_TCP_RECV_MAX_BUFFERS));
+    printf("%10s %10s %12s %14s %12s\n", "msg size", "burst", "messages", "ns/msg", "MB/s");
+
+    for (size_t m = 0; m < sizeof(kTCPMessageSizes) / sizeof(kTCPMessageSizes[0]) && sTCPConnected; m++)
+    {
+        const uint16_t lMessageSize = kTCPMessageSizes[m];
+
+        for (size_t b = 0; b < sizeof(kTCPBurstSizes) / sizeof(kTCPBurstSizes[0]); b++)
+        {
+            const size_t lBurst = kTCPBurstSizes[b];
+            const uint32_t lTotal = static_cast<uint32_t>(kBenchmarkBursts * lBurst);
+            uint32_t lExpected = sNumTCPBytesReceived;
+            uint64_t lStart, lElapsed;
+
+            lStart = Layer::GetClock_MonotonicHiRes();
+
+            // Queue a burst of messages, as a connection flushing its queued messages would, push it, and then service the event
+            // loop until all of it has been received.
+            for (uint32_t i = 0; i < kBenchmarkBursts; i++)
+            {
+                for (size_t j = 0; j < lBurst; j++)
+                {
+                    PacketBuffer* lBuffer = PacketBuffer::New(0);
+
+                    if (lBuffer == NULL)
+                        break;
+
+                    memset(lBuffer->Start(), 0x5A, lMessageSize);
+                    lBuffer->SetDataLength(lMessageSize);
+                    lClientEndPoint->Send(lBuffer, j == lBurst - 1);
+                    lExpected += lMessageSize;
+                }
+
+                for (uint32_t lSpins = 0; sNumTCPBytesReceived < lExpected && lSpins < 1000; lSpins++)
+                    ServiceEvents(lContext, 100);
+            }
+
+            lElapsed = Layer::GetClock_MonotonicHiRes() - lStart;
+
+            NL_TEST_ASSERT(inSuite, sNumTCPBytesReceived == lExpected);
+
+            printf("%10u %10u %12u %14.1f %12.1f\n", static_cast<unsigned int>(lMessageSize), static_cast<unsigned int>(lBurst),
+                static_cast<unsigned int>(lTotal), (lElapsed * 1000.0) / lTotal,
+                (static_cast<double>(lTotal) * lMessageSize) / (lElapsed ? lElapsed : 1));
+        }
+    }
+
+    CloseTCPConnection(lListenEndPoint, lClientEndPoint);
+}
+
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+// Defined here, rather than by including linux/ipv6.h, which clashes with netinet/in.h.
+struct TunBenchIn6IfReq
+{
+    struct in6_addr ifr6_addr;
+    uint32_t ifr6_prefixlen;
+    int ifr6_ifindex;
+};
+
+static void HandleTunPacketReceived(TunEndPoint* aEndPoint, PacketBuffer* aMessage)
+{
+    const uint8_t* lPacket = aMessage->Start();
+
+    // Count only the benchmark's UDP datagrams, not the router solicitations and the like the interface sends of its own accord.
+    if (aMessage->DataLength() >= 40 && lPacket[6] == IPPROTO_UDP)
+    {
+        sNumTunPacketsReceived++;
+        sNumTunQueuesUsed |= 1U << reinterpret_cast<uintptr_t>(aEndPoint->AppState);
+    }
+
+    PacketBuffer::Free(aMessage);
+}
+
+static bool AddTunAddress(InterfaceId aInterface, const char* aAddress)
+{
+    struct TunBenchIn6IfReq lReq;
+    int lSocket = socket(AF_INET6, SOCK_DGRAM, 0);
+    bool lAdded;
+
+    memset(&lReq, 0, sizeof(lReq));
+    inet_pton(AF_INET6, aAddress, &lReq.ifr6_addr);
+    lReq.ifr6_prefixlen = 64;
+    lReq.ifr6_ifindex = static_cast<int>(aInterface);
+
+    lAdded = (lSocket >= 0 && (ioctl(lSocket, SIOCSIFADDR, &lReq) == 0 || errno == EEXIST));
+
+    if (lSocket >= 0)
+        close(lSocket);
+
+    return lAdded;
+}
+
+static size_t OpenTunQueues(TestContext& aContext, TunEndPoint** aQueues, size_t aCount)
+{
+    size_t lOpened;
+
+    for (lOpened = 0; lOpened < aCount; lOpened++)
+    {
+        TunEndPoint* lQueue = NULL;
+
+        if (aContext.mInetLayer->NewTunEndPoint(&lQueue) != INET_NO_ERROR)
+            break;
+
+        lQueue->Init(aContext.mInetLayer);
+
+        if (lQueue->Open(kTunIntfName, true) != INET_NO_ERROR)
+        {
+            lQueue->Free();
+            break;
+        }
+
+        lQueue->OnPacketReceived = HandleTunPacketReceived;
+        lQueue->AppState = reinterpret_cast<void*>(static_cast<uintptr_t>(lOpened));
+
+        aQueues[lOpened] = lQueue;
+    }
+
+    return lOpened;
+}
+
+static void CloseTunQueues(TunEndPoint** aQueues, size_t aCount)
+{
+    for (size_t i = 0; i < aCount; i++)
+        aQueues[i]->Free();
+}
+
+static void CheckTunThroughput(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    static const uint8_t kPayload[32] = { 0 };
+    int lSenders[kTunFlows];
+    struct sockaddr_in6 lDest;
+
+    memset(&lDest, 0, sizeof(lDest));
+    lDest.sin6_family = AF_INET6;
+    lDest.sin6_port = htons(kBasePort);
+    inet_pton(AF_INET6, "fd00:0:0:b::2", &lDest.sin6_addr);
+
+    for (size_t f = 0; f < kTunFlows; f++)
+        lSenders[f] = socket(AF_INET6, SOCK_DGRAM, 0);
+
+    printf("\nTun loopback, 32-byte UDP datagrams in %u flows, receive batch size %u\n", static_cast<unsigned int>(kTunFlows),
+        static_cast<unsigned int>(INET_CONFIG_TUN_RECV_BATCH_SIZE));
+    printf("%10s %12s %14s %14s %12s\n", "queues", "packets", "ns/packet", "packets/s", "queues used");
+
+    for (size_t q = 0; q < sizeof(kTunQueueCounts) / sizeof(kTunQueueCounts[0]); q++)
+    {
+        const size_t lQueueCount = kTunQueueCounts[q];
+        const uint32_t lTotal = static_cast<uint32_t>(kBenchmarkBursts * kTunBurstSize);
+        TunEndPoint* lQueues[kTunMaxQueues];
+        const size_t lOpened = OpenTunQueues(lContext, lQueues, lQueueCount);
+        uint64_t lStart, lElapsed;
+        uint32_t lSent = 0;
+
+        if (lOpened != lQueueCount)
+        {
+            CloseTunQueues(lQueues, lOpened);
+
+            // Opening the very first queue needs the tun device and the privilege to use it.
+            if (q == 0)
+            {
+                printf("skipped: %s cannot be opened\n", INET_CONFIG_TUNNEL_DEVICE_NAME);
+                break;
+            }
+
+            NL_TEST_ASSERT(inSuite, lOpened == lQueueCount);
+            break;
+        }
+
+        NL_TEST_ASSERT(inSuite, lQueues[0]->InterfaceUp() == INET_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, AddTunAddress(lQueues[0]->GetTunnelInterfaceId(), "fd00:0:0:b::1"));
+
+        // Let the packets the interface sends on coming up drain before timing.
+        for (int i = 0; i < 10; i++)
+            ServiceEvents(lContext, 10);
+
+        sNumTunPacketsReceived = 0;
+        sNumTunQueuesUsed = 0;
+        lStart = Layer::GetClock_MonotonicHiRes();
+
+        // Route a burst of datagrams, spread over the flows, out of the interface, then service the event loop until the queues
+        // have read all of it.
+        for (uint32_t i = 0; i < kBenchmarkBursts; i++)
+        {
+            for (size_t j = 0; j < kTunBurstSize; j++)
+            {
+                const int lSender = lSenders[(i * kTunBurstSize + j) % kTunFlows];
+
+                if (sendto(lSender, kPayload, sizeof(kPayload), 0, reinterpret_cast<struct sockaddr*>(&lDest), sizeof(lDest)) > 0)
+                    lSent++;
+            }
+
+            for (uint32_t lSpins = 0; sNumTunPacketsReceived < lSent && lSpins < 1000; lSpins++)
+                ServiceEvents(lContext, 100);
+        }
+
+        lElapsed = Layer::GetClock_MonotonicHiRes() - lStart;
+
+        NL_TEST_ASSERT(inSuite, lSent == lTotal);
+        NL_TEST_ASSERT(inSuite, sNumTunPacketsReceived == lSent);
+
+        printf("%10u %12u %14.1f %14.0f %12u\n", static_cast<unsigned int>(lQueueCount), static_cast<unsigned int>(lSent),
+            (lElapsed * 1000.0) / (lSent ? lSent : 1), (sNumTunPacketsReceived * 1000000.0) / (lElapsed ? lElapsed : 1),
+            static_cast<unsigned int>(__builtin_popcount(sNumTunQueuesUsed)));
+
+        CloseTunQueues(lQueues, lOpened);
+
+        // Let any latched readiness for the closed queues drain.
+        ServiceEvents(lContext, 0);
+    }
+
+    for (size_t f = 0; f < kTunFlows; f++)
+    {
+        if (lSenders[f] >= 0)
+            close(lSenders[f]);
+    }
+}
+
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("EventLoop::TestUDPDelivery",         CheckUDPDelivery),
+    NL_TEST_DEF("EventLoop::TestUDPBatchDelivery",    CheckUDPBatchDelivery),
+    NL_TEST_DEF("EventLoop::TestTCPDelivery",         CheckTCPDelivery),
+#if INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+    NL_TEST_DEF("EventLoop::TestTCPReceiveChaining",  CheckTCPReceiveChaining),
+#endif // INET_CONFIG_TCP_RECV_MAX_BUFFERS > 1
+    NL_TEST_DEF("EventLoop::BenchmarkEventCost",      CheckEventCost),
+    NL_TEST_DEF("EventLoop::BenchmarkUDPThroughput",  CheckUDPThroughput),
+    NL_TEST_DEF("EventLoop::BenchmarkTCPThroughput",  CheckTCPThroughput),
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    NL_TEST_DEF("EventLoop::BenchmarkTunThroughput",  CheckTunThroughput),
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* aContext);
+static int TestTeardown(void* aContext);
+
+static nlTestSuite kTheSuite = {
+    "inet-event-loop",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* aContext)
+{
+    static Layer sSystemLayer;
+    static InetLayer sInetLayer;
+
+    TestContext& lContext = *reinterpret_cast<TestContext*>(aContext);
+
+    if (sSystemLayer.Init(NULL) != WEAVE_SYSTEM_NO_ERROR)
+        return (FAILURE);
+
+    if (sInetLayer.Init(sSystemLayer, NULL) != INET_NO_ERROR)
+        return (FAILURE);
+
+    lContext.mSystemLayer = &sSystemLayer;
+    lContext.mInetLayer = &sInetLayer;
+    lContext.mTestSuite = &kTheSuite;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* aContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(aContext);
+
+    lContext.mInetLayer->Shutdown();
+    lContext.mSystemLayer->Shutdown();
+
+    return (SUCCESS);
+}
+
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_IPV4
+
+int main(int argc, char *argv[])
+{
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_IPV4
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one lContext.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+#else // !(INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_IPV4)
+    return 0;
+#endif // !(INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_IPV4)
+}
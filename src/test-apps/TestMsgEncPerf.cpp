@@ -0,0 +1,663 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a micro-benchmark for Weave message encryption and
+ *      integrity checking with the AES128CTRSHA1 encryption type.
+ *
+ *      It reports the cost, per message and per payload byte, of
+ *      encoding (encrypt and MAC) and decoding (decrypt and verify)
+ *      small messages under a session key, and of AES-128-CTR alone.
+ *      It also checks that the cached HMAC-SHA1 and AES key schedules
+ *      produce the same output as keying the primitives directly, and
+ *      that CTR mode, including the bulk keystream path of the AES-NI
+ *      implementation, matches encrypting one counter block at a time.
+ *      Finally, it checks that WeaveMessageLayer::EncodeMessages() and
+ *      DecodeMessages() agree with the single-message functions, and
+ *      compares their cost per message against those functions.
+ *
+ *      Build with and without WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+ *      to compare cached key schedules against re-keying per message,
+ *      and with WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI to measure the
+ *      AES-NI implementation.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Support/crypto/AESBlockCipher.h>
+#include <Weave/Support/crypto/CTRMode.h>
+#include <Weave/Support/crypto/HMAC.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <SystemLayer/SystemLayer.h>
+
+using namespace nl::Weave;
+using namespace nl::Weave::Crypto;
+
+namespace nl {
+namespace Weave {
+
+class NL_DLL_EXPORT WeaveMessageLayerTestObject
+{
+public:
+    WeaveMessageLayer *msgLayer;
+
+    WEAVE_ERROR DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen)
+    {
+        return msgLayer->DecodeMessage(msgBuf, sourceNodeId, con, msgInfo, rPayload, rPayloadLen);
+    }
+};
+
+} // namespace nl
+} // namespace Weave
+
+// Test input data.
+
+struct TestContext {
+    nlTestSuite* mTestSuite;
+};
+
+static struct TestContext sContext;
+
+static const uint64_t kPeerNodeId = 0x18B4300000000042ULL;
+static const size_t kMessagesPerRun = 100000;
+static const uint16_t kPayloadLengths[] = { 16, 64, 128, 256, 512, 1024 };
+
+static const uint8_t sDataKey[] =
+{
+    0x5F, 0x3E, 0x21, 0x95, 0x0C, 0x6A, 0x87, 0xD2, 0x4B, 0x10, 0xE9, 0x73, 0xA6, 0x2D, 0xC8, 0x01
+};
+
+static const uint8_t sIntegrityKey[] =
+{
+    0x91, 0x7C, 0x03, 0xEE, 0x42, 0xB8, 0x5D, 0x16, 0xF0, 0x29, 0x8A, 0x64, 0xCD, 0x37, 0x0B, 0x9F,
+    0x58, 0xE1, 0x76, 0xA3
+};
+
+static uint16_t sSessionKeyId;
+static uint32_t sNextMessageId;
+static uint8_t sPayload[1024];
+static uint8_t sEncodedMsg[1024 + 64];
+
+static const size_t kBatchSize = 12;
+static PacketBuffer* sBatchBuffers[kBatchSize];
+static WeaveMessageInfo sBatchMsgInfos[kBatchSize];
+static WeaveMessageBatchEntry sBatch[kBatchSize];
+static uint8_t sEncodedBatch[kBatchSize][1024 + 64];
+static uint16_t sEncodedBatchLens[kBatchSize];
+
+static double NanosecondsPer(uint64_t aStartUS, size_t aCount)
+{
+    return ((System::Layer::GetClock_MonotonicHiRes() - aStartUS) * 1000.0) / aCount;
+}
+
+static double MegabytesPerSecond(double aNanosecondsPerMsg, uint16_t aPayloadLen)
+{
+    return (aPayloadLen * 1000.0) / aNanosecondsPerMsg;
+}
+
+/**
+ *  Fill a buffer with a payload, and a message info with the header of a message to the peer under the session key.
+ */
+static void PrepareMessage(PacketBuffer* aBuffer, WeaveMessageInfo& aMsgInfo, uint16_t aPayloadLen, uint32_t aMessageId)
+{
+    memcpy(aBuffer->Start(), sPayload, aPayloadLen);
+    aBuffer->SetDataLength(aPayloadLen);
+
+    aMsgInfo.Clear();
+    aMsgInfo.SourceNodeId = FabricState.LocalNodeId;
+    aMsgInfo.DestNodeId = kPeerNodeId;
+    aMsgInfo.MessageId = aMessageId;
+    aMsgInfo.KeyId = sSessionKeyId;
+    aMsgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+    aMsgInfo.MessageVersion = kWeaveMessageVersion_V2;
+    aMsgInfo.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+}
+
+static WEAVE_ERROR EncodeMessage(PacketBuffer* aBuffer, uint16_t aPayloadLen)
+{
+    WeaveMessageInfo lMsgInfo;
+
+    PrepareMessage(aBuffer, lMsgInfo, aPayloadLen, sNextMessageId++);
+
+    return MessageLayer.EncodeMessage(&lMsgInfo, aBuffer, NULL, UINT16_MAX, 0);
+}
+
+static void CheckKeySchedules(nlTestSuite* inSuite, void* inContext)
+{
+    uint8_t lExpected[HMACSHA1::kDigestLength];
+    uint8_t lActual[HMACSHA1::kDigestLength];
+    uint8_t lLongKey[100];
+    HMACSHA1 lHMAC;
+    HMACSHA1::KeySchedule lKeySchedule;
+    AES128CTRMode lCTR;
+    AES128CTRMode lKeyedCTR;
+    nl::Weave::Platform::Security::AES128BlockCipherEnc lCipher;
+
+    // An HMAC begun from a key schedule must match one begun from the raw key, and must be reusable.
+    for (int i = 0; i < 2; i++)
+    {
+        lHMAC.Begin(sIntegrityKey, sizeof(sIntegrityKey));
+        lHMAC.AddData(sPayload, sizeof(sPayload));
+        lHMAC.Finish(lExpected);
+
+        lKeySchedule.Init(sIntegrityKey, sizeof(sIntegrityKey));
+        lHMAC.Begin(lKeySchedule);
+        lHMAC.AddData(sPayload, sizeof(sPayload));
+        lHMAC.Finish(lActual);
+
+        NL_TEST_ASSERT(inSuite, memcmp(lExpected, lActual, sizeof(lExpected)) == 0);
+    }
+
+    // Keys longer than the hash block size are hashed first.
+    memset(lLongKey, 0xA5, sizeof(lLongKey));
+
+    lHMAC.Begin(lLongKey, sizeof(lLongKey));
+    lHMAC.AddData(sPayload, 64);
+    lHMAC.Finish(lExpected);
+
+    lKeySchedule.Init(lLongKey, sizeof(lLongKey));
+    lHMAC.Begin(lKeySchedule);
+    lHMAC.AddData(sPayload, 64);
+    lHMAC.Finish(lActual);
+
+    NL_TEST_ASSERT(inSuite, memcmp(lExpected, lActual, sizeof(lExpected)) == 0);
+
+    lKeySchedule.Reset();
+
+    // CTR mode keyed from an expanded block cipher must match CTR mode keyed from the raw key.
+    {
+        uint8_t lExpectedData[100];
+        uint8_t lActualData[100];
+
+        lCTR.SetKey(sDataKey);
+        lCTR.SetWeaveMessageCounter(kPeerNodeId, 1);
+        lCTR.EncryptData(sPayload, sizeof(lExpectedData), lExpectedData);
+
+        lCipher.SetKey(sDataKey);
+        lKeyedCTR.SetKey(lCipher);
+        lKeyedCTR.SetWeaveMessageCounter(kPeerNodeId, 1);
+        lKeyedCTR.EncryptData(sPayload, sizeof(lActualData), lActualData);
+
+        NL_TEST_ASSERT(inSuite, memcmp(lExpectedData, lActualData, sizeof(lExpectedData)) == 0);
+    }
+
+    lCTR.Reset();
+    lKeyedCTR.Reset();
+    lCipher.Reset();
+}
+
+static void CheckCTRKeystream(nlTestSuite* inSuite, void* inContext)
+{
+    static uint8_t sExpected[1024];
+    static uint8_t sActual[1024];
+    nl::Weave::Platform::Security::AES128BlockCipherEnc lCipher;
+    uint8_t lCounter[AES128CTRMode::kCounterLength];
+    uint8_t lKeystream[AES128CTRMode::kCounterLength];
+    uint64_t lStart;
+    double lNanoseconds;
+
+    lCipher.SetKey(sDataKey);
+
+    // Encrypting in arbitrarily split calls must match the keystream generated one counter block at a time.
+    for (uint16_t lLen = 0; lLen <= 300; lLen += 7)
+    {
+        for (uint16_t lSplit = 0; lSplit <= lLen; lSplit += 5)
+        {
+            AES128CTRMode lCTR;
+
+            // Start close to a carry out of the low byte of the block counter.
+            lCTR.SetKey(sDataKey);
+            lCTR.SetWeaveMessageCounter(kPeerNodeId, 1);
+            lCTR.Counter[sizeof(lCounter) - 1] = 0xFA;
+            memcpy(lCounter, lCTR.Counter, sizeof(lCounter));
+
+            for (uint16_t i = 0; i < lLen; i++)
+            {
+                if (i % sizeof(lCounter) == 0)
+                {
+                    lCipher.EncryptBlock(lCounter, lKeystream);
+                    for (int j = sizeof(lCounter) - 1; j >= 12 && ++lCounter[j] == 0; j--)
+                        ;
+                }
+                sExpected[i] = sPayload[i] ^ lKeystream[i % sizeof(lCounter)];
+            }
+
+            lCTR.EncryptData(sPayload, lSplit, sActual);
+            lCTR.EncryptData(sPayload + lSplit, lLen - lSplit, sActual + lSplit);
+
+            NL_TEST_ASSERT(inSuite, memcmp(sExpected, sActual, lLen) == 0);
+            NL_TEST_ASSERT(inSuite, memcmp(lCTR.Counter, lCounter, sizeof(lCounter)) == 0);
+        }
+    }
+
+    // Report raw CTR throughput, which bounds that of message encryption.
+    lStart = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kMessagesPerRun; i++)
+    {
+        AES128CTRMode lCTR;
+
+        lCTR.SetKey(lCipher);
+        lCTR.SetWeaveMessageCounter(kPeerNodeId, static_cast<uint32_t>(i));
+        lCTR.EncryptData(sPayload, sizeof(sPayload), sActual);
+    }
+
+    lNanoseconds = NanosecondsPer(lStart, kMessagesPerRun);
+
+    printf("\n%-28s %10.1f ns/msg %8.1f MB/s\n", "AES-128-CTR 1024 B", lNanoseconds,
+        MegabytesPerSecond(lNanoseconds, sizeof(sPayload)));
+
+    lCipher.Reset();
+}
+
+static void CheckEncodeDecodeCost(nlTestSuite* inSuite, void* inContext)
+{
+    WeaveMessageLayerTestObject lTestObject;
+    PacketBuffer* lBuffer;
+    uint64_t lStart;
+    double lNanoseconds;
+    size_t i, j;
+
+    printf("\n%s\n", WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES ? "cached key schedules" : "per-message key setup");
+
+    lBuffer = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+    if (lBuffer == NULL)
+        return;
+
+    lTestObject.msgLayer = &MessageLayer;
+
+    for (j = 0; j < sizeof(kPayloadLengths) / sizeof(kPayloadLengths[0]); j++)
+    {
+        const uint16_t kPayloadLen = kPayloadLengths[j];
+        WEAVE_ERROR lError = WEAVE_NO_ERROR;
+        uint16_t lEncodedLen;
+        char lLabel[32];
+
+        // Encrypt and MAC.
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kMessagesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            lError = EncodeMessage(lBuffer, kPayloadLen);
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kMessagesPerRun);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "encode %u B", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+
+        // Decrypt and verify the last encoded message, restoring it before each pass.
+        lEncodedLen = lBuffer->DataLength();
+        memcpy(sEncodedMsg, lBuffer->Start(), lEncodedLen);
+
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kMessagesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            WeaveMessageInfo lMsgInfo;
+            uint8_t* lPayload;
+            uint16_t lPayloadLen;
+
+            memcpy(lBuffer->Start(), sEncodedMsg, lEncodedLen);
+            lBuffer->SetDataLength(lEncodedLen);
+
+            lMsgInfo.Clear();
+            lError = lTestObject.DecodeMessage(lBuffer, FabricState.LocalNodeId, NULL, &lMsgInfo, &lPayload, &lPayloadLen);
+
+            if (lError == WEAVE_NO_ERROR && (lPayloadLen != kPayloadLen || memcmp(lPayload, sPayload, kPayloadLen) != 0))
+                lError = WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kMessagesPerRun);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "decode %u B", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+    }
+
+    PacketBuffer::Free(lBuffer);
+}
+
+/**
+ *  Point each batch entry at its buffer and message info.
+ */
+static void ResetBatch(size_t aCount)
+{
+    for (size_t i = 0; i < aCount; i++)
+    {
+        memset(&sBatch[i], 0, sizeof(sBatch[i]));
+        sBatch[i].MsgInfo = &sBatchMsgInfos[i];
+        sBatch[i].MsgBuf = sBatchBuffers[i];
+    }
+}
+
+/**
+ *  Restore the encoded messages saved in sEncodedBatch, ready to be decoded.
+ */
+static void RestoreEncodedBatch(size_t aCount)
+{
+    for (size_t i = 0; i < aCount; i++)
+    {
+        memcpy(sBatchBuffers[i]->Start(), sEncodedBatch[i], sEncodedBatchLens[i]);
+        sBatchBuffers[i]->SetDataLength(sEncodedBatchLens[i]);
+        sBatchMsgInfos[i].Clear();
+        sBatchMsgInfos[i].SourceNodeId = FabricState.LocalNodeId;
+    }
+}
+
+static void CheckBatchEncodeDecode(nlTestSuite* inSuite, void* inContext)
+{
+    // Payload lengths around the AES block size, plus a few longer ones.
+    static const uint16_t kLengths[] = { 1, 15, 16, 17, 64, 100, 1024, 33, 48, 250, 8 };
+    const size_t kCount = sizeof(kLengths) / sizeof(kLengths[0]);
+    PacketBuffer* lBuffer = PacketBuffer::New();
+    WEAVE_ERROR lError;
+    size_t i;
+
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+    if (lBuffer == NULL)
+        return;
+
+    // Batched encoding must produce the same messages as encoding them one at a time.
+    ResetBatch(kCount);
+    for (i = 0; i < kCount; i++)
+    {
+        PrepareMessage(sBatchBuffers[i], sBatchMsgInfos[i], kLengths[i], 0x1000 + i);
+    }
+
+    // Send one message in the clear, mixed in with the encrypted ones.
+    sBatchMsgInfos[5].KeyId = WeaveKeyId::kNone;
+    sBatchMsgInfos[5].EncryptionType = kWeaveEncryptionType_None;
+
+    lError = MessageLayer.EncodeMessages(sBatch, kCount);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    for (i = 0; i < kCount; i++)
+    {
+        WeaveMessageInfo lMsgInfo;
+
+        NL_TEST_ASSERT(inSuite, sBatch[i].Status == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, (sBatchMsgInfos[i].Flags & kWeaveMessageFlag_MessageEncoded) != 0);
+
+        PrepareMessage(lBuffer, lMsgInfo, kLengths[i], 0x1000 + i);
+        lMsgInfo.KeyId = sBatchMsgInfos[i].KeyId;
+        lMsgInfo.EncryptionType = sBatchMsgInfos[i].EncryptionType;
+        lError = MessageLayer.EncodeMessage(&lMsgInfo, lBuffer, NULL, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, lBuffer->DataLength() == sBatchBuffers[i]->DataLength());
+        NL_TEST_ASSERT(inSuite, memcmp(lBuffer->Start(), sBatchBuffers[i]->Start(), lBuffer->DataLength()) == 0);
+
+        sEncodedBatchLens[i] = sBatchBuffers[i]->DataLength();
+        memcpy(sEncodedBatch[i], sBatchBuffers[i]->Start(), sEncodedBatchLens[i]);
+    }
+
+    // Batched decoding must recover every payload.
+    RestoreEncodedBatch(kCount);
+    ResetBatch(kCount);
+
+    lError = MessageLayer.DecodeMessages(sBatch, kCount);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    for (i = 0; i < kCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sBatch[i].Status == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, sBatch[i].PayloadLen == kLengths[i]);
+        NL_TEST_ASSERT(inSuite, memcmp(sBatch[i].Payload, sPayload, kLengths[i]) == 0);
+        NL_TEST_ASSERT(inSuite, sBatchMsgInfos[i].MessageId == 0x1000 + i);
+    }
+
+    // A corrupted message fails on its own, and its status is the one returned for the batch.
+    RestoreEncodedBatch(kCount);
+    ResetBatch(kCount);
+    sBatchBuffers[9]->Start()[sEncodedBatchLens[9] - 1] ^= 0x01;
+
+    lError = MessageLayer.DecodeMessages(sBatch, kCount);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+
+    for (i = 0; i < kCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sBatch[i].Status == ((i == 9) ? WEAVE_ERROR_INTEGRITY_CHECK_FAILED : WEAVE_NO_ERROR));
+    }
+
+    PacketBuffer::Free(lBuffer);
+}
+
+static void CheckBatchCost(nlTestSuite* inSuite, void* inContext)
+{
+    WeaveMessageLayerTestObject lTestObject;
+    const size_t kBatchesPerRun = kMessagesPerRun / kBatchSize;
+    uint64_t lStart;
+    double lNanoseconds;
+    size_t i, j, k;
+
+    printf("\nper-message vs batched (%u messages per batch)\n", static_cast<unsigned int>(kBatchSize));
+
+    lTestObject.msgLayer = &MessageLayer;
+
+    for (j = 1; j < sizeof(kPayloadLengths) / sizeof(kPayloadLengths[0]); j++)
+    {
+        const uint16_t kPayloadLen = kPayloadLengths[j];
+        WEAVE_ERROR lError = WEAVE_NO_ERROR;
+        char lLabel[32];
+
+        // Encode one message at a time.
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kBatchesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            for (k = 0; k < kBatchSize && lError == WEAVE_NO_ERROR; k++)
+            {
+                PrepareMessage(sBatchBuffers[k], sBatchMsgInfos[k], kPayloadLen, sNextMessageId++);
+                lError = MessageLayer.EncodeMessage(&sBatchMsgInfos[k], sBatchBuffers[k], NULL, UINT16_MAX, 0);
+            }
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kBatchesPerRun * kBatchSize);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "encode %u B", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+
+        // Encode a batch at a time.
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kBatchesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            ResetBatch(kBatchSize);
+            for (k = 0; k < kBatchSize; k++)
+            {
+                PrepareMessage(sBatchBuffers[k], sBatchMsgInfos[k], kPayloadLen, sNextMessageId++);
+            }
+
+            lError = MessageLayer.EncodeMessages(sBatch, kBatchSize);
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kBatchesPerRun * kBatchSize);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "encode %u B, batched", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+
+        for (k = 0; k < kBatchSize; k++)
+        {
+            sEncodedBatchLens[k] = sBatchBuffers[k]->DataLength();
+            memcpy(sEncodedBatch[k], sBatchBuffers[k]->Start(), sEncodedBatchLens[k]);
+        }
+
+        // Decode one message at a time.
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kBatchesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            RestoreEncodedBatch(kBatchSize);
+
+            for (k = 0; k < kBatchSize && lError == WEAVE_NO_ERROR; k++)
+            {
+                uint8_t* lPayload;
+                uint16_t lPayloadLen;
+
+                lError = lTestObject.DecodeMessage(sBatchBuffers[k], FabricState.LocalNodeId, NULL, &sBatchMsgInfos[k], &lPayload, &lPayloadLen);
+            }
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kBatchesPerRun * kBatchSize);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "decode %u B", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+
+        // Decode a batch at a time.
+        lStart = System::Layer::GetClock_MonotonicHiRes();
+
+        for (i = 0; i < kBatchesPerRun && lError == WEAVE_NO_ERROR; i++)
+        {
+            RestoreEncodedBatch(kBatchSize);
+            ResetBatch(kBatchSize);
+
+            lError = MessageLayer.DecodeMessages(sBatch, kBatchSize);
+        }
+
+        lNanoseconds = NanosecondsPer(lStart, kBatchesPerRun * kBatchSize);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+        snprintf(lLabel, sizeof(lLabel), "decode %u B, batched", kPayloadLen);
+        printf("%-28s %10.1f ns/msg %8.1f MB/s\n", lLabel, lNanoseconds, MegabytesPerSecond(lNanoseconds, kPayloadLen));
+    }
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("MsgEnc::TestKeySchedules",           CheckKeySchedules),
+    NL_TEST_DEF("MsgEnc::TestCTRKeystream",           CheckCTRKeystream),
+    NL_TEST_DEF("MsgEnc::BenchmarkEncodeDecode",      CheckEncodeDecodeCost),
+    NL_TEST_DEF("MsgEnc::TestBatchEncodeDecode",      CheckBatchEncodeDecode),
+    NL_TEST_DEF("MsgEnc::BenchmarkBatch",             CheckBatchCost),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* inContext);
+static int TestTeardown(void* inContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-msg-enc-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* inContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(inContext);
+    WeaveSessionKey* lSessionKey;
+    WeaveEncryptionKey lEncKey;
+
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(false, true);
+
+    // Keep per-message logging out of the measurements.
+    nl::Weave::Logging::SetLogFilter(nl::Weave::Logging::kLogCategory_None);
+
+    // Establish a session key with the peer, as CASE would.
+    memcpy(lEncKey.AES128CTRSHA1.DataKey, sDataKey, sizeof(sDataKey));
+    memcpy(lEncKey.AES128CTRSHA1.IntegrityKey, sIntegrityKey, sizeof(sIntegrityKey));
+
+    sSessionKeyId = sTestDefaultSessionKeyId;
+    if (FabricState.AllocSessionKey(kPeerNodeId, sSessionKeyId, NULL, lSessionKey) != WEAVE_NO_ERROR)
+        return (FAILURE);
+
+    FabricState.SetSessionKey(lSessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &lEncKey);
+
+    // Install the same key for the local node, so that encoded messages can be decoded locally.
+    if (FabricState.AllocSessionKey(FabricState.LocalNodeId, sSessionKeyId, NULL, lSessionKey) != WEAVE_NO_ERROR)
+        return (FAILURE);
+
+    FabricState.SetSessionKey(lSessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &lEncKey);
+
+    for (size_t i = 0; i < sizeof(sPayload); i++)
+    {
+        sPayload[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        sBatchBuffers[i] = PacketBuffer::New();
+        if (sBatchBuffers[i] == NULL)
+            return (FAILURE);
+    }
+
+    lContext.mTestSuite = &kTheSuite;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* inContext)
+{
+    FabricState.RemoveSessionKey(sSessionKeyId, kPeerNodeId);
+    FabricState.RemoveSessionKey(sSessionKeyId, FabricState.LocalNodeId);
+
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        PacketBuffer::Free(sBatchBuffers[i]);
+        sBatchBuffers[i] = NULL;
+    }
+
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return (SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
@@ -137,7 +137,9 @@ static void BufferAlloc(struct TestContext* theContext)
     memset(theContext->buf, 0, lAllocSize);
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     theContext->buf->alloc_size = lAllocSize;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#elif WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    theContext->buf->alloc_size = WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX;
+#endif // WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     theContext->start_buffer = reinterpret_cast<uint8_t*>(theContext->buf);
@@ -1099,11 +1101,78 @@ static void CheckFreeHead(nlTestSuite *inSuite, void *inContext)
 }
 
 /**
- *  Test PacketBuffer::BuildFreeList() function.
+ *  Test PacketBuffer::RightSize() function.
+ *
+ *  Description: Build a short message in a full-size buffer and right-size it. When
+ *               the packet buffer pool has size classes, verify that the message moved,
+ *               with its reserved space and data intact, into a buffer of a smaller
+ *               class. Otherwise, verify that the buffer is returned unchanged. Finally,
+ *               verify that a chained buffer is never moved.
+ *
+ *               This must run before the pool is drained by other tests.
+ */
+static void CheckRightSize(nlTestSuite *inSuite, void *inContext)
+{
+    static const uint16_t kReservedSize = 16;
+    static const uint16_t kDataLength = 40;
+    PacketBuffer *buffer;
+    PacketBuffer *tail;
+    PacketBuffer *returned;
+
+    (void)inContext;
+
+    buffer = PacketBuffer::New(kReservedSize);
+    NL_TEST_ASSERT(inSuite, buffer != NULL);
+    if (buffer == NULL)
+        return;
+
+    for (uint16_t i = 0; i < kDataLength; i++)
+        buffer->Start()[i] = static_cast<uint8_t>(i);
+    buffer->SetDataLength(kDataLength);
+
+    returned = PacketBuffer::RightSize(buffer);
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    NL_TEST_ASSERT(inSuite, returned != buffer);
+    NL_TEST_ASSERT(inSuite, returned->AllocSize() < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+    NL_TEST_ASSERT(inSuite, returned->AllocSize() >= kReservedSize + kDataLength);
+    NL_TEST_ASSERT(inSuite, returned->ReservedSize() == kReservedSize);
+    NL_TEST_ASSERT(inSuite, returned->DataLength() == kDataLength);
+    NL_TEST_ASSERT(inSuite, returned->Next() == NULL);
+
+    for (uint16_t i = 0; i < kDataLength; i++)
+        NL_TEST_ASSERT(inSuite, returned->Start()[i] == static_cast<uint8_t>(i));
+#elif !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, returned == buffer);
+#endif
+
+    PacketBuffer::Free(returned);
+
+    buffer = PacketBuffer::New(kReservedSize);
+    tail = PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && tail != NULL);
+    if (buffer == NULL || tail == NULL)
+    {
+        PacketBuffer::Free(buffer);
+        PacketBuffer::Free(tail);
+        return;
+    }
+
+    buffer->AddToEnd(tail);
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, PacketBuffer::RightSize(buffer) == buffer);
+#endif
+
+    PacketBuffer::Free(buffer);
+}
+
+/**
+ *  Test PacketBuffer::BuildFreeLists() function.
  */
-static void CheckBuildFreeList(nlTestSuite *inSuite, void *inContext)
+static void CheckBuildFreeLists(nlTestSuite *inSuite, void *inContext)
 {
-    // BuildFreeList() is a private method called automatically.
+    // BuildFreeLists() is a private method called automatically.
     (void)inSuite;
     (void)inContext;
 }
@@ -1112,6 +1181,7 @@ static void CheckBuildFreeList(nlTestSuite *inSuite, void *inContext)
  *   Test Suite. It lists all the test functions.
  */
 static const nlTest sTests[] = {
+    NL_TEST_DEF("PacketBuffer::RightSize",                      CheckRightSize),
     NL_TEST_DEF("PacketBuffer::NewWithAvailableSize&PacketBuffer::Free", CheckNewWithAvailableSizeAndFree),
     NL_TEST_DEF("PacketBuffer::Start",                          CheckStart),
     NL_TEST_DEF("PacketBuffer::SetStart",                       CheckSetStart),
@@ -1132,7 +1202,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("PacketBuffer::AddRef",                         CheckAddRef),
     NL_TEST_DEF("PacketBuffer::Free",                           CheckFree),
     NL_TEST_DEF("PacketBuffer::FreeHead",                       CheckFreeHead),
-    NL_TEST_DEF("PacketBuffer::BuildFreeList",                  CheckBuildFreeList),
+    NL_TEST_DEF("PacketBuffer::BuildFreeLists",                 CheckBuildFreeLists),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,424 @@
+/*
+ *
+ *    Copyright (c) 2016-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a contention benchmark for the
+ *      <tt>nl::Weave::System::PacketBuffer</tt> pool allocator.
+ *
+ *      It reports the cost of allocating and freeing packet buffers
+ *      when several application threads build messages that a single
+ *      network thread frees, and when several threads each allocate
+ *      and free their own buffers, then checks that every pool buffer
+ *      is allocatable again once the threads have exited.
+ *
+ *      Build with WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC of at
+ *      least kMinPoolSize, with and without
+ *      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE, to compare the
+ *      per-thread magazines against the pool mutex.
+ *
+ *      It also reports the memory footprint of the pool under a mix of
+ *      short and long messages, held in flight until the pool runs out.
+ *      Build with and without WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+ *      and WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM, adjusting
+ *      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC for a similar pool
+ *      memory, to compare size classes against full-size buffers only.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <SystemLayer/SystemConfig.h>
+#include <SystemLayer/SystemLayer.h>
+#include <SystemLayer/SystemPacketBuffer.h>
+#include <SystemLayer/SystemStats.h>
+
+#include <nlunit-test.h>
+
+using namespace nl::Weave::System;
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+// Test input data.
+
+static const size_t kNumAppThreads = 3;
+static const size_t kQueueDepth = 16;
+static const size_t kBuffersPerThread = 200000;
+static const size_t kPairsHeld = 4;
+static const uint16_t kMessageLength = 64;
+
+// Buffers in flight plus, at most, a full magazine per thread.
+static const size_t kMinPoolSize = kNumAppThreads * (kQueueDepth + kPairsHeld) +
+    (kNumAppThreads + 1) * WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE;
+
+// Mixed traffic: message payload lengths and their relative frequencies.
+struct TrafficMix {
+    const char* mName;
+    uint16_t mLength;
+    uint8_t mWeight;
+};
+
+static const TrafficMix sTrafficMix[] = {
+    { "WRMP ack",           0, 6 },
+    { "status report",     16, 2 },
+    { "WDM notification", 320, 2 },
+    { "BDX block",       1024, 1 },
+};
+
+static const size_t kNumTrafficMix = sizeof(sTrafficMix) / sizeof(sTrafficMix[0]);
+
+// Memory statically reserved for the packet buffer pool, ignoring alignment padding.
+static const size_t kPoolMemory = WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC * WEAVE_SYSTEM_PACKETBUFFER_SIZE +
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL * (WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL) +
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM * (WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM);
+
+static const size_t kMaxPoolBuffers = WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL +
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM;
+
+// Single-producer, single-consumer ring carrying buffers from an application thread to the network thread.
+struct BufferQueue {
+    PacketBuffer* mSlots[kQueueDepth];
+    volatile size_t mHead;
+    volatile size_t mTail;
+};
+
+static BufferQueue sQueues[kNumAppThreads];
+static volatile size_t sNumAllocFailures;
+
+static double NanosecondsPer(uint64_t aStartUS, size_t aCount)
+{
+    return ((Layer::GetClock_MonotonicHiRes() - aStartUS) * 1000.0) / aCount;
+}
+
+static PacketBuffer* NewMessage(void)
+{
+    PacketBuffer* lBuffer;
+
+    while ((lBuffer = PacketBuffer::New()) == NULL)
+    {
+        __sync_fetch_and_add(&sNumAllocFailures, 1);
+        sched_yield();
+    }
+
+    memset(lBuffer->Start(), 0xA5, kMessageLength);
+    lBuffer->SetDataLength(kMessageLength);
+
+    return lBuffer;
+}
+
+static void* AppThreadMain(void* aArg)
+{
+    BufferQueue& lQueue = *static_cast<BufferQueue*>(aArg);
+
+    for (size_t i = 0; i < kBuffersPerThread; i++)
+    {
+        PacketBuffer* lBuffer = NewMessage();
+
+        while (lQueue.mHead - lQueue.mTail == kQueueDepth)
+            sched_yield();
+
+        lQueue.mSlots[lQueue.mHead % kQueueDepth] = lBuffer;
+        __sync_synchronize();
+        lQueue.mHead = lQueue.mHead + 1;
+    }
+
+    return NULL;
+}
+
+static void* NetworkThreadMain(void* aArg)
+{
+    size_t lRemaining = kNumAppThreads * kBuffersPerThread;
+
+    while (lRemaining > 0)
+    {
+        bool lIdle = true;
+
+        for (size_t i = 0; i < kNumAppThreads; i++)
+        {
+            BufferQueue& lQueue = sQueues[i];
+
+            while (lQueue.mTail != lQueue.mHead)
+            {
+                PacketBuffer* lBuffer = lQueue.mSlots[lQueue.mTail % kQueueDepth];
+
+                __sync_synchronize();
+                lQueue.mTail = lQueue.mTail + 1;
+
+                PacketBuffer::Free(lBuffer);
+                lRemaining--;
+                lIdle = false;
+            }
+        }
+
+        if (lIdle)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void* PairThreadMain(void* aArg)
+{
+    PacketBuffer* lHeld[kPairsHeld];
+
+    for (size_t i = 0; i < kBuffersPerThread; i += kPairsHeld)
+    {
+        for (size_t j = 0; j < kPairsHeld; j++)
+            lHeld[j] = NewMessage();
+
+        for (size_t j = 0; j < kPairsHeld; j++)
+            PacketBuffer::Free(lHeld[j]);
+    }
+
+    return NULL;
+}
+
+static void PrintConfiguration(void)
+{
+    static bool sPrinted;
+
+    if (sPrinted)
+        return;
+
+    if (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE)
+        printf("\nper-thread magazines of %u\n", static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE));
+    else
+        printf("\npool mutex\n");
+
+    sPrinted = true;
+}
+
+static bool CheckPoolSize(nlTestSuite* inSuite)
+{
+    PrintConfiguration();
+
+    if (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC < kMinPoolSize)
+    {
+        printf("%-28s skipped, pool of %u buffers is below %u\n", "benchmark",
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC), static_cast<unsigned int>(kMinPoolSize));
+        return false;
+    }
+
+    return true;
+}
+
+static void CheckNoBuffersInUse(nlTestSuite* inSuite)
+{
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    NL_TEST_ASSERT(inSuite, Stats::GetResourcesInUse()[Stats::kSystemLayer_NumPacketBufs] == 0);
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
+static void CheckProducerConsumer(nlTestSuite* inSuite, void* aContext)
+{
+    pthread_t lAppThreads[kNumAppThreads];
+    pthread_t lNetworkThread;
+    uint64_t lStart;
+    size_t i;
+
+    if (!CheckPoolSize(inSuite))
+        return;
+
+    memset(sQueues, 0, sizeof(sQueues));
+    sNumAllocFailures = 0;
+
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    NL_TEST_ASSERT(inSuite, pthread_create(&lNetworkThread, NULL, NetworkThreadMain, NULL) == 0);
+
+    for (i = 0; i < kNumAppThreads; i++)
+        NL_TEST_ASSERT(inSuite, pthread_create(&lAppThreads[i], NULL, AppThreadMain, &sQueues[i]) == 0);
+
+    for (i = 0; i < kNumAppThreads; i++)
+        pthread_join(lAppThreads[i], NULL);
+
+    pthread_join(lNetworkThread, NULL);
+
+    printf("%-28s %10.1f ns/buffer\n", "app New, network Free", NanosecondsPer(lStart, kNumAppThreads * kBuffersPerThread));
+    printf("%-28s %10u\n", "allocation failures", static_cast<unsigned int>(sNumAllocFailures));
+
+    CheckNoBuffersInUse(inSuite);
+}
+
+static void CheckThreadLocalPairs(nlTestSuite* inSuite, void* aContext)
+{
+    pthread_t lThreads[kNumAppThreads];
+    uint64_t lStart;
+    size_t i;
+
+    if (!CheckPoolSize(inSuite))
+        return;
+
+    sNumAllocFailures = 0;
+
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kNumAppThreads; i++)
+        NL_TEST_ASSERT(inSuite, pthread_create(&lThreads[i], NULL, PairThreadMain, NULL) == 0);
+
+    for (i = 0; i < kNumAppThreads; i++)
+        pthread_join(lThreads[i], NULL);
+
+    printf("%-28s %10.1f ns/buffer\n", "per-thread New and Free", NanosecondsPer(lStart, kNumAppThreads * kBuffersPerThread));
+    printf("%-28s %10u\n", "allocation failures", static_cast<unsigned int>(sNumAllocFailures));
+
+    CheckNoBuffersInUse(inSuite);
+}
+
+static void CheckPoolRecovered(nlTestSuite* inSuite, void* aContext)
+{
+    static PacketBuffer* sBuffers[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
+    size_t lNumAllocated = 0;
+
+    PrintConfiguration();
+
+    // The worker threads have exited, so any buffers left in their magazines must have been returned to the pool.
+    for (size_t i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+    {
+        sBuffers[i] = PacketBuffer::New();
+        if (sBuffers[i] != NULL)
+            lNumAllocated++;
+    }
+
+    printf("%-28s %10u of %u\n", "buffers allocatable", static_cast<unsigned int>(lNumAllocated),
+        static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC));
+
+    NL_TEST_ASSERT(inSuite, lNumAllocated == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC);
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    printf("%-28s %10d\n", "cached buffers (max)", Stats::GetHighWatermarks()[Stats::kSystemLayer_NumPacketBufsCached]);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAGAZINE_SIZE && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    for (size_t i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+        PacketBuffer::Free(sBuffers[i]);
+
+    CheckNoBuffersInUse(inSuite);
+}
+
+static void ReportMixedTrafficFootprint(nlTestSuite* inSuite, void* aContext)
+{
+    static PacketBuffer* sBuffers[kMaxPoolBuffers];
+    size_t lCounts[kNumTrafficMix] = { 0 };
+    size_t lNumHeld = 0;
+    size_t lPayloadBytes = 0;
+    size_t lBlockBytes = 0;
+    bool lExhausted = false;
+
+    PrintConfiguration();
+
+    // Hold messages in flight, interleaved according to their weights, until an allocation fails.
+    while (!lExhausted && lNumHeld < kMaxPoolBuffers)
+    {
+        for (size_t i = 0; i < kNumTrafficMix && !lExhausted; i++)
+        {
+            for (size_t j = 0; j < sTrafficMix[i].mWeight && lNumHeld < kMaxPoolBuffers; j++)
+            {
+                // Room for the message trailer (e.g. an encryption MIC), as WeaveMessageLayer::EncodeMessage needs.
+                PacketBuffer* lBuffer = PacketBuffer::NewWithAvailableSize(sTrafficMix[i].mLength + 20);
+
+                if (lBuffer == NULL)
+                {
+                    lExhausted = true;
+                    break;
+                }
+
+                sBuffers[lNumHeld++] = lBuffer;
+                lCounts[i]++;
+                lPayloadBytes += sTrafficMix[i].mLength;
+                lBlockBytes += WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + lBuffer->AllocSize();
+            }
+        }
+    }
+
+    if (WEAVE_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES)
+        printf("%-28s %u x %u, %u x %u, %u x %u bytes\n", "size classes",
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_SMALL),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MEDIUM),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX));
+    else
+        printf("%-28s %u x %u bytes\n", "full-size buffers only",
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC),
+            static_cast<unsigned int>(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX));
+
+    printf("%-28s %10u bytes\n", "pool memory", static_cast<unsigned int>(kPoolMemory));
+    printf("%-28s %10u\n", "messages in flight", static_cast<unsigned int>(lNumHeld));
+
+    for (size_t i = 0; i < kNumTrafficMix; i++)
+        printf("  %-26s %10u of %u bytes\n", sTrafficMix[i].mName, static_cast<unsigned int>(lCounts[i]),
+            static_cast<unsigned int>(sTrafficMix[i].mLength));
+
+    if (lNumHeld > 0)
+    {
+        printf("%-28s %10.1f bytes\n", "pool memory per message", static_cast<double>(kPoolMemory) / lNumHeld);
+        printf("%-28s %10.1f %%\n", "payload / occupied buffers", (100.0 * lPayloadBytes) / lBlockBytes);
+    }
+
+    NL_TEST_ASSERT(inSuite, lNumHeld > 0);
+
+    for (size_t i = 0; i < lNumHeld; i++)
+        PacketBuffer::Free(sBuffers[i]);
+
+    CheckNoBuffersInUse(inSuite);
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("PacketBuffer::BenchmarkProducerConsumer", CheckProducerConsumer),
+    NL_TEST_DEF("PacketBuffer::BenchmarkThreadLocalPairs", CheckThreadLocalPairs),
+    NL_TEST_DEF("PacketBuffer::TestPoolRecovered",         CheckPoolRecovered),
+    NL_TEST_DEF("PacketBuffer::ReportFootprint",           ReportMixedTrafficFootprint),
+    NL_TEST_SENTINEL()
+};
+
+static nlTestSuite kTheSuite = {
+    "weave-system-packetbuffer-perf",
+    &sTests[0],
+    NULL,
+    NULL
+};
+
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+int main(int argc, char *argv[])
+{
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&kTheSuite, NULL);
+
+    return nlTestRunnerStats(&kTheSuite);
+#else // WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+    return 0;
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+}
@@ -18,8 +18,8 @@
 
 /**
  *    @file
- *      This file implements unit tests for the TraiPathStore
- *      class.
+ *      This file implements unit tests and a benchmark for the
+ *      TraiPathStore class.
  *
  */
 
@@ -102,8 +102,17 @@ class TraitPathStoreTest {
         void TestFlags(nlTestSuite *inSuite, void *inContext);
         void TestInsertItem(nlTestSuite *inSuite, void *inContext);
         void TestSetFailedTrait(nlTestSuite *inSuite, void *inContext);
+        void TestPerTraitIteration(nlTestSuite *inSuite, void *inContext);
+        void TestBenchmark(nlTestSuite *inSuite, void *inContext);
 };
 
+enum {
+    kLargeStoreSize = 4096,
+    kNumLeafProperties = TestHTrait::kPropertyHandle_J - TestHTrait::kPropertyHandle_A + 1,
+};
+
+static TraitPathStore::Record sLargeStorage[kLargeStoreSize];
+
 TraitPathStoreTest::TraitPathStoreTest() :
             mTDH1(1), mTDH2(2), mSchemaEngine(&TestHTrait::TraitSchema)
 {
@@ -644,6 +653,146 @@ void TraitPathStoreTest::TestSetFailedTrait(nlTestSuite *inSuite, void *inContex
     mStore.Clear();
 }
 
+// Check that iterating over the items of one trait instance visits, in order, the valid items a scan of the whole store finds.
+static void CheckPerTraitIteration(nlTestSuite *inSuite, TraitPathStore &aStore, TraitDataHandle aNumTraits)
+{
+    for (TraitDataHandle tdh = 0; tdh < aNumTraits; tdh++)
+    {
+        size_t expected = 0;
+        size_t i = aStore.GetFirstValidItem(tdh);
+
+        while (true)
+        {
+            while (expected < aStore.GetPathStoreSize() &&
+                    !(aStore.IsItemValid(expected) && aStore.mStore[expected].mTraitPath.mTraitDataHandle == tdh))
+            {
+                expected++;
+            }
+
+            NL_TEST_ASSERT(inSuite, i == expected);
+            if (i != expected || i >= aStore.GetPathStoreSize())
+            {
+                break;
+            }
+
+            i = aStore.GetNextValidItem(i, tdh);
+            expected++;
+        }
+    }
+}
+
+void TraitPathStoreTest::TestPerTraitIteration(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitDataHandle numTraits = 40;
+    TraitPathStore store;
+    TraitPath tp;
+    size_t i;
+
+    store.Init(sLargeStorage, 300);
+
+    // Interleave adds, removals, failures, insertions and compaction, checking the per-trait iteration after each.
+    for (size_t round = 0; round < 200; round++)
+    {
+        tp.mTraitDataHandle = static_cast<TraitDataHandle>((round * 7) % numTraits);
+        tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_A + (round % kNumLeafProperties));
+
+        switch (round % 10)
+        {
+        case 3:
+            store.RemoveTrait(static_cast<TraitDataHandle>((round * 3) % numTraits));
+            break;
+
+        case 5:
+            store.SetFailedTrait(tp.mTraitDataHandle);
+            break;
+
+        case 7:
+            for (i = store.GetFirstValidItem(tp.mTraitDataHandle); i < store.GetPathStoreSize();
+                    i = store.GetNextValidItem(i, tp.mTraitDataHandle))
+            {
+                if (store.mStore[i].mTraitPath.mPropertyPathHandle != tp.mPropertyPathHandle)
+                {
+                    store.RemoveItemAt(i);
+                }
+            }
+            break;
+
+        case 9:
+            store.Compact();
+            store.InsertItemAt(round % (store.GetNumItems() + 1), tp, TraitPathStore::kFlag_None);
+            break;
+
+        default:
+            store.AddItemDedup(tp, mSchemaEngine);
+            store.AddItem(tp);
+            break;
+        }
+
+        CheckPerTraitIteration(inSuite, store, numTraits);
+
+        tp.mPropertyPathHandle = TestHTrait::kPropertyHandle_Root;
+        NL_TEST_ASSERT(inSuite, store.IsTraitPresent(tp.mTraitDataHandle) ==
+                (store.GetFirstValidItem(tp.mTraitDataHandle) < store.GetPathStoreSize()));
+    }
+}
+
+void TraitPathStoreTest::TestBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    const size_t storeSizes[] = { 256, 1024, kLargeStoreSize };
+    TraitPathStore store;
+    TraitPath tp;
+
+    printf("\n%8s %8s %14s %14s %14s\n", "paths", "traits", "dedup add us", "includes us", "remove us");
+
+    for (size_t s = 0; s < sizeof(storeSizes) / sizeof(storeSizes[0]); s++)
+    {
+        const TraitDataHandle numTraits = static_cast<TraitDataHandle>(storeSizes[s] / kNumLeafProperties);
+        const size_t numPaths = numTraits * kNumLeafProperties;
+        uint64_t start, addTime, includesTime, removeTime;
+        size_t numIncluded = 0;
+
+        store.Init(sLargeStorage, storeSizes[s]);
+
+        // Mark every leaf of every trait instance dirty, the way a large subscription would.
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (size_t p = 0; p < kNumLeafProperties; p++)
+        {
+            for (TraitDataHandle tdh = 0; tdh < numTraits; tdh++)
+            {
+                tp.mTraitDataHandle = tdh;
+                tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_A + p);
+                store.AddItemDedup(tp, mSchemaEngine);
+            }
+        }
+        addTime = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, store.GetNumItems() == numPaths);
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (TraitDataHandle tdh = 0; tdh < numTraits; tdh++)
+        {
+            tp.mTraitDataHandle = tdh;
+            tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_J);
+            numIncluded += store.Includes(tp, mSchemaEngine);
+            tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa);
+            numIncluded += store.Includes(tp, mSchemaEngine);
+        }
+        includesTime = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, numIncluded == numTraits);
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (TraitDataHandle tdh = 0; tdh < numTraits; tdh++)
+        {
+            store.RemoveTrait(tdh);
+        }
+        removeTime = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, store.IsEmpty());
+
+        printf("%8u %8u %14.2f %14.2f %14.2f\n", static_cast<unsigned int>(numPaths), static_cast<unsigned int>(numTraits),
+                static_cast<double>(addTime) / numPaths, static_cast<double>(includesTime) / (2 * numTraits),
+                static_cast<double>(removeTime) / numTraits);
+    }
+}
+
 } // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }
 }
@@ -720,6 +869,16 @@ void TraitPathStoreTest_SetFailedTrait(nlTestSuite *inSuite, void *inContext)
     gPathStoreTest.TestSetFailedTrait(inSuite, inContext);
 }
 
+void TraitPathStoreTest_PerTraitIteration(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestPerTraitIteration(inSuite, inContext);
+}
+
+void TraitPathStoreTest_Benchmark(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestBenchmark(inSuite, inContext);
+}
+
 // Test Suite
 
 /**
@@ -738,6 +897,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Flags",  TraitPathStoreTest_Flags),
     NL_TEST_DEF("InsertItem",  TraitPathStoreTest_InsertItem),
     NL_TEST_DEF("SetFailedTrait",  TraitPathStoreTest_SetFailedTrait),
+    NL_TEST_DEF("Per-trait iteration",  TraitPathStoreTest_PerTraitIteration),
+    NL_TEST_DEF("Benchmark",  TraitPathStoreTest_Benchmark),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a peer Weave node, run in the same process as
+ *      a test tool, for tests and benchmarks that exchange messages
+ *      between the tool's own Weave stack and that of the peer over the
+ *      loopback interface.
+ *
+ *      NOTE: These do not comprise a public part of the Weave API and
+ *            are subject to change without notice.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include "ToolCommon.h"
+#include "TestPeer.h"
+#include <Weave/Support/logging/WeaveLogging.h>
+
+using namespace nl::Weave;
+
+/**
+ *  Initialize the peer's stack, with the given node id on the tool's fabric.
+ *
+ *  @param[in] nodeId               The node id of the peer.
+ *  @param[in] initExchangeMgr      Whether to initialize an exchange manager on the peer's message layer.
+ */
+WEAVE_ERROR TestPeer::Init(uint64_t nodeId, bool initExchangeMgr)
+{
+    WeaveMessageLayer::InitContext initContext;
+    WEAVE_ERROR err;
+
+    err = FabricState.Init();
+    SuccessOrExit(err);
+
+    FabricState.FabricId = nl::Weave::FabricState.FabricId;
+    FabricState.LocalNodeId = nodeId;
+
+    initContext.systemLayer = &SystemLayer;
+    initContext.inet = &Inet;
+    initContext.fabricState = &FabricState;
+    initContext.listenTCP = false;
+    initContext.listenUDP = false;
+
+    err = MessageLayer.Init(&initContext);
+    SuccessOrExit(err);
+
+    if (initExchangeMgr)
+    {
+        err = ExchangeMgr.Init(&MessageLayer);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+void TestPeer::Shutdown(void)
+{
+    if (ExchangeMgr.State == WeaveExchangeManager::kState_Initialized)
+        ExchangeMgr.Shutdown();
+
+    MessageLayer.Shutdown();
+    FabricState.Shutdown();
+}
+
+/**
+ *  Initialize the peer's stack and a BDX node, allowed to run transfers, on its exchange manager.
+ */
+WEAVE_ERROR TestBdxPeer::Init(uint64_t nodeId)
+{
+    WEAVE_ERROR err;
+
+    err = TestPeer::Init(nodeId);
+    SuccessOrExit(err);
+
+    err = Node.Init(&ExchangeMgr);
+    SuccessOrExit(err);
+
+    Node.AllowBdxTransferToRun(true);
+
+exit:
+    return err;
+}
+
+void TestBdxPeer::Shutdown(void)
+{
+    Node.Shutdown();
+
+    TestPeer::Shutdown();
+}
+
+void TestPeerRun::Start(uint32_t numExpected)
+{
+    NumExpected = numExpected;
+    ToolDone = 0;
+    PeerDone = 0;
+    NumFailed = 0;
+    Done = false;
+}
+
+/**
+ *  Mark the run as over once both sides have finished every operation, or either has failed.
+ */
+void TestPeerRun::Update(void)
+{
+    Done = (ToolDone == NumExpected && PeerDone == NumExpected) || NumFailed != 0;
+}
+
+/**
+ *  Bring up the tool's own stack, listening on the loopback interface for its peers, and keep
+ *  per-message logging out of the measurements.
+ */
+void InitPeerTestTool(uint64_t localNodeId)
+{
+    gWeaveNodeOptions.LocalNodeId = localNodeId;
+
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(true, true);
+
+    nl::Weave::Logging::SetLogFilter(nl::Weave::Logging::kLogCategory_None);
+}
+
+void ShutdownPeerTestTool(void)
+{
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+}
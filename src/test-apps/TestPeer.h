@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a peer Weave node, run in the same process as a
+ *      test tool, for tests and benchmarks that exchange messages between
+ *      the tool's own Weave stack and that of the peer over the loopback
+ *      interface.
+ *
+ *      NOTE: These do not comprise a public part of the Weave API and
+ *            are subject to change without notice.
+ *
+ */
+
+#ifndef TESTPEER_H_
+#define TESTPEER_H_
+
+#include <stdint.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+
+/**
+ *  A peer with a Weave stack of its own, sharing the tool's system and Inet layers.
+ *
+ *  The peer only ever initiates connections; the tool's stack owns the listening endpoints.
+ */
+class TestPeer
+{
+public:
+    nl::Weave::WeaveFabricState FabricState;
+    nl::Weave::WeaveMessageLayer MessageLayer;
+    nl::Weave::WeaveExchangeManager ExchangeMgr;
+
+    WEAVE_ERROR Init(uint64_t nodeId, bool initExchangeMgr = true);
+    void Shutdown(void);
+};
+
+/**
+ *  A peer running a development BDX node on its exchange manager.
+ */
+class TestBdxPeer : public TestPeer
+{
+public:
+    nl::Weave::Profiles::BulkDataTransfer::BdxNode Node;
+
+    WEAVE_ERROR Init(uint64_t nodeId);
+    void Shutdown(void);
+};
+
+/**
+ *  The progress of a run in which the tool and its peer each finish the same number of operations.
+ */
+struct TestPeerRun
+{
+    uint32_t NumExpected;              /**< The number of operations each side is to finish. */
+    uint32_t ToolDone;                 /**< The number of operations finished by the tool. */
+    uint32_t PeerDone;                 /**< The number of operations finished by the peer. */
+    size_t NumFailed;                  /**< The number of failures on either side, any of which ends the run. */
+    bool Done;                         /**< Whether the run is over, for ServiceNetworkUntil(). */
+
+    void Start(uint32_t numExpected);
+    void Update(void);
+};
+
+extern void InitPeerTestTool(uint64_t localNodeId);
+extern void ShutdownPeerTestTool(void);
+
+#endif /* TESTPEER_H_ */
@@ -188,6 +188,59 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+static volatile bool sCancelledWorkRan;
+static volatile bool sWorkRan;
+
+void HandleCancelledWork(Layer* aLayer, void* aState, Error aError)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aState);
+    NL_TEST_ASSERT(lContext.mTestSuite, false);
+    sCancelledWorkRan = true;
+}
+
+void HandleWorkCancellingOther(Layer* aLayer, void* aState, Error aError)
+{
+    // The work scheduled after this one has been handed to the event loop by now, and must still be cancellable.
+    aLayer->CancelTimer(HandleCancelledWork, aState);
+    sWorkRan = true;
+}
+
+static void CheckCancelScheduledWork(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    struct timeval sleepTime;
+
+    sCancelledWorkRan = false;
+    sWorkRan = false;
+
+    // Cancel work before the event loop has seen it.
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleCancelledWork, aContext) == WEAVE_SYSTEM_NO_ERROR);
+    lSys.CancelTimer(HandleCancelledWork, aContext);
+
+    for (int i = 0; i < 3; i++)
+    {
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, !sCancelledWorkRan);
+
+    // Cancel work from a callback that runs just before it.
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleWorkCancellingOther, aContext) == WEAVE_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleCancelledWork, aContext) == WEAVE_SYSTEM_NO_ERROR);
+
+    for (int i = 0; i < 3; i++)
+    {
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sWorkRan);
+    NL_TEST_ASSERT(inSuite, !sCancelledWorkRan);
+}
 
 // Test Suite
 
@@ -198,6 +251,7 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
 static const nlTest sTests[] = {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+    NL_TEST_DEF("Timer::TestCancelScheduledWork",  CheckCancelScheduledWork),
     NL_TEST_SENTINEL()
 };
 
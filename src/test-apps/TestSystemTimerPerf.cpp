@@ -0,0 +1,319 @@
+/*
+ *
+ *    Copyright (c) 2016-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a micro-benchmark for <tt>nl::Weave::System::Timer</tt>
+ *      with a large number of live timers.
+ *
+ *      It reports the cost of arming, re-arming and cancelling timers
+ *      through the System Layer, and of an event loop iteration, while
+ *      as many timers as the timer pool allows (up to kMaxTimers) are
+ *      armed, then checks that a burst of short timers all expire, and
+ *      none early.
+ *
+ *      Build with WEAVE_SYSTEM_CONFIG_NUM_TIMERS of at least 10240,
+ *      with and without WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL, to compare
+ *      the timer wheel against scanning the timer pool.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <SystemLayer/SystemConfig.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#include <sys/select.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+#include <SystemLayer/SystemError.h>
+#include <SystemLayer/SystemLayer.h>
+#include <SystemLayer/SystemTimer.h>
+
+#include <Weave/Support/ErrorStr.h>
+
+#include <nlunit-test.h>
+
+using nl::ErrorStr;
+using namespace nl::Weave::System;
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+// Test input vector format.
+
+struct TestContext {
+    Layer* mLayer;
+    nlTestSuite* mTestSuite;
+};
+
+struct TimerState {
+    uint64_t mAwakenEpoch;
+    bool mFired;
+};
+
+// Test input data.
+
+static struct TestContext sContext;
+
+static const size_t kMaxTimers = 16384;
+static const uint32_t kLongDelayMin = 60 * 1000;
+static const uint32_t kLongDelaySpread = 3600 * 1000;
+static const uint32_t kShortDelaySpread = 500;
+static const size_t kLoopIterations = 1000;
+
+static TimerState sStates[kMaxTimers];
+static size_t sNumTimers;
+static size_t sNumFired;
+static size_t sNumEarly;
+
+static void ServiceEvents(Layer& aLayer, ::timeval& aSleepTime)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, aSleepTime);
+
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &aSleepTime);
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+static void HandleLongTimer(Layer* aLayer, void* aState, Error aError)
+{
+    static_cast<TimerState*>(aState)->mFired = true;
+}
+
+static void HandleShortTimer(Layer* aLayer, void* aState, Error aError)
+{
+    TimerState& lState = *static_cast<TimerState*>(aState);
+
+    if (Layer::GetClock_MonotonicMS() < lState.mAwakenEpoch)
+        sNumEarly++;
+
+    lState.mFired = true;
+    sNumFired++;
+}
+
+static uint32_t LongDelay(void)
+{
+    return kLongDelayMin + static_cast<uint32_t>(rand()) % kLongDelaySpread;
+}
+
+static double NanosecondsPer(uint64_t aStartUS, size_t aCount)
+{
+    return ((Layer::GetClock_MonotonicHiRes() - aStartUS) * 1000.0) / aCount;
+}
+
+static void CheckLiveTimerCost(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    uint64_t lStart;
+    size_t i;
+
+    srand(1);
+
+    printf("\n%s\n", WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL ? "timer wheel" : "timer pool scan");
+
+    // Arm as many long timers as the pool holds, none of which expire during the benchmark.
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kMaxTimers; i++)
+    {
+        if (lSys.StartTimer(LongDelay(), HandleLongTimer, &sStates[i]) != WEAVE_SYSTEM_NO_ERROR)
+            break;
+    }
+
+    sNumTimers = i;
+    NL_TEST_ASSERT(inSuite, sNumTimers > 0);
+    if (sNumTimers == 0)
+        return;
+
+    printf("%-28s %10u\n", "live timers", static_cast<unsigned int>(sNumTimers));
+    printf("%-28s %10.1f ns/op\n", "StartTimer (arm)", NanosecondsPer(lStart, sNumTimers));
+
+    // Re-arm timers at random, as retransmission and liveness timers are.
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < sNumTimers; i++)
+    {
+        const Error lError = lSys.StartTimer(LongDelay(), HandleLongTimer, &sStates[static_cast<size_t>(rand()) % sNumTimers]);
+
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    }
+
+    printf("%-28s %10.1f ns/op\n", "StartTimer (re-arm)", NanosecondsPer(lStart, sNumTimers));
+
+    // Run the event loop with nothing expiring.
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < kLoopIterations; i++)
+    {
+        fd_set readFDs, writeFDs, exceptFDs;
+        int numFDs = 0;
+        struct timeval lSleepTime = { 1, 0 };
+
+        FD_ZERO(&readFDs);
+        FD_ZERO(&writeFDs);
+        FD_ZERO(&exceptFDs);
+
+        lSys.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, lSleepTime);
+        FD_ZERO(&readFDs);
+        lSys.HandleSelectResult(0, &readFDs, &writeFDs, &exceptFDs);
+    }
+
+    printf("%-28s %10.1f ns/op\n", "event loop iteration", NanosecondsPer(lStart, kLoopIterations));
+
+    lStart = Layer::GetClock_MonotonicHiRes();
+
+    for (i = 0; i < sNumTimers; i++)
+    {
+        lSys.CancelTimer(HandleLongTimer, &sStates[i]);
+    }
+
+    printf("%-28s %10.1f ns/op\n", "CancelTimer", NanosecondsPer(lStart, sNumTimers));
+
+    for (i = 0; i < sNumTimers; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !sStates[i].mFired);
+    }
+}
+
+static void CheckExpiry(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    uint64_t lStart;
+    size_t i;
+
+    if (sNumTimers == 0)
+        return;
+
+    sNumFired = 0;
+    sNumEarly = 0;
+
+    // Arm a burst of short timers and let them all expire.
+    lStart = Layer::GetClock_MonotonicMS();
+
+    for (i = 0; i < sNumTimers; i++)
+    {
+        const uint32_t kDelay = static_cast<uint32_t>(rand()) % kShortDelaySpread;
+
+        sStates[i].mFired = false;
+        sStates[i].mAwakenEpoch = Layer::GetClock_MonotonicMS() + kDelay;
+        lSys.StartTimer(kDelay, HandleShortTimer, &sStates[i]);
+    }
+
+    while (sNumFired < sNumTimers && Layer::GetClock_MonotonicMS() - lStart < 10 * kShortDelaySpread)
+    {
+        struct timeval lSleepTime = { 0, 100000 };
+
+        ServiceEvents(lSys, lSleepTime);
+    }
+
+    printf("%-28s %10u in %u ms\n", "expired timers", static_cast<unsigned int>(sNumFired),
+        static_cast<unsigned int>(Layer::GetClock_MonotonicMS() - lStart));
+
+    NL_TEST_ASSERT(inSuite, sNumFired == sNumTimers);
+    NL_TEST_ASSERT(inSuite, sNumEarly == 0);
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Timer::BenchmarkLiveTimers",      CheckLiveTimerCost),
+    NL_TEST_DEF("Timer::TestExpiry",               CheckExpiry),
+    NL_TEST_SENTINEL()
+};
+
+static int TestSetup(void* aContext);
+static int TestTeardown(void* aContext);
+
+static nlTestSuite kTheSuite = {
+    "weave-system-timer-perf",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void* aContext)
+{
+    static Layer sLayer;
+
+    TestContext& lContext = *reinterpret_cast<TestContext*>(aContext);
+
+    if (sLayer.Init(NULL) != WEAVE_SYSTEM_NO_ERROR)
+        return (FAILURE);
+
+    lContext.mLayer = &sLayer;
+    lContext.mTestSuite = &kTheSuite;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void* aContext)
+{
+    TestContext& lContext = *reinterpret_cast<TestContext*>(aContext);
+
+    lContext.mLayer->Shutdown();
+
+    return (SUCCESS);
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+int main(int argc, char *argv[])
+{
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one lContext.
+    nlTestRunner(&kTheSuite, &sContext);
+
+    return nlTestRunnerStats(&kTheSuite);
+#else // !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    return 0;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+}
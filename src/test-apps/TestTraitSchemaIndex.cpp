@@ -0,0 +1,454 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests and a benchmark for the schema
+ *      tree index of the TraitSchemaEngine class
+ *      (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT).
+ *
+ *      The tests check that an engine with an index answers every
+ *      child, sibling, context tag, leaf and ancestor query exactly as the same
+ *      schema does without one.  The benchmark serializes and then
+ *      deserializes a whole trait of several hundred properties with
+ *      RetrieveData and StoreData, with and without the index.
+ *
+ */
+
+#include "ToolCommon.h"
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+#include <nest/test/trait/TestHTrait.h>
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+using namespace Schema::Nest::Test::Trait;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+    // for unit tests, the dummy critical section is sufficient.
+    void CriticalSectionEnter()
+    {
+        return;
+    }
+
+    void CriticalSectionExit()
+    {
+        return;
+    }
+} // Platform
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // Profiles
+} // Weave
+} // nl
+
+#if TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
+// The large trait: kNumTopLeaves leaves and kNumStructs structures at the top level, each structure holding kLeavesPerStruct
+// leaves. The leaves of odd structures are listed in descending tag order.
+enum
+{
+    kNumTopLeaves     = 200,
+    kNumStructs       = 4,
+    kLeavesPerStruct  = 50,
+    kNumProperties    = kNumTopLeaves + kNumStructs + kNumStructs * kLeavesPerStruct,
+    kMaxIndexEntries  = kNumProperties + 1,
+    kBenchmarkRounds  = 200,
+    kEncodedTraitSize = 8192
+};
+
+static TraitSchemaEngine::PropertyInfo sLargePropertyMap[kNumProperties];
+static TraitSchemaEngine::PropertyIndexEntry sIndexStorage[kMaxIndexEntries];
+static uint8_t sEncodedTrait[kEncodedTraitSize];
+
+static TraitSchemaEngine::Schema MakeLargeSchema(void)
+{
+    TraitSchemaEngine::Schema schema;
+    uint32_t i = 0;
+
+    for (uint32_t leaf = 0; leaf < kNumTopLeaves; leaf++, i++)
+    {
+        sLargePropertyMap[i].mParentHandle = kRootPropertyPathHandle;
+        sLargePropertyMap[i].mContextTag   = static_cast<uint8_t>(leaf + 1);
+    }
+
+    for (uint32_t s = 0; s < kNumStructs; s++, i++)
+    {
+        sLargePropertyMap[i].mParentHandle = kRootPropertyPathHandle;
+        sLargePropertyMap[i].mContextTag   = static_cast<uint8_t>(kNumTopLeaves + s + 1);
+    }
+
+    for (uint32_t s = 0; s < kNumStructs; s++)
+    {
+        const PropertySchemaHandle structHandle = static_cast<PropertySchemaHandle>(kNumTopLeaves + s + TraitSchemaEngine::kHandleTableOffset);
+
+        for (uint32_t leaf = 0; leaf < kLeavesPerStruct; leaf++, i++)
+        {
+            sLargePropertyMap[i].mParentHandle = structHandle;
+            sLargePropertyMap[i].mContextTag   = static_cast<uint8_t>((s & 1) ? kLeavesPerStruct - leaf : leaf + 1);
+        }
+    }
+
+    memset(&schema, 0, sizeof(schema));
+    schema.mProfileId              = 0x235A0000 | 0xFF01;
+    schema.mSchemaHandleTbl        = sLargePropertyMap;
+    schema.mNumSchemaHandleEntries = kNumProperties;
+    schema.mTreeDepth              = 3;
+
+    return schema;
+}
+
+static TraitSchemaEngine::Schema WithIndex(TraitSchemaEngine::Schema aSchema)
+{
+    aSchema.mPropertyIndex = sIndexStorage;
+    memset(sIndexStorage, 0, sizeof(sIndexStorage));
+
+    return aSchema;
+}
+
+static TraitSchemaEngine::Schema WithoutIndex(TraitSchemaEngine::Schema aSchema)
+{
+    aSchema.mPropertyIndex = NULL;
+
+    return aSchema;
+}
+
+// Writes each leaf's own handle as its value, and checks the values read back.
+class TraitDelegate : public TraitSchemaEngine::IGetDataDelegate, public TraitSchemaEngine::ISetDataDelegate
+{
+public:
+    TraitDelegate(void) : mNumLeavesSet(0), mNumBadLeaves(0) { }
+
+    WEAVE_ERROR GetLeafData(PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, TLVWriter & aWriter)
+    {
+        return aWriter.Put(aTagToWrite, static_cast<uint32_t>(aLeafHandle));
+    }
+
+    WEAVE_ERROR GetData(PropertyPathHandle aHandle, uint64_t aTagToWrite, TLVWriter & aWriter, bool & aIsNull, bool & aIsPresent)
+    {
+        aIsNull    = false;
+        aIsPresent = true;
+
+        return GetLeafData(aHandle, aTagToWrite, aWriter);
+    }
+
+    WEAVE_ERROR GetNextDictionaryItemKey(PropertyPathHandle aDictionaryHandle, uintptr_t & aContext, PropertyDictionaryKey & aKey)
+    {
+        return WEAVE_END_OF_INPUT;
+    }
+
+    WEAVE_ERROR SetLeafData(PropertyPathHandle aLeafHandle, TLVReader & aReader)
+    {
+        uint32_t value = 0;
+        WEAVE_ERROR err = aReader.Get(value);
+
+        mNumLeavesSet++;
+        if (err != WEAVE_NO_ERROR || value != aLeafHandle)
+        {
+            mNumBadLeaves++;
+        }
+
+        return err;
+    }
+
+    WEAVE_ERROR SetData(PropertyPathHandle aHandle, TLVReader & aReader, bool aIsNull)
+    {
+        return SetLeafData(aHandle, aReader);
+    }
+
+    void OnDataSinkEvent(DataSinkEventType aType, PropertyPathHandle aHandle) { }
+
+    uint32_t mNumLeavesSet;
+    uint32_t mNumBadLeaves;
+};
+
+// Check that every schema query answered by the index matches the answer found by searching the handle table.
+static void CheckSameQueries(nlTestSuite *inSuite, const TraitSchemaEngine & aPlain, const TraitSchemaEngine & aIndexed,
+                             PropertyDictionaryKey aKey)
+{
+    const uint32_t numHandles = aPlain.mSchema.mNumSchemaHandleEntries + TraitSchemaEngine::kHandleTableOffset;
+
+    for (uint32_t h = kRootPropertyPathHandle; h < numHandles + 1; h++)
+    {
+        const PropertyPathHandle handle = CreatePropertyPathHandle(static_cast<PropertySchemaHandle>(h), aKey);
+        PropertyPathHandle plainChild   = aPlain.GetFirstChild(handle);
+        PropertyPathHandle indexedChild = aIndexed.GetFirstChild(handle);
+
+        NL_TEST_ASSERT(inSuite, aPlain.IsLeaf(handle) == aIndexed.IsLeaf(handle));
+
+        while (true)
+        {
+            NL_TEST_ASSERT(inSuite, plainChild == indexedChild);
+            if (plainChild != indexedChild || IsNullPropertyPathHandle(plainChild))
+                break;
+
+            plainChild   = aPlain.GetNextChild(handle, plainChild);
+            indexedChild = aIndexed.GetNextChild(handle, indexedChild);
+        }
+
+        // A child handle that does not belong to this parent resumes the search at the next handle in the table.
+        for (uint32_t c = kRootPropertyPathHandle; c < numHandles; c++)
+        {
+            const PropertyPathHandle other = CreatePropertyPathHandle(static_cast<PropertySchemaHandle>(c), aKey);
+
+            NL_TEST_ASSERT(inSuite, aPlain.GetNextChild(handle, other) == aIndexed.GetNextChild(handle, other));
+        }
+
+        for (uint32_t tag = 0; tag <= UINT8_MAX; tag++)
+        {
+            NL_TEST_ASSERT(inSuite, aPlain.GetChildHandle(handle, static_cast<uint8_t>(tag)) ==
+                           aIndexed.GetChildHandle(handle, static_cast<uint8_t>(tag)));
+        }
+
+        NL_TEST_ASSERT(inSuite, aPlain.GetDictionaryItemHandle(handle, 7) == aIndexed.GetDictionaryItemHandle(handle, 7));
+        NL_TEST_ASSERT(inSuite, aPlain.GetDepth(handle) == aIndexed.GetDepth(handle));
+    }
+}
+
+// Check that ancestor queries answered by the index match the answers found by walking up the tree, including for handles
+// whose dictionary keys differ.
+static void CheckSameAncestors(nlTestSuite *inSuite, const TraitSchemaEngine & aPlain, const TraitSchemaEngine & aIndexed,
+                               PropertyDictionaryKey aKey)
+{
+    const uint32_t numHandles = aPlain.mSchema.mNumSchemaHandleEntries + TraitSchemaEngine::kHandleTableOffset;
+
+    for (uint32_t h1 = kRootPropertyPathHandle; h1 < numHandles + 1; h1++)
+    {
+        for (uint32_t h2 = kRootPropertyPathHandle; h2 < numHandles + 1; h2++)
+        {
+            const PropertyDictionaryKey keys[] = { 0, aKey };
+
+            for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+            {
+                const PropertyDictionaryKey key2 = keys[k];
+                const PropertyPathHandle handle1 = CreatePropertyPathHandle(static_cast<PropertySchemaHandle>(h1), aKey);
+                const PropertyPathHandle handle2 = CreatePropertyPathHandle(static_cast<PropertySchemaHandle>(h2), key2);
+                PropertyPathHandle plainBranch1 = kNullPropertyPathHandle, plainBranch2 = kNullPropertyPathHandle;
+                PropertyPathHandle indexedBranch1 = kNullPropertyPathHandle, indexedBranch2 = kNullPropertyPathHandle;
+                PropertyPathHandle plainAncestor, indexedAncestor;
+
+                NL_TEST_ASSERT(inSuite, aPlain.IsParent(handle1, handle2) == aIndexed.IsParent(handle1, handle2));
+
+                // The walk up the tree never meets when the keys of two handles differ below their common dictionary.
+                if (h1 >= numHandles || h2 >= numHandles || key2 != aKey)
+                    continue;
+
+                plainAncestor   = aPlain.FindLowestCommonAncestor(handle1, handle2, &plainBranch1, &plainBranch2);
+                indexedAncestor = aIndexed.FindLowestCommonAncestor(handle1, handle2, &indexedBranch1, &indexedBranch2);
+
+                NL_TEST_ASSERT(inSuite, plainAncestor == indexedAncestor);
+                NL_TEST_ASSERT(inSuite, plainBranch1 == indexedBranch1 && plainBranch2 == indexedBranch2);
+            }
+        }
+    }
+}
+
+static void CheckTestHTraitQueries(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine & generated = TestHTrait::TraitSchema;
+    const TraitSchemaEngine plain       = { WithoutIndex(generated.mSchema) };
+    const TraitSchemaEngine indexed     = { WithIndex(generated.mSchema) };
+
+    NL_TEST_ASSERT(inSuite, plain.mSchema.mNumSchemaHandleEntries + 1 <= kMaxIndexEntries);
+
+    // The generated schema supplies its own index storage.
+    NL_TEST_ASSERT(inSuite, generated.mSchema.mPropertyIndex != NULL);
+
+    CheckSameQueries(inSuite, plain, indexed, 0);
+    CheckSameQueries(inSuite, plain, indexed, 3);
+    CheckSameQueries(inSuite, plain, generated, 3);
+
+    CheckSameAncestors(inSuite, plain, indexed, 0);
+    CheckSameAncestors(inSuite, plain, indexed, 3);
+    CheckSameAncestors(inSuite, plain, generated, 3);
+}
+
+static void CheckLargeTraitQueries(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine plain   = { MakeLargeSchema() };
+    const TraitSchemaEngine indexed = { WithIndex(plain.mSchema) };
+
+    CheckSameQueries(inSuite, plain, indexed, 0);
+    CheckSameAncestors(inSuite, plain, indexed, 0);
+}
+
+static WEAVE_ERROR SerializeTrait(const TraitSchemaEngine & aEngine, TraitDelegate & aDelegate, uint32_t & aEncodedLen)
+{
+    WEAVE_ERROR err;
+    TLVWriter writer;
+
+    writer.Init(sEncodedTrait, sizeof(sEncodedTrait));
+
+    err = aEngine.RetrieveData(kRootPropertyPathHandle, AnonymousTag, writer, &aDelegate);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    aEncodedLen = writer.GetLengthWritten();
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR DeserializeTrait(const TraitSchemaEngine & aEngine, TraitDelegate & aDelegate, uint32_t aEncodedLen)
+{
+    WEAVE_ERROR err;
+    TLVReader reader;
+
+    reader.Init(sEncodedTrait, aEncodedLen);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = aEngine.StoreData(kRootPropertyPathHandle, reader, &aDelegate, NULL);
+
+exit:
+    return err;
+}
+
+static void CheckRoundTrip(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine plain   = { MakeLargeSchema() };
+    const TraitSchemaEngine indexed = { WithIndex(plain.mSchema) };
+    const uint32_t numLeaves        = kNumTopLeaves + kNumStructs * kLeavesPerStruct;
+    uint8_t plainEncoding[kEncodedTraitSize];
+    uint32_t plainLen = 0, indexedLen = 0;
+    TraitDelegate delegate;
+    WEAVE_ERROR err;
+
+    // Both engines must produce the same encoding, properties in table order, and read every leaf back.
+    err = SerializeTrait(plain, delegate, plainLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    memcpy(plainEncoding, sEncodedTrait, plainLen);
+
+    err = SerializeTrait(indexed, delegate, indexedLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, indexedLen == plainLen && memcmp(plainEncoding, sEncodedTrait, plainLen) == 0);
+
+    err = DeserializeTrait(indexed, delegate, indexedLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, delegate.mNumLeavesSet == numLeaves);
+    NL_TEST_ASSERT(inSuite, delegate.mNumBadLeaves == 0);
+}
+
+static void CheckSerializePerf(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine plain   = { MakeLargeSchema() };
+    const TraitSchemaEngine indexed = { WithIndex(plain.mSchema) };
+    const TraitSchemaEngine * engines[] = { &plain, &indexed };
+    const char * labels[] = { "table scan", "index" };
+
+    printf("\n%u properties, %u rounds\n", static_cast<unsigned int>(kNumProperties), static_cast<unsigned int>(kBenchmarkRounds));
+    printf("%-12s %16s %16s\n", "engine", "serialize us", "deserialize us");
+
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++)
+    {
+        TraitDelegate delegate;
+        uint32_t encodedLen = 0;
+        uint64_t start, serializeTime, deserializeTime;
+        WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (uint32_t i = 0; i < kBenchmarkRounds && err == WEAVE_NO_ERROR; i++)
+        {
+            err = SerializeTrait(*engines[e], delegate, encodedLen);
+        }
+        serializeTime = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (uint32_t i = 0; i < kBenchmarkRounds && err == WEAVE_NO_ERROR; i++)
+        {
+            err = DeserializeTrait(*engines[e], delegate, encodedLen);
+        }
+        deserializeTime = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, delegate.mNumBadLeaves == 0);
+
+        printf("%-12s %16.1f %16.1f\n", labels[e], static_cast<double>(serializeTime) / kBenchmarkRounds,
+               static_cast<double>(deserializeTime) / kBenchmarkRounds);
+    }
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("TestHTrait queries",  CheckTestHTraitQueries),
+    NL_TEST_DEF("Large trait queries",  CheckLargeTraitQueries),
+    NL_TEST_DEF("Round trip",  CheckRoundTrip),
+    NL_TEST_DEF("Benchmark serialize/deserialize",  CheckSerializePerf),
+
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    return 0;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void *inContext)
+{
+    return 0;
+}
+
+#endif // TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+#if TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+    nlTestSuite theSuite = {
+        "weave-trait-schema-index",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+#else // !TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+    return 0;
+#endif // !TDM_SCHEMA_PROPERTY_INDEX_SUPPORT
+}
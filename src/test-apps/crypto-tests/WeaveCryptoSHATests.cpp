@@ -303,12 +303,100 @@ static void Check_SHA1_Test3(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, memcmp(hashBuf, LongMsg6056Result, SHA1::kHashLength) == 0);
 }
 
+static void Check_SHA256_Test1(nlTestSuite *inSuite, void *inContext)
+{
+    // Same messages as the SHA1 driver above; results from FIPS 180-2.
+
+    static const char *testarray[4] =
+    {
+        TEST1,
+        TEST2,
+        TEST3,
+        TEST4
+    };
+
+    static long int repeatcount[4] = { 1, 1, 1000000, 10 };
+
+    static uint8_t resultarray[][SHA256::kHashLength] =
+    {
+        { 0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+          0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD },
+        { 0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+          0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1 },
+        { 0xCD, 0xC7, 0x6E, 0x5C, 0x99, 0x14, 0xFB, 0x92, 0x81, 0xA1, 0xC7, 0xE2, 0x84, 0xD7, 0x3E, 0x67,
+          0xF1, 0x80, 0x9A, 0x48, 0xA4, 0x97, 0x20, 0x0E, 0x04, 0x6D, 0x39, 0xCC, 0xC7, 0x11, 0x2C, 0xD0 },
+        { 0x59, 0x48, 0x47, 0x32, 0x84, 0x51, 0xBD, 0xFA, 0x85, 0x05, 0x62, 0x25, 0x46, 0x2C, 0xC1, 0xD8,
+          0x67, 0xD8, 0x77, 0xFB, 0x38, 0x8D, 0xF0, 0xCE, 0x35, 0xF2, 0x5A, 0xB5, 0x56, 0x2B, 0xFB, 0xB5 }
+    };
+
+    nl::Weave::Platform::Security::SHA256 sha256;
+    uint8_t hashBuf[SHA256::kHashLength];
+
+    for (int j = 0; j < 4; ++j)
+    {
+        sha256.Begin();
+        for (int i = 0; i < repeatcount[j]; ++i)
+            sha256.AddData((const uint8_t *) testarray[j], strlen(testarray[j]));
+        sha256.Finish(hashBuf);
+        // Invalid SHA256 result
+        NL_TEST_ASSERT(inSuite, memcmp(hashBuf, resultarray[j], SHA256::kHashLength) == 0);
+    }
+}
+
+static void Check_SHA_Test4(nlTestSuite *inSuite, void *inContext)
+{
+    // Hashing a message in pieces must give the same result as hashing it whole, for every
+    // message length around the block and padding boundaries and every split point.
+
+    uint8_t msg[200];
+    uint8_t wholeHash[SHA256::kHashLength];
+    uint8_t splitHash[SHA256::kHashLength];
+    nl::Weave::Platform::Security::SHA1 sha1;
+    nl::Weave::Platform::Security::SHA256 sha256;
+
+    for (size_t i = 0; i < sizeof(msg); i++)
+        msg[i] = (uint8_t)(i * 7 + 3);
+
+    for (size_t len = 0; len <= sizeof(msg); len++)
+    {
+        sha1.Begin();
+        sha1.AddData(msg, len);
+        sha1.Finish(wholeHash);
+
+        for (size_t split = 0; split <= len; split += 5)
+        {
+            sha1.Begin();
+            sha1.AddData(msg, split);
+            sha1.AddData(msg + split, len - split);
+            sha1.Finish(splitHash);
+            // Invalid SHA1 result (split message)
+            NL_TEST_ASSERT(inSuite, memcmp(wholeHash, splitHash, SHA1::kHashLength) == 0);
+        }
+
+        sha256.Begin();
+        sha256.AddData(msg, len);
+        sha256.Finish(wholeHash);
+
+        for (size_t split = 0; split <= len; split += 5)
+        {
+            sha256.Begin();
+            sha256.AddData(msg, split);
+            sha256.AddData(msg + split, len - split);
+            sha256.Finish(splitHash);
+            // Invalid SHA256 result (split message)
+            NL_TEST_ASSERT(inSuite, memcmp(wholeHash, splitHash, SHA256::kHashLength) == 0);
+        }
+    }
+}
+
 static const nlTest sTests[] = {
     NL_TEST_DEF("SHA1 Test1",          Check_SHA1_Test1),
 #if WEAVE_WITH_OPENSSL
     NL_TEST_DEF("SHA1 Test2",          Check_SHA1_Test2),
 #endif
     NL_TEST_DEF("SHA1 Test3",          Check_SHA1_Test3),
+    NL_TEST_DEF("SHA256 Test1",        Check_SHA256_Test1),
+    NL_TEST_DEF("SHA Test4",           Check_SHA_Test4),
     NL_TEST_SENTINEL()
 };
 
@@ -88,6 +88,14 @@ uint8_t IsEphemeralHandleBitfield[] = {
         0x18, 0x0, 0x10, 0x8
 };
 
+//
+// Property Index
+//
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
 //
 // Schema
 //
@@ -111,6 +119,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndex,
 #endif
     }
 };
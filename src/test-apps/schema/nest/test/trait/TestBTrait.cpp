@@ -96,6 +96,14 @@ uint8_t IsEphemeralHandleBitfield[] = {
         0x18, 0x0, 0x10, 0x40, 0x8
 };
 
+//
+// Property Index
+//
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
 //
 // Schema
 //
@@ -119,6 +127,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndex,
 #endif
     }
 };
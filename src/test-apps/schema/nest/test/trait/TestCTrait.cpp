@@ -38,6 +38,14 @@ const TraitSchemaEngine::PropertyInfo PropertyMap[] = {
 //
 const ConstSchemaVersionRange traitVersion = { .mMinVersion = 1, .mMaxVersion = 2 };
 
+//
+// Property Index
+//
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
 //
 // Schema
 //
@@ -61,6 +69,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         &traitVersion,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndex,
 #endif
     }
 };
@@ -41,6 +41,14 @@ const TraitSchemaEngine::PropertyInfo PropertyMap[] = {
 //
 const ConstSchemaVersionRange traitVersion = { .mMinVersion = 1, .mMaxVersion = 2 };
 
+//
+// Property Index
+//
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
 //
 // Schema
 //
@@ -64,6 +72,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         &traitVersion,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+        PropertyIndex,
 #endif
     }
 };
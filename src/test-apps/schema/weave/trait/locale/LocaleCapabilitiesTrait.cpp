@@ -36,6 +36,10 @@ namespace LocaleCapabilitiesTrait {
         { kRootPropertyPathHandle,         2 }
     };
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    TraitSchemaEngine::PropertyIndexEntry gPropertyIndex[sizeof(gSchemaMap) / sizeof(gSchemaMap[0]) + 1];
+#endif
+
     TraitSchemaEngine TraitSchema = {
         .mSchema = {
             kWeaveProfileId,
@@ -57,6 +61,9 @@ namespace LocaleCapabilitiesTrait {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
             NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+            gPropertyIndex,
 #endif
         }
     };
@@ -36,6 +36,10 @@ namespace LocaleSettingsTrait {
         { kPropertyHandle_Root,         1 }
     };
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    TraitSchemaEngine::PropertyIndexEntry gPropertyIndex[sizeof(gSchemaMap) / sizeof(gSchemaMap[0]) + 1];
+#endif
+
     TraitSchemaEngine TraitSchema = {
         {
             kWeaveProfileId,
@@ -57,6 +61,9 @@ namespace LocaleSettingsTrait {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
             NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+            gPropertyIndex,
 #endif
         }
     };
@@ -37,6 +37,10 @@ namespace BoltLockSettingTrait {
         { kRootPropertyPathHandle,         2 },
     };
 
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    TraitSchemaEngine::PropertyIndexEntry gPropertyIndex[sizeof(gSchemaMap) / sizeof(gSchemaMap[0]) + 1];
+#endif
+
     TraitSchemaEngine TraitSchema = {
         {
             kWeaveProfileId,
@@ -58,6 +62,9 @@ namespace BoltLockSettingTrait {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
             NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+            gPropertyIndex,
 #endif
         }
     };
@@ -40,6 +40,14 @@ namespace NetworkWiFiTelemetryTrait {
     const TraitSchemaEngine::PropertyInfo PropertyMap[] = {
     };
 
+    //
+    // Property Index
+    //
+
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+    TraitSchemaEngine::PropertyIndexEntry PropertyIndex[sizeof(PropertyMap) / sizeof(PropertyMap[0]) + 1];
+#endif
+
     //
     // Schema
     //
@@ -65,6 +73,9 @@ namespace NetworkWiFiTelemetryTrait {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
             NULL,
+#endif
+#if (TDM_SCHEMA_PROPERTY_INDEX_SUPPORT)
+            PropertyIndex,
 #endif
         }
     };